@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <dots/GuestTransceiver.h>
+#include <dots/HostTransceiver.h>
+#include <PublishData.dots.h>
+
+namespace po = boost::program_options;
+
+namespace
+{
+    enum struct Mode
+    {
+        post,
+        queue
+    };
+
+    struct Subscriber
+    {
+        Subscriber(const dots::io::Endpoint& endpoint) :
+            guest{ "concurrent-publish-subscriber", ioContext }
+        {
+            guest.open(endpoint);
+
+            while (!guest.connected())
+            {
+                ioContext.run_one();
+            }
+
+            subscription.emplace(guest.subscribe<PublishData>([this](const dots::Event<PublishData>& event)
+            {
+                if (*event().sequence == 0)
+                {
+                    ready.store(true, std::memory_order_release);
+                }
+                else
+                {
+                    received.fetch_add(1, std::memory_order_release);
+                }
+            }));
+
+            thread = std::thread{ [this]{ ioContext.run(); } };
+        }
+
+        ~Subscriber()
+        {
+            ioContext.stop();
+            thread.join();
+        }
+
+        dots::asio::io_context ioContext;
+        dots::GuestTransceiver guest;
+        std::optional<dots::Subscription> subscription;
+        std::atomic<bool> ready = false;
+        std::atomic<uint32_t> received = 0;
+        std::thread thread;
+    };
+
+    struct Options
+    {
+        std::string endpoint;
+        uint32_t transmissions;
+        size_t payloadSize;
+    };
+
+    double run(Mode mode, uint32_t producers, const Options& options)
+    {
+        dots::io::Endpoint endpoint{ options.endpoint };
+
+        // create host that operates on its own thread
+        dots::asio::io_context hostContext;
+        dots::HostTransceiver host{ "concurrent-publish", hostContext, dots::type::Registry::StaticTypePolicy::InternalOnly };
+        host.listen({ endpoint });
+        std::thread hostThread{ [&hostContext]{ hostContext.run(); } };
+
+        // create subscriber that operates on its own thread
+        auto subscriber = std::make_unique<Subscriber>(endpoint);
+
+        // create publisher that operates on its own thread after the
+        // subscription has been established
+        dots::asio::io_context publisherContext;
+        dots::GuestTransceiver publisher{ "concurrent-publish-publisher", publisherContext };
+        publisher.open(endpoint);
+
+        while (!publisher.connected())
+        {
+            publisherContext.run_one();
+        }
+
+        std::string payload(options.payloadSize, 'x');
+
+        while (!subscriber->ready.load(std::memory_order_acquire))
+        {
+            publisher.publish(PublishData{ .sequence = 0, .payload = payload });
+            publisherContext.poll();
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+        }
+
+        auto workGuard = dots::asio::make_work_guard(publisherContext);
+        std::thread publisherThread{ [&publisherContext]{ publisherContext.run(); } };
+
+        // publish from all producer threads at once
+        uint32_t transmissionsPerProducer = options.transmissions / producers;
+        uint32_t transmissions = transmissionsPerProducer * producers;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> producerThreads;
+
+        for (uint32_t producer = 0; producer < producers; ++producer)
+        {
+            producerThreads.emplace_back([&, producer]
+            {
+                for (uint32_t i = 0; i < transmissionsPerProducer; ++i)
+                {
+                    PublishData instance{ .sequence = 1 + producer * transmissionsPerProducer + i, .payload = payload };
+
+                    if (mode == Mode::post)
+                    {
+                        dots::asio::post(publisherContext, [&publisher, instance{ std::move(instance) }]{ publisher.publish(instance); });
+                    }
+                    else
+                    {
+                        publisher.postPublish(std::move(instance));
+                    }
+                }
+            });
+        }
+
+        for (std::thread& producerThread : producerThreads)
+        {
+            producerThread.join();
+        }
+
+        while (subscriber->received.load(std::memory_order_acquire) < transmissions)
+        {
+            std::this_thread::yield();
+        }
+
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+        workGuard.reset();
+        publisherContext.stop();
+        publisherThread.join();
+        subscriber.reset();
+        hostContext.stop();
+        hostThread.join();
+
+        return transmissions / duration.count();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        po::options_description optionsDescription("Allowed options");
+        optionsDescription.add_options()
+            ("help", "display help message")
+            ("endpoint", po::value<std::string>()->default_value("tcp://127.0.0.1:11299"), "host endpoint to publish to")
+            ("producers", po::value<std::vector<uint32_t>>()->multitoken()->default_value({ 1, 2, 4, 8 }, "1 2 4 8"), "amounts of producer threads to benchmark")
+            ("transmissions", po::value<uint32_t>()->default_value(200000), "total amount of transmissions to publish across all producer threads")
+            ("payload-size", po::value<size_t>()->default_value(64), "size of the payload of each transmission in bytes")
+        ;
+
+        po::variables_map args;
+        po::store(po::parse_command_line(argc, argv, optionsDescription), args);
+        po::notify(args);
+
+        if (args.count("help"))
+        {
+            std::cout << optionsDescription << "\n";
+            return EXIT_SUCCESS;
+        }
+
+        Options options{
+            .endpoint = args["endpoint"].as<std::string>(),
+            .transmissions = args["transmissions"].as<uint32_t>(),
+            .payloadSize = args["payload-size"].as<size_t>()
+        };
+
+        std::cout << "producers,post-transmissions/s,queue-transmissions/s" << "\n";
+
+        for (uint32_t producers : args["producers"].as<std::vector<uint32_t>>())
+        {
+            if (producers == 0)
+            {
+                throw std::runtime_error{ "amount of producer threads must be greater than zero" };
+            }
+
+            double postThroughput = run(Mode::post, producers, options);
+            double queueThroughput = run(Mode::queue, producers, options);
+            std::cout << producers << "," << postThroughput << "," << queueThroughput << std::endl;
+        }
+
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR running concurrent-publish -> " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+}
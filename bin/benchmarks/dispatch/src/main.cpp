@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <dots/Dispatcher.h>
+#include <DispatchData.dots.h>
+#include <UncachedDispatchData.dots.h>
+
+namespace po = boost::program_options;
+
+namespace
+{
+    struct Options
+    {
+        uint32_t transmissions;
+        uint32_t instances;
+    };
+
+    template <typename T>
+    double run(uint32_t handlers, const Options& options)
+    {
+        dots::Dispatcher dispatcher{ [](const dots::type::StructDescriptor&/* descriptor*/, std::exception_ptr e){ std::rethrow_exception(e); } };
+        uint64_t sum = 0;
+
+        for (uint32_t i = 0; i < handlers; ++i)
+        {
+            dispatcher.addEventHandler<T>([&sum](const dots::Event<T>& event)
+            {
+                sum += *event.updated().value;
+            });
+        }
+
+        // note: transmissions are created in advance, so that only the cost
+        // of dispatching is measured
+        std::vector<dots::io::Transmission> transmissions;
+        transmissions.reserve(options.transmissions);
+
+        for (uint32_t i = 0; i < options.transmissions; ++i)
+        {
+            T instance{ .id = i % options.instances, .value = i };
+            DotsHeader header{
+                .typeName = T::_Descriptor().name(),
+                .sentTime = dots::timepoint_t::Now(),
+                .attributes = instance._validProperties(),
+                .sender = 1
+            };
+
+            transmissions.emplace_back(std::move(header), std::move(instance));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (const dots::io::Transmission& transmission : transmissions)
+        {
+            dispatcher.dispatch(transmission);
+        }
+
+        std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+
+        if (handlers > 0 && sum == 0)
+        {
+            throw std::logic_error{ "event handlers were not invoked" };
+        }
+
+        return duration.count() / options.transmissions;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        po::options_description optionsDescription("Allowed options");
+        optionsDescription.add_options()
+            ("help", "display help message")
+            ("handlers", po::value<std::vector<uint32_t>>()->multitoken()->default_value({ 0, 1, 4, 16, 64, 256 }, "0 1 4 16 64 256"), "amounts of event handlers to benchmark")
+            ("transmissions", po::value<uint32_t>()->default_value(1000000), "amount of transmissions to dispatch")
+            ("instances", po::value<uint32_t>()->default_value(1000), "amount of distinct instances of the cached type")
+        ;
+
+        po::variables_map args;
+        po::store(po::parse_command_line(argc, argv, optionsDescription), args);
+        po::notify(args);
+
+        if (args.count("help"))
+        {
+            std::cout << optionsDescription << "\n";
+            return EXIT_SUCCESS;
+        }
+
+        Options options{
+            .transmissions = args["transmissions"].as<uint32_t>(),
+            .instances = args["instances"].as<uint32_t>()
+        };
+
+        if (options.transmissions == 0 || options.instances == 0)
+        {
+            throw std::runtime_error{ "amounts of transmissions and instances must be greater than zero" };
+        }
+
+        std::cout << "handlers,cached-ns/dispatch,uncached-ns/dispatch" << "\n";
+
+        for (uint32_t handlers : args["handlers"].as<std::vector<uint32_t>>())
+        {
+            double cachedDuration = run<DispatchData>(handlers, options);
+            double uncachedDuration = run<UncachedDispatchData>(handlers, options);
+            std::cout << handlers << "," << cachedDuration << "," << uncachedDuration << std::endl;
+        }
+
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR running dispatch -> " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+}
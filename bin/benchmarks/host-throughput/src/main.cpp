@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <dots/GuestTransceiver.h>
+#include <dots/HostTransceiver.h>
+#include <ThroughputData.dots.h>
+
+namespace po = boost::program_options;
+
+namespace
+{
+    struct Subscriber
+    {
+        Subscriber(std::string name, const dots::io::Endpoint& endpoint) :
+            guest{ std::move(name), ioContext }
+        {
+            guest.open(endpoint);
+
+            while (!guest.connected())
+            {
+                ioContext.run_one();
+            }
+
+            subscription.emplace(guest.subscribe<ThroughputData>([this](const dots::Event<ThroughputData>& event)
+            {
+                received.store(*event().sequence + 1, std::memory_order_release);
+            }));
+
+            thread = std::thread{ [this]{ ioContext.run(); } };
+        }
+
+        ~Subscriber()
+        {
+            ioContext.stop();
+            thread.join();
+        }
+
+        dots::asio::io_context ioContext;
+        dots::GuestTransceiver guest;
+        std::optional<dots::Subscription> subscription;
+        std::atomic<uint32_t> received = 0;
+        std::thread thread;
+    };
+
+    struct Options
+    {
+        size_t subscribers;
+        uint32_t transmissions;
+        size_t payloadSize;
+        uint32_t window;
+        std::string port;
+    };
+
+    double run(const std::string& scheme, size_t threads, const Options& options)
+    {
+        dots::io::Endpoint endpoint{ scheme + "://127.0.0.1:" + options.port };
+
+        // create host that distributes guest connections across the given amount of worker threads
+        dots::asio::io_context hostContext;
+        dots::HostTransceiver host{ "host-throughput", hostContext, dots::type::Registry::StaticTypePolicy::InternalOnly };
+        host.setWorkerThreads(threads);
+        host.listen({ endpoint });
+        std::thread hostThread{ [&hostContext]{ hostContext.run(); } };
+
+        // create subscribers that each operate on their own thread
+        std::vector<std::unique_ptr<Subscriber>> subscribers;
+
+        for (size_t i = 0; i < options.subscribers; ++i)
+        {
+            subscribers.emplace_back(std::make_unique<Subscriber>("host-throughput-subscriber-" + std::to_string(i), endpoint));
+        }
+
+        auto min_received = [&subscribers]
+        {
+            uint32_t minReceived = std::numeric_limits<uint32_t>::max();
+
+            for (const auto& subscriber : subscribers)
+            {
+                minReceived = std::min(minReceived, subscriber->received.load(std::memory_order_acquire));
+            }
+
+            return minReceived;
+        };
+
+        // create publisher that operates on the main thread
+        dots::asio::io_context publisherContext;
+        dots::GuestTransceiver publisher{ "host-throughput-publisher", publisherContext };
+        publisher.open(endpoint);
+
+        while (!publisher.connected())
+        {
+            publisherContext.run_one();
+        }
+
+        std::string payload(options.payloadSize, 'x');
+
+        // ensure that all subscriptions have been established by the host
+        while (min_received() == 0)
+        {
+            publisher.publish(ThroughputData{ .sequence = 0, .payload = payload });
+            publisherContext.poll();
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+        }
+
+        // publish transmissions while limiting the amount of transmissions that have not been received by all subscribers
+        auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t sequence = 1; sequence <= options.transmissions;)
+        {
+            if (sequence - min_received() < options.window)
+            {
+                publisher.publish(ThroughputData{ .sequence = sequence++, .payload = payload });
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+
+            publisherContext.poll();
+        }
+
+        while (min_received() <= options.transmissions)
+        {
+            publisherContext.poll();
+            std::this_thread::yield();
+        }
+
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+        subscribers.clear();
+        hostContext.stop();
+        hostThread.join();
+
+        return options.transmissions / duration.count();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        po::options_description optionsDescription("Allowed options");
+        optionsDescription.add_options()
+            ("help", "display help message")
+        #if defined(DOTS_ENABLE_IO_URING)
+            ("schemes", po::value<std::vector<std::string>>()->multitoken()->default_value(std::vector<std::string>{ "tcp", "tcp-uring" }, "tcp tcp-uring"), "TCP endpoint schemes to benchmark")
+        #else
+            ("schemes", po::value<std::vector<std::string>>()->multitoken()->default_value(std::vector<std::string>{ "tcp" }, "tcp"), "TCP endpoint schemes to benchmark")
+        #endif
+            ("threads", po::value<std::vector<size_t>>()->multitoken()->default_value(std::vector<size_t>{ 0, 1, 2, 4 }, "0 1 2 4"), "amounts of host worker threads to benchmark")
+            ("subscribers", po::value<size_t>()->default_value(32), "amount of subscribers to fan out to")
+            ("transmissions", po::value<uint32_t>()->default_value(100000), "amount of transmissions to publish per run")
+            ("payload-size", po::value<size_t>()->default_value(256), "size of the payload of each transmission in bytes")
+            ("window", po::value<uint32_t>()->default_value(1000), "maximum amount of transmissions that have not been received by all subscribers")
+            ("port", po::value<std::string>()->default_value("11299"), "local TCP port of the host")
+        ;
+
+        po::variables_map args;
+        po::store(po::parse_command_line(argc, argv, optionsDescription), args);
+        po::notify(args);
+
+        if (args.count("help"))
+        {
+            std::cout << optionsDescription << "\n";
+            return EXIT_SUCCESS;
+        }
+
+        Options options{
+            .subscribers = args["subscribers"].as<size_t>(),
+            .transmissions = args["transmissions"].as<uint32_t>(),
+            .payloadSize = args["payload-size"].as<size_t>(),
+            .window = args["window"].as<uint32_t>(),
+            .port = args["port"].as<std::string>()
+        };
+
+        std::cout << "scheme,threads,transmissions/s,deliveries/s" << "\n";
+
+        for (const std::string& scheme : args["schemes"].as<std::vector<std::string>>())
+        {
+            for (size_t threads : args["threads"].as<std::vector<size_t>>())
+            {
+                double throughput = run(scheme, threads, options);
+                std::cout << scheme << "," << threads << "," << throughput << "," << throughput * options.subscribers << std::endl;
+            }
+        }
+
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR running host-throughput -> " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <dots/GuestTransceiver.h>
+#include <dots/HostTransceiver.h>
+#include <TransportData.dots.h>
+
+namespace po = boost::program_options;
+
+namespace
+{
+    uint64_t now()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    struct Subscriber
+    {
+        Subscriber(const dots::io::Endpoint& endpoint, size_t maxLatencies) :
+            guest{ "local-transport-subscriber", ioContext }
+        {
+            latencies.reserve(maxLatencies);
+            guest.open(endpoint);
+
+            while (!guest.connected())
+            {
+                ioContext.run_one();
+            }
+
+            subscription.emplace(guest.subscribe<TransportData>([this](const dots::Event<TransportData>& event)
+            {
+                if (recording.load(std::memory_order_acquire) && latencies.size() < latencies.capacity())
+                {
+                    latencies.emplace_back(now() - *event().sentTime);
+                }
+
+                received.store(*event().sequence + 1, std::memory_order_release);
+            }));
+
+            thread = std::thread{ [this]{ ioContext.run(); } };
+        }
+
+        ~Subscriber()
+        {
+            ioContext.stop();
+            thread.join();
+        }
+
+        dots::asio::io_context ioContext;
+        dots::GuestTransceiver guest;
+        std::optional<dots::Subscription> subscription;
+        std::vector<uint64_t> latencies;
+        std::atomic<bool> recording = false;
+        std::atomic<uint32_t> received = 0;
+        std::thread thread;
+    };
+
+    struct Options
+    {
+        uint32_t transmissions;
+        uint32_t roundtrips;
+        size_t payloadSize;
+        uint32_t window;
+    };
+
+    struct Result
+    {
+        double throughput;
+        double latencyMedian;
+        double latencyP99;
+    };
+
+    Result run(const dots::io::Endpoint& endpoint, const Options& options)
+    {
+        // create host that operates on its own thread
+        dots::asio::io_context hostContext;
+        dots::HostTransceiver host{ "local-transport", hostContext, dots::type::Registry::StaticTypePolicy::InternalOnly };
+        host.listen({ endpoint });
+        std::thread hostThread{ [&hostContext]{ hostContext.run(); } };
+
+        // create subscriber that operates on its own thread
+        auto subscriber = std::make_unique<Subscriber>(endpoint, options.roundtrips);
+
+        // create publisher that operates on the main thread
+        dots::asio::io_context publisherContext;
+        dots::GuestTransceiver publisher{ "local-transport-publisher", publisherContext };
+        publisher.open(endpoint);
+
+        while (!publisher.connected())
+        {
+            publisherContext.run_one();
+        }
+
+        std::string payload(options.payloadSize, 'x');
+
+        // ensure that the subscription has been established by the host
+        while (subscriber->received.load(std::memory_order_acquire) == 0)
+        {
+            publisher.publish(TransportData{ .sequence = 0, .sentTime = now(), .payload = payload });
+            publisherContext.poll();
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+        }
+
+        // measure the latency by publishing one transmission at a time
+        uint32_t sequence = 1;
+        subscriber->recording.store(true, std::memory_order_release);
+
+        for (uint32_t i = 0; i < options.roundtrips; ++i, ++sequence)
+        {
+            publisher.publish(TransportData{ .sequence = sequence, .sentTime = now(), .payload = payload });
+
+            while (subscriber->received.load(std::memory_order_acquire) <= sequence)
+            {
+                publisherContext.poll();
+            }
+        }
+
+        subscriber->recording.store(false, std::memory_order_release);
+
+        // measure the throughput while limiting the amount of transmissions that have not been received
+        auto start = std::chrono::steady_clock::now();
+        uint32_t lastSequence = sequence + options.transmissions;
+
+        while (sequence < lastSequence)
+        {
+            if (sequence - subscriber->received.load(std::memory_order_acquire) < options.window)
+            {
+                publisher.publish(TransportData{ .sequence = sequence++, .sentTime = now(), .payload = payload });
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+
+            publisherContext.poll();
+        }
+
+        while (subscriber->received.load(std::memory_order_acquire) < lastSequence)
+        {
+            publisherContext.poll();
+            std::this_thread::yield();
+        }
+
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+        std::vector<uint64_t> latencies = std::move(subscriber->latencies);
+        subscriber.reset();
+        hostContext.stop();
+        hostThread.join();
+
+        std::sort(latencies.begin(), latencies.end());
+
+        auto percentile = [&latencies](double p)
+        {
+            return latencies.empty() ? 0.0 : latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))] / 1000.0;
+        };
+
+        return Result{
+            .throughput = options.transmissions / duration.count(),
+            .latencyMedian = percentile(0.5),
+            .latencyP99 = percentile(0.99)
+        };
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        std::vector<std::string> defaultEndpoints{
+            "tcp://127.0.0.1:11298",
+            "uds:/tmp/dots-local-transport-uds.socket",
+            #if defined(__linux__)
+            "shm:/tmp/dots-local-transport-shm.socket"
+            #endif
+        };
+
+        po::options_description optionsDescription("Allowed options");
+        optionsDescription.add_options()
+            ("help", "display help message")
+            ("endpoints", po::value<std::vector<std::string>>()->multitoken()->default_value(defaultEndpoints, "tcp://127.0.0.1:11298 uds:/tmp/dots-local-transport-uds.socket shm:/tmp/dots-local-transport-shm.socket"), "host endpoints to benchmark")
+            ("transmissions", po::value<uint32_t>()->default_value(200000), "amount of transmissions to publish to measure the throughput")
+            ("roundtrips", po::value<uint32_t>()->default_value(10000), "amount of transmissions to publish one at a time to measure the latency")
+            ("payload-size", po::value<size_t>()->default_value(256), "size of the payload of each transmission in bytes")
+            ("window", po::value<uint32_t>()->default_value(1000), "maximum amount of transmissions that have not been received by the subscriber")
+        ;
+
+        po::variables_map args;
+        po::store(po::parse_command_line(argc, argv, optionsDescription), args);
+        po::notify(args);
+
+        if (args.count("help"))
+        {
+            std::cout << optionsDescription << "\n";
+            return EXIT_SUCCESS;
+        }
+
+        Options options{
+            .transmissions = args["transmissions"].as<uint32_t>(),
+            .roundtrips = args["roundtrips"].as<uint32_t>(),
+            .payloadSize = args["payload-size"].as<size_t>(),
+            .window = args["window"].as<uint32_t>()
+        };
+
+        std::cout << "endpoint,transmissions/s,latency-p50/us,latency-p99/us" << "\n";
+
+        for (const std::string& endpoint : args["endpoints"].as<std::vector<std::string>>())
+        {
+            Result result = run(dots::io::Endpoint{ endpoint }, options);
+            std::cout << endpoint << "," << result.throughput << "," << result.latencyMedian << "," << result.latencyP99 << std::endl;
+        }
+
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR running local-transport -> " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+}
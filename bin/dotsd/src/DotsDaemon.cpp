@@ -15,16 +15,31 @@
 #include <StructDescriptorData.dots.h>
 #include <DotsStatistics.dots.h>
 #include <DotsCacheStatus.dots.h>
+#include <DotsWriteQueueStatus.dots.h>
+#include <DotsTypeStatistics.dots.h>
+#include <DotsTypeLatency.dots.h>
+#include <DotsClientLatency.dots.h>
 
 using namespace dots::literals;
 
 namespace dots
 {
+    namespace
+    {
+        void accumulate(DotsStatistics& total, const DotsStatistics& statistics)
+        {
+            total.bytes = total.bytes.valueOrDefault(0) + statistics.bytes.valueOrDefault(0);
+            total.packages = total.packages.valueOrDefault(0) + statistics.packages.valueOrDefault(0);
+        }
+    }
+
     DotsDaemon::DotsDaemon(std::string name, int argc, char* argv[]) :
         Application(argc, argv, HostTransceiver{ std::move(name), io::global_io_context(), type::Registry::StaticTypePolicy::InternalOnly, HostTransceiver::transition_handler_t{&DotsDaemon::handleTransition, this}}),
         m_daemonStatus{ .serverName = transceiver().selfName(), .startTime = timepoint_t::Now() },
+        m_closedReceived{ .bytes = 0, .packages = 0 },
+        m_closedSent{ .bytes = 0, .packages = 0 },
         m_updateServerStatusTimer{ io::global_io_context(), 1s, { &DotsDaemon::updateServerStatus, this }, true },
-        m_cleanUpClientsTimer{ io::global_io_context(), 10s, { &DotsDaemon::cleanUpClients, this }, true }
+        m_updateLatencyStatisticsTimer{ io::global_io_context(), 10s, { &DotsDaemon::updateLatencyStatistics, this }, true }
     {
         // For backward compatibility: in the legacy version of DOTS,
         // DotsContinuousRecorderStatus and DotsDumpContinuousRecorder where internal-types.
@@ -34,6 +49,8 @@ namespace dots
         type::Descriptor<DotsDumpContinuousRecorder>::Instance();
 
         static_cast<HostTransceiver&>(transceiver()).setAuthManager<io::LegacyAuthManager>();
+        static_cast<HostTransceiver&>(transceiver()).setPeerReleaseHandler(ContainerPool::release_handler_t{ &DotsDaemon::handlePeerRelease, this });
+        static_cast<HostTransceiver&>(transceiver()).setLatencyRecording(true);
     }
 
     void DotsDaemon::handleTransition(const Connection& connection, std::exception_ptr/* ePtr*/)
@@ -43,48 +60,46 @@ namespace dots
             .name = connection.peerName(),
             .connectionState = connection.state()
         });
+
+        // note: the client might not be referenced by any instance at all, in
+        // which case it has to be expired without being released
+        if (connection.closed())
+        {
+            accumulate(m_closedReceived, connection.receivedStatistics());
+            accumulate(m_closedSent, connection.sentStatistics());
+            handlePeerRelease(connection.peerId());
+        }
     }
 
-    void DotsDaemon::cleanUpClients()
+    void DotsDaemon::handlePeerRelease(Connection::id_t id)
     {
-        std::set<Connection::id_t> expiredClients;
+        // note: expiring is deferred, because peers are released while the
+        // cache is being modified
+        asio::post(io::global_io_context(), [this, id]
+        {
+            expireClient(id);
+        });
+    }
 
-        for (auto& element : transceiver().pool().get<DotsClient>())
+    void DotsDaemon::expireClient(Connection::id_t id)
+    {
+        try
         {
-            const auto& client = element.first.to<DotsClient>();
+            const DotsClient* client = transceiver().pool().get<DotsClient>().find(DotsClient{ .id = id });
 
-            if (client.connectionState == DotsConnectionState::closed)
+            if (client != nullptr && client->connectionState == DotsConnectionState::closed && transceiver().pool().referenceCount(id) == 0)
             {
-                bool isStale = [&]
-                {
-                    for (const auto& [descriptor, container] : transceiver().pool())
-                    {
-                        (void)descriptor;
-
-                        for (const auto& [instance, cloneInformation] : container)
-                        {
-                            (void)instance;
+                transceiver().remove(DotsClient{ .id = id });
 
-                            if (cloneInformation.createdFrom == client.id || cloneInformation.lastUpdateFrom == client.id)
-                            {
-                                return false;
-                            }
-                        }
-                    }
-
-                    return true;
-                }();
-
-                if (isStale)
+                if (transceiver().pool().get<DotsClientLatency>().find(DotsClientLatency{ .id = id }) != nullptr)
                 {
-                    expiredClients.emplace(*client.id);
+                    transceiver().remove(DotsClientLatency{ .id = id });
                 }
             }
         }
-
-        for (Connection::id_t id : expiredClients)
+        catch (const std::exception& e)
         {
-            transceiver().remove(DotsClient{ .id = id });
+            LOG_ERROR_S("exception in expireClient: " << e.what());
         }
     }
 
@@ -93,6 +108,17 @@ namespace dots
         try
         {
             DotsDaemonStatus ds{ m_daemonStatus };
+            ds.received = m_closedReceived;
+            ds.sent = m_closedSent;
+
+            for (const Connection* connection : static_cast<HostTransceiver&>(transceiver()).guestConnections())
+            {
+                if (!connection->closed())
+                {
+                    accumulate(*ds.received, connection->receivedStatistics());
+                    accumulate(*ds.sent, connection->sentStatistics());
+                }
+            }
 
             if (m_daemonStatus._diffProperties(ds))
             {
@@ -122,10 +148,76 @@ namespace dots
                 transceiver().publish(ds);
                 m_daemonStatus = ds;
             }
+
+            updateClientStatus();
+            updateTypeStatistics();
         }
         catch (const std::exception& e)
         {
             LOG_ERROR_S("exception in updateServerStatus: " << e.what());
         }
     }
+
+    void DotsDaemon::updateClientStatus()
+    {
+        const Container<DotsClient>& clients = transceiver().pool().get<DotsClient>();
+
+        for (const Connection* connection : static_cast<HostTransceiver&>(transceiver()).guestConnections())
+        {
+            if (connection->closed())
+            {
+                continue;
+            }
+
+            DotsClient status{
+                .id = connection->peerId(),
+                .writeQueue = connection->writeQueueStatus(),
+                .received = connection->receivedStatistics(),
+                .sent = connection->sentStatistics()
+            };
+
+            if (const DotsClient* client = clients.find(status); client == nullptr || !client->_equal(status, status._validProperties()))
+            {
+                transceiver().publish(status);
+            }
+        }
+    }
+
+    void DotsDaemon::updateTypeStatistics()
+    {
+        const Container<DotsTypeStatistics>& typeStatistics = transceiver().pool().get<DotsTypeStatistics>();
+
+        for (const DotsTypeStatistics& statistics : static_cast<HostTransceiver&>(transceiver()).typeStatistics())
+        {
+            if (const DotsTypeStatistics* published = typeStatistics.find(statistics); published == nullptr || *published != statistics)
+            {
+                transceiver().publish(statistics);
+            }
+        }
+    }
+    void DotsDaemon::updateLatencyStatistics()
+    {
+        try
+        {
+            // note: the latencies are reset after each update, so the
+            // published statistics always cover the last update interval
+            HostTransceiver& host = static_cast<HostTransceiver&>(transceiver());
+
+            for (const DotsTypeLatency& latency : host.typeLatencies())
+            {
+                transceiver().publish(latency);
+            }
+
+            for (const DotsClientLatency& latency : host.clientLatencies())
+            {
+                transceiver().publish(latency);
+            }
+
+            host.resetLatencies();
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR_S("exception in updateLatencyStatistics: " << e.what());
+        }
+    }
 }
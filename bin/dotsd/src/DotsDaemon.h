@@ -21,12 +21,18 @@ namespace dots
     private:
 
         void handleTransition(const Connection& connection, std::exception_ptr ePtr);
-        void cleanUpClients();
+        void handlePeerRelease(Connection::id_t id);
+        void expireClient(Connection::id_t id);
 
         void updateServerStatus();
+        void updateClientStatus();
+        void updateTypeStatistics();
+        void updateLatencyStatistics();
 
         DotsDaemonStatus m_daemonStatus;
+        DotsStatistics m_closedReceived;
+        DotsStatistics m_closedSent;
         Timer m_updateServerStatusTimer;
-        Timer m_cleanUpClientsTimer;
+        Timer m_updateLatencyStatisticsTimer;
     };
 }
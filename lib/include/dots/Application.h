@@ -48,6 +48,24 @@ namespace dots
          * endpoint given by the '--dots-endpoint' option. If no endpoint is
          * specified, "tcp://127.0.0.1:11235" will be used as a default.
          *
+         * If the '--dots-multicast' option is given, uncached types will be
+         * received via UDP multicast if the host offers it. The interface to
+         * join multicast groups on can be given via the
+         * '--dots-multicast-interface' option (see
+         * GuestTransceiver::setMulticast()).
+         *
+         * If the '--dots-reconnect' option is given, the connection will be
+         * established asynchronously and the constructor will return without
+         * blocking. The transceiver will then reconnect whenever the
+         * connection is lost instead of exiting the application (see
+         * GuestTransceiver::setReconnect()). Note that the caches of preloaded
+         * types will therefore not have been updated when the constructor
+         * returns.
+         *
+         * If the '--dots-handler-threads' option is given, the event handlers
+         * of subscriptions will be invoked on the given amount of worker
+         * threads (see GuestTransceiver::setHandlerThreads()).
+         *
          * If no transceiver is given (i.e. the global transceiver is used) and
          * any of the statically typed versions of dots::subscribe<T>() or
          * dots::container<T>() of the global DOTS API were instantiated (see
@@ -147,6 +165,25 @@ namespace dots
          * the endpoints given by the '--dots-endpoint' option. If no endpoints
          * are specified, "tcp://127.0.0.1:11235" will be used as a default.
          *
+         * If the '--dots-threads' option is given, the IO of guest
+         * connections will be distributed across the given amount of worker
+         * threads (see HostTransceiver::setWorkerThreads()).
+         *
+         * The write queues of guest connections can be limited via the
+         * '--dots-write-queue-size' and '--dots-write-queue-policy' options
+         * (see HostTransceiver::setWriteQueueLimit()). Updates of cached
+         * types can be conflated for lagging guests via the
+         * '--dots-conflation-threshold' option (see
+         * HostTransceiver::setConflationThreshold()). Updates of cached
+         * types can be reduced to the properties that actually changed via
+         * the '--dots-delta-updates' option or, for specific types, the
+         * '--dots-delta-update-type' option (see
+         * HostTransceiver::setDeltaUpdates()). Uncached types can be
+         * distributed via UDP multicast with the '--dots-multicast-type'
+         * option (e.g. 'Foo=udp://239.255.0.1:11240') and, optionally, the
+         * '--dots-multicast-interface' option (see
+         * HostTransceiver::setMulticast()).
+         *
          * @param argc The number of command line arguments as given in the
          * main() function of the application.
          *
@@ -261,6 +298,17 @@ namespace dots
 
         std::optional<io::Endpoint> m_openEndpoint;
         std::vector<io::Endpoint> m_listenEndpoints;
+        std::optional<size_t> m_hostThreads;
+        std::optional<size_t> m_hostWriteQueueSize;
+        std::optional<DotsWriteQueuePolicy> m_hostWriteQueuePolicy;
+        std::optional<size_t> m_hostConflationThreshold;
+        bool m_hostDeltaUpdates;
+        std::vector<std::string> m_hostDeltaUpdateTypes;
+        std::vector<std::pair<std::string, io::Endpoint>> m_hostMulticastTypes;
+        bool m_multicast;
+        std::optional<std::string> m_multicastInterface;
+        bool m_reconnect;
+        std::optional<size_t> m_handlerThreads;
         std::unique_ptr<signal_set_storage> m_signals;
         int m_exitCode;
         Transceiver* m_transceiver;
@@ -50,6 +50,7 @@ namespace dots
 
         using receive_handler_t = tools::Handler<bool(Connection&, io::Transmission)>;
         using transition_handler_t = tools::Handler<void(Connection&, std::exception_ptr)>;
+        using write_queue_handler_t = tools::Handler<void(Connection&)>;
 
         /*!
          * @brief Construct a new Connection object.
@@ -292,6 +293,45 @@ namespace dots
          */
         void transmit(const io::Transmission& transmission);
 
+        /*!
+         * @brief Transmit a batch of instances with a shared header.
+         *
+         * This will transmit the given instances via the underlying channel.
+         * If supported by the channel (see io::TransmissionFormat::v3), the
+         * instances will be transmitted as a single batch. Otherwise, they
+         * will be transmitted individually with the given header.
+         *
+         * Note that before the connection is established (i.e. the handshake
+         * has been completed), using any of the Connection::transmit()
+         * function is invalid and will indirectly result in closing the
+         * connection.
+         *
+         * @param header The header to transmit. The included properties of
+         * the header apply to all instances.
+         *
+         * @param instances The instances to transmit. Must all be of the type
+         * given in the header.
+         */
+        void transmit(const DotsHeader& header, const io::Channel::instance_batch_t& instances);
+
+        /*!
+         * @brief Transmit a batch of transmissions.
+         *
+         * This will transmit the given transmissions via the underlying
+         * channel. If supported by the channel (see
+         * io::TransmissionFormat::v3), the transmissions will be transmitted
+         * as a single batch that uses the header of the first transmission.
+         *
+         * Note that before the connection is established (i.e. the handshake
+         * has been completed), using any of the Connection::transmit()
+         * function is invalid and will indirectly result in closing the
+         * connection.
+         *
+         * @param transmissions The transmissions to transmit. Must all be of
+         * the same type and only differ in their instances.
+         */
+        void transmit(const std::vector<io::Transmission>& transmissions);
+
         /*!
          * @brief Transmit a specific type.
          *
@@ -311,6 +351,139 @@ namespace dots
          */
         void transmit(const type::StructDescriptor& descriptor);
 
+        /*!
+         * @brief Limit the size of the write queue of the connection.
+         *
+         * This will limit the amount of serialized data that is queued for
+         * writing by the underlying channel and determine what happens when
+         * the limit is exceeded (see DotsWriteQueuePolicy):
+         *
+         * - 'disconnect': the connection will be closed.
+         * - 'drop_oldest': the oldest transmissions of uncached types
+         * distributed by a host that have not been written yet will be
+         * dropped. Transmissions of cached types are never dropped, so the
+         * connection will be closed if the limit cannot be restored
+         * otherwise (see Connection::setConflationThreshold()).
+         * - 'pause_reading': the write queue will be marked as congested
+         * (see Connection::writeQueueCongested()) until it has been drained to
+         * half of the limit. The connection will be closed if the write queue
+         * exceeds twice the limit.
+         *
+         * Note that write queues are only supported by stream channels (e.g.
+         * TCP and UDS). The limit is ignored by all other channels.
+         *
+         * @param maxSize The maximum size of the write queue in bytes.
+         *
+         * @param policy The policy to apply when the write queue exceeds
+         * @p maxSize.
+         *
+         * @param drainHandler The handler to invoke when a congested write
+         * queue has been drained.
+         *
+         * @exception std::logic_error Thrown if @p maxSize is zero.
+         */
+        void setWriteQueueLimit(size_t maxSize, DotsWriteQueuePolicy policy, std::optional<write_queue_handler_t> drainHandler = std::nullopt);
+
+        /*!
+         * @brief Conflate updates of cached types when the write queue
+         * exceeds a specific size.
+         *
+         * When the write queue of the underlying channel exceeds the given
+         * threshold, subsequent updates of the same instance will be merged
+         * into a single transmission until the write queue has been drained
+         * below the threshold again. Merged updates are written before any
+         * other transmission, so transmissions are never reordered. This is
+         * intended for peers that are only interested in the latest state of
+         * instances and cannot keep up with the rate of updates.
+         *
+         * Note that to preserve the order across types, every transmission
+         * that is not conflated (e.g. a remove or an instance of an uncached
+         * type) flushes all pending merged updates, regardless of their
+         * type. Conflation is therefore only effective as long as the
+         * updates of a congested peer are mostly updates of cached types.
+         *
+         * Also note that conflation is only supported by stream channels (e.g. TCP
+         * and UDS) that distribute transmissions of a host. The threshold is
+         * ignored by all other channels.
+         *
+         * @param threshold The size of the write queue in bytes above which
+         * updates will be conflated. If zero, conflation is disabled.
+         */
+        void setConflationThreshold(size_t threshold);
+
+        /*!
+         * @brief Get the current status of the write queue.
+         *
+         * @return DotsWriteQueueStatus The current limit, size and statistics
+         * of the write queue.
+         */
+        DotsWriteQueueStatus writeQueueStatus() const;
+
+        /*!
+         * @brief Get the statistics of the data received through the
+         * connection.
+         *
+         * @return DotsStatistics The total amount of bytes and transmissions
+         * that have been received.
+         */
+        DotsStatistics receivedStatistics() const;
+
+        /*!
+         * @brief Get the statistics of the data sent through the connection.
+         *
+         * Note that transmissions are only considered sent after they have
+         * been written by the underlying channel.
+         *
+         * @return DotsStatistics The total amount of bytes and transmissions
+         * that have been sent.
+         */
+        DotsStatistics sentStatistics() const;
+
+        /*!
+         * @brief Indicates whether the write queue is congested.
+         *
+         * Note that this can only be the case if the write queue is limited
+         * with the 'pause_reading' policy.
+         *
+         * @return true If the write queue has exceeded its limit and has not
+         * been drained yet.
+         * @return false Else.
+         */
+        bool writeQueueCongested() const;
+
+        /*!
+         * @brief Request the write queue handler to be invoked once the write
+         * queue has been drained.
+         *
+         * This can be used to throttle bulk transmissions (e.g. the
+         * transmission of a large container) to the rate at which the peer
+         * receives them. The write queue handler that was given in
+         * setWriteQueueLimit() will be invoked once the write queue has been
+         * drained to half of its maximum size.
+         *
+         * @return true If the write queue handler will be invoked.
+         * @return false If the write queue is already drained, in which case
+         * the write queue handler will not be invoked.
+         */
+        bool awaitWriteQueueDrain();
+
+        /*!
+         * @brief Pause receiving transmissions from the peer.
+         *
+         * This will stop reading from the underlying channel after the
+         * current transmission has been handled, until receiving is resumed
+         * via Connection::resumeReceive().
+         */
+        void pauseReceive();
+
+        /*!
+         * @brief Resume receiving transmissions from the peer.
+         *
+         * This will resume receiving after it has been paused via
+         * Connection::pauseReceive(). It is a no-op if receiving is not paused.
+         */
+        void resumeReceive();
+
         /*!
          * @brief Handle a specific error.
          *
@@ -332,6 +505,7 @@ namespace dots
         static constexpr serialization::TextOptions StringOptions = { serialization::TextOptions::MultiLine };
 
         bool handleReceive(io::Transmission transmission);
+        void handleWriteQueueDrained();
         void handleClose(std::exception_ptr ePtr);
 
         void handleHello(const DotsMsgHello& hello);
@@ -364,6 +538,7 @@ namespace dots
         io::AuthManager* m_authManager;
         std::optional<receive_handler_t> m_receiveHandler;
         std::optional<transition_handler_t> m_transitionHandler;
+        std::optional<write_queue_handler_t> m_writeQueueHandler;
     };
 
     using connection_ptr_t = std::shared_ptr<Connection>;
@@ -3,7 +3,14 @@
 #pragma once
 #include <map>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <dots/type/AnyStruct.h>
+#include <dots/tools/Handler.h>
 #include <DotsHeader.dots.h>
 #include <DotsCloneInformation.dots.h>
 
@@ -30,6 +37,30 @@ namespace dots
      * updated by a dots::Dispatcher based on incoming transmissions (i.e.
      * a dots::type::Struct instance annotated by a DotsHeader).
      *
+     * In addition to the instances, a Container maintains an index of the
+     * clones that were last updated by a specific peer (see
+     * Container::findOwned()). This allows instances of a peer to be looked
+     * up without iterating over the entire Container.
+     *
+     * Furthermore, a Container counts the references of each peer (i.e.
+     * the amount of clones that were either created or last updated by the
+     * peer). The reference counts can be shared between multiple
+     * containers, which allows a dots::ContainerPool to track whether a
+     * peer is referenced by any clone at all.
+     *
+     * A Container can also be restricted to a projection of the DOTS
+     * struct type (see Container::setProjection()), in which case it only
+     * stores a subset of the properties of each clone. This is used by
+     * guests that join groups with a projection.
+     *
+     * By default, clones are stored ordered by their keys. Alternatively,
+     * a Container can store its clones in a hash table that is indexed by
+     * a hash of the key properties (see Container::setStorage()). This
+     * allows clones to be looked up in constant time, which is beneficial
+     * for large caches that are frequently updated. Ordered iteration is
+     * then provided by a sorted view that is created on demand (see
+     * Container::orderedBegin()).
+     *
      * @attention Outside of advanced use cases, a regular user is never
      * required to create or manage Container objects themselves. Instead,
      * Container references can be retrieved and used for inspection via
@@ -45,6 +76,12 @@ namespace dots
     template <>
     struct Container<type::Struct>
     {
+        enum struct Storage : uint8_t
+        {
+            Ordered,
+            Hashed
+        };
+
         struct key_compare
         {
             using is_transparent = void;
@@ -61,17 +98,157 @@ namespace dots
         };
 
         using container_t = std::map<type::AnyStruct, DotsCloneInformation, key_compare>;
-        using const_iterator_t = container_t::const_iterator;
         using value_t = container_t::value_type;
-        using node_t = container_t::node_type;
+        using release_handler_t = tools::Handler<void(uint32_t)>;
+
+        /*!
+         * @brief Constant forward iterator over the clones of a Container.
+         *
+         * Depending on the storage of the Container, the iterator either
+         * refers to the ordered storage or to the slots of the hash table
+         * (or its sorted view), in which case empty slots are skipped.
+         */
+        struct const_iterator_t
+        {
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = value_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_t*;
+            using reference = const value_t&;
+
+            const_iterator_t() = default;
+
+            const_iterator_t(container_t::const_iterator it) :
+                m_it{ it }
+            {
+                /* do nothing */
+            }
+
+            const_iterator_t(value_t* const* slot, value_t* const* end) :
+                m_slot{ slot },
+                m_end{ end }
+            {
+                skipEmptySlots();
+            }
+
+            reference operator * () const
+            {
+                return m_slot == nullptr ? *m_it : **m_slot;
+            }
+
+            pointer operator -> () const
+            {
+                return &**this;
+            }
+
+            const_iterator_t& operator ++ ()
+            {
+                if (m_slot == nullptr)
+                {
+                    ++m_it;
+                }
+                else
+                {
+                    ++m_slot;
+                    skipEmptySlots();
+                }
+
+                return *this;
+            }
+
+            const_iterator_t operator ++ (int)
+            {
+                const_iterator_t it = *this;
+                ++*this;
+
+                return it;
+            }
+
+            bool operator == (const const_iterator_t& rhs) const
+            {
+                return m_slot == rhs.m_slot && m_it == rhs.m_it;
+            }
+
+            bool operator != (const const_iterator_t& rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+        private:
+
+            void skipEmptySlots()
+            {
+                while (m_slot != m_end && *m_slot == nullptr)
+                {
+                    ++m_slot;
+                }
+            }
+
+            container_t::const_iterator m_it;
+            value_t* const* m_slot = nullptr;
+            value_t* const* m_end = nullptr;
+        };
+
+        /*!
+         * @brief Clone that has been removed from a Container.
+         *
+         * A node owns the removed clone and offers the same interface as the
+         * node handle of the ordered storage.
+         */
+        struct node_t
+        {
+            node_t() = default;
+
+            node_t(container_t::node_type node) :
+                m_node{ std::move(node) }
+            {
+                /* do nothing */
+            }
+
+            node_t(std::unique_ptr<value_t> value) :
+                m_value{ std::move(value) }
+            {
+                /* do nothing */
+            }
+
+            bool empty() const
+            {
+                return m_node.empty() && m_value == nullptr;
+            }
+
+            const type::AnyStruct& key() const
+            {
+                return m_value == nullptr ? m_node.key() : m_value->first;
+            }
+
+            DotsCloneInformation& mapped() const
+            {
+                return m_value == nullptr ? m_node.mapped() : m_value->second;
+            }
+
+        private:
+
+            container_t::node_type m_node;
+            std::unique_ptr<value_t> m_value;
+        };
+
+        struct peer_references_t
+        {
+            std::unordered_map<uint32_t, size_t> counts;
+            std::optional<release_handler_t> releaseHandler;
+        };
 
         /*!
          * @brief Construct a new Container object for a given DOTS struct
          * type.
          *
          * @param descriptor The DOTS struct type of the Container.
+         *
+         * @param peerReferences The reference counts to update when the
+         * Container is modified. If no reference counts are given, the
+         * Container will use dedicated ones.
          */
-        Container(const type::StructDescriptor& descriptor);
+        Container(const type::StructDescriptor& descriptor, std::shared_ptr<peer_references_t> peerReferences = nullptr);
 
         /*!
          * @brief Get the DOTS struct type of the Container.
@@ -120,6 +297,57 @@ namespace dots
         const_iterator_t cend() const &;
         const_iterator_t cend() && = delete;
 
+        /*!
+         * @brief Get a constant iterator to the beginning of the Container
+         * in the order of the keys.
+         *
+         * If the Container uses the ordered storage, this is the same as
+         * begin(). Otherwise, the clones of the Container are sorted once
+         * and the sorted view is reused until a clone is created or removed.
+         *
+         * @return const_iterator_t A constant iterator to the beginning of the
+         * ordered Container.
+         */
+        const_iterator_t orderedBegin() const &;
+        const_iterator_t orderedBegin() && = delete;
+
+        /*!
+         * @brief Get a constant iterator to the end of the Container in the
+         * order of the keys.
+         *
+         * @return const_iterator_t A constant iterator to the end of the
+         * ordered Container.
+         */
+        const_iterator_t orderedEnd() const &;
+        const_iterator_t orderedEnd() && = delete;
+
+        /*!
+         * @brief Get the storage of the Container.
+         *
+         * @return Storage The storage that is used to store the clones.
+         */
+        Storage storage() const &;
+        Storage storage() && = delete;
+
+        /*!
+         * @brief Specify how the clones of the Container are stored.
+         *
+         * By default, clones are stored ordered by their keys, so that
+         * iterating the Container yields the clones in the order of their
+         * keys. This requires O(log n) key comparisons to look up a clone.
+         *
+         * When using the hashed storage, the hash of the key properties is
+         * calculated once for each inserted, removed or looked up instance
+         * and clones are looked up in O(1) via an open-addressing hash
+         * table. Iterating the Container via begin() and end() then yields
+         * the clones in no particular order.
+         *
+         * @param storage The storage to use.
+         *
+         * @exception std::logic_error Thrown if the Container is not empty.
+         */
+        void setStorage(Storage storage) &;
+
         /*!
          * @brief Check whether the Container is empty (i.e. contains no
          * clones).
@@ -220,6 +448,83 @@ namespace dots
         const type::Struct* find(const type::Struct& instance) const &;
         const type::Struct* find(const type::Struct& instance) && = delete;
 
+        /*!
+         * @brief Get an iterator to the first clone whose key is greater than
+         * the key of a specific instance.
+         *
+         * This can be used to resume an iteration over the Container after
+         * the Container was modified, because the given instance does not
+         * have to be part of the Container.
+         *
+         * Note that the iterator refers to the ordered range of the
+         * Container (see orderedBegin() and orderedEnd()).
+         *
+         * @param instance The key instance to compare with (non-key
+         * properties are ignored).
+         *
+         * @return const_iterator_t An iterator to the first clone whose key is
+         * greater than the key of @p instance or orderedEnd() if there is no
+         * such clone.
+         */
+        const_iterator_t upperBound(const type::Struct& instance) const &;
+        const_iterator_t upperBound(const type::Struct& instance) && = delete;
+
+        /*!
+         * @brief Find all clone instances that were last updated by a
+         * specific peer.
+         *
+         * The lookup is performed via an index that is updated whenever an
+         * instance is inserted or removed and therefore only takes time
+         * proportional to the amount of instances owned by the peer.
+         *
+         * @param peerId The id of the peer (i.e. the value of
+         * DotsCloneInformation::lastUpdateFrom).
+         *
+         * @return std::vector<const type::Struct*> Pointers to the clone
+         * instances in no particular order. Will be empty if the peer does
+         * not own any instances.
+         */
+        std::vector<const type::Struct*> findOwned(uint32_t peerId) const &;
+        std::vector<const type::Struct*> findOwned(uint32_t peerId) && = delete;
+
+        /*!
+         * @brief Get the amount of references to a specific peer.
+         *
+         * A clone references a peer if it was either created or last updated
+         * by the peer.
+         *
+         * Note that the count includes the references of all containers that
+         * share the reference counts of the Container (see Container()).
+         *
+         * @param peerId The id of the peer.
+         *
+         * @return size_t The amount of clones referencing the peer.
+         */
+        size_t referenceCount(uint32_t peerId) const &;
+        size_t referenceCount(uint32_t peerId) && = delete;
+
+        /*!
+         * @brief Get the projection of the Container.
+         *
+         * @return property_set_t The properties that are stored by the
+         * Container. This is the set of all properties unless the Container
+         * was restricted via Container::setProjection().
+         */
+        property_set_t projection() const &;
+        property_set_t projection() && = delete;
+
+        /*!
+         * @brief Restrict the properties that are stored by the Container.
+         *
+         * After this call, properties that are not part of the projection
+         * will be ignored when instances are inserted. Note that the key
+         * properties are always part of the projection and that existing
+         * clones are not affected.
+         *
+         * @param projection The properties to store.
+         */
+        void setProjection(property_set_t projection) &;
+
         /*!
          * @brief Get the clone of a specific instance.
          *
@@ -426,10 +731,56 @@ namespace dots
 
     private:
 
+        using owner_index_t = std::unordered_map<uint32_t, std::unordered_set<const type::Struct*>>;
+
+        // note: the hash table uses linear probing and stores the values
+        // and their precomputed key hashes in separate arrays, so that
+        // probing only has to access the values when the hashes are equal
+        struct hash_table_t
+        {
+            hash_table_t() = default;
+            hash_table_t(const hash_table_t& other) = delete;
+            hash_table_t(hash_table_t&& other) noexcept;
+            ~hash_table_t();
+
+            hash_table_t& operator = (const hash_table_t& rhs) = delete;
+            hash_table_t& operator = (hash_table_t&& rhs) noexcept;
+
+            std::vector<value_t*> values;
+            std::vector<size_t> hashes;
+            size_t size = 0;
+        };
+
+        static constexpr size_t HashTableMinCapacity = 16;
+
+        type::AnyStruct projectInstance(const type::Struct& instance) const;
+        static DotsCloneInformation createCloneInfo(const DotsHeader& header);
+        void updateClone(const DotsHeader& header, const type::Struct& instance, type::Struct& existing, DotsCloneInformation& cloneInfo);
+
+        size_t hashKey(const type::Struct& instance) const;
+        bool equalKey(const type::Struct& lhs, const type::Struct& rhs) const;
+        std::optional<size_t> findSlot(const type::Struct& instance, size_t hash) const;
+        value_t& emplaceSlot(std::unique_ptr<value_t> value, size_t hash);
+        void eraseSlot(size_t slot);
+        void rehash(size_t capacity);
+        const std::vector<value_t*>& orderedView() const;
+
         void updateWithoutKeys(type::Struct& lhs, const type::Struct& rhs, property_set_t includedSet);
+        void indexOwner(const type::Struct& instance, const DotsCloneInformation& cloneInfo);
+        void deindexOwner(const type::Struct& instance, const DotsCloneInformation& cloneInfo);
+        void referencePeers(const DotsCloneInformation& cloneInfo);
+        void releasePeers(const DotsCloneInformation& cloneInfo);
+        void releasePeer(uint32_t peerId);
 
         const type::StructDescriptor* m_descriptor;
+        Storage m_storage;
         container_t m_instances;
+        hash_table_t m_hashedInstances;
+        mutable std::optional<std::vector<value_t*>> m_orderedView;
+        owner_index_t m_ownerIndex;
+        std::shared_ptr<peer_references_t> m_peerReferences;
+        property_set_t m_projection;
+        type::partial_property_descriptor_container_t m_keyPropertyDescriptors;
         type::partial_property_descriptor_container_t m_noKeyPropertyDescriptors;
     };
 
@@ -4,6 +4,7 @@
 #include <map>
 #include <unordered_map>
 #include <string_view>
+#include <vector>
 #include <dots/Container.h>
 
 namespace dots
@@ -32,6 +33,15 @@ namespace dots
         using const_iterator_t = pool_t::const_iterator;
         using value_t = pool_t::value_type;
         using node_t = pool_t::node_type;
+        using release_handler_t = Container<>::release_handler_t;
+
+        /*!
+         * @brief Construct a new ContainerPool object.
+         *
+         * All Container objects of the ContainerPool will share the same
+         * peer reference counts (see ContainerPool::referenceCount()).
+         */
+        ContainerPool();
 
         /*!
          * @brief Get a constant iterator to the beginning of the
@@ -238,6 +248,33 @@ namespace dots
          */
         size_t totalMemoryUsage() const;
 
+        /*!
+         * @brief Get the amount of references to a specific peer in all
+         * Container objects of the ContainerPool.
+         *
+         * A clone references a peer if it was either created or last updated
+         * by the peer. The reference counts are updated whenever a Container
+         * is modified, so this only takes constant time.
+         *
+         * @param peerId The id of the peer.
+         *
+         * @return size_t The amount of clones referencing the peer.
+         */
+        size_t referenceCount(uint32_t peerId) const;
+
+        /*!
+         * @brief Set the handler to invoke when a peer is no longer
+         * referenced by any clone in the ContainerPool.
+         *
+         * The handler will be invoked with the id of the peer while the
+         * corresponding Container is being modified. It therefore must not
+         * modify the ContainerPool itself.
+         *
+         * @param handler The handler to invoke or std::nullopt to remove a
+         * previously set handler.
+         */
+        void setReleaseHandler(std::optional<release_handler_t> handler);
+
         /*!
          * @brief Try to find a specific Container by type.
          *
@@ -304,9 +341,12 @@ namespace dots
     private:
 
         using name_cache_t = std::map<std::string, Container<>*, std::less<>>;
+        using type_id_cache_t = std::vector<Container<>*>;
 
         // TODO: remove mutability when utilities are fixed to no longer require non-const pool access
         mutable pool_t m_pool;
         mutable name_cache_t m_nameCache;
+        mutable type_id_cache_t m_typeIdCache;
+        std::shared_ptr<Container<>::peer_references_t> m_peerReferences;
     };
 }
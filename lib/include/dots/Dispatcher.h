@@ -1,9 +1,12 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #pragma once
+#include <deque>
 #include <map>
 #include <unordered_map>
 #include <functional>
+#include <memory>
+#include <vector>
 #include <dots/type/AnyStruct.h>
 #include <dots/Event.h>
 #include <dots/ContainerPool.h>
@@ -48,11 +51,11 @@ namespace dots
          */
         Dispatcher(error_handler_t handler);
         Dispatcher(const Dispatcher& other) = delete;
-        Dispatcher(Dispatcher&& other) noexcept = default;
-        ~Dispatcher() = default;
+        Dispatcher(Dispatcher&& other) noexcept;
+        ~Dispatcher();
 
         Dispatcher& operator = (const Dispatcher& rhs) = delete;
-        Dispatcher& operator = (Dispatcher&& rhs) noexcept = default;
+        Dispatcher& operator = (Dispatcher&& rhs) noexcept;
 
         /*!
          * @brief Get the container pool.
@@ -214,9 +217,51 @@ namespace dots
          *
          * @param id The unique id of the handler as returned by
          * Dispatcher::addEventHandler().
+         *
+         * Note that if event handlers are invoked on worker threads (see
+         * Dispatcher::setWorkerThreads()), this function can be called from
+         * any thread. Unless it is called by the handler itself, it will then
+         * block until a concurrent invocation of the handler has completed,
+         * so that the handler is never invoked after this function has
+         * returned. The caller must therefore not hold any resources the
+         * handler might wait for (e.g. a mutex that is also locked by the
+         * handler).
          */
         void removeEventHandler(const type::StructDescriptor& descriptor, id_t id);
 
+        /*!
+         * @brief Specify whether event handlers are invoked on worker
+         * threads.
+         *
+         * By default, all handlers are invoked synchronously on the thread
+         * that dispatches the transmission. If worker threads are used,
+         * containers are still updated on the dispatching thread, but event
+         * handlers are invoked asynchronously on one of the worker threads.
+         * The events of each type are handled on a separate strand, so that
+         * they are always handled in order, while handlers of independent
+         * types can run in parallel on any of the worker threads.
+         * Transmission handlers are not affected and always invoked
+         * synchronously.
+         *
+         * Because the container might already have been changed again when a
+         * handler is invoked, the event refers to an immutable snapshot of
+         * the transmitted instance, the updated instance and the clone
+         * information instead. Event handlers must therefore not access the
+         * containers directly.
+         *
+         * Note that event handlers have to be added on the dispatching
+         * thread. Removing event handlers is possible from any thread,
+         * including the handler itself, and waits for concurrent invocations
+         * of the handler (see Dispatcher::removeEventHandler()).
+         *
+         * @param numThreads The amount of worker threads. If zero is given,
+         * event handlers will be invoked synchronously again (default: 0).
+         *
+         * @exception std::logic_error Thrown if any event handlers are
+         * currently registered.
+         */
+        void setWorkerThreads(size_t numThreads);
+
         /*!
          * @brief Dispatch a transmission.
          *
@@ -330,27 +375,70 @@ namespace dots
 
     private:
 
-        using transmission_handlers_t = std::map<id_t, transmission_handler_t, std::greater<>>;
-        using transmission_handler_pool_t = std::unordered_map<const type::StructDescriptor*, transmission_handlers_t>;
+        struct worker_state_t;
 
-        using event_handlers_t = std::map<id_t, event_handler_t<>, std::greater<>>;
-        using event_handler_pool_t = std::unordered_map<const type::StructDescriptor*, event_handlers_t>;
+        // note: the handlers of a type are stored contiguously in ascending
+        // order of their ids and invoked in reverse order (i.e. the most
+        // recently added handler first). while a table is being dispatched
+        // to, removed handlers are only marked as removed (tombstones) and
+        // added handlers are deferred, so that the handler that is currently
+        // being invoked is never moved or destroyed
+        template <typename Handler>
+        struct handler_table_t
+        {
+            struct entry_t
+            {
+                id_t id;
+                Handler handler;
+                bool removed;
+            };
+
+            bool empty() const
+            {
+                return numHandlers == 0;
+            }
+
+            std::vector<entry_t> entries;
+            std::deque<entry_t> deferred;
+            size_t numHandlers = 0;
+            size_t numRemoved = 0;
+            uint32_t dispatching = 0;
+        };
+
+        // note: handler pools are indexed by the interned type id of the
+        // descriptor. a deque is used, because growing it does not invalidate
+        // references to the tables that are currently being dispatched to
+        using transmission_handlers_t = handler_table_t<transmission_handler_t>;
+        using transmission_handler_pool_t = std::deque<transmission_handlers_t>;
+
+        using event_handlers_t = handler_table_t<event_handler_t<>>;
+        using event_handler_pool_t = std::deque<event_handlers_t>;
+
+        template <typename HandlerPool>
+        static typename HandlerPool::value_type* findHandlers(HandlerPool& handlerPool, const type::StructDescriptor& descriptor);
+        template <typename HandlerPool>
+        static typename HandlerPool::value_type& getHandlers(HandlerPool& handlerPool, const type::StructDescriptor& descriptor);
 
+        template <typename Handler>
+        static typename handler_table_t<Handler>::entry_t& addHandler(handler_table_t<Handler>& handlers, id_t id, Handler handler);
         template <typename HandlerPool>
-        void removeHandler(HandlerPool& handlerPool, const type::StructDescriptor& descriptor, id_t id);
+        static void removeHandler(HandlerPool& handlerPool, const type::StructDescriptor& descriptor, id_t id);
+        template <typename Handler>
+        static void finishDispatch(handler_table_t<Handler>& handlers);
 
+        bool hasEventHandlers(const type::StructDescriptor& descriptor);
         void dispatchTransmission(const io::Transmission& transmission);
-        void dispatchEvent(const DotsHeader& header, const type::AnyStruct& instance);
+        void dispatchEvent(const io::Transmission& transmission);
+        void dispatchEvent(const type::StructDescriptor& descriptor, event_handlers_t* handlers, const io::Transmission& transmission, const Event<>& event);
 
-        template <typename Handlers, typename Dispatchable>
-        void dispatchToHandlers(const type::StructDescriptor& descriptor, Handlers& handlers, const Dispatchable& dispatchable);
+        template <typename Handler, typename Dispatchable>
+        void dispatchToHandlers(const type::StructDescriptor& descriptor, handler_table_t<Handler>& handlers, const Dispatchable& dispatchable);
 
-        std::optional<id_t> m_currentlyDispatchingId;
-        std::vector<id_t> m_removeIds;
         ContainerPool m_containerPool;
         transmission_handler_pool_t m_transmissionHandlerPool;
         event_handler_pool_t m_eventHandlerPool;
         id_t m_nextId;
         error_handler_t m_errorHandler;
+        std::unique_ptr<worker_state_t> m_workers;
     };
 }
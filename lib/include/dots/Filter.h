@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <vector>
+#include <dots/type/AnyStruct.h>
+#include <DotsFilterCondition.dots.h>
+
+namespace dots
+{
+    /*!
+     * @class Filter Filter.h <dots/Filter.h>
+     *
+     * @brief Predicate over the properties of instances of a DOTS struct
+     * type.
+     *
+     * A Filter is the evaluable form of a set of DotsFilterCondition
+     * instances. An instance matches the filter if it meets all of the
+     * conditions (i.e. the conditions are combined by a logical 'and').
+     *
+     * Each condition refers to a (top-level) property by name and compares
+     * it with one or more values that are given in string representation
+     * (see dots::from_string()). Values of string properties are used
+     * verbatim. Ranges can be expressed by combining two conditions on the
+     * same property (e.g. DotsFilterComparison::greaterEqual and
+     * DotsFilterComparison::less).
+     *
+     * Note that an instance never meets a condition on a property that is
+     * not valid in the instance, regardless of the comparison.
+     */
+    struct Filter
+    {
+        /*!
+         * @brief Construct a new Filter object from a set of conditions.
+         *
+         * This will resolve the properties and parse the values of all
+         * conditions, which allows the filter to be evaluated without
+         * further conversions.
+         *
+         * @param descriptor The descriptor of the struct type to filter.
+         *
+         * @param conditions The conditions of the filter.
+         *
+         * @exception std::runtime_error Thrown if a condition is incomplete,
+         * refers to a property that does not exist in @p descriptor or
+         * contains a value that cannot be converted to the type of the
+         * property.
+         */
+        Filter(const type::StructDescriptor& descriptor, const std::vector<DotsFilterCondition>& conditions);
+        Filter(const Filter& other) = default;
+        Filter(Filter&& other) = default;
+        ~Filter() = default;
+
+        Filter& operator = (const Filter& rhs) = default;
+        Filter& operator = (Filter&& rhs) = default;
+
+        /*!
+         * @brief Get the descriptor of the filtered struct type.
+         *
+         * @return const type::StructDescriptor& A reference to the
+         * descriptor.
+         */
+        const type::StructDescriptor& descriptor() const;
+
+        /*!
+         * @brief Get the properties that are referred to by the conditions
+         * of the filter.
+         *
+         * @return property_set_t The set of properties.
+         */
+        property_set_t properties() const;
+
+        /*!
+         * @brief Evaluate the filter for a specific instance.
+         *
+         * @param instance The instance to evaluate. Must be of the filtered
+         * type.
+         *
+         * @return true If the instance meets all conditions of the filter.
+         * @return false Else.
+         */
+        bool matches(const type::Struct& instance) const;
+
+    private:
+
+        struct condition_t
+        {
+            property_set_t property;
+            DotsFilterComparison comparison;
+            std::vector<type::AnyStruct> values;
+        };
+
+        static bool Matches(const condition_t& condition, const type::Struct& instance);
+
+        const type::StructDescriptor* m_descriptor;
+        std::vector<condition_t> m_conditions;
+        property_set_t m_properties;
+    };
+}
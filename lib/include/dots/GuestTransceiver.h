@@ -2,11 +2,24 @@
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #pragma once
 #include <string_view>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <optional>
+#include <map>
+#include <memory>
 #include <set>
+#include <vector>
 #include <dots/type/DescriptorMap.h>
 #include <dots/Transceiver.h>
 #include <dots/Connection.h>
+#include <dots/LatencyHistogram.h>
+#include <dots/io/MulticastReceiver.h>
+#include <dots/tools/MpscQueue.h>
+#include <DotsTypeLatency.dots.h>
+#include <DotsFilterCondition.dots.h>
+#include <DotsMulticast.dots.h>
+#include <DotsCacheInfo.dots.h>
 
 namespace dots
 {
@@ -224,6 +237,83 @@ namespace dots
          */
         const Connection& open(io::Endpoint endpoint);
 
+        /*!
+         * @brief Start to asynchronously connect to a host via a specific
+         * endpoint without blocking.
+         *
+         * In contrast to GuestTransceiver::open(), this will not block while
+         * the channel is being connected. For the 'tcp' schemes, resolving
+         * the host and connecting the socket are performed asynchronously.
+         * Channels of other schemes are created synchronously, but from
+         * within the event loop.
+         *
+         * If the channel cannot be created (e.g. because the host is not
+         * available yet), a warning will be logged and connecting will be
+         * retried with the backoff given in
+         * GuestTransceiver::setReconnect(), regardless of whether
+         * reconnecting is enabled.
+         *
+         * @param preloadPublishTypes The publish types to preload.
+         *
+         * @param preloadSubscribeTypes The subscribe types to preload.
+         *
+         * @param endpoint The endpoint to connect to. The channel type will
+         * be determined by the endpoint's scheme.
+         *
+         * @exception std::logic_error Thrown if another host connection has
+         * already been opened.
+         */
+        void asyncOpen(type::DescriptorMap preloadPublishTypes, type::DescriptorMap preloadSubscribeTypes, io::Endpoint endpoint);
+
+        /*!
+         * @brief Start to asynchronously connect to a host via a specific
+         * endpoint without blocking.
+         *
+         * This is a version of GuestTransceiver::asyncOpen() without
+         * preloading.
+         *
+         * @param endpoint The endpoint to connect to. The channel type will
+         * be determined by the endpoint's scheme.
+         *
+         * @exception std::logic_error Thrown if another host connection has
+         * already been opened.
+         */
+        void asyncOpen(io::Endpoint endpoint);
+
+        /*!
+         * @brief Specify whether the transceiver reconnects to the host after
+         * the host connection was lost.
+         *
+         * If enabled and the host connection was opened via an endpoint (see
+         * GuestTransceiver::open(io::Endpoint) and
+         * GuestTransceiver::asyncOpen()), the transceiver will connect to the
+         * endpoint again after the connection was closed. The delay between
+         * two attempts starts at @p minBackoff and is doubled after every
+         * failed attempt up to @p maxBackoff.
+         *
+         * After reconnecting, the transceiver will join all groups it had
+         * joined before. The containers of cached types are retained while
+         * disconnected and reconciled with the instances the host transmits
+         * when the group is joined again: unchanged instances will not be
+         * dispatched, changed instances will only be dispatched with the
+         * properties that actually changed and instances that no longer
+         * exist at the host will be dispatched as removes. Subscribers
+         * therefore only observe the differences that occurred while the
+         * transceiver was disconnected.
+         *
+         * Note that publishing while disconnected will result in an error as
+         * usual, while subscribing and unsubscribing will take effect after
+         * reconnecting.
+         *
+         * @param enabled Specifies whether the transceiver reconnects
+         * (default: false).
+         *
+         * @param minBackoff The delay before the first attempt to reconnect.
+         *
+         * @param maxBackoff The maximum delay between two attempts.
+         */
+        void setReconnect(bool enabled, std::chrono::milliseconds minBackoff = std::chrono::milliseconds{ 100 }, std::chrono::milliseconds maxBackoff = std::chrono::seconds{ 10 });
+
         /*!
          * @brief Publish an instance of a DOTS struct type.
          *
@@ -255,17 +345,387 @@ namespace dots
          */
         void publish(const type::Struct& instance, std::optional<property_set_t> includedProperties = std::nullopt, bool remove = false) override;
 
+        /*!
+         * @brief Publish multiple instances of a DOTS struct type.
+         *
+         * This is equivalent to publishing each instance individually via
+         * GuestTransceiver::publish(const type::Struct&, std::optional<property_set_t>, bool),
+         * except that the instances will be transmitted as batches that share
+         * a single header if supported by the host connection (see
+         * io::TransmissionFormat::v3).
+         *
+         * Because the included properties are part of the header, a batch
+         * only contains consecutive instances with the same included
+         * properties. If no set is given, a new batch is therefore started
+         * whenever the valid property set of an instance differs from the
+         * previous one.
+         *
+         * @param instances The instances to publish. Must all be of the same
+         * type.
+         *
+         * @param includedProperties The properties to publish in addition to
+         * the key properties. If no set is given, the valid property set of
+         * each instance will be used.
+         *
+         * @param remove Specifies whether the publish is a remove.
+         *
+         * @exception std::logic_error Thrown if the instances are of a
+         * 'substruct-only' type or not all of the same type.
+         *
+         * @exception std::runtime_error Thrown if a key property of an
+         * instance is invalid.
+         *
+         * @exception std::runtime_error Thrown if no host connection has been
+         * established when the function is called.
+         */
+        void publish(const io::Channel::instance_batch_t& instances, std::optional<property_set_t> includedProperties = std::nullopt, bool remove = false);
+
+        /*!
+         * @brief Publish a range of instances of a DOTS struct type.
+         *
+         * This is a convenience version of
+         * GuestTransceiver::publish(const io::Channel::instance_batch_t&, std::optional<property_set_t>, bool)
+         * for arbitrary ranges (e.g. std::vector<T>).
+         *
+         * @tparam Range The type of the range. The elements must be
+         * convertible to const type::Struct&.
+         *
+         * @param instances The instances to publish. Must all be of the same
+         * type.
+         *
+         * @param includedProperties The properties to publish in addition to
+         * the key properties. If no set is given, the valid property set of
+         * each instance will be used.
+         *
+         * @param remove Specifies whether the publish is a remove.
+         */
+        template <typename Range, std::enable_if_t<std::is_convertible_v<decltype(*std::begin(std::declval<const Range&>())), const type::Struct&>, int> = 0>
+        void publish(const Range& instances, std::optional<property_set_t> includedProperties = std::nullopt, bool remove = false)
+        {
+            io::Channel::instance_batch_t batch;
+
+            for (const type::Struct& instance : instances)
+            {
+                batch.emplace_back(instance);
+            }
+
+            publish(batch, includedProperties, remove);
+        }
+
+        /*!
+         * @brief Publish an instance of a DOTS struct type from any thread.
+         *
+         * In contrast to GuestTransceiver::publish(), this function can be
+         * called concurrently from any thread. A copy of the instance is
+         * submitted to a lock-free queue (see tools::MpscQueue) that is
+         * drained in batches by the thread that runs the IO context of the
+         * transceiver. Consecutive instances of the same type are then
+         * transmitted as a batch (see
+         * GuestTransceiver::publish(const io::Channel::instance_batch_t&, std::optional<property_set_t>, bool)).
+         *
+         * Instances that are submitted by the same thread are published in
+         * order, but not necessarily in order relative to instances that are
+         * published via GuestTransceiver::publish(). If no host connection is
+         * open when the queue is drained, the instances will be discarded.
+         * Errors that occur while a batch is published are logged and do not
+         * affect the remaining instances in the queue.
+         *
+         * @param instance The instance to publish.
+         *
+         * @param includedProperties The properties to publish in addition to
+         * the key properties. If no set is given, the valid property set of
+         * @p instance will be used.
+         *
+         * @param remove Specifies whether the publish is a remove.
+         *
+         * @exception std::logic_error Thrown if the instance type is a
+         * 'substruct-only' type.
+         *
+         * @exception std::runtime_error Thrown if a key property of the
+         * instance is invalid.
+         */
+        void postPublish(const type::Struct& instance, std::optional<property_set_t> includedProperties = std::nullopt, bool remove = false);
+
+        /*!
+         * @brief Publish an instance of a DOTS struct type from any thread.
+         *
+         * This is a version of GuestTransceiver::postPublish() that moves
+         * the properties of the instance instead of copying them.
+         *
+         * @param instance The instance to publish.
+         *
+         * @param includedProperties The properties to publish in addition to
+         * the key properties. If no set is given, the valid property set of
+         * @p instance will be used.
+         *
+         * @param remove Specifies whether the publish is a remove.
+         *
+         * @exception std::logic_error Thrown if the instance type is a
+         * 'substruct-only' type.
+         *
+         * @exception std::runtime_error Thrown if a key property of the
+         * instance is invalid.
+         */
+        void postPublish(type::Struct&& instance, std::optional<property_set_t> includedProperties = std::nullopt, bool remove = false);
+
+        /*!
+         * @brief Restrict the instances of a DOTS struct type that the host
+         * transmits to the transceiver.
+         *
+         * The filter will be evaluated by the host (see dots::Filter), which
+         * avoids transmitting and deserializing instances that are not of
+         * interest to the transceiver.
+         *
+         * Note that the filter applies to the group of the type and
+         * therefore affects all subscriptions to the type, as well as the
+         * content of the local container. If the transceiver has already
+         * joined the group, it will join it again with the given filter, in
+         * which case the host will transmit the filtered content of the
+         * container again.
+         *
+         * @param descriptor The descriptor of the struct type to filter.
+         *
+         * @param conditions The conditions that must all be met by instances
+         * to be transmitted to the transceiver. If empty, an existing filter
+         * will be removed.
+         *
+         * @exception std::logic_error Thrown if @p descriptor is a
+         * 'substruct-only' type.
+         */
+        void setFilter(const type::StructDescriptor& descriptor, std::vector<DotsFilterCondition> conditions);
+
+        /*!
+         * @brief Restrict the instances of a DOTS struct type that the host
+         * transmits to the transceiver.
+         *
+         * This is an explicitly typed version of
+         * GuestTransceiver::setFilter(const type::StructDescriptor&, std::vector<DotsFilterCondition>).
+         *
+         * @tparam T The struct type to filter.
+         *
+         * @param conditions The conditions that must all be met by instances
+         * to be transmitted to the transceiver. If empty, an existing filter
+         * will be removed.
+         */
+        template <typename T>
+        void setFilter(std::vector<DotsFilterCondition> conditions)
+        {
+            setFilter(type::Descriptor<T>::Instance(), std::move(conditions));
+        }
+
+        /*!
+         * @brief Restrict the properties of a DOTS struct type that the host
+         * transmits to the transceiver.
+         *
+         * The host will only transmit the projected properties (and the key
+         * properties) of the type and omit updates that do not contain any
+         * of them. The local container of the type will be restricted to the
+         * projection accordingly (see Container::setProjection()).
+         *
+         * Note that the projection applies to the group of the type and
+         * therefore affects all subscriptions to the type. If the transceiver
+         * has already joined the group, it will join it again with the given
+         * projection. Because clones that already exist in the container are
+         * not affected, a projection should usually be set before
+         * subscribing to the type.
+         *
+         * @param descriptor The descriptor of the struct type to project.
+         *
+         * @param projection The properties to receive in addition to the key
+         * properties. If std::nullopt is given, an existing projection will
+         * be removed.
+         *
+         * @exception std::logic_error Thrown if @p descriptor is a
+         * 'substruct-only' type or not cached.
+         */
+        void setProjection(const type::StructDescriptor& descriptor, std::optional<property_set_t> projection);
+
+        /*!
+         * @brief Restrict the properties of a DOTS struct type that the host
+         * transmits to the transceiver.
+         *
+         * This is an explicitly typed version of
+         * GuestTransceiver::setProjection(const type::StructDescriptor&, std::optional<property_set_t>).
+         *
+         * @tparam T The struct type to project.
+         *
+         * @param projection The properties to receive in addition to the key
+         * properties. If std::nullopt is given, an existing projection will
+         * be removed.
+         */
+        template <typename T>
+        void setProjection(std::optional<property_set_t> projection)
+        {
+            setProjection(type::Descriptor<T>::Instance(), projection);
+        }
+
+        /*!
+         * @brief Specify whether the transceiver requests to receive
+         * uncached types via multicast.
+         *
+         * If enabled, the transceiver will request multicast when joining the
+         * group of an uncached type. If the host offers a multicast group for
+         * the type (see HostTransceiver::setMulticast()), the transceiver
+         * will join the multicast group and receive the transmissions of the
+         * type from it instead of the host connection.
+         *
+         * If a gap in the sequence of the multicast transmissions is detected
+         * (e.g. because a datagram was lost), the transceiver will fall back
+         * to the host connection for the type. The host will then retransmit
+         * the missed transmissions (as long as it still retains them), so
+         * that they are dispatched in order. Multicast is requested again
+         * only when the group is joined again.
+         *
+         * Note that groups with a filter (see GuestTransceiver::setFilter())
+         * are always received via the host connection and that this only
+         * affects groups that are joined after the function was called.
+         *
+         * @param enabled Specifies whether multicast is requested (default:
+         * false).
+         *
+         * @param interfaceAddress The address of the local interface to join
+         * multicast groups on. If not given, the interface will be chosen by
+         * the operating system.
+         */
+        void setMulticast(bool enabled, std::optional<std::string> interfaceAddress = std::nullopt);
+
+        /*!
+         * @brief Specify whether event handlers of subscriptions are invoked
+         * on worker threads.
+         *
+         * If enabled, transmissions are still received and the containers
+         * are still updated on the thread that runs the IO context, but the
+         * event handlers are invoked on a pool of worker threads. Each type
+         * is handled by a single worker thread, so that the events of a type
+         * remain in order, while slow handlers of one type no longer delay
+         * the handlers of other types (see Dispatcher::setWorkerThreads()).
+         *
+         * Handlers then receive events that refer to an immutable snapshot
+         * of the instance and must not access containers directly. Publishing
+         * from a handler is redirected to GuestTransceiver::postPublish().
+         * Subscribing has to be performed on the thread that runs the IO
+         * context, whereas subscriptions can be released on any thread.
+         *
+         * @param numThreads The amount of worker threads. If zero is given,
+         * handlers will be invoked on the thread that runs the IO context
+         * (default: 0).
+         *
+         * @exception std::logic_error Thrown if any subscriptions with event
+         * handlers currently exist.
+         */
+        void setHandlerThreads(size_t numThreads);
+
+        /*!
+         * @brief Specify whether the transceiver records the delivery
+         * latencies of the transmissions it receives from the host.
+         *
+         * If enabled, the transceiver will record the time from receiving by
+         * the host (i.e. DotsHeader::serverSentTime) until the transmission is
+         * dispatched by the transceiver. The latencies are recorded in
+         * histograms per type (see GuestTransceiver::typeLatencies()).
+         *
+         * Note that the delivery latency is only meaningful if the clock of
+         * the guest is synchronized with the clock of the host.
+         *
+         * @param enabled Specifies whether latencies are recorded (default:
+         * false).
+         */
+        void setLatencyRecording(bool enabled);
+
+        /*!
+         * @brief Get the delivery latency statistics of the types that have
+         * been received since the latencies were last reset.
+         *
+         * @return std::vector<DotsTypeLatency> The statistics of all types
+         * with at least one recorded latency in no particular order. Only
+         * the DotsTypeLatency::delivery property will be set.
+         */
+        std::vector<DotsTypeLatency> typeLatencies() const;
+
+        /*!
+         * @brief Reset all recorded latencies.
+         */
+        void resetLatencies();
+
     private:
 
+        using type_latency_index_t = std::vector<std::unique_ptr<LatencyHistogram>>;
+
+        static constexpr size_t MulticastPendingSize = 1024;
+
+        struct multicast_group_t
+        {
+            std::unique_ptr<io::MulticastReceiver> receiver;
+            std::optional<uint64_t> nextSequence;
+            std::deque<std::pair<uint64_t, io::Transmission>> pending;
+        };
+
+        using multicast_map_t = std::map<std::string, multicast_group_t, std::less<>>;
+        static constexpr size_t PublishQueueDrainSize = 4096;
+
+        struct publish_request_t
+        {
+            type::AnyStruct instance;
+            std::optional<property_set_t> includedProperties;
+            bool remove;
+        };
+
+        struct publish_queue_t
+        {
+            tools::MpscQueue<publish_request_t> requests;
+            std::atomic_bool drainPending = false;
+        };
+
+        using resync_map_t = std::map<const type::StructDescriptor*, std::set<type::AnyStruct, Container<>::key_compare>>;
+
         void joinGroup(std::string_view name) override;
         void leaveGroup(std::string_view name) override;
 
+        void transmitJoin(std::string_view name);
+
+        io::channel_ptr_t makeChannel(const io::Endpoint& endpoint);
+        template <typename TChannel>
+        void asyncConnect(std::optional<std::string> authSecret);
+        void asyncConnect();
+        void handleConnectError(std::exception_ptr ePtr);
+        void scheduleReconnect();
+        void rejoinGroups(Connection& connection);
+        bool resyncTransmission(io::Transmission& transmission);
+        void completeResync(const DotsCacheInfo& cacheInfo);
+
+        void submitPublish(type::AnyStruct instance, std::optional<property_set_t> includedProperties, bool remove);
+        void schedulePublishDrain();
+        void drainPublishQueue();
+
         bool handleTransmission(Connection& connection, io::Transmission transmission);
+        void handleMulticastMessage(const DotsMulticast& multicast);
+        void handleMulticastTransmission(const std::string& groupName, uint64_t sequence, io::Transmission transmission);
+        void handleMulticastError(const std::string& groupName, std::exception_ptr ePtr);
+        void fallBackFromMulticast(std::string_view groupName);
+        void recordLatency(const io::Transmission& transmission);
         void handleTransitionImpl(Connection& connection, std::exception_ptr ePtr) noexcept override;
 
         std::unique_ptr<Connection> m_hostConnection;
         type::DescriptorMap m_preloadPublishTypes;
         type::DescriptorMap m_preloadSubscribeTypes;
         std::set<std::string> m_joinedGroups;
+        std::map<std::string, std::vector<DotsFilterCondition>, std::less<>> m_filters;
+        std::map<std::string, property_set_t, std::less<>> m_projections;
+        bool m_latencyRecording;
+        type_latency_index_t m_typeLatencies;
+        bool m_multicast;
+        std::optional<std::string> m_multicastInterface;
+        multicast_map_t m_multicastGroups;
+        std::optional<io::Endpoint> m_openEndpoint;
+        bool m_reconnect;
+        bool m_connecting;
+        bool m_rejoin;
+        std::chrono::milliseconds m_minReconnectBackoff;
+        std::chrono::milliseconds m_maxReconnectBackoff;
+        std::chrono::milliseconds m_reconnectBackoff;
+        asio::steady_timer m_reconnectTimer;
+        io::channel_ptr_t m_connectingChannel;
+        resync_map_t m_resyncs;
+        std::shared_ptr<publish_queue_t> m_publishQueue;
     };
 }
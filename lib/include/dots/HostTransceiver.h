@@ -1,17 +1,28 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #pragma once
+#include <deque>
+#include <map>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include <dots/tools/Handler.h>
 #include <dots/Connection.h>
+#include <dots/LatencyHistogram.h>
+#include <dots/Filter.h>
 #include <dots/Transceiver.h>
 #include <dots/io/Listener.h>
+#include <dots/io/MulticastSender.h>
 #include <dots/io/auth/AuthManager.h>
 #include <DotsClearCache.dots.h>
 #include <DotsDescriptorRequest.dots.h>
 #include <DotsMember.dots.h>
+#include <DotsMulticast.dots.h>
 #include <DotsEcho.dots.h>
+#include <DotsClientLatency.dots.h>
+#include <DotsTypeLatency.dots.h>
+#include <DotsTypeStatistics.dots.h>
 
 namespace dots
 {
@@ -31,6 +42,50 @@ namespace dots
      * published DOTS instances to all attendees that are subscribed to the
      * corresponding types.
      *
+     * When a guest subscribes to a cached type, the host transmits the
+     * current content of the corresponding container (i.e. a "snapshot")
+     * to the guest. Large snapshots are transmitted in chunks that are
+     * interleaved with other transmissions and are throttled to the rate at
+     * which the guest receives them. Updates of instances that have not yet
+     * been transmitted as part of the snapshot are not transmitted
+     * separately, because the snapshot will contain their latest state.
+     *
+     * Guests can restrict the instances they receive by joining a group
+     * with a filter (see DotsMember::filter). Filters are evaluated by the
+     * host before transmissions are distributed and when snapshots are
+     * transmitted. For cached types, updates are evaluated against the
+     * updated instance in the container. If an update changes a filtered
+     * property, a guest will receive either the complete instance (if it
+     * matches the filter) or a remove (if it does not), because the
+     * instance might have started or stopped matching the filter.
+     *
+     * Guests can furthermore restrict the properties they receive by
+     * joining a group with a projection (see DotsMember::projection). The
+     * host only transmits the projected properties (and the key properties)
+     * to such guests and omits updates that do not contain any projected
+     * property at all.
+     *
+     * Optionally, the host can reduce updates of cached types to the
+     * properties that actually changed (see
+     * HostTransceiver::setDeltaUpdates()). Updates that do not change a
+     * cached instance at all are then still dispatched locally, but not
+     * distributed.
+     *
+     * Transmissions that are received as a batch (see
+     * io::TransmissionFormat::v3) are dispatched individually, but
+     * distributed as a unit once the batch has been received completely.
+     * Guests for which a batch has to be altered (e.g. because of a filter)
+     * receive its transmissions individually instead.
+     *
+     * Optionally, uncached types can be distributed via UDP multicast (see
+     * HostTransceiver::setMulticast()). Guests that request it (see
+     * GuestTransceiver::setMulticast()) then receive the transmissions of
+     * such a type from a multicast group instead of their connection, so
+     * that each transmission only has to be sent once. Transmissions are
+     * sequenced per type and guests that detect a gap fall back to their
+     * connection, through which they receive the transmissions they have
+     * missed (as long as they are still retained by the host).
+     *
      * Even though a HostTransceiver often technically acts as a server, it
      * is agnostic about how a connection is established. A HostTransceiver
      * can asynchronously accept incoming connections from provided
@@ -119,6 +174,271 @@ namespace dots
          */
         void listen(std::vector<io::Endpoint> listenEndpoints);
 
+        /*!
+         * @brief Distribute the IO of guest connections across worker
+         * threads.
+         *
+         * When set to a non-zero value, each connection that is accepted by a
+         * supported listener (i.e. TCP and UDS listeners) will be assigned to
+         * one of the given amount of worker threads in a round-robin fashion.
+         * Each worker thread runs its own event loop and performs all reading,
+         * writing and (de)serialization for its connections.
+         *
+         * The processing of transmissions (i.e. updating the containers,
+         * dispatching to local subscribers and selecting the destination
+         * connections) is still performed once per transmission on the IO
+         * context of the transceiver. Transmissions are handed over to the
+         * workers without being copied (see io::WorkerChannel).
+         *
+         * Note that this has no effect on listeners that were added before
+         * the function was called.
+         *
+         * @param numThreads The amount of worker threads to use. If zero, all
+         * connections will be operated on the IO context of the transceiver.
+         */
+        void setWorkerThreads(size_t numThreads);
+
+        /*!
+         * @brief Limit the write queues of guest connections.
+         *
+         * This determines how much serialized data can be queued for each
+         * guest connection and what happens if a guest does not consume the
+         * data fast enough (see Connection::setWriteQueueLimit()).
+         *
+         * When the 'pause_reading' policy is used, the host will pause
+         * reading from guests that publish transmissions to a congested
+         * connection. Paused guests will be resumed once all congested
+         * connections have been drained (or closed).
+         *
+         * By default, write queues are limited to 10 MiB with the
+         * 'disconnect' policy.
+         *
+         * Note that this has no effect on connections that were accepted
+         * before the function was called.
+         *
+         * @param maxSize The maximum size of each write queue in bytes.
+         *
+         * @param policy The policy to apply when a write queue exceeds
+         * @p maxSize.
+         *
+         * @exception std::logic_error Thrown if @p maxSize is zero.
+         */
+        void setWriteQueueLimit(size_t maxSize, DotsWriteQueuePolicy policy);
+
+        /*!
+         * @brief Conflate updates of cached types for lagging guests.
+         *
+         * When the write queue of a guest connection exceeds the given
+         * threshold, the host will merge subsequent updates of the same
+         * instance into a single transmission that contains the union of the
+         * updated properties (see Connection::setConflationThreshold()).
+         * Guests that keep up with the rate of updates still receive every
+         * update.
+         *
+         * Note that this has no effect on connections that were accepted
+         * before the function was called.
+         *
+         * @param threshold The size of the write queue in bytes above which
+         * updates will be conflated. If zero, conflation is disabled (default).
+         */
+        void setConflationThreshold(size_t threshold);
+
+        /*!
+         * @brief Specify whether the host reduces updates of cached types to
+         * the properties that actually changed.
+         *
+         * If enabled, the host will compare every update it receives from a
+         * guest with the cached instance before the update is dispatched
+         * (see type::Struct::_diffProperties()). The included properties of
+         * the update are then reduced to the key properties and the
+         * properties whose values differ from the cached instance. Updates
+         * that do not change any property are still dispatched to the local
+         * handlers of the host, but are not distributed to the guests, unless
+         * they are published by a different guest than the previous update
+         * of the instance (in which case only the key properties are
+         * distributed).
+         *
+         * This can considerably reduce the traffic to subscribers of types
+         * whose publishers repeatedly publish their complete state. Note,
+         * however, that guests will consequently not be able to observe
+         * updates that do not change anything and that the clone information
+         * in the containers of the guests (e.g.
+         * DotsCloneInformation::modified) is not updated by such updates.
+         *
+         * Creates and removes are never reduced. Reduced updates are
+         * distributed as new transmissions and therefore only count as
+         * packages in the sent statistics (see
+         * HostTransceiver::typeStatistics()).
+         *
+         * @param enabled Specifies whether updates of all cached types are
+         * reduced (default: false). Overrides of specific types (see
+         * HostTransceiver::setDeltaUpdates(std::string_view, bool)) take
+         * precedence.
+         */
+        void setDeltaUpdates(bool enabled);
+
+        /*!
+         * @brief Specify whether the host reduces updates of a specific
+         * cached type to the properties that actually changed.
+         *
+         * This overrides the default that is set via
+         * HostTransceiver::setDeltaUpdates(bool) for a single type. The type
+         * does not have to be known to the host when the function is
+         * called.
+         *
+         * @param typeName The name of the type.
+         *
+         * @param enabled Specifies whether updates of the type are reduced.
+         */
+        void setDeltaUpdates(std::string_view typeName, bool enabled);
+
+        /*!
+         * @brief Specify the UDP multicast group via which an uncached type
+         * is distributed.
+         *
+         * Guests that join the group of the type and request multicast (see
+         * DotsMember::multicast) are offered the multicast group. Once a
+         * guest has joined the multicast group, the host sends every
+         * transmission of the type once to the multicast group instead of
+         * transmitting it to each of these guests individually. Guests that
+         * cannot use multicast (e.g. because they filter the type) still
+         * receive the transmissions via their connections.
+         *
+         * Every multicast transmission has a sequence number and the last
+         * 4096 transmissions of the type are retained by the host. When a
+         * guest detects a gap in the sequence, it falls back to its
+         * connection and the host retransmits the missed transmissions from
+         * the retained ones.
+         *
+         * Transmissions that cannot be sent to the multicast group (e.g.
+         * because they exceed io::MulticastSender::MaxDatagramSize) are only
+         * retained and therefore are retrieved by the guests via their
+         * connections once they have detected the gap.
+         *
+         * Note that transmissions that are received via multicast are not
+         * ordered relative to transmissions of other types.
+         *
+         * @param typeName The name of the uncached type. The type does not
+         * have to be known to the host when the function is called.
+         *
+         * @param groupEndpoint The IPv4 multicast endpoint of the group (e.g.
+         * 'udp://239.255.0.1:11240') or std::nullopt to no longer distribute
+         * the type via multicast.
+         *
+         * @param interfaceAddress The address of the local interface to send
+         * from. If not given, the default interface for multicast will be
+         * used.
+         *
+         * @exception std::logic_error Thrown if guests currently receive the
+         * type via multicast.
+         *
+         * @exception std::runtime_error Thrown if the multicast group cannot
+         * be used.
+         */
+        void setMulticast(std::string_view typeName, std::optional<io::Endpoint> groupEndpoint, std::optional<std::string> interfaceAddress = std::nullopt);
+
+        /*!
+         * @brief Set the handler to invoke when a peer is no longer
+         * referenced by any cached instance.
+         *
+         * An instance references a peer if it was either created or last
+         * updated by the peer (see ContainerPool::referenceCount()). This can
+         * be used to release resources associated with a peer as soon as it
+         * is no longer relevant for the cache.
+         *
+         * Note that the handler is invoked while a cached instance is being
+         * removed or updated and therefore must not publish or remove
+         * instances itself (e.g. by deferring such operations).
+         *
+         * @param handler The handler to invoke or std::nullopt to remove a
+         * previously set handler.
+         */
+        void setPeerReleaseHandler(std::optional<ContainerPool::release_handler_t> handler);
+
+        /*!
+         * @brief Get the current guest connections of the host.
+         *
+         * @return std::vector<const Connection*> The guest connections in no
+         * particular order.
+         */
+        std::vector<const Connection*> guestConnections() const;
+
+        /*!
+         * @brief Get the traffic statistics of the types that have been
+         * transmitted through the host.
+         *
+         * The statistics are counted per transmission when the host receives
+         * a transmission from a guest or distributes it to the guests. This
+         * includes transmissions that originate from the host itself, such as
+         * instances published by the host and the snapshots of the
+         * containers that are transmitted when a guest joins a group.
+         *
+         * Note that the amount of bytes is based on the encoded size of the
+         * received transmissions (see io::Transmission::encodedSize()).
+         * Transmissions that originate from the host itself are only encoded
+         * by the channels of the individual guests, so they count as packages
+         * but do not contribute to the amount of bytes. Determining their
+         * size on the host would require an additional serialization of every
+         * instance.
+         *
+         * @return std::vector<DotsTypeStatistics> The statistics of all types
+         * with at least one transmission in no particular order.
+         */
+        std::vector<DotsTypeStatistics> typeStatistics() const;
+
+        /*!
+         * @brief Specify whether the host records the latencies of the
+         * transmissions it receives from guests.
+         *
+         * If enabled, the host will record two latencies for every
+         * transmission that is received from a guest and distributed to the
+         * other guests:
+         *
+         * - 'transport': the time from sending by the guest (i.e.
+         * DotsHeader::sentTime) until receiving by the host (i.e.
+         * DotsHeader::serverSentTime).
+         * - 'processing': the time from receiving by the host until the
+         * transmission has been dispatched and distributed.
+         *
+         * The latencies are recorded in histograms per type and per guest
+         * connection (see HostTransceiver::typeLatencies() and
+         * HostTransceiver::clientLatencies()).
+         *
+         * Note that the transport latency is only meaningful if the clocks of
+         * the guests are synchronized with the clock of the host.
+         *
+         * @param enabled Specifies whether latencies are recorded (default:
+         * false).
+         */
+        void setLatencyRecording(bool enabled);
+
+        /*!
+         * @brief Get the latency statistics of the types that have been
+         * received by the host since the latencies were last reset.
+         *
+         * @return std::vector<DotsTypeLatency> The statistics of all types
+         * with at least one recorded latency in no particular order.
+         */
+        std::vector<DotsTypeLatency> typeLatencies() const;
+
+        /*!
+         * @brief Get the latency statistics of the guest connections of the
+         * host since the latencies were last reset.
+         *
+         * @return std::vector<DotsClientLatency> The statistics of all
+         * guest connections with at least one recorded latency in no
+         * particular order.
+         */
+        std::vector<DotsClientLatency> clientLatencies() const;
+
+        /*!
+         * @brief Reset all recorded latencies.
+         *
+         * This can be used to obtain the latency statistics of consecutive
+         * intervals.
+         */
+        void resetLatencies();
+
         /*!
          * @brief Publish an instance of a DOTS struct type.
          *
@@ -179,28 +499,137 @@ namespace dots
         using connection_map_t = std::unordered_map<Connection*, connection_ptr_t>;
         using group_t = std::unordered_set<Connection*>;
         using group_map_t = std::unordered_map<std::string, group_t>;
+        using group_index_t = std::vector<std::optional<group_t*>>;
+
+        struct snapshot_t
+        {
+            Container<>::key_compare keyCompare;
+            std::optional<type::AnyStruct> lastKey;
+            size_t transmitted;
+            bool awaitingDrain;
+        };
+
+        using snapshot_map_t = std::map<std::pair<Connection*, const type::StructDescriptor*>, snapshot_t>;
+        using filter_map_t = std::map<std::pair<Connection*, const type::StructDescriptor*>, Filter>;
+
+        using projection_map_t = std::map<std::pair<Connection*, const type::StructDescriptor*>, property_set_t>;
+
+        struct projected_transmission_t
+        {
+            const io::Transmission* source;
+            io::Transmission transmission;
+        };
+
+        struct derived_transmissions_t
+        {
+            bool resolved = false;
+            const Container<>::value_t* clone = nullptr;
+            std::optional<io::Transmission> update;
+            std::optional<io::Transmission> remove;
+            std::vector<projected_transmission_t> projections;
+        };
+
+        static constexpr size_t SnapshotChunkSize = 1024;
+
+        struct type_traffic_t
+        {
+            uint64_t receivedBytes = 0;
+            uint64_t receivedPackages = 0;
+            uint64_t sentBytes = 0;
+            uint64_t sentPackages = 0;
+        };
+
+        using type_traffic_index_t = std::vector<type_traffic_t>;
+
+        struct latency_histograms_t
+        {
+            LatencyHistogram transport;
+            LatencyHistogram processing;
+        };
+
+        using type_latency_index_t = std::vector<std::unique_ptr<latency_histograms_t>>;
+        using connection_latency_map_t = std::unordered_map<Connection*, latency_histograms_t>;
+        using batch_map_t = std::unordered_map<Connection*, std::vector<io::Transmission>>;
+        using delta_update_map_t = std::unordered_map<std::string, bool>;
+        using delta_update_index_t = std::vector<std::optional<bool>>;
+
+        static constexpr size_t MulticastHistorySize = 4096;
+
+        struct multicast_group_t
+        {
+            io::Endpoint endpoint;
+            std::unique_ptr<io::MulticastSender> sender;
+            uint64_t sequence = 0;
+            std::deque<std::pair<uint64_t, io::Transmission>> history;
+            std::unordered_map<Connection*, uint64_t> members;
+        };
+
+        using multicast_map_t = std::unordered_map<std::string, multicast_group_t>;
+        using multicast_index_t = std::vector<std::optional<multicast_group_t*>>;
 
         void joinGroup(std::string_view name) override;
         void leaveGroup(std::string_view name) override;
 
-        void transmit(const io::Transmission& transmission);
+        bool transmit(const io::Transmission& transmission);
+        bool transmit(const std::vector<io::Transmission>& transmissions);
+        group_t* findGroup(const type::StructDescriptor& descriptor);
 
         bool handleListenAccept(io::Listener& listener, io::channel_ptr_t channel);
         void handleListenError(io::Listener& listener, std::exception_ptr ePtr);
 
         bool handleTransmission(Connection& connection, io::Transmission transmission);
         void handleTransitionImpl(Connection& connection, std::exception_ptr ePtr) noexcept override;
+        void handleWriteQueueDrained(Connection& connection);
 
         void handleMemberMessage(Connection& connection, const DotsMember& member);
         void handleDescriptorRequest(Connection& connection, const DotsDescriptorRequest& descriptorRequest);
         void handleClearCache(Connection& connection, const DotsClearCache& clearCache);
         void handleEchoRequest(Connection& connection, const DotsEcho& echoRequest);
+        void handleMulticastMessage(Connection& connection, const DotsMulticast& multicast);
 
-        void transmitContainer(Connection& connection, const Container<>& container);
+        void transmitSnapshot(Connection& connection, const type::StructDescriptor& descriptor);
+        void transmitSnapshotChunk(Connection& connection, const type::StructDescriptor& descriptor);
+        void postSnapshotChunk(Connection& connection, const type::StructDescriptor& descriptor);
+        void resumeSnapshots(Connection& connection);
+        bool isPendingInSnapshot(Connection& connection, const io::Transmission& transmission) const;
+        const Filter* findFilter(Connection& connection, const type::StructDescriptor& descriptor) const;
+        const io::Transmission* deriveTransmission(Connection& connection, const io::Transmission& transmission, derived_transmissions_t& derived) const;
+        const io::Transmission* filterTransmission(const Filter& filter, const io::Transmission& transmission, derived_transmissions_t& derived) const;
+        const property_set_t* findProjection(Connection& connection, const type::StructDescriptor& descriptor) const;
+        const io::Transmission* projectTransmission(property_set_t projection, const io::Transmission& transmission, derived_transmissions_t& derived) const;
+        const Container<>::value_t* resolveClone(const io::Transmission& transmission, derived_transmissions_t& derived) const;
+        bool deltaUpdates(const type::StructDescriptor& descriptor);
+        bool reduceTransmission(io::Transmission& transmission) const;
+        multicast_group_t* findMulticastGroup(const type::StructDescriptor& descriptor);
+        void transmitMulticast(multicast_group_t& multicastGroup, const io::Transmission& transmission);
+        void leaveMulticastGroup(Connection& connection, multicast_group_t& multicastGroup);
+        type_traffic_t& typeTraffic(const type::StructDescriptor& descriptor);
+        void recordLatency(Connection& connection, const io::Transmission& transmission);
+        void resumePausedConnections();
 
+        std::shared_ptr<io::WorkerPool> m_workerPool;
+        size_t m_writeQueueMaxSize;
+        DotsWriteQueuePolicy m_writeQueuePolicy;
+        size_t m_conflationThreshold;
+        bool m_latencyRecording;
+        bool m_deltaUpdates;
+        delta_update_map_t m_deltaUpdateTypes;
+        delta_update_index_t m_deltaUpdateIndex;
+        multicast_map_t m_multicastGroups;
+        multicast_index_t m_multicastIndex;
         listener_map_t m_listeners;
         connection_map_t m_guestConnections;
         group_map_t m_groups;
+        group_index_t m_groupIndex;
+        snapshot_map_t m_snapshots;
+        filter_map_t m_filters;
+        projection_map_t m_projections;
+        type_traffic_index_t m_typeTraffic;
+        type_latency_index_t m_typeLatencies;
+        connection_latency_map_t m_connectionLatencies;
+        batch_map_t m_batches;
+        group_t m_congestedConnections;
+        group_t m_pausedConnections;
         std::unique_ptr<io::AuthManager> m_authManager;
     };
 }
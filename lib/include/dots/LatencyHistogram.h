@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <dots/type/FundamentalTypes.h>
+#include <DotsLatencyStatistics.dots.h>
+
+namespace dots
+{
+    /*!
+     * @class LatencyHistogram LatencyHistogram.h <dots/LatencyHistogram.h>
+     *
+     * @brief Histogram for recording latencies with bounded relative error.
+     *
+     * This class implements a log-linear histogram similar to an HDR
+     * histogram. Latencies are recorded with microsecond resolution into
+     * buckets whose width grows with the magnitude of the latency, which
+     * limits the relative error of every reported value to
+     * 1 / 2^(SubBucketBits - 1) (i.e. about 6%).
+     *
+     * Recording a latency takes constant time and does not allocate memory
+     * unless a latency of a previously unseen magnitude is recorded.
+     */
+    struct LatencyHistogram
+    {
+        static constexpr uint32_t SubBucketBits = 5;
+        static constexpr uint64_t SubBucketCount = uint64_t{ 1 } << SubBucketBits;
+        static constexpr uint64_t MaxValue = (uint64_t{ 1 } << 40) - 1;
+
+        /*!
+         * @brief Construct a new (i.e. empty) LatencyHistogram object.
+         */
+        LatencyHistogram();
+        LatencyHistogram(const LatencyHistogram& other) = default;
+        LatencyHistogram(LatencyHistogram&& other) = default;
+        ~LatencyHistogram() = default;
+
+        LatencyHistogram& operator = (const LatencyHistogram& rhs) = default;
+        LatencyHistogram& operator = (LatencyHistogram&& rhs) = default;
+
+        /*!
+         * @brief Record a latency.
+         *
+         * Negative latencies (e.g. caused by unsynchronized clocks) will be
+         * recorded as zero and latencies that exceed the maximum value of the
+         * histogram (about 12 days) will be recorded as the maximum value.
+         *
+         * @param latency The latency to record.
+         */
+        void record(duration_t latency);
+
+        /*!
+         * @brief Remove all recorded latencies.
+         */
+        void reset();
+
+        /*!
+         * @brief Get the amount of recorded latencies.
+         *
+         * @return uint64_t The amount of recorded latencies.
+         */
+        uint64_t count() const;
+
+        /*!
+         * @brief Get the minimum recorded latency.
+         *
+         * @return duration_t The minimum latency or zero if no latencies
+         * have been recorded.
+         */
+        duration_t min() const;
+
+        /*!
+         * @brief Get the maximum recorded latency.
+         *
+         * @return duration_t The maximum latency or zero if no latencies
+         * have been recorded.
+         */
+        duration_t max() const;
+
+        /*!
+         * @brief Get the latency at a specific percentile.
+         *
+         * The result is the highest latency that is equivalent (i.e. falls
+         * into the same bucket) to the latency at the given percentile, but
+         * never exceeds the maximum recorded latency.
+         *
+         * @param percentile The percentile in the range [0, 100].
+         *
+         * @return duration_t The latency at the percentile or zero if no
+         * latencies have been recorded.
+         */
+        duration_t percentile(double percentile) const;
+
+        /*!
+         * @brief Get the statistics of the recorded latencies.
+         *
+         * @return DotsLatencyStatistics The amount of recorded latencies
+         * and, if at least one latency was recorded, the minimum, maximum and
+         * common percentiles.
+         */
+        DotsLatencyStatistics statistics() const;
+
+    private:
+
+        static size_t BucketIndex(uint64_t value);
+        static uint64_t BucketUpperBound(size_t index);
+        static duration_t ToDuration(uint64_t value);
+
+        std::vector<uint64_t> m_buckets;
+        uint64_t m_count;
+        uint64_t m_min;
+        uint64_t m_max;
+    };
+}
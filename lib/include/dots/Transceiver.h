@@ -123,6 +123,25 @@ namespace dots
          */
         const Container<>& container(const type::StructDescriptor& descriptor) const;
 
+        /*!
+         * @brief Specify how the clones of a specific type are stored.
+         *
+         * @remark This effectively calls dots::Container::setStorage() on
+         * the Container of the given type. The Container will be created if
+         * it does not exist yet.
+         *
+         * Note that the storage can only be changed as long as the Container
+         * is empty, which is usually the case before the type has been
+         * subscribed to.
+         *
+         * @param descriptor The type descriptor of the Container.
+         *
+         * @param storage The storage to use.
+         *
+         * @exception std::logic_error Thrown if the Container is not empty.
+         */
+        void setContainerStorage(const type::StructDescriptor& descriptor, Container<>::Storage storage);
+
         /*!
          * @brief Subscribe to transmissions of a specific type.
          *
@@ -412,6 +431,25 @@ namespace dots
             return m_dispatcher.container<T>();
         }
 
+        /*!
+         * @brief Specify how the clones of a specific type are stored.
+         *
+         * @remark This effectively calls
+         * Transceiver::setContainerStorage() with the descriptor of the given
+         * type.
+         *
+         * @tparam T The type of the Container.
+         *
+         * @param storage The storage to use.
+         *
+         * @exception std::logic_error Thrown if the Container is not empty.
+         */
+        template <typename T>
+        void setContainerStorage(Container<>::Storage storage)
+        {
+            setContainerStorage(T::_Descriptor(), storage);
+        }
+
         /*!
          * @brief Subscribe to events of a specific type.
          *
@@ -1,16 +1,26 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include <system_error>
 #include <type_traits>
 #include <set>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 #include <dots/tools/Handler.h>
 #include <dots/io/Endpoint.h>
 #include <dots/io/Transmission.h>
 #include <dots/tools/shared_ptr_only.h>
 #include <DotsHeader.dots.h>
+#include <DotsStatistics.dots.h>
+#include <DotsWriteQueuePolicy.dots.h>
+#include <DotsWriteQueueStatus.dots.h>
 
 namespace dots::type
 {
@@ -23,6 +33,10 @@ namespace dots::io
     {
         using receive_handler_t = tools::Handler<bool(Transmission)>;
         using error_handler_t = tools::Handler<void(std::exception_ptr)>;
+        using write_queue_handler_t = tools::Handler<void()>;
+        using instance_batch_t = std::vector<std::reference_wrapper<const type::Struct>>;
+
+        static constexpr size_t DefaultWriteQueueMaxSize = 10 * 1024 * 1024;
 
         Channel(key_t key);
         Channel(const Channel& other) = delete;
@@ -41,41 +55,176 @@ namespace dots::io
         void transmit(const type::Struct& instance);
         void transmit(const DotsHeader& header, const type::Struct& instance);
         void transmit(const Transmission& transmission);
+        void transmit(const DotsHeader& header, const instance_batch_t& instances);
+        void transmit(const std::vector<Transmission>& transmissions);
         void transmit(const type::Descriptor<>& descriptor);
 
+        void setWriteQueueLimit(size_t maxSize, DotsWriteQueuePolicy policy, std::optional<write_queue_handler_t> drainHandler = std::nullopt);
+        void setConflationThreshold(size_t threshold);
+        void setPassThrough(bool passThrough);
+        DotsWriteQueueStatus writeQueueStatus() const;
+        bool writeQueueCongested() const;
+        bool awaitWriteQueueDrain();
+        DotsStatistics receivedStatistics() const;
+        DotsStatistics sentStatistics() const;
+
+        void pauseReceive();
+        void resumeReceive();
+
     protected:
 
+        struct WriteQueueState
+        {
+            std::atomic<size_t> maxSize = DefaultWriteQueueMaxSize;
+            std::atomic<DotsWriteQueuePolicy> policy = DotsWriteQueuePolicy::disconnect;
+            std::atomic<uint64_t> size = 0;
+            std::atomic<uint32_t> depth = 0;
+            std::atomic<uint64_t> dropped = 0;
+            std::atomic<uint32_t> congestions = 0;
+            std::atomic<bool> congested = false;
+            std::atomic<bool> drainRequested = false;
+            std::atomic<size_t> conflationThreshold = 0;
+            std::atomic<uint64_t> conflated = 0;
+        };
+
+        struct TrafficState
+        {
+            std::atomic<uint64_t> receivedBytes = 0;
+            std::atomic<uint64_t> receivedPackages = 0;
+            std::atomic<uint64_t> sentBytes = 0;
+            std::atomic<uint64_t> sentPackages = 0;
+        };
+
         void initEndpoints(Endpoint localEndpoint, Endpoint remoteEndpoint);
 
         const type::Registry& registry() const;
         type::Registry& registry();
+        const type::StructDescriptor& resolveStructType(const std::string& name);
+        bool passThrough(const type::StructDescriptor& descriptor) const;
 
         virtual void asyncReceiveImpl() = 0;
         virtual void transmitImpl(const DotsHeader& header, const type::Struct& instance) = 0;
         virtual void transmitImpl(const Transmission& transmission);
+        virtual void transmitImpl(const DotsHeader& header, const instance_batch_t& instances);
+        virtual void transmitImpl(const std::vector<Transmission>& transmissions);
+
+        const WriteQueueState& writeQueueState() const;
+        WriteQueueState& writeQueueState();
+        TrafficState& trafficState();
+
+        /*!
+         * @brief Indicates whether queued transmissions of a specific type
+         * can be dropped by the 'drop_oldest' policy.
+         *
+         * Only transmissions of uncached types can be dropped, because the
+         * peer would otherwise retain cached instances that diverge from the
+         * cache of the host. Internal types are never dropped.
+         *
+         * @param descriptor The descriptor of the type.
+         *
+         * @return true If transmissions of the type can be dropped.
+         * @return false Else.
+         */
+        static bool Droppable(const type::StructDescriptor& descriptor);
+
+        /*!
+         * @brief Apply the write queue policy if the write queue would
+         * exceed its maximum size.
+         *
+         * Depending on the policy, this will either drop the oldest
+         * droppable entries of the given write queue (see
+         * Channel::Droppable()), mark the write queue as congested or fail.
+         *
+         * The entries of the write queue have to provide their size in bytes
+         * via size(), the amount of transmissions they contain via
+         * 'transmissions' and whether they can be dropped via 'droppable'.
+         *
+         * @param size The size the write queue would have in bytes,
+         * including the data that is about to be enqueued.
+         *
+         * @param writeQueue The write queue of the channel.
+         *
+         * @param first The first entry of the write queue that can be
+         * dropped (i.e. that is not currently being written).
+         *
+         * @return std::pair<size_t, uint64_t> The amount of bytes and
+         * transmissions that have been dropped.
+         *
+         * @exception std::runtime_error Thrown if the policy is 'disconnect'
+         * or if the maximum size cannot be restored otherwise.
+         */
+        template <typename WriteQueue>
+        std::pair<size_t, uint64_t> limitWriteQueue(size_t size, WriteQueue& writeQueue, typename WriteQueue::iterator first)
+        {
+            WriteQueueState& state = writeQueueState();
+
+            if (size <= state.maxSize)
+            {
+                return { 0, 0 };
+            }
+
+            size_t droppedSize = 0;
+            uint64_t droppedTransmissions = 0;
+
+            if (state.policy == DotsWriteQueuePolicy::drop_oldest)
+            {
+                size_t maxSize = state.maxSize;
+
+                for (auto it = first; it != writeQueue.end() && size - droppedSize > maxSize;)
+                {
+                    if (it->droppable)
+                    {
+                        droppedSize += it->size();
+                        droppedTransmissions += it->transmissions;
+                        it = writeQueue.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+
+                state.dropped += droppedTransmissions;
+            }
+
+            applyWriteQueuePolicy(size - droppedSize);
+
+            return { droppedSize, droppedTransmissions };
+        }
 
         void processReceive(Transmission transmission) noexcept;
         void processError(std::exception_ptr ePtr);
         void processError(const std::string& what);
+        void processWriteQueueDrained();
         void verifyErrorCode(std::error_code errorCode);
 
     private:
 
         template <typename T, typename... Args>
         friend std::shared_ptr<T> make_channel(Args&&... args);
+        friend struct WorkerChannel;
 
+        void applyWriteQueuePolicy(size_t size);
         void importDependencies(const type::Struct& instance);
         void exportDependencies(const type::Descriptor<>& descriptor);
 
         std::set<std::string> m_sharedTypeNames;
         std::unordered_set<const type::Descriptor<>*> m_sharedTypeDescriptors;
+        std::unordered_map<std::string, const type::StructDescriptor*> m_structTypes;
+        uint64_t m_structTypesDeregistrations;
         bool m_asyncReceiving;
+        bool m_receivePaused;
+        bool m_receiveSuspended;
         bool m_initialized;
+        bool m_passThrough;
         type::Registry* m_registry;
         std::optional<Endpoint> m_localEndpoint;
         std::optional<Endpoint> m_remoteEndpoint;
         std::optional<receive_handler_t> m_receiveHandler;
         std::optional<error_handler_t> m_errorHandler;
+        std::shared_ptr<WriteQueueState> m_writeQueueState;
+        std::shared_ptr<TrafficState> m_trafficState;
+        std::optional<write_queue_handler_t> m_writeQueueHandler;
     };
 
     using channel_ptr_t = std::shared_ptr<Channel>;
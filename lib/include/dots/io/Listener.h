@@ -5,6 +5,7 @@
 #include <optional>
 #include <dots/tools/Handler.h>
 #include <dots/io/Channel.h>
+#include <dots/io/WorkerPool.h>
 
 namespace dots::io
 {
@@ -22,10 +23,12 @@ namespace dots::io
         Listener& operator = (Listener&& rhs) = delete;
 
         void asyncAccept(accept_handler_t acceptHandler, error_handler_t errorHandler);
+        void setWorkerPool(std::shared_ptr<WorkerPool> workerPool);
 
     protected:
 
         virtual void asyncAcceptImpl() = 0;
+        WorkerPool* workerPool();
         void processAccept(channel_ptr_t channel);
         void processError(std::exception_ptr ePtr);
         void processError(const std::string& what);
@@ -36,6 +39,7 @@ namespace dots::io
         bool m_asyncAcceptActive = false;
         std::optional<accept_handler_t> m_acceptHandler;
         std::optional<error_handler_t> m_errorHandler;
+        std::shared_ptr<WorkerPool> m_workerPool;
     };
 
     using listener_ptr_t = std::unique_ptr<Listener>;
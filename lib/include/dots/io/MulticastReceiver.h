@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <dots/asio.h>
+#include <dots/tools/Handler.h>
+#include <dots/io/Endpoint.h>
+#include <dots/io/Transmission.h>
+
+namespace dots::io
+{
+    /*!
+     * @class MulticastReceiver MulticastReceiver.h <dots/io/MulticastReceiver.h>
+     *
+     * @brief Receiver of sequenced transmissions from a UDP multicast group.
+     *
+     * A receiver joins a multicast group and decodes the datagrams that are
+     * sent by an io::MulticastSender. All transmissions of a group are
+     * expected to be of the same type.
+     *
+     * The receiver does not reorder datagrams or detect lost datagrams
+     * itself. Instead, the sequence number of each transmission is passed to
+     * the receive handler.
+     */
+    struct MulticastReceiver
+    {
+        using receive_handler_t = tools::Handler<void(uint64_t, Transmission)>;
+        using error_handler_t = tools::Handler<void(std::exception_ptr)>;
+
+        /*!
+         * @brief Construct a new MulticastReceiver object.
+         *
+         * This will open a socket that is bound to the port of the endpoint
+         * and join the multicast group.
+         *
+         * @param ioContext The ASIO IO context to use.
+         *
+         * @param endpoint The IPv4 multicast endpoint to receive from (e.g.
+         * 'udp://239.255.0.1:11240').
+         *
+         * @param descriptor The descriptor of the type of the transmissions.
+         *
+         * @param interfaceAddress The address of the local interface to join
+         * the multicast group on. If not given, the interface will be chosen
+         * by the operating system.
+         *
+         * @exception std::runtime_error Thrown if the endpoint is not an IPv4
+         * multicast endpoint or the multicast group could not be joined.
+         */
+        MulticastReceiver(asio::io_context& ioContext, const Endpoint& endpoint, const type::StructDescriptor& descriptor, std::optional<std::string> interfaceAddress = std::nullopt);
+        MulticastReceiver(const MulticastReceiver& other) = delete;
+        MulticastReceiver(MulticastReceiver&& other) = delete;
+
+        /*!
+         * @brief Destroy the MulticastReceiver object.
+         *
+         * This will leave the multicast group. Pending handlers will not be
+         * invoked.
+         *
+         * Note that it is safe to destroy a receiver from within one of its
+         * handlers.
+         */
+        ~MulticastReceiver();
+
+        MulticastReceiver& operator = (const MulticastReceiver& rhs) = delete;
+        MulticastReceiver& operator = (MulticastReceiver&& rhs) = delete;
+
+        /*!
+         * @brief Asynchronously receive transmissions from the multicast
+         * group.
+         *
+         * The receive handler is invoked once for every received
+         * transmission. The error handler is invoked if a datagram cannot be
+         * decoded (in which case receiving continues) or if receiving fails
+         * (in which case receiving stops).
+         *
+         * @param receiveHandler The handler to invoke with the sequence
+         * number and the transmission of every received datagram.
+         *
+         * @param errorHandler The handler to invoke when an error occurs.
+         *
+         * @exception std::logic_error Thrown if the receiver is already
+         * receiving.
+         */
+        void asyncReceive(receive_handler_t receiveHandler, error_handler_t errorHandler);
+
+    private:
+
+        struct state;
+
+        std::shared_ptr<state> m_state;
+    };
+}
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <optional>
+#include <string>
+#include <dots/asio.h>
+#include <dots/io/Endpoint.h>
+#include <dots/io/Transmission.h>
+#include <dots/serialization/CborSerializer.h>
+
+namespace dots::io
+{
+    /*!
+     * @class MulticastSender MulticastSender.h <dots/io/MulticastSender.h>
+     *
+     * @brief Sender of sequenced transmissions to a UDP multicast group.
+     *
+     * Each transmission is sent as a single datagram that consists of the
+     * CBOR encoded sequence number, followed by the CBOR encoded DotsHeader
+     * and instance of the transmission (see io::MulticastReceiver).
+     *
+     * Datagrams are sent synchronously via a non-blocking socket. If a
+     * datagram cannot be sent immediately (e.g. because the send buffer of
+     * the socket is full), it is dropped. Receivers are expected to detect
+     * such gaps based on the sequence numbers.
+     *
+     * Note that multicast loopback is enabled, so that the transmissions
+     * can also be received on the sending host.
+     */
+    struct MulticastSender
+    {
+        static constexpr size_t MaxDatagramSize = 65507;
+
+        /*!
+         * @brief Construct a new MulticastSender object.
+         *
+         * @param ioContext The ASIO IO context to use.
+         *
+         * @param endpoint The IPv4 multicast endpoint to send to (e.g.
+         * 'udp://239.255.0.1:11240').
+         *
+         * @param interfaceAddress The address of the local interface to send
+         * from. If not given, the default interface for multicast will be
+         * used.
+         *
+         * @exception std::runtime_error Thrown if the endpoint is not an IPv4
+         * multicast endpoint or the socket could not be opened.
+         */
+        MulticastSender(asio::io_context& ioContext, const Endpoint& endpoint, std::optional<std::string> interfaceAddress = std::nullopt);
+        MulticastSender(const MulticastSender& other) = delete;
+        MulticastSender(MulticastSender&& other) = delete;
+        ~MulticastSender() = default;
+
+        MulticastSender& operator = (const MulticastSender& rhs) = delete;
+        MulticastSender& operator = (MulticastSender&& rhs) = delete;
+
+        /*!
+         * @brief Send a transmission to the multicast group.
+         *
+         * @param sequence The sequence number of the transmission.
+         *
+         * @param transmission The transmission to send. Undecoded
+         * transmissions are sent without being decoded.
+         *
+         * @return true If the datagram has been sent.
+         * @return false If the transmission exceeds the maximum datagram
+         * size or the datagram could not be sent without blocking.
+         */
+        bool send(uint64_t sequence, const Transmission& transmission);
+
+    private:
+
+        asio::ip::udp::socket m_socket;
+        asio::ip::udp::endpoint m_endpoint;
+        serialization::CborSerializer m_serializer;
+    };
+}
@@ -3,6 +3,9 @@
 #pragma once
 #include <memory>
 #include <atomic>
+#include <mutex>
+#include <optional>
+#include <vector>
 #include <dots/type/AnyStruct.h>
 #include <DotsHeader.dots.h>
 
@@ -11,8 +14,10 @@ namespace dots::io
     struct Transmission
     {
         using id_t = uint64_t;
+        using payload_t = std::vector<uint8_t>;
 
         Transmission(DotsHeader header, type::AnyStruct instance);
+        Transmission(DotsHeader header, const type::StructDescriptor& descriptor, payload_t payload);
         Transmission(const Transmission& other) = delete;
         Transmission(Transmission&& other) = default;
         ~Transmission() = default;
@@ -22,10 +27,22 @@ namespace dots::io
 
         id_t id() const;
 
+        Transmission share() const;
+
         const DotsHeader& header() const&;
         DotsHeader& header() &;
         DotsHeader header() &&;
 
+        const type::StructDescriptor& descriptor() const;
+        const payload_t* payload() const;
+        bool decoded() const;
+
+        size_t encodedSize() const;
+        void setEncodedSize(size_t encodedSize);
+
+        uint32_t batchRemaining() const;
+        void setBatchRemaining(uint32_t batchRemaining);
+
         const type::AnyStruct& instance() const&;
         type::AnyStruct instance() &&;
 
@@ -76,10 +93,22 @@ namespace dots::io
         {
             id_t id;
             DotsHeader header;
-            type::AnyStruct instance;
+            const type::StructDescriptor* descriptor;
+            std::optional<payload_t> payload;
+            size_t encodedSize;
+            uint32_t batchRemaining;
+            mutable std::optional<type::AnyStruct> instance;
+            mutable std::once_flag decodeFlag;
+            mutable std::atomic<bool> decoded;
         };
 
-        std::unique_ptr<TransmissionData> m_data;
+        Transmission(std::shared_ptr<TransmissionData> data);
+
+        bool exclusive() const;
+        TransmissionData& mutableData();
+        void decode() const;
+
+        std::shared_ptr<TransmissionData> m_data;
     };
 }
 
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <dots/asio.h>
+
+namespace dots::io
+{
+    /*!
+     * @class WorkerPool WorkerPool.h <dots/io/WorkerPool.h>
+     *
+     * @brief Pool of worker threads that each run a dedicated IO context.
+     *
+     * A worker pool can be used to distribute IO objects (e.g. sockets)
+     * across multiple event loops that are executed on separate threads.
+     *
+     * Note that the worker threads are started lazily when the first
+     * worker is selected via WorkerPool::next(). This allows a pool to be
+     * created before the process is detached (e.g. by the Linux 'daemon'
+     * syscall) without losing the threads.
+     */
+    struct WorkerPool
+    {
+        /*!
+         * @brief Construct a new WorkerPool object.
+         *
+         * @param numWorkers The amount of workers (i.e. threads and IO
+         * contexts) in the pool.
+         *
+         * @exception std::logic_error Thrown if @p numWorkers is zero.
+         */
+        WorkerPool(size_t numWorkers);
+        WorkerPool(const WorkerPool& other) = delete;
+        WorkerPool(WorkerPool&& other) = delete;
+
+        /*!
+         * @brief Destroy the WorkerPool object.
+         *
+         * This will stop the IO contexts of all workers and join the worker
+         * threads. Handlers that are still pending will be destroyed without
+         * being invoked.
+         */
+        ~WorkerPool();
+
+        WorkerPool& operator = (const WorkerPool& rhs) = delete;
+        WorkerPool& operator = (WorkerPool&& rhs) = delete;
+
+        /*!
+         * @brief Get the amount of workers in the pool.
+         *
+         * @return size_t The amount of workers.
+         */
+        size_t size() const;
+
+        /*!
+         * @brief Get the IO context of a specific worker.
+         *
+         * @param index The index of the worker.
+         *
+         * @return asio::io_context& A reference to the IO context of the
+         * worker.
+         */
+        asio::io_context& ioContext(size_t index);
+
+        /*!
+         * @brief Select the next worker in a round-robin fashion.
+         *
+         * If the worker threads have not been started yet, they will be
+         * started before this function returns.
+         *
+         * @return size_t The index of the selected worker.
+         */
+        size_t next();
+
+        /*!
+         * @brief Indicates whether the calling thread is a worker thread of
+         * any WorkerPool.
+         *
+         * @return true If the calling thread is a worker thread.
+         * @return false Else.
+         */
+        static bool RunningInWorkerThread();
+
+    private:
+
+        using work_guard_t = asio::executor_work_guard<asio::io_context::executor_type>;
+
+        struct Worker
+        {
+            asio::io_context ioContext;
+            std::optional<work_guard_t> workGuard;
+            std::thread thread;
+        };
+
+        void start();
+
+        inline static thread_local bool M_isWorkerThread = false;
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        size_t m_nextWorker;
+        bool m_started;
+    };
+}
@@ -4,8 +4,13 @@
 #define DOTS_ACKNOWLEDGE_DEPRECATION_OF_DotsTransportHeader_destinationGroup
 #define DOTS_ACKNOWLEDGE_DEPRECATION_OF_DotsTransportHeader_nameSpace
 #define DOTS_ACKNOWLEDGE_DEPRECATION_OF_DotsTransportHeader_destinationClientId
+#include <deque>
+#include <memory>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 #include <dots/asio.h>
+#include <dots/Container.h>
 #include <dots/type/Registry.h>
 #include <dots/io/Channel.h>
 #include <dots/serialization/CborSerializer.h>
@@ -23,13 +28,21 @@ namespace dots::io
      * DotsTransportHeader to be backwards compatible with legacy
      * applications.
      *
+     * When set to 'v3', transmissions will be serialized as in 'v2', but
+     * multiple instances of the same type can additionally be packed into
+     * a single batch that shares one header (see
+     * dots::io::Channel::transmit(const DotsHeader&, const
+     * instance_batch_t&)). Note that 'v3' can receive transmissions in
+     * 'v2' format, but not vice versa.
+     *
      * @remark This enum is intended to be used as an argument to
      * instantiate the dots::io::AsyncStreamChannel template.
      */
     enum struct TransmissionFormat : uint8_t
     {
         v1,
-        v2
+        v2,
+        v3
     };
 
     /*!
@@ -55,7 +68,43 @@ namespace dots::io
      * Additionally, the channel optionally can use a payload cache to
      * avoid redundant serializations when writing. This is intended to be
      * used by DOTS hosts, where the same transmission will be distributed
-     * to an arbitrary number of subscribers.
+     * to an arbitrary number of subscribers. Cached payloads are stored in
+     * immutable shared buffers that are referenced by the write queues of
+     * all channels using the cache and gathered by a single write
+     * operation, so no copies are made per channel.
+     *
+     * The size of the write queue is limited according to the limit and
+     * policy given in dots::io::Channel::setWriteQueueLimit(). Note that
+     * the 'drop_oldest' policy only drops transmissions of uncached types
+     * that have been queued via the payload cache (i.e. transmissions
+     * distributed by a host). Dropping transmissions of cached types would
+     * leave the cache of the peer inconsistent and dropping any other
+     * transmissions would corrupt its protocol state. Updates of cached
+     * types can only be bounded by conflation (see below). If the write
+     * queue cannot be restored to its maximum size by dropping, the channel
+     * fails as with the 'disconnect' policy.
+     *
+     * If a conflation threshold is set (see
+     * dots::io::Channel::setConflationThreshold()) and the write queue
+     * exceeds the threshold, updates of instances of cached types will not
+     * be serialized immediately. Instead, all updates of the same instance
+     * are merged into a single transmission that contains the union of the
+     * included properties. The merged transmissions will be written in the
+     * order of their first update when the write queue has been drained
+     * below the threshold or before any other transmission is written, so
+     * the order of the transmissions is preserved. This limits the
+     * bandwidth and memory that is used for peers that cannot keep up,
+     * while all other peers will still receive every update. Note that
+     * the flush is not limited to the type of the transmission that is
+     * written, so frequent removals or transmissions of uncached types
+     * effectively disable conflation.
+     *
+     * If @p TransmissionFormat is 'v3', batches of transmissions are
+     * serialized into a single frame, in which the header is followed by a
+     * CBOR array of the instances. Received batches are unpacked one
+     * instance at a time directly from the read buffer, so every instance
+     * is delivered as a separate transmission without intermediate copies
+     * (see dots::io::Transmission::batchRemaining()).
      *
      * @tparam Stream The stream type to use. Must meet the requirements
      * for AsyncReadStream and AsyncWriteStream from the Asio library.
@@ -74,7 +123,8 @@ namespace dots::io
         using serializer_t = Serializer;
 
         using buffer_t = typename serializer_t::data_t;
-        using payload_cache_t = std::pair<Transmission::id_t, buffer_t>;
+        using shared_buffer_t = std::shared_ptr<const buffer_t>;
+        using payload_cache_t = std::pair<Transmission::id_t, shared_buffer_t>;
 
         /*!
          * @brief Construct a new AsyncStreamChannel object.
@@ -123,6 +173,12 @@ namespace dots::io
          */
         AsyncStreamChannel(key_t key, stream_t&& stream, payload_cache_t* payloadCache) :
             Channel(key),
+            m_transportHeaderSize(0),
+            m_batchRemaining(0),
+            m_batchSize(0),
+            m_writeQueueSize(0),
+            m_writeQueueDepth(0),
+            m_writeBufferDepth(0),
             m_asyncWriting(false),
             m_readDispatching(false),
             m_stream{ std::move(stream) },
@@ -189,11 +245,28 @@ namespace dots::io
                 return;
             }
 
+            if constexpr (TransmissionFormat == TransmissionFormat::v3)
+            {
+                // note: the remaining instances of a batch are already
+                // contained in the read buffer
+                if (m_batchRemaining > 0)
+                {
+                    asyncRead(0, [this]
+                    {
+                        trafficState().receivedPackages.fetch_add(1, std::memory_order_relaxed);
+                        Transmission transmission = deserializeBatchInstance();
+                        processReceive(std::move(transmission));
+                    });
+
+                    return;
+                }
+            }
+
             if constexpr (TransmissionFormat == TransmissionFormat::v1)
             {
-                auto process_transmission = [this]
+                auto process_transmission = [this](size_t transmissionSize)
                 {
-                    Transmission transmission = deserializeTransmission();
+                    Transmission transmission = deserializeTransmission(transmissionSize);
                     processReceive(std::move(transmission));
                 };
 
@@ -201,11 +274,14 @@ namespace dots::io
                 {
                     if (size_t transmissionSize = deserializeTransmissionSize(); transmissionSize <= m_serializer.inputAvailable())
                     {
-                        process_transmission();
+                        process_transmission(transmissionSize);
                     }
                     else
                     {
-                        asyncRead(transmissionSize, process_transmission);
+                        asyncRead(transmissionSize, [process_transmission, transmissionSize]
+                        {
+                            process_transmission(transmissionSize);
+                        });
                     }
                 };
 
@@ -228,9 +304,9 @@ namespace dots::io
             }
             else
             {
-                auto process_transmission = [this]
+                auto process_transmission = [this](size_t transmissionSize)
                 {
-                    Transmission transmission = deserializeTransmission();
+                    Transmission transmission = deserializeTransmission(transmissionSize);
                     processReceive(std::move(transmission));
                 };
 
@@ -238,11 +314,14 @@ namespace dots::io
                 {
                     if (size_t transmissionSize = deserializeTransmissionSize(); transmissionSize <= m_serializer.inputAvailable())
                     {
-                        process_transmission();
+                        process_transmission(transmissionSize);
                     }
                     else
                     {
-                        asyncRead(transmissionSize, process_transmission);
+                        asyncRead(transmissionSize, [process_transmission, transmissionSize]
+                        {
+                            process_transmission(transmissionSize);
+                        });
                     }
                 };
 
@@ -258,7 +337,7 @@ namespace dots::io
          * asynchronously write the payload to the underlying stream.
          *
          * If the channel is already asynchronously writing data, all
-         * subsequent transmits will remain in the current write buffer and
+         * subsequent transmits will remain in the current write queue and
          * automatically be asynchronously written in a bulk operation when the
          * initial write has completed (see AsyncStreamChannel::asyncWrite()).
          *
@@ -268,12 +347,17 @@ namespace dots::io
          */
         void transmitImpl(const DotsHeader& header, const type::Struct& instance) override
         {
+            flushConflatedTransmissions();
             serializeTransmission(header, instance);
 
             if (!m_asyncWriting)
             {
                 asyncWrite();
             }
+            else
+            {
+                updateWriteQueueState();
+            }
         }
 
         /*!
@@ -283,7 +367,7 @@ namespace dots::io
          * asynchronously write the payload to the underlying stream.
          *
          * If the channel is already asynchronously writing data, all
-         * subsequent transmits will remain in the current write buffer and
+         * subsequent transmits will remain in the current write queue and
          * automatically be asynchronously written in a bulk operation when the
          * initial write has completed (see AsyncStreamChannel::asyncWrite()).
          *
@@ -291,24 +375,149 @@ namespace dots::io
          */
         void transmitImpl(const Transmission& transmission) override
         {
-            serializeTransmission(transmission);
+            if (!conflateTransmission(transmission))
+            {
+                flushConflatedTransmissions();
+                serializeTransmission(transmission);
+            }
 
             if (!m_asyncWriting)
             {
                 asyncWrite();
             }
+            else
+            {
+                updateWriteQueueState();
+            }
+        }
+
+        /*!
+         * @brief Asynchronously transmit a batch of instances through the
+         * channel.
+         *
+         * If @p TransmissionFormat is 'v3', this will serialize all given
+         * instances with the given header into a single batch and
+         * asynchronously write the payload to the underlying stream.
+         * Otherwise, the instances will be transmitted individually.
+         *
+         * @param header The header to use for all instances. The included
+         * properties of the header apply to every instance.
+         *
+         * @param instances The instances to transmit. Must all be of the type
+         * given in the header.
+         */
+        void transmitImpl(const DotsHeader& header, const instance_batch_t& instances) override
+        {
+            if constexpr (TransmissionFormat == TransmissionFormat::v3)
+            {
+                flushConflatedTransmissions();
+                serializeBatch(header, instances.size(), [&](serializer_t& serializer, size_t i)
+                {
+                    serializer.serialize(instances[i].get(), *header.attributes);
+                });
+
+                if (!m_asyncWriting)
+                {
+                    asyncWrite();
+                }
+                else
+                {
+                    updateWriteQueueState();
+                }
+            }
+            else
+            {
+                Channel::transmitImpl(header, instances);
+            }
+        }
+
+        /*!
+         * @brief Asynchronously transmit a batch of transmissions through
+         * the channel.
+         *
+         * If @p TransmissionFormat is 'v3', this will serialize all given
+         * transmissions into a single batch and asynchronously write the
+         * payload to the underlying stream. Otherwise, or if the transmissions
+         * might have to be conflated (see
+         * AsyncStreamChannel::conflateTransmission()), the transmissions will
+         * be transmitted individually.
+         *
+         * Note that the header of the first transmission will be used for
+         * all transmissions of the batch. The transmissions must therefore
+         * only differ in their instances (e.g. because they were received as
+         * a batch).
+         *
+         * @param transmissions The transmissions to transmit. Must all be of
+         * the same type.
+         */
+        void transmitImpl(const std::vector<Transmission>& transmissions) override
+        {
+            if constexpr (TransmissionFormat == TransmissionFormat::v3)
+            {
+                if (writeQueueState().conflationThreshold > 0 && transmissions.front().descriptor().cached())
+                {
+                    Channel::transmitImpl(transmissions);
+                }
+                else
+                {
+                    flushConflatedTransmissions();
+                    serializeBatch(transmissions);
+
+                    if (!m_asyncWriting)
+                    {
+                        asyncWrite();
+                    }
+                    else
+                    {
+                        updateWriteQueueState();
+                    }
+                }
+            }
+            else
+            {
+                Channel::transmitImpl(transmissions);
+            }
         }
 
     private:
 
         static constexpr size_t ReadBufferMinSize = 16 * 128;
-        static constexpr size_t WriteBufferMaxSize = 10 * 1024 * 1024;
 
         using transmission_size_t = std::conditional_t<TransmissionFormat == TransmissionFormat::v1, dots::uint16_t, dots::uint32_t>;
         static constexpr size_t TransmissionSizeSize = TransmissionFormat == TransmissionFormat::v1 ? sizeof(dots::uint16_t) : sizeof(dots::uint32_t) + 1;
 
+        // note: the size of a batch is encoded as a fixed size CBOR array
+        // head, so it can be distinguished from the CBOR map of a single
+        // instance
+        static constexpr uint8_t BatchHead = 0x9A;
+        static constexpr Transmission::id_t BatchCacheIdFlag = Transmission::id_t{ 1 } << 63;
+        static constexpr size_t MaxWriteBufferPoolSize = 4;
+
         using iterator_t = typename buffer_t::iterator;
 
+        struct queued_buffer_t
+        {
+            shared_buffer_t buffer;
+            uint32_t transmissions;
+            bool droppable;
+            bool recyclable;
+
+            size_t size() const
+            {
+                return buffer->size();
+            }
+        };
+
+        struct conflated_transmission_t
+        {
+            DotsHeader header;
+            const type::Struct* instance;
+        };
+
+        using conflated_containers_t = std::unordered_map<const type::StructDescriptor*, Container<>>;
+        using conflated_transmissions_t = std::vector<conflated_transmission_t>;
+        using conflated_indices_t = std::unordered_map<const type::Struct*, size_t>;
+
         /*!
          * @brief Asynchronously read at least a specific amount of bytes.
          *
@@ -388,6 +597,7 @@ namespace dots::io
 
                         verifyErrorCode(ec);
 
+                        trafficState().receivedBytes.fetch_add(bytesRead, std::memory_order_relaxed);
                         m_serializer.setInput(m_serializer.inputData(), m_serializer.inputAvailable() + bytesRead);
 
                         if (m_serializer.inputAvailable() < requiredBytes)
@@ -410,27 +620,54 @@ namespace dots::io
         /*!
          * @brief Asynchronously write all outstanding payloads.
          *
-         * This will asynchronously write all data in the current write buffer
-         * as a bulk operation via the underlying stream object.
+         * This will asynchronously write all buffers in the current write
+         * queue as a bulk (i.e. scatter-gather) operation via the underlying
+         * stream object.
          *
          * When the operation has completed and additional payloads were
-         * buffered in the meantime, another asynchronous write operation will
+         * queued in the meantime, another asynchronous write operation will
          * be initiated automatically.
          *
-         * This process will continue until the write buffer is empty.
+         * This process will continue until the write queue is empty.
          */
         void asyncWrite()
         {
-            m_writeBuffer.swap(m_serializer.output());
-            m_serializer.output().clear();
+            TrafficState& traffic = trafficState();
+
+            for (queued_buffer_t& writtenBuffer : m_writeBuffers)
+            {
+                m_writeQueueSize -= writtenBuffer.buffer->size();
+                m_writeQueueDepth -= writtenBuffer.transmissions;
+                traffic.sentBytes.fetch_add(writtenBuffer.buffer->size(), std::memory_order_relaxed);
+                traffic.sentPackages.fetch_add(writtenBuffer.transmissions, std::memory_order_relaxed);
+
+                if (writtenBuffer.recyclable)
+                {
+                    recycleWriteBuffer(std::move(writtenBuffer.buffer));
+                }
+            }
+
+            m_writeBuffers.clear();
+            serializeConflatedTransmissions();
+            enqueueWriteBuffer();
+            m_writeBuffers.swap(m_writeQueue);
+            updateWriteQueueState();
 
-            if (m_writeBuffer.empty())
+            if (m_writeBuffers.empty())
             {
                 m_asyncWriting = false;
             }
             else
             {
-                asio::async_write(m_stream, asio::buffer(m_writeBuffer.data(), m_writeBuffer.size()), [&, this_{ shared_from_this() }](boost::system::error_code ec, size_t/* numBytes*/)
+                std::vector<asio::const_buffer> buffers;
+                buffers.reserve(m_writeBuffers.size());
+
+                for (const queued_buffer_t& writeBuffer : m_writeBuffers)
+                {
+                    buffers.emplace_back(asio::buffer(writeBuffer.buffer->data(), writeBuffer.buffer->size()));
+                }
+
+                asio::async_write(m_stream, buffers, [&, this_{ shared_from_this() }](boost::system::error_code ec, size_t/* numBytes*/)
                 {
                     try
                     {
@@ -450,6 +687,211 @@ namespace dots::io
             }
         }
 
+        /*!
+         * @brief Move the data of the current write buffer to the write
+         * queue.
+         *
+         * The data is swapped into a buffer of the write buffer pool, so
+         * that the serializer continues with the (cleared) storage of a
+         * previously written buffer instead of reallocating its output for
+         * every flush.
+         *
+         * This will be a no-op if the current write buffer is empty.
+         */
+        void enqueueWriteBuffer()
+        {
+            if (buffer_t& writeBuffer = m_serializer.output(); !writeBuffer.empty())
+            {
+                std::shared_ptr<buffer_t> queuedBuffer;
+
+                if (m_writeBufferPool.empty())
+                {
+                    queuedBuffer = std::make_shared<buffer_t>();
+                }
+                else
+                {
+                    queuedBuffer = std::move(m_writeBufferPool.back());
+                    m_writeBufferPool.pop_back();
+                }
+
+                queuedBuffer->swap(writeBuffer);
+                m_writeQueueSize += queuedBuffer->size();
+                m_writeQueueDepth += m_writeBufferDepth;
+                m_writeQueue.emplace_back(queued_buffer_t{ std::move(queuedBuffer), m_writeBufferDepth, false, true });
+                m_writeBufferDepth = 0;
+            }
+        }
+
+        /*!
+         * @brief Return a written buffer to the write buffer pool.
+         *
+         * Note that only buffers that were created by
+         * AsyncStreamChannel::enqueueWriteBuffer() can be recycled, because
+         * they are exclusively owned by the channel and therefore not
+         * actually const.
+         *
+         * @param buffer The written buffer to recycle.
+         */
+        void recycleWriteBuffer(shared_buffer_t&& buffer)
+        {
+            if (m_writeBufferPool.size() < MaxWriteBufferPoolSize && buffer.use_count() == 1)
+            {
+                auto recycledBuffer = std::const_pointer_cast<buffer_t>(std::move(buffer));
+                recycledBuffer->clear();
+                m_writeBufferPool.emplace_back(std::move(recycledBuffer));
+            }
+        }
+
+        /*!
+         * @brief Apply the write queue policy to the write queue of the
+         * channel (see Channel::limitWriteQueue()).
+         *
+         * @exception std::runtime_error Thrown if the policy is 'disconnect'
+         * or if the maximum size cannot be restored otherwise.
+         */
+        void limitWriteQueue()
+        {
+            auto [droppedSize, droppedTransmissions] = Channel::limitWriteQueue(m_writeQueueSize + m_serializer.output().size(), m_writeQueue, m_writeQueue.begin());
+            m_writeQueueSize -= droppedSize;
+            m_writeQueueDepth -= static_cast<uint32_t>(droppedTransmissions);
+        }
+
+        /*!
+         * @brief Attempt to conflate a transmission with previous
+         * transmissions of the same instance.
+         *
+         * Transmissions of cached types will be conflated if the write queue
+         * exceeds the conflation threshold or if other transmissions are
+         * currently being conflated, which ensures that updates of the same
+         * instance are never reordered.
+         *
+         * The conflated instances are stored in a dots::Container per type,
+         * so the properties of the given transmission are merged into the
+         * conflated instance exactly as a container applies updates. The
+         * included properties of the conflated transmission will be the union
+         * of the included properties of all merged transmissions.
+         *
+         * Removals will never be conflated. Like all other transmissions that
+         * are not conflated, they require the conflated transmissions to be
+         * written first (see
+         * AsyncStreamChannel::flushConflatedTransmissions()).
+         *
+         * @param transmission The transmission to conflate.
+         *
+         * @return true If the transmission was conflated and must not be
+         * serialized.
+         * @return false Else.
+         */
+        bool conflateTransmission(const Transmission& transmission)
+        {
+            size_t threshold = writeQueueState().conflationThreshold;
+            const type::StructDescriptor& descriptor = transmission.descriptor();
+            const DotsHeader& header = transmission.header();
+
+            if (threshold == 0 || !descriptor.cached() || header.removeObj == true)
+            {
+                return false;
+            }
+
+            if (m_conflatedTransmissions.empty() && m_writeQueueSize + m_serializer.output().size() <= threshold)
+            {
+                return false;
+            }
+
+            Container<>& container = m_conflatedContainers.try_emplace(&descriptor, descriptor).first->second;
+            const type::Struct& conflatedInstance = *container.insert(header, transmission.instance()).first;
+
+            if (auto [itIndex, emplaced] = m_conflatedIndices.try_emplace(&conflatedInstance, m_conflatedTransmissions.size()); emplaced)
+            {
+                m_conflatedTransmissions.emplace_back(conflated_transmission_t{ header, &conflatedInstance });
+            }
+            else
+            {
+                DotsHeader& conflatedHeader = m_conflatedTransmissions[itIndex->second].header;
+                property_set_t attributes = *conflatedHeader.attributes + *header.attributes;
+                conflatedHeader = header;
+                conflatedHeader.attributes = attributes;
+
+                ++writeQueueState().conflated;
+            }
+
+            return true;
+        }
+
+        /*!
+         * @brief Serialize all conflated transmissions into the current write
+         * buffer if the write queue has been drained below the conflation
+         * threshold.
+         */
+        void serializeConflatedTransmissions()
+        {
+            if (m_writeQueueSize + m_serializer.output().size() <= writeQueueState().conflationThreshold)
+            {
+                flushConflatedTransmissions();
+            }
+        }
+
+        /*!
+         * @brief Serialize all conflated transmissions into the current write
+         * buffer in the order of their first update.
+         *
+         * This must be done before any transmission that is not conflated is
+         * serialized, because the transmission would otherwise overtake the
+         * conflated transmissions (e.g. a DotsCacheInfo that completes the
+         * transmission of a container snapshot).
+         */
+        void flushConflatedTransmissions()
+        {
+            if (m_conflatedTransmissions.empty())
+            {
+                return;
+            }
+
+            conflated_transmissions_t conflatedTransmissions = std::move(m_conflatedTransmissions);
+            m_conflatedTransmissions.clear();
+            m_conflatedIndices.clear();
+
+            for (const conflated_transmission_t& conflatedTransmission : conflatedTransmissions)
+            {
+                serializeTransmission(conflatedTransmission.header, *conflatedTransmission.instance);
+            }
+
+            for (auto& [descriptor, container] : m_conflatedContainers)
+            {
+                (void)descriptor;
+                container.clear();
+            }
+        }
+
+        /*!
+         * @brief Update the published state of the write queue.
+         *
+         * If the write queue is congested or a drain has been requested (see
+         * dots::io::Channel::awaitWriteQueueDrain()) and the write queue has
+         * been drained to half of its maximum size, the congestion will be
+         * resolved and the drain handler will be invoked.
+         */
+        void updateWriteQueueState()
+        {
+            WriteQueueState& state = writeQueueState();
+            size_t size = m_writeQueueSize + m_serializer.output().size();
+            state.size = size;
+            state.depth = m_writeQueueDepth + m_writeBufferDepth + static_cast<uint32_t>(m_conflatedTransmissions.size());
+
+            if (size <= state.maxSize / 2 && (state.congested || state.drainRequested))
+            {
+                bool congested = state.congested.exchange(false);
+                bool drainRequested = state.drainRequested.exchange(false);
+
+                // note: the drain handler must not be invoked if the channel
+                // is only kept alive by a pending write operation
+                if ((congested || drainRequested) && weak_from_this().use_count() > 1)
+                {
+                    processWriteQueueDrained();
+                }
+            }
+        }
+
         /*!
          * @brief Deserialize the size of the DotsTransportHeader from the
          * current input data.
@@ -482,7 +924,7 @@ namespace dots::io
             if constexpr (TransmissionFormat == TransmissionFormat::v1)
             {
                 m_transportHeader = {};
-                m_serializer.deserialize(m_transportHeader);
+                m_transportHeaderSize = m_serializer.deserialize(m_transportHeader);
 
                 if (!m_transportHeader.payloadSize.isValid())
                 {
@@ -500,25 +942,179 @@ namespace dots::io
         /*!
          * @brief Deserialize a transmission from the current input data.
          *
+         * The encoded size of the resulting transmission will be set to the
+         * size of the transmission including its framing (see
+         * dots::io::Transmission::encodedSize()).
+         *
+         * @param transmissionSize The size of the transmission as returned by
+         * AsyncStreamChannel::deserializeTransmissionSize().
+         *
          * @return Transmission The deserialized transmission.
          */
-        Transmission deserializeTransmission()
+        Transmission deserializeTransmission(size_t transmissionSize)
         {
+            trafficState().receivedPackages.fetch_add(1, std::memory_order_relaxed);
+
             if constexpr (TransmissionFormat == TransmissionFormat::v1)
             {
-                type::AnyStruct instance{ registry().getStructType(*m_transportHeader.dotsHeader->typeName) };
-                m_serializer.deserialize(*instance);
+                Transmission transmission = deserializeInstance(std::move(*m_transportHeader.dotsHeader), transmissionSize);
+                transmission.setEncodedSize(TransmissionSizeSize + m_transportHeaderSize + transmissionSize);
 
-                return Transmission{ std::move(*m_transportHeader.dotsHeader), std::move(instance) };
+                return transmission;
             }
             else
             {
+                const auto* transmissionBegin = m_serializer.inputData();
                 auto header = m_serializer.template deserialize<DotsHeader>();
-                type::AnyStruct instance{ registry().getStructType(*header.typeName) };
-                m_serializer.deserialize(*instance);
+                size_t headerSize = static_cast<size_t>(m_serializer.inputData() - transmissionBegin);
+
+                if constexpr (TransmissionFormat == TransmissionFormat::v3)
+                {
+                    if (headerSize < transmissionSize && *m_serializer.inputData() == BatchHead)
+                    {
+                        const auto* batchBegin = m_serializer.inputData();
+                        m_batchRemaining = static_cast<uint32_t>(m_serializer.reader().readArraySize());
+                        size_t batchHeadSize = static_cast<size_t>(m_serializer.inputData() - batchBegin);
+
+                        if (m_batchRemaining == 0)
+                        {
+                            throw std::runtime_error{ "received empty batch of type " + *header.typeName };
+                        }
 
-                return Transmission{ std::move(header), std::move(instance) };
+                        if (headerSize + batchHeadSize > transmissionSize)
+                        {
+                            throw std::runtime_error{ "received truncated batch head of type " + *header.typeName };
+                        }
+
+                        // note: every instance occupies at least one byte,
+                        // so the count of a valid batch cannot exceed the
+                        // remaining size of the frame
+                        m_batchSize = transmissionSize - headerSize - batchHeadSize;
+
+                        if (m_batchRemaining > m_batchSize)
+                        {
+                            throw std::runtime_error{ "received batch of type " + *header.typeName + " with " + std::to_string(m_batchRemaining) + " instances that exceeds the frame size" };
+                        }
+
+                        m_batchHeader = std::move(header);
+
+                        // note: the framing of the batch is attributed to its
+                        // first transmission
+                        Transmission transmission = deserializeBatchInstance();
+                        transmission.setEncodedSize(TransmissionSizeSize + headerSize + batchHeadSize + transmission.encodedSize());
+
+                        return transmission;
+                    }
+                }
+
+                Transmission transmission = deserializeInstance(std::move(header), transmissionSize - headerSize);
+                transmission.setEncodedSize(TransmissionSizeSize + transmissionSize);
+
+                return transmission;
+            }
+        }
+
+        /*!
+         * @brief Deserialize the next instance of the current batch from the
+         * current input data.
+         *
+         * The resulting transmission will use a copy of the header of the
+         * batch, which is moved into the transmission of the last instance.
+         *
+         * The input is limited to the remaining bytes of the batch frame, so
+         * that a malformed batch cannot be continued with the data of the
+         * subsequent frame. An exception is thrown if an instance exceeds
+         * the frame or if the last instance does not end exactly at the end
+         * of the frame.
+         *
+         * Note that this function is only available if v3 transmissions are
+         * used.
+         *
+         * @tparam TransmissionFormat_ Defaulted helper value parameter used
+         * for SFINAE. Do not specify manually!
+         *
+         * @return Transmission The deserialized transmission.
+         */
+        template <io::TransmissionFormat TransmissionFormat_ = TransmissionFormat, std::enable_if_t<TransmissionFormat_ == TransmissionFormat::v3, int> = 0>
+        Transmission deserializeBatchInstance()
+        {
+            const auto* instanceBegin = m_serializer.inputData();
+            size_t inputAvailable = m_serializer.inputAvailable();
+            m_serializer.setInput(instanceBegin, m_batchSize);
+            --m_batchRemaining;
+
+            Transmission transmission = m_batchRemaining == 0 ? deserializeInstance(std::move(m_batchHeader), std::nullopt) : deserializeInstance(m_batchHeader, std::nullopt);
+
+            size_t instanceSize = static_cast<size_t>(m_serializer.inputData() - instanceBegin);
+            m_serializer.setInput(m_serializer.inputData(), inputAvailable - instanceSize);
+            m_batchSize -= instanceSize;
+
+            if (m_batchRemaining == 0 && m_batchSize != 0)
+            {
+                throw std::runtime_error{ "received batch with " + std::to_string(m_batchSize) + " trailing bytes" };
+            }
+            else if (m_batchRemaining > m_batchSize)
+            {
+                throw std::runtime_error{ "received truncated batch with " + std::to_string(m_batchRemaining) + " missing instances" };
+            }
+
+            transmission.setEncodedSize(instanceSize);
+            transmission.setBatchRemaining(m_batchRemaining);
+
+            return transmission;
+        }
+
+        /*!
+         * @brief Deserialize the instance of a transmission from the current
+         * input data.
+         *
+         * If pass-through is enabled for the type of the instance (see
+         * dots::io::Channel::setPassThrough()), the instance will not be
+         * decoded. Instead, the serialized instance will be stored as is in
+         * the resulting transmission, which allows it to be forwarded to
+         * other stream channels without being decoded and encoded again.
+         *
+         * Note that pass-through is only supported if @p Serializer is the
+         * CBOR serializer.
+         *
+         * @param header The previously deserialized header of the
+         * transmission.
+         *
+         * @param instanceSize The size of the serialized instance. If not
+         * given (e.g. for instances of a batch), the size will be determined
+         * by skipping the serialized instance when required.
+         *
+         * @return Transmission The deserialized transmission.
+         */
+        Transmission deserializeInstance(DotsHeader header, std::optional<size_t> instanceSize)
+        {
+            const type::StructDescriptor& descriptor = resolveStructType(*header.typeName);
+
+            if constexpr (std::is_same_v<serializer_t, serialization::CborSerializer>)
+            {
+                if (passThrough(descriptor))
+                {
+                    const auto* instanceBegin = m_serializer.inputData();
+
+                    if (instanceSize == std::nullopt)
+                    {
+                        m_serializer.reader().skip();
+                    }
+                    else
+                    {
+                        m_serializer.setInput(instanceBegin + *instanceSize, m_serializer.inputAvailable() - *instanceSize);
+                    }
+
+                    Transmission::payload_t payload(instanceBegin, m_serializer.inputData());
+
+                    return Transmission{ std::move(header), descriptor, std::move(payload) };
+                }
             }
+
+            type::AnyStruct instance{ descriptor };
+            m_serializer.deserialize(*instance);
+
+            return Transmission{ std::move(header), std::move(instance) };
         }
 
         /*!
@@ -538,15 +1134,61 @@ namespace dots::io
          */
         iterator_t serializeTransmission(const DotsHeader& header, const type::Struct& instance)
         {
-            if (m_serializer.output().size() > WriteBufferMaxSize)
+            return serializeTransmission(header, instance._descriptor(), [&](serializer_t& serializer)
             {
-                throw std::runtime_error{ "async write buffer exceeded maximum size" };
-            }
+                serializer.serialize(instance, *header.attributes);
+            });
+        }
+
+        /*!
+         * @brief Serialize a transmission with an already serialized instance
+         * into the current write buffer.
+         *
+         * This is used to forward undecoded transmissions (see
+         * AsyncStreamChannel::deserializeInstance()).
+         *
+         * @param header The header to serialize.
+         *
+         * @param descriptor The descriptor of the serialized instance.
+         *
+         * @param payload The serialized instance.
+         *
+         * @return iterator_t An iterator to the begin of the area of the write
+         * buffer that is used by the serialized payload.
+         */
+        iterator_t serializeTransmission(const DotsHeader& header, const type::StructDescriptor& descriptor, const Transmission::payload_t& payload)
+        {
+            return serializeTransmission(header, descriptor, [&](serializer_t& serializer)
+            {
+                serializer.output().insert(serializer.output().end(), payload.begin(), payload.end());
+            });
+        }
+
+        /*!
+         * @brief Serialize a transmission into the current write buffer.
+         *
+         * @tparam InstanceSerializer The type of the function that serializes
+         * the instance.
+         *
+         * @param header The header to serialize.
+         *
+         * @param descriptor The descriptor of the instance.
+         *
+         * @param serializeInstance The function that serializes the instance
+         * with a given serializer.
+         *
+         * @return iterator_t An iterator to the begin of the area of the write
+         * buffer that is used by the serialized payload.
+         */
+        template <typename InstanceSerializer>
+        iterator_t serializeTransmission(const DotsHeader& header, const type::StructDescriptor& descriptor, InstanceSerializer&& serializeInstance)
+        {
+            limitWriteQueue();
 
             if constexpr (TransmissionFormat == TransmissionFormat::v1)
             {
                 serializer_t serializer;
-                serializer.serialize(instance, *header.attributes);
+                serializeInstance(serializer);
                 std::vector<uint8_t> serializedInstance = std::move(serializer.output());
 
                 DotsTransportHeader transportHeader{
@@ -560,7 +1202,7 @@ namespace dots::io
                     transportHeader.destinationGroup = transportHeader.dotsHeader->typeName;
 
                     // conditionally set namespace
-                    if (instance._descriptor().internal() && !instance._is<DotsClient>() && !instance._is<DotsDescriptorRequest>())
+                    if (descriptor.internal() && &descriptor != &DotsClient::_Descriptor() && &descriptor != &DotsDescriptorRequest::_Descriptor())
                     {
                         transportHeader.nameSpace.emplace("SYS");
                     }
@@ -590,6 +1232,8 @@ namespace dots::io
                 writeBuffer.insert(writeBuffer.end(), serializedHeader.begin(), serializedHeader.end());
                 writeBuffer.insert(writeBuffer.end(), serializedInstance.begin(), serializedInstance.end());
 
+                ++m_writeBufferDepth;
+
                 return writeBuffer.begin() + beginIndex;
             }
             else
@@ -602,32 +1246,108 @@ namespace dots::io
 
                 // serialize header and instance
                 m_serializer.serialize(header);
-                m_serializer.serialize(instance, *header.attributes);
+                serializeInstance(m_serializer);
 
-                // serialize transmission size into previously created storage
-                // area. note that the transmission size is encoded as a fixed size
-                // unsigned CBOR integer
-                size_t payloadSize = writeBuffer.size() - beginIndex;
-                auto transmissionSize = static_cast<transmission_size_t>(payloadSize - TransmissionSizeSize);
-                size_t sizeIndex = beginIndex;
-                writeBuffer[sizeIndex++] = static_cast<uint8_t>(0x1A);
-
-                for (int16_t i = sizeof(transmission_size_t) - 1; i >= 0; --i)
-                {
-                    writeBuffer[sizeIndex++] = static_cast<uint8_t>(transmissionSize >> i * 8);
-                }
+                serializeTransmissionSize(beginIndex);
+                ++m_writeBufferDepth;
 
                 return writeBuffer.begin() + beginIndex;
             }
         }
 
         /*!
-         * @brief Serialize a transmission into the current write buffer.
+         * @brief Serialize a batch of instances into the current write
+         * buffer.
+         *
+         * Note that this function is only available if v3 transmissions are
+         * used.
+         *
+         * @tparam InstanceSerializer The type of the function that serializes
+         * an instance of the batch.
+         *
+         * @tparam TransmissionFormat_ Defaulted helper value parameter used
+         * for SFINAE. Do not specify manually!
+         *
+         * @param header The header to serialize.
+         *
+         * @param batchSize The amount of instances in the batch.
+         *
+         * @param serializeInstance The function that serializes the instance
+         * with a given index with a given serializer.
+         *
+         * @return iterator_t An iterator to the begin of the area of the write
+         * buffer that is used by the serialized payload.
+         */
+        template <typename InstanceSerializer, io::TransmissionFormat TransmissionFormat_ = TransmissionFormat, std::enable_if_t<TransmissionFormat_ == TransmissionFormat::v3, int> = 0>
+        iterator_t serializeBatch(const DotsHeader& header, size_t batchSize, InstanceSerializer&& serializeInstance)
+        {
+            limitWriteQueue();
+
+            buffer_t& writeBuffer = m_serializer.output();
+
+            // create storage area for transmission size
+            size_t beginIndex = writeBuffer.size();
+            writeBuffer.resize(writeBuffer.size() + TransmissionSizeSize);
+
+            // serialize header and batch head
+            m_serializer.serialize(header);
+            auto batchHeadSize = static_cast<dots::uint32_t>(batchSize);
+            writeBuffer.emplace_back(BatchHead);
+
+            for (int16_t i = sizeof(dots::uint32_t) - 1; i >= 0; --i)
+            {
+                writeBuffer.emplace_back(static_cast<uint8_t>(batchHeadSize >> i * 8));
+            }
+
+            // serialize instances
+            for (size_t i = 0; i < batchSize; ++i)
+            {
+                serializeInstance(m_serializer, i);
+            }
+
+            serializeTransmissionSize(beginIndex);
+            m_writeBufferDepth += batchHeadSize;
+
+            return writeBuffer.begin() + beginIndex;
+        }
+
+        /*!
+         * @brief Serialize the size of a transmission into the storage area
+         * that was created at the begin of the transmission.
+         *
+         * Note that the transmission size is encoded as a fixed size unsigned
+         * CBOR integer.
+         *
+         * @param beginIndex The index of the transmission in the current write
+         * buffer.
+         */
+        void serializeTransmissionSize(size_t beginIndex)
+        {
+            buffer_t& writeBuffer = m_serializer.output();
+
+            size_t payloadSize = writeBuffer.size() - beginIndex;
+            auto transmissionSize = static_cast<transmission_size_t>(payloadSize - TransmissionSizeSize);
+            size_t sizeIndex = beginIndex;
+            writeBuffer[sizeIndex++] = static_cast<uint8_t>(0x1A);
+
+            for (int16_t i = sizeof(transmission_size_t) - 1; i >= 0; --i)
+            {
+                writeBuffer[sizeIndex++] = static_cast<uint8_t>(transmissionSize >> i * 8);
+            }
+        }
+
+        /*!
+         * @brief Serialize a transmission into the current write queue.
          *
          * If a payload cache was provided in
          * AsyncStreamChannel(key_t, stream_t&&, payload_cache_t*),
          * the function will attempt to retrieve the payload from the cache
-         * based on the id of the given transmission.
+         * based on the id of the given transmission. If the payload is not
+         * cached, it will be serialized into a new shared buffer, which
+         * replaces the current content of the cache.
+         *
+         * In both cases only a reference to the shared buffer will be added
+         * to the write queue.
          *
          * Otherwise the transmission will be serialized as in
          * AsyncStreamChannel::serializeTransmission(const DotsHeader&, const
@@ -637,32 +1357,144 @@ namespace dots::io
          */
         void serializeTransmission(const Transmission& transmission)
         {
-            if (m_payloadCache == nullptr)
+            auto serialize_transmission = [this, &transmission]
             {
+                if constexpr (std::is_same_v<serializer_t, serialization::CborSerializer>)
+                {
+                    if (const Transmission::payload_t* payload = transmission.payload(); payload != nullptr)
+                    {
+                        serializeTransmission(transmission.header(), transmission.descriptor(), *payload);
+                        return;
+                    }
+                }
+
                 serializeTransmission(transmission.header(), transmission.instance());
+            };
+
+            if (m_payloadCache == nullptr)
+            {
+                serialize_transmission();
             }
             else
             {
                 auto& [cacheId, cacheBuffer] = *m_payloadCache;
-                buffer_t& writeBuffer = m_serializer.output();
+                enqueueWriteBuffer();
 
-                if (transmission.id() == cacheId)
+                if (transmission.id() != cacheId || cacheBuffer == nullptr)
                 {
-                    writeBuffer.insert(writeBuffer.end(), cacheBuffer.begin(), cacheBuffer.end());
+                    serialize_transmission();
+                    cacheId = transmission.id();
+                    // note: the payload is copied into an exactly sized
+                    // shared buffer, so that the serializer retains the
+                    // capacity of its output
+                    cacheBuffer = std::make_shared<const buffer_t>(m_serializer.output());
+                    m_serializer.output().clear();
+                    m_writeBufferDepth = 0;
                 }
                 else
                 {
-                    iterator_t begin = serializeTransmission(transmission.header(), transmission.instance());
-                    cacheId = transmission.id();
-                    cacheBuffer.assign(begin, writeBuffer.end());
+                    limitWriteQueue();
                 }
+
+                m_writeQueueSize += cacheBuffer->size();
+                ++m_writeQueueDepth;
+                m_writeQueue.emplace_back(queued_buffer_t{ cacheBuffer, 1, Droppable(transmission.descriptor()), false });
             }
         }
 
+        /*!
+         * @brief Serialize a batch of transmissions into the current write
+         * queue.
+         *
+         * This is equivalent to
+         * AsyncStreamChannel::serializeTransmission(const Transmission&),
+         * but serializes all transmissions into a single batch that uses the
+         * header of the first transmission.
+         *
+         * If a payload cache is used, the batch is cached based on the id of
+         * its first transmission. All channels that share the cache must
+         * therefore be given the same transmissions when transmitting a batch
+         * that starts with the same transmission.
+         *
+         * Note that this function is only available if v3 transmissions are
+         * used.
+         *
+         * @tparam TransmissionFormat_ Defaulted helper value parameter used
+         * for SFINAE. Do not specify manually!
+         *
+         * @param transmissions The transmissions to serialize.
+         */
+        template <io::TransmissionFormat TransmissionFormat_ = TransmissionFormat, std::enable_if_t<TransmissionFormat_ == TransmissionFormat::v3, int> = 0>
+        void serializeBatch(const std::vector<Transmission>& transmissions)
+        {
+            auto serialize_batch = [this, &transmissions]
+            {
+                const DotsHeader& header = transmissions.front().header();
+
+                serializeBatch(header, transmissions.size(), [&](serializer_t& serializer, size_t i)
+                {
+                    const Transmission& transmission = transmissions[i];
+
+                    if constexpr (std::is_same_v<serializer_t, serialization::CborSerializer>)
+                    {
+                        if (const Transmission::payload_t* payload = transmission.payload(); payload != nullptr)
+                        {
+                            serializer.output().insert(serializer.output().end(), payload->begin(), payload->end());
+                            return;
+                        }
+                    }
+
+                    serializer.serialize(*transmission.instance(), *header.attributes);
+                });
+            };
+
+            if (m_payloadCache == nullptr)
+            {
+                serialize_batch();
+            }
+            else
+            {
+                // note: the id of the first transmission is flagged to avoid
+                // conflicts with the cached payload of the transmission itself
+                Transmission::id_t batchId = transmissions.front().id() | BatchCacheIdFlag;
+                auto& [cacheId, cacheBuffer] = *m_payloadCache;
+                enqueueWriteBuffer();
+
+                if (batchId != cacheId || cacheBuffer == nullptr)
+                {
+                    serialize_batch();
+                    cacheId = batchId;
+                    cacheBuffer = std::make_shared<const buffer_t>(m_serializer.output());
+                    m_serializer.output().clear();
+                    m_writeBufferDepth = 0;
+                }
+                else
+                {
+                    limitWriteQueue();
+                }
+
+                auto batchSize = static_cast<uint32_t>(transmissions.size());
+                m_writeQueueSize += cacheBuffer->size();
+                m_writeQueueDepth += batchSize;
+                m_writeQueue.emplace_back(queued_buffer_t{ cacheBuffer, batchSize, Droppable(transmissions.front().descriptor()), false });
+            }
+        }
 
         DotsTransportHeader m_transportHeader;
+        size_t m_transportHeaderSize;
+        DotsHeader m_batchHeader;
+        uint32_t m_batchRemaining;
+        size_t m_batchSize;
         buffer_t m_readBuffer;
-        buffer_t m_writeBuffer;
+        std::deque<queued_buffer_t> m_writeQueue;
+        std::deque<queued_buffer_t> m_writeBuffers;
+        std::vector<std::shared_ptr<buffer_t>> m_writeBufferPool;
+        size_t m_writeQueueSize;
+        uint32_t m_writeQueueDepth;
+        uint32_t m_writeBufferDepth;
+        conflated_containers_t m_conflatedContainers;
+        conflated_transmissions_t m_conflatedTransmissions;
+        conflated_indices_t m_conflatedIndices;
         serializer_t m_serializer;
         bool m_asyncWriting;
         bool m_readDispatching;
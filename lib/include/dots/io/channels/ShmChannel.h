@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <dots/io/channels/AsyncStreamChannel.h>
+#include <dots/io/channels/ShmStream.h>
+
+namespace dots::io::posix::details
+{
+    template <typename Serializer, TransmissionFormat TransmissionFormat>
+    struct GenericShmChannel : AsyncStreamChannel<ShmStream, Serializer, TransmissionFormat>
+    {
+        using base_t = AsyncStreamChannel<ShmStream, Serializer, TransmissionFormat>;
+        using key_t = typename base_t::key_t;
+        using payload_cache_t = typename base_t::payload_cache_t;
+
+        GenericShmChannel(key_t key, asio::io_context& ioContext, const Endpoint& endpoint);
+        GenericShmChannel(key_t key, asio::io_context& ioContext, std::string_view path);
+        GenericShmChannel(key_t key, ShmStream&& stream, payload_cache_t* payloadCache);
+        GenericShmChannel(const GenericShmChannel& other) = delete;
+        GenericShmChannel(GenericShmChannel&& other) = delete;
+        virtual ~GenericShmChannel() noexcept = default;
+
+        GenericShmChannel& operator = (const GenericShmChannel& rhs) = delete;
+        GenericShmChannel& operator = (GenericShmChannel&& rhs) = delete;
+
+    private:
+
+        using base_t::stream;
+        using base_t::initEndpoints;
+
+        static ShmStream Connect(asio::io_context& ioContext, std::string_view path);
+    };
+
+    extern template struct GenericShmChannel<serialization::CborSerializer, TransmissionFormat::v1>;
+    extern template struct GenericShmChannel<serialization::CborSerializer, TransmissionFormat::v2>;
+    extern template struct GenericShmChannel<serialization::CborSerializer, TransmissionFormat::v3>;
+}
+
+namespace dots::io::posix
+{
+    namespace v1
+    {
+        using ShmChannel = details::GenericShmChannel<serialization::CborSerializer, TransmissionFormat::v1>;
+    }
+
+    inline namespace v2
+    {
+        using ShmChannel = details::GenericShmChannel<serialization::CborSerializer, TransmissionFormat::v2>;
+    }
+
+    namespace v3
+    {
+        using ShmChannel = details::GenericShmChannel<serialization::CborSerializer, TransmissionFormat::v3>;
+    }
+}
+
+#else
+#error "Shared memory channels are not available on this platform"
+#endif
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <dots/io/Listener.h>
+#include <dots/io/channels/ShmChannel.h>
+
+namespace dots::io::posix::details
+{
+    template <typename TChannel>
+    struct GenericShmListener : Listener
+    {
+        GenericShmListener(asio::io_context& ioContext, const Endpoint& endpoint, std::optional<int> backlog = std::nullopt, size_t capacity = ShmStream::DefaultCapacity);
+        GenericShmListener(asio::io_context& ioContext, std::string_view path, std::optional<int> backlog = std::nullopt, size_t capacity = ShmStream::DefaultCapacity);
+        GenericShmListener(const GenericShmListener& other) = delete;
+        GenericShmListener(GenericShmListener&& other) = delete;
+        ~GenericShmListener();
+
+        GenericShmListener& operator = (const GenericShmListener& rhs) = delete;
+        GenericShmListener& operator = (GenericShmListener&& rhs) = delete;
+
+    protected:
+
+        void asyncAcceptImpl() override;
+
+    private:
+
+        using buffer_t = typename TChannel::buffer_t;
+        using payload_cache_t = typename TChannel::payload_cache_t;
+
+        asio::local::stream_protocol::endpoint m_endpoint;
+        asio::local::stream_protocol::acceptor m_acceptor;
+        std::reference_wrapper<asio::io_context> m_ioContext;
+        asio::local::stream_protocol::socket m_socket;
+        size_t m_capacity;
+        payload_cache_t m_payloadCache;
+        std::vector<payload_cache_t> m_workerPayloadCaches;
+    };
+
+    extern template struct GenericShmListener<v1::ShmChannel>;
+    extern template struct GenericShmListener<v2::ShmChannel>;
+    extern template struct GenericShmListener<v3::ShmChannel>;
+}
+
+namespace dots::io::posix
+{
+    namespace v1
+    {
+        using ShmListener = details::GenericShmListener<v1::ShmChannel>;
+    }
+
+    inline namespace v2
+    {
+        using ShmListener = details::GenericShmListener<v2::ShmChannel>;
+    }
+
+    namespace v3
+    {
+        using ShmListener = details::GenericShmListener<v3::ShmChannel>;
+    }
+}
+
+#else
+#error "Shared memory channels are not available on this platform"
+#endif
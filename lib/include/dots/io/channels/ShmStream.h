@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace dots::io::posix
+{
+    /*!
+     * @class ShmStream ShmStream.h <dots/io/channels/ShmStream.h>
+     *
+     * @brief Asynchronous stream backed by ring buffers in shared memory.
+     *
+     * A ShmStream connects two processes on the same host via a pair of
+     * lock-free single-producer/single-consumer ring buffers in a shared
+     * memory segment (one for each direction). Reading and writing only
+     * copies data from and to the ring buffers and does not require any
+     * system calls as long as the peer keeps up.
+     *
+     * Each side additionally owns an eventfd that is signalled by the peer
+     * when the side is waiting for data (i.e. its read ring is empty) or
+     * space (i.e. its write ring is full). Wakeups are therefore only
+     * performed if a side would otherwise have to block.
+     *
+     * The shared memory segment and the eventfds are exchanged via a
+     * connected UNIX domain socket (i.e. a "handshake socket"), which is
+     * kept open for the lifetime of the stream to detect when the peer has
+     * closed the stream or has terminated.
+     *
+     * The peer is not trusted to maintain the positions of the ring buffers
+     * correctly. If the positions of either ring buffer are inconsistent
+     * (i.e. they differ by more than the capacity), the stream is closed and
+     * all subsequent operations fail with
+     * boost::system::errc::protocol_error.
+     *
+     * The stream meets the requirements for AsyncReadStream and
+     * AsyncWriteStream from the Asio library and is intended to be used with
+     * dots::io::AsyncStreamChannel (see dots::io::posix::ShmChannel).
+     *
+     * Note that only one read and one write operation can be outstanding at
+     * a time and that completion handlers are always invoked on the
+     * executor of the stream.
+     */
+    struct ShmStream
+    {
+        using executor_type = asio::posix::stream_descriptor::executor_type;
+
+        static constexpr size_t DefaultCapacity = 4 * 1024 * 1024;
+
+        /*!
+         * @brief Construct a new ShmStream object by creating a shared memory
+         * segment.
+         *
+         * This will create the shared memory segment and the eventfds and
+         * transmit them to the peer via the given handshake socket. This is
+         * intended to be used by the accepting side (i.e. a listener).
+         *
+         * @param socket The connected handshake socket.
+         *
+         * @param capacity The capacity of each ring buffer in bytes. Will be
+         * rounded up to the next power of two.
+         *
+         * @exception std::system_error Thrown if the shared memory segment
+         * or the eventfds could not be created or transmitted.
+         */
+        ShmStream(asio::local::stream_protocol::socket&& socket, size_t capacity);
+
+        /*!
+         * @brief Construct a new ShmStream object by receiving a shared
+         * memory segment.
+         *
+         * This will synchronously receive the shared memory segment and the
+         * eventfds that were created by the peer via the given handshake
+         * socket. This is intended to be used by the connecting side.
+         *
+         * @param socket The connected handshake socket.
+         *
+         * @exception std::system_error Thrown if the shared memory segment
+         * or the eventfds could not be received or mapped.
+         *
+         * @exception std::runtime_error Thrown if the peer did not transmit a
+         * valid handshake.
+         */
+        explicit ShmStream(asio::local::stream_protocol::socket&& socket);
+        ShmStream(const ShmStream& other) = delete;
+        ShmStream(ShmStream&& other) = default;
+        ~ShmStream() = default;
+
+        ShmStream& operator = (const ShmStream& rhs) = delete;
+        ShmStream& operator = (ShmStream&& rhs) = default;
+
+        /*!
+         * @brief Get the executor the completion handlers are invoked on.
+         *
+         * @return executor_type The executor of the stream.
+         */
+        executor_type get_executor();
+
+        /*!
+         * @brief Get the handshake socket of the stream.
+         *
+         * @return const asio::local::stream_protocol::socket& A reference to
+         * the socket.
+         */
+        const asio::local::stream_protocol::socket& socket() const;
+
+        /*!
+         * @brief Get the capacity of the ring buffers of the stream.
+         *
+         * @return size_t The capacity of each ring buffer in bytes.
+         */
+        size_t capacity() const;
+
+        /*!
+         * @brief Asynchronously read data from the stream.
+         *
+         * The operation completes as soon as at least one byte has been
+         * read or the peer has closed the stream (in which case
+         * asio::error::eof is reported after all remaining data has been
+         * read).
+         *
+         * @param buffers The buffers to read into.
+         *
+         * @param handler The handler to invoke with the error code and the
+         * amount of bytes read.
+         */
+        template <typename MutableBufferSequence, typename ReadHandler>
+        auto async_read_some(const MutableBufferSequence& buffers, ReadHandler&& handler)
+        {
+            return asio::async_initiate<ReadHandler, void(boost::system::error_code, size_t)>([this](auto&& handler_, const MutableBufferSequence& buffers_)
+            {
+                asyncReadSome({ asio::buffer_sequence_begin(buffers_), asio::buffer_sequence_end(buffers_) }, MakeHandler(std::forward<decltype(handler_)>(handler_)));
+            }, handler, buffers);
+        }
+
+        /*!
+         * @brief Asynchronously write data to the stream.
+         *
+         * The operation completes as soon as at least one byte has been
+         * written or the peer has closed the stream (in which case
+         * asio::error::broken_pipe is reported).
+         *
+         * @param buffers The buffers to write.
+         *
+         * @param handler The handler to invoke with the error code and the
+         * amount of bytes written.
+         */
+        template <typename ConstBufferSequence, typename WriteHandler>
+        auto async_write_some(const ConstBufferSequence& buffers, WriteHandler&& handler)
+        {
+            return asio::async_initiate<WriteHandler, void(boost::system::error_code, size_t)>([this](auto&& handler_, const ConstBufferSequence& buffers_)
+            {
+                asyncWriteSome({ asio::buffer_sequence_begin(buffers_), asio::buffer_sequence_end(buffers_) }, MakeHandler(std::forward<decltype(handler_)>(handler_)));
+            }, handler, buffers);
+        }
+
+    private:
+
+        struct handler_base
+        {
+            virtual ~handler_base() = default;
+            virtual void operator () (boost::system::error_code error, size_t numBytes) = 0;
+        };
+
+        template <typename Handler>
+        struct handler_impl : handler_base
+        {
+            handler_impl(Handler handler) : m_handler{ std::move(handler) } {}
+            void operator () (boost::system::error_code error, size_t numBytes) override { m_handler(error, numBytes); }
+            Handler m_handler;
+        };
+
+        using handler_t = std::unique_ptr<handler_base>;
+
+        struct state;
+
+        template <typename Handler>
+        static handler_t MakeHandler(Handler&& handler)
+        {
+            return std::make_unique<handler_impl<std::decay_t<Handler>>>(std::forward<Handler>(handler));
+        }
+
+        void asyncReadSome(std::vector<asio::mutable_buffer> buffers, handler_t handler);
+        void asyncWriteSome(std::vector<asio::const_buffer> buffers, handler_t handler);
+
+        std::shared_ptr<state> m_state;
+    };
+}
+
+#else
+#error "Shared memory streams are not available on this platform"
+#endif
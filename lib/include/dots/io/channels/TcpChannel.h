@@ -18,6 +18,7 @@ namespace dots::io::details
             {
                 case TransmissionFormat::v1: return "11234";
                 case TransmissionFormat::v2: return "11235";
+                case TransmissionFormat::v3: return "11236";
             }
         }();
 
@@ -77,6 +78,7 @@ namespace dots::io::details
 
     extern template struct GenericTcpChannel<serialization::CborSerializer, TransmissionFormat::v1>;
     extern template struct GenericTcpChannel<serialization::CborSerializer, TransmissionFormat::v2>;
+    extern template struct GenericTcpChannel<serialization::CborSerializer, TransmissionFormat::v3>;
 }
 
 namespace dots::io
@@ -90,4 +92,9 @@ namespace dots::io
     {
         using TcpChannel = details::GenericTcpChannel<serialization::CborSerializer, TransmissionFormat::v2>;
     }
+
+    namespace v3
+    {
+        using TcpChannel = details::GenericTcpChannel<serialization::CborSerializer, TransmissionFormat::v3>;
+    }
 }
@@ -2,6 +2,7 @@
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #pragma once
 #include <optional>
+#include <vector>
 #include <dots/asio.h>
 #include <dots/io/Listener.h>
 #include <dots/io/channels/TcpChannel.h>
@@ -34,12 +35,15 @@ namespace dots::io::details
         std::string m_address;
         std::string m_port;
         asio::ip::tcp::acceptor m_acceptor;
+        std::reference_wrapper<asio::io_context> m_ioContext;
         asio::ip::tcp::socket m_socket;
         payload_cache_t m_payloadCache;
+        std::vector<payload_cache_t> m_workerPayloadCaches;
     };
 
     extern template struct GenericTcpListener<v1::TcpChannel>;
     extern template struct GenericTcpListener<v2::TcpChannel>;
+    extern template struct GenericTcpListener<v3::TcpChannel>;
 }
 
 namespace dots::io
@@ -53,4 +57,9 @@ namespace dots::io
     {
         using TcpListener = details::GenericTcpListener<v2::TcpChannel>;
     }
+
+    namespace v3
+    {
+        using TcpListener = details::GenericTcpListener<v3::TcpChannel>;
+    }
 }
@@ -36,6 +36,7 @@ namespace dots::io::posix::details
 
     extern template struct GenericUdsChannel<serialization::CborSerializer, TransmissionFormat::v1>;
     extern template struct GenericUdsChannel<serialization::CborSerializer, TransmissionFormat::v2>;
+    extern template struct GenericUdsChannel<serialization::CborSerializer, TransmissionFormat::v3>;
 }
 
 namespace dots::io::posix
@@ -49,6 +50,11 @@ namespace dots::io::posix
     {
         using UdsChannel = details::GenericUdsChannel<serialization::CborSerializer, TransmissionFormat::v2>;
     }
+
+    namespace v3
+    {
+        using UdsChannel = details::GenericUdsChannel<serialization::CborSerializer, TransmissionFormat::v3>;
+    }
 }
 
 #else
@@ -5,6 +5,7 @@
 #if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
 #include <string_view>
 #include <optional>
+#include <vector>
 #include <dots/io/Listener.h>
 #include <dots/io/channels/UdsChannel.h>
 
@@ -33,12 +34,15 @@ namespace dots::io::posix::details
 
         asio::local::stream_protocol::endpoint m_endpoint;
         asio::local::stream_protocol::acceptor m_acceptor;
+        std::reference_wrapper<asio::io_context> m_ioContext;
         asio::local::stream_protocol::socket m_socket;
         payload_cache_t m_payloadCache;
+        std::vector<payload_cache_t> m_workerPayloadCaches;
     };
 
     extern template struct GenericUdsListener<v1::UdsChannel>;
     extern template struct GenericUdsListener<v2::UdsChannel>;
+    extern template struct GenericUdsListener<v3::UdsChannel>;
 }
 
 namespace dots::io::posix
@@ -52,6 +56,11 @@ namespace dots::io::posix
     {
         using UdsListener = details::GenericUdsListener<v2::UdsChannel>;
     }
+
+    namespace v3
+    {
+        using UdsListener = details::GenericUdsListener<v3::UdsChannel>;
+    }
 }
 
 #else
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <dots/io/channels/AsyncStreamChannel.h>
+#include <dots/io/channels/TcpChannel.h>
+#include <dots/io/channels/UringStream.h>
+
+namespace dots::io::posix::details
+{
+    template <typename Protocol, typename Serializer, TransmissionFormat TransmissionFormat>
+    struct GenericUringChannel : AsyncStreamChannel<UringStream, Serializer, TransmissionFormat>
+    {
+        using base_t = AsyncStreamChannel<UringStream, Serializer, TransmissionFormat>;
+        using key_t = typename base_t::key_t;
+        using payload_cache_t = typename base_t::payload_cache_t;
+        using protocol_t = Protocol;
+        using socket_t = typename Protocol::socket;
+
+        static constexpr std::string_view DefaultPort = io::details::GenericTcpChannel<Serializer, TransmissionFormat>::DefaultPort;
+
+        GenericUringChannel(key_t key, asio::io_context& ioContext, const Endpoint& endpoint);
+
+        /**
+         * Construct channel with an already connected socket.
+         * @param key
+         * @param socket
+         * @param payloadCache
+         */
+        GenericUringChannel(key_t key, socket_t&& socket, payload_cache_t* payloadCache);
+        GenericUringChannel(const GenericUringChannel& other) = delete;
+        GenericUringChannel(GenericUringChannel&& other) = delete;
+        ~GenericUringChannel() override = default;
+
+        GenericUringChannel& operator = (const GenericUringChannel& rhs) = delete;
+        GenericUringChannel& operator = (GenericUringChannel&& rhs) = delete;
+
+    private:
+
+        using base_t::initEndpoints;
+
+        GenericUringChannel(key_t key, Endpoint localEndpoint, Endpoint remoteEndpoint, socket_t&& socket, payload_cache_t* payloadCache);
+
+        static socket_t Connect(asio::io_context& ioContext, const Endpoint& endpoint);
+        static Endpoint LocalEndpoint(const socket_t& socket);
+        static Endpoint RemoteEndpoint(const socket_t& socket);
+    };
+
+    extern template struct GenericUringChannel<asio::ip::tcp, serialization::CborSerializer, TransmissionFormat::v1>;
+    extern template struct GenericUringChannel<asio::ip::tcp, serialization::CborSerializer, TransmissionFormat::v2>;
+    extern template struct GenericUringChannel<asio::ip::tcp, serialization::CborSerializer, TransmissionFormat::v3>;
+    extern template struct GenericUringChannel<asio::local::stream_protocol, serialization::CborSerializer, TransmissionFormat::v1>;
+    extern template struct GenericUringChannel<asio::local::stream_protocol, serialization::CborSerializer, TransmissionFormat::v2>;
+    extern template struct GenericUringChannel<asio::local::stream_protocol, serialization::CborSerializer, TransmissionFormat::v3>;
+}
+
+namespace dots::io::posix
+{
+    namespace v1
+    {
+        using UringTcpChannel = details::GenericUringChannel<asio::ip::tcp, serialization::CborSerializer, TransmissionFormat::v1>;
+        using UringUdsChannel = details::GenericUringChannel<asio::local::stream_protocol, serialization::CborSerializer, TransmissionFormat::v1>;
+    }
+
+    inline namespace v2
+    {
+        using UringTcpChannel = details::GenericUringChannel<asio::ip::tcp, serialization::CborSerializer, TransmissionFormat::v2>;
+        using UringUdsChannel = details::GenericUringChannel<asio::local::stream_protocol, serialization::CborSerializer, TransmissionFormat::v2>;
+    }
+
+    namespace v3
+    {
+        using UringTcpChannel = details::GenericUringChannel<asio::ip::tcp, serialization::CborSerializer, TransmissionFormat::v3>;
+        using UringUdsChannel = details::GenericUringChannel<asio::local::stream_protocol, serialization::CborSerializer, TransmissionFormat::v3>;
+    }
+}
+
+#else
+#error "io_uring channels are not available on this platform"
+#endif
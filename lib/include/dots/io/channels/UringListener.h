@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <optional>
+#include <string>
+#include <vector>
+#include <dots/io/Listener.h>
+#include <dots/io/channels/UringChannel.h>
+
+namespace dots::io::posix::details
+{
+    template <typename TChannel>
+    struct GenericUringListener : Listener
+    {
+        static constexpr std::string_view DefaultPort = TChannel::DefaultPort;
+
+        GenericUringListener(asio::io_context& ioContext, const Endpoint& endpoint, std::optional<int> backlog = std::nullopt);
+        GenericUringListener(const GenericUringListener& other) = delete;
+        GenericUringListener(GenericUringListener&& other) = delete;
+        ~GenericUringListener() override;
+
+        GenericUringListener& operator = (const GenericUringListener& rhs) = delete;
+        GenericUringListener& operator = (GenericUringListener&& rhs) = delete;
+
+    protected:
+
+        void asyncAcceptImpl() override;
+
+    private:
+
+        using protocol_t = typename TChannel::protocol_t;
+        using socket_t = typename TChannel::socket_t;
+        using endpoint_t = typename protocol_t::endpoint;
+        using acceptor_t = typename protocol_t::acceptor;
+        using buffer_t = typename TChannel::buffer_t;
+        using payload_cache_t = typename TChannel::payload_cache_t;
+
+        static endpoint_t ResolveEndpoint(asio::io_context& ioContext, const Endpoint& endpoint);
+        static acceptor_t Listen(asio::io_context& ioContext, const endpoint_t& endpoint, std::optional<int> backlog);
+        static std::string Description(const endpoint_t& endpoint);
+
+        endpoint_t m_endpoint;
+        UringAcceptor m_acceptor;
+        std::reference_wrapper<asio::io_context> m_ioContext;
+        payload_cache_t m_payloadCache;
+        std::vector<payload_cache_t> m_workerPayloadCaches;
+    };
+
+    extern template struct GenericUringListener<v1::UringTcpChannel>;
+    extern template struct GenericUringListener<v2::UringTcpChannel>;
+    extern template struct GenericUringListener<v3::UringTcpChannel>;
+    extern template struct GenericUringListener<v1::UringUdsChannel>;
+    extern template struct GenericUringListener<v2::UringUdsChannel>;
+    extern template struct GenericUringListener<v3::UringUdsChannel>;
+}
+
+namespace dots::io::posix
+{
+    namespace v1
+    {
+        using UringTcpListener = details::GenericUringListener<v1::UringTcpChannel>;
+        using UringUdsListener = details::GenericUringListener<v1::UringUdsChannel>;
+    }
+
+    inline namespace v2
+    {
+        using UringTcpListener = details::GenericUringListener<v2::UringTcpChannel>;
+        using UringUdsListener = details::GenericUringListener<v2::UringUdsChannel>;
+    }
+
+    namespace v3
+    {
+        using UringTcpListener = details::GenericUringListener<v3::UringTcpChannel>;
+        using UringUdsListener = details::GenericUringListener<v3::UringUdsChannel>;
+    }
+}
+
+#else
+#error "io_uring channels are not available on this platform"
+#endif
@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace dots::io::posix
+{
+    /*!
+     * @class UringStream UringStream.h <dots/io/channels/UringStream.h>
+     *
+     * @brief Asynchronous stream that performs socket IO via io_uring.
+     *
+     * A UringStream operates a connected stream socket (e.g. TCP or UNIX
+     * domain) via an io_uring instance that is shared by all streams and
+     * acceptors of the same IO context.
+     *
+     * Operations are not submitted individually. Instead, all submission
+     * queue entries that are prepared while the IO context processes a
+     * batch of handlers are submitted by a single system call. Completions
+     * are signalled via an eventfd that is registered with the io_uring
+     * instance and observed by the IO context, so the stream can be used
+     * alongside other Asio objects.
+     *
+     * Data is received by a multishot receive operation, which remains
+     * armed for as long as the stream is open. The kernel places received
+     * data into buffers from a buffer ring that is registered once per IO
+     * context, from which it is copied into the buffers of the read
+     * operation. Data that is received while no read operation is
+     * outstanding is retained up to a small limit per stream, after which
+     * receiving is suspended until the data has been read.
+     *
+     * The stream meets the requirements for AsyncReadStream and
+     * AsyncWriteStream from the Asio library and is intended to be used with
+     * dots::io::AsyncStreamChannel (see dots::io::posix::UringTcpChannel and
+     * dots::io::posix::UringUdsChannel).
+     *
+     * Note that using a UringStream requires Linux 6.0 or later. Also note
+     * that only one read and one write operation can be outstanding at a
+     * time, that completion handlers are always invoked on the executor of
+     * the stream and that the IO context must not be run by more than one
+     * thread.
+     */
+    struct UringStream
+    {
+        using executor_type = asio::io_context::executor_type;
+        using native_handle_type = int;
+
+        /*!
+         * @brief Construct a new UringStream object from a native socket.
+         *
+         * @param ioContext The IO context to operate the stream on.
+         *
+         * @param socket The native handle of the connected socket. The
+         * stream takes ownership of the handle and closes it once all
+         * outstanding operations have completed after the stream has been
+         * destroyed.
+         *
+         * @exception std::system_error Thrown if the io_uring instance of the
+         * IO context could not be created.
+         */
+        UringStream(asio::io_context& ioContext, native_handle_type socket);
+
+        /*!
+         * @brief Construct a new UringStream object from an Asio socket.
+         *
+         * The native handle is released from the given socket, which must
+         * not have any outstanding operations.
+         *
+         * @param socket The connected socket.
+         *
+         * @exception std::system_error Thrown if the io_uring instance of the
+         * IO context could not be created.
+         */
+        template <typename Protocol, typename Executor>
+        explicit UringStream(asio::basic_stream_socket<Protocol, Executor>&& socket) :
+            UringStream(static_cast<asio::io_context&>(socket.get_executor().context()), socket.release())
+        {
+            /* do nothing */
+        }
+
+        UringStream(const UringStream& other) = delete;
+        UringStream(UringStream&& other) = default;
+        ~UringStream();
+
+        UringStream& operator = (const UringStream& rhs) = delete;
+        UringStream& operator = (UringStream&& rhs) noexcept;
+
+        /*!
+         * @brief Get the executor the completion handlers are invoked on.
+         *
+         * @return executor_type The executor of the stream.
+         */
+        executor_type get_executor();
+
+        /*!
+         * @brief Get the native handle of the socket of the stream.
+         *
+         * @return native_handle_type The native handle.
+         */
+        native_handle_type native_handle() const;
+
+        /*!
+         * @brief Asynchronously read data from the stream.
+         *
+         * The operation completes as soon as at least one byte has been
+         * read or the peer has closed the stream (in which case
+         * asio::error::eof is reported after all remaining data has been
+         * read).
+         *
+         * @param buffers The buffers to read into.
+         *
+         * @param handler The handler to invoke with the error code and the
+         * amount of bytes read.
+         */
+        template <typename MutableBufferSequence, typename ReadHandler>
+        auto async_read_some(const MutableBufferSequence& buffers, ReadHandler&& handler)
+        {
+            return asio::async_initiate<ReadHandler, void(boost::system::error_code, size_t)>([this](auto&& handler_, const MutableBufferSequence& buffers_)
+            {
+                asyncReadSome({ asio::buffer_sequence_begin(buffers_), asio::buffer_sequence_end(buffers_) }, MakeHandler(std::forward<decltype(handler_)>(handler_)));
+            }, handler, buffers);
+        }
+
+        /*!
+         * @brief Asynchronously write data to the stream.
+         *
+         * The operation completes as soon as at least one byte has been
+         * written. The given buffers must remain valid until the handler
+         * has been invoked.
+         *
+         * @param buffers The buffers to write.
+         *
+         * @param handler The handler to invoke with the error code and the
+         * amount of bytes written.
+         */
+        template <typename ConstBufferSequence, typename WriteHandler>
+        auto async_write_some(const ConstBufferSequence& buffers, WriteHandler&& handler)
+        {
+            return asio::async_initiate<WriteHandler, void(boost::system::error_code, size_t)>([this](auto&& handler_, const ConstBufferSequence& buffers_)
+            {
+                asyncWriteSome({ asio::buffer_sequence_begin(buffers_), asio::buffer_sequence_end(buffers_) }, MakeHandler(std::forward<decltype(handler_)>(handler_)));
+            }, handler, buffers);
+        }
+
+    private:
+
+        struct handler_base
+        {
+            virtual ~handler_base() = default;
+            virtual void operator () (boost::system::error_code error, size_t numBytes) = 0;
+        };
+
+        template <typename Handler>
+        struct handler_impl : handler_base
+        {
+            handler_impl(Handler handler) : m_handler{ std::move(handler) } {}
+            void operator () (boost::system::error_code error, size_t numBytes) override { m_handler(error, numBytes); }
+            Handler m_handler;
+        };
+
+        using handler_t = std::unique_ptr<handler_base>;
+
+        struct state;
+
+        template <typename Handler>
+        static handler_t MakeHandler(Handler&& handler)
+        {
+            return std::make_unique<handler_impl<std::decay_t<Handler>>>(std::forward<Handler>(handler));
+        }
+
+        void asyncReadSome(std::vector<asio::mutable_buffer> buffers, handler_t handler);
+        void asyncWriteSome(std::vector<asio::const_buffer> buffers, handler_t handler);
+
+        std::shared_ptr<state> m_state;
+    };
+
+    /*!
+     * @class UringAcceptor UringStream.h <dots/io/channels/UringStream.h>
+     *
+     * @brief Asynchronous acceptor that accepts connections via io_uring.
+     *
+     * A UringAcceptor accepts connections on a listening socket by a
+     * multishot accept operation, which remains armed for as long as
+     * connections are requested. Connections that are accepted while no
+     * accept operation is outstanding are retained up to a small limit and
+     * handed out by subsequent accept operations.
+     *
+     * Note that the same requirements as for dots::io::posix::UringStream
+     * apply.
+     */
+    struct UringAcceptor
+    {
+        using executor_type = asio::io_context::executor_type;
+        using native_handle_type = int;
+        using accept_handler_t = std::function<void(const boost::system::error_code& error, native_handle_type socket)>;
+
+        /*!
+         * @brief Construct a new UringAcceptor object from a native socket.
+         *
+         * @param ioContext The IO context to operate the acceptor on.
+         *
+         * @param socket The native handle of the listening socket. The
+         * acceptor takes ownership of the handle.
+         *
+         * @exception std::system_error Thrown if the io_uring instance of the
+         * IO context could not be created.
+         */
+        UringAcceptor(asio::io_context& ioContext, native_handle_type socket);
+
+        /*!
+         * @brief Construct a new UringAcceptor object from an Asio acceptor.
+         *
+         * The native handle is released from the given acceptor, which must
+         * already be listening and must not have any outstanding operations.
+         *
+         * @param acceptor The listening acceptor.
+         *
+         * @exception std::system_error Thrown if the io_uring instance of the
+         * IO context could not be created.
+         */
+        template <typename Protocol, typename Executor>
+        explicit UringAcceptor(asio::basic_socket_acceptor<Protocol, Executor>&& acceptor) :
+            UringAcceptor(static_cast<asio::io_context&>(acceptor.get_executor().context()), acceptor.release())
+        {
+            /* do nothing */
+        }
+
+        UringAcceptor(const UringAcceptor& other) = delete;
+        UringAcceptor(UringAcceptor&& other) = default;
+        ~UringAcceptor();
+
+        UringAcceptor& operator = (const UringAcceptor& rhs) = delete;
+        UringAcceptor& operator = (UringAcceptor&& rhs) noexcept;
+
+        /*!
+         * @brief Get the executor the completion handlers are invoked on.
+         *
+         * @return executor_type The executor of the acceptor.
+         */
+        executor_type get_executor();
+
+        /*!
+         * @brief Asynchronously accept a connection.
+         *
+         * @param handler The handler to invoke with the error code and the
+         * native handle of the accepted socket. The handler takes ownership
+         * of the socket.
+         */
+        void async_accept(accept_handler_t handler);
+
+    private:
+
+        struct state;
+
+        std::shared_ptr<state> m_state;
+    };
+}
+
+#else
+#error "io_uring streams are not available on this platform"
+#endif
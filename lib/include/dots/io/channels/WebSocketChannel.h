@@ -1,17 +1,38 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #pragma once
+#include <deque>
+#include <string>
 #include <string_view>
 #include <dots/asio.h>
 #include <boost/beast.hpp>
 #include <dots/io/Channel.h>
+#include <dots/io/channels/AsyncStreamChannel.h>
+#include <dots/io/channels/WebSocketStream.h>
 #include <dots/serialization/JsonSerializer.h>
 
 namespace dots::io
 {
+    /*!
+     * @class WebSocketChannel WebSocketChannel.h
+     * <dots/io/channels/WebSocketChannel.h>
+     *
+     * @brief Channel for WebSocket connections using the 'dots-json'
+     * subprotocol.
+     *
+     * Each transmission is sent as a single text message that contains a
+     * JSON array of the header and the instance. This is intended to be
+     * used by browser-based clients.
+     *
+     * Messages are written asynchronously. If the channel is already
+     * writing a message, subsequent messages remain in a write queue and
+     * are written when the previous write has completed. The write queue is
+     * limited according to the policy given in
+     * dots::io::Channel::setWriteQueueLimit().
+     */
     struct WebSocketChannel : Channel
     {
-        using ws_stream_t = boost::beast::websocket::stream<boost::beast::tcp_stream>;
+        using ws_stream_t = WebSocketStream::ws_stream_t;
         static constexpr char Subprotocol[] = "dots-json";
 
         WebSocketChannel(key_t key, asio::io_context& ioContext, const Endpoint& endpoint);
@@ -24,6 +45,27 @@ namespace dots::io
         WebSocketChannel& operator = (const WebSocketChannel& rhs) = delete;
         WebSocketChannel& operator = (WebSocketChannel&& rhs) = delete;
 
+        /*!
+         * @brief Connect to a WebSocket server.
+         *
+         * This will synchronously connect to the given server and perform
+         * the WebSocket handshake, requesting the given subprotocol.
+         *
+         * @param ioContext The ASIO IO context to use.
+         *
+         * @param host The host of the server.
+         *
+         * @param port The port of the server.
+         *
+         * @param subprotocol The subprotocol to request.
+         *
+         * @return ws_stream_t The connected WebSocket stream.
+         *
+         * @exception std::runtime_error Thrown if the connection could not
+         * be established or the server did not accept the subprotocol.
+         */
+        static ws_stream_t Connect(asio::io_context& ioContext, std::string_view host, std::string_view port, std::string_view subprotocol);
+
     protected:
 
         void asyncReceiveImpl() override;
@@ -31,8 +73,58 @@ namespace dots::io
 
     private:
 
+        struct queued_message_t
+        {
+            static constexpr uint32_t transmissions = 1;
+
+            std::string data;
+            bool droppable;
+
+            size_t size() const
+            {
+                return data.size();
+            }
+        };
+
+        void asyncWrite();
+        void limitWriteQueue(size_t size);
+        void updateWriteQueueState();
+
         ws_stream_t m_stream;
         boost::beast::flat_buffer m_buffer;
         serialization::JsonSerializer m_serializer;
+        std::deque<queued_message_t> m_writeQueue;
+        size_t m_writeQueueSize;
+        bool m_asyncWriting;
+    };
+
+    /*!
+     * @class WebSocketCborChannel WebSocketChannel.h
+     * <dots/io/channels/WebSocketChannel.h>
+     *
+     * @brief Channel for WebSocket connections using the 'dots-cbor'
+     * subprotocol.
+     *
+     * The channel transmits the same CBOR frames as a v2 TCP channel via
+     * binary messages (see dots::io::WebSocketStream). Transmissions that
+     * are queued while a write is in progress are combined into a single
+     * message. This is intended to be used by programmatic clients that
+     * need to use WebSockets, but do not want to pay the cost of encoding
+     * JSON.
+     */
+    struct WebSocketCborChannel : AsyncStreamChannel<WebSocketStream, serialization::CborSerializer, TransmissionFormat::v2>
+    {
+        using base_t = AsyncStreamChannel<WebSocketStream, serialization::CborSerializer, TransmissionFormat::v2>;
+        using ws_stream_t = WebSocketStream::ws_stream_t;
+        static constexpr char Subprotocol[] = "dots-cbor";
+
+        WebSocketCborChannel(key_t key, asio::io_context& ioContext, const Endpoint& endpoint);
+        WebSocketCborChannel(key_t key, ws_stream_t&& stream, payload_cache_t* payloadCache);
+        WebSocketCborChannel(const WebSocketCborChannel& other) = delete;
+        WebSocketCborChannel(WebSocketCborChannel&& other) = delete;
+        ~WebSocketCborChannel() override = default;
+
+        WebSocketCborChannel& operator = (const WebSocketCborChannel& rhs) = delete;
+        WebSocketCborChannel& operator = (WebSocketCborChannel&& rhs) = delete;
     };
 }
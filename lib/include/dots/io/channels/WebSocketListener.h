@@ -1,12 +1,29 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #pragma once
+#include <optional>
 #include <dots/asio.h>
 #include <boost/beast.hpp>
 #include <dots/io/Listener.h>
+#include <dots/io/channels/WebSocketChannel.h>
 
 namespace dots::io
 {
+    /*!
+     * @class WebSocketListener WebSocketListener.h
+     * <dots/io/channels/WebSocketListener.h>
+     *
+     * @brief Listener for WebSocket connections.
+     *
+     * The subprotocol of an accepted connection is negotiated during the
+     * WebSocket handshake. Clients that request the 'dots-cbor' subprotocol
+     * are operated by a dots::io::WebSocketCborChannel, while all other
+     * clients are operated by a dots::io::WebSocketChannel using the
+     * 'dots-json' subprotocol.
+     *
+     * The handshake is performed asynchronously, so that slow clients do
+     * not block the IO context.
+     */
     struct WebSocketListener : Listener
     {
         WebSocketListener(asio::io_context& ioContext, const Endpoint& endpoint, std::optional<int> backlog = std::nullopt);
@@ -24,9 +41,15 @@ namespace dots::io
 
     private:
 
+        void asyncHandshake();
+        void closeSocket();
+
         std::string m_address;
         std::string m_port;
         asio::ip::tcp::acceptor m_acceptor;
         asio::ip::tcp::socket m_socket;
+        std::optional<WebSocketChannel::ws_stream_t> m_stream;
+        boost::beast::flat_buffer m_buffer;
+        boost::beast::http::request<boost::beast::http::string_body> m_request;
     };
 }
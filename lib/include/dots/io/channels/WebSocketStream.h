@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <utility>
+#include <dots/asio.h>
+#include <boost/beast.hpp>
+
+namespace dots::io
+{
+    /*!
+     * @class WebSocketStream WebSocketStream.h
+     * <dots/io/channels/WebSocketStream.h>
+     *
+     * @brief Asynchronous byte stream on top of a binary WebSocket
+     * connection.
+     *
+     * A WebSocketStream adapts an established WebSocket stream to the
+     * requirements for AsyncReadStream and AsyncWriteStream from the Asio
+     * library, so that it can be used with dots::io::AsyncStreamChannel (see
+     * dots::io::WebSocketCborChannel).
+     *
+     * Every write operation is sent as a single binary message, while read
+     * operations treat the data of consecutive messages as a contiguous
+     * stream. Message boundaries therefore carry no meaning and a single
+     * message can contain multiple transmissions.
+     *
+     * Note that only one read and one write operation can be outstanding at
+     * a time.
+     */
+    struct WebSocketStream
+    {
+        using ws_stream_t = boost::beast::websocket::stream<boost::beast::tcp_stream>;
+        using executor_type = ws_stream_t::executor_type;
+
+        /*!
+         * @brief Construct a new WebSocketStream object.
+         *
+         * @param stream The WebSocket stream to operate on. The handshake
+         * must already have been performed.
+         */
+        explicit WebSocketStream(ws_stream_t&& stream) :
+            m_stream{ std::move(stream) }
+        {
+            m_stream.binary(true);
+        }
+
+        WebSocketStream(const WebSocketStream& other) = delete;
+        WebSocketStream(WebSocketStream&& other) = default;
+        ~WebSocketStream() = default;
+
+        WebSocketStream& operator = (const WebSocketStream& rhs) = delete;
+        WebSocketStream& operator = (WebSocketStream&& rhs) = default;
+
+        /*!
+         * @brief Get the executor the completion handlers are invoked on.
+         *
+         * @return executor_type The executor of the stream.
+         */
+        executor_type get_executor()
+        {
+            return m_stream.get_executor();
+        }
+
+        /*!
+         * @brief Get the underlying WebSocket stream.
+         *
+         * @return ws_stream_t& A reference to the underlying WebSocket
+         * stream.
+         */
+        ws_stream_t& ws()
+        {
+            return m_stream;
+        }
+
+        /*!
+         * @brief Asynchronously read data from the stream.
+         *
+         * The operation completes as soon as some data of the current
+         * message has been read.
+         *
+         * @param buffers The buffers to read into.
+         *
+         * @param handler The handler to invoke with the error code and the
+         * amount of bytes read.
+         */
+        template <typename MutableBufferSequence, typename ReadHandler>
+        auto async_read_some(const MutableBufferSequence& buffers, ReadHandler&& handler)
+        {
+            return m_stream.async_read_some(buffers, std::forward<ReadHandler>(handler));
+        }
+
+        /*!
+         * @brief Asynchronously write data to the stream.
+         *
+         * The given buffers are written as a single binary message. The
+         * operation therefore only completes when all data has been written.
+         *
+         * @param buffers The buffers to write.
+         *
+         * @param handler The handler to invoke with the error code and the
+         * amount of bytes written.
+         */
+        template <typename ConstBufferSequence, typename WriteHandler>
+        auto async_write_some(const ConstBufferSequence& buffers, WriteHandler&& handler)
+        {
+            return m_stream.async_write(buffers, std::forward<WriteHandler>(handler));
+        }
+
+    private:
+
+        ws_stream_t m_stream;
+    };
+}
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <deque>
+#include <vector>
+#include <dots/asio.h>
+#include <dots/io/Channel.h>
+
+namespace dots::io
+{
+    /*!
+     * @class WorkerChannel WorkerChannel.h
+     * <dots/io/channels/WorkerChannel.h>
+     *
+     * @brief Channel adapter that operates another channel on a worker
+     * thread.
+     *
+     * A WorkerChannel wraps a channel whose IO objects are associated with
+     * the IO context of a worker thread (see dots::io::WorkerPool). All
+     * operations on the wrapped channel, including the (de)serialization of
+     * transmissions, are performed on the worker thread, while the handlers
+     * of the WorkerChannel itself are invoked on the owning IO context.
+     *
+     * Received transmissions are handed over to the owning IO context in
+     * the order in which they were received. Transmissions to transmit are
+     * handed over to the worker by sharing the underlying transmission data
+     * (see io::Transmission::share()), which allows a transmission to be
+     * serialized only once per worker when a payload cache is used by the
+     * wrapped channel.
+     *
+     * Note that the wrapped channel will continuously receive transmissions
+     * while the WorkerChannel is receiving and will be destroyed on the
+     * worker thread when the WorkerChannel is destroyed. Transmissions that
+     * are received while the WorkerChannel is not receiving (e.g. while
+     * receiving is paused) are buffered and the wrapped channel is paused
+     * until the buffer has been processed.
+     */
+    struct WorkerChannel : Channel
+    {
+        /*!
+         * @brief Construct a new WorkerChannel object.
+         *
+         * @param key The key to construct the channel. This will automatically
+         * be provided by the dots::io::make_channel() helper function.
+         *
+         * @param ioContext The owning IO context to invoke the handlers of the
+         * channel on.
+         *
+         * @param workerContext The IO context of the worker thread the wrapped
+         * channel is associated with.
+         *
+         * @param channel The channel to wrap. The channel must not have been
+         * initialized and must not be accessed by the caller afterwards.
+         */
+        WorkerChannel(key_t key, asio::io_context& ioContext, asio::io_context& workerContext, channel_ptr_t channel);
+        WorkerChannel(const WorkerChannel& other) = delete;
+        WorkerChannel(WorkerChannel&& other) = delete;
+        ~WorkerChannel() override;
+
+        WorkerChannel& operator = (const WorkerChannel& rhs) = delete;
+        WorkerChannel& operator = (WorkerChannel&& rhs) = delete;
+
+    protected:
+
+        void asyncReceiveImpl() override;
+        void transmitImpl(const DotsHeader& header, const type::Struct& instance) override;
+        void transmitImpl(const Transmission& transmission) override;
+        void transmitImpl(const std::vector<Transmission>& transmissions) override;
+
+    private:
+
+        void transmitOnWorker(Transmission transmission);
+        void transmitOnWorker(std::vector<Transmission> transmissions);
+        void handleWorkerReceive(Transmission transmission);
+        void processReceivedTransmission();
+        void handleWorkerError(std::exception_ptr ePtr);
+
+        std::reference_wrapper<asio::io_context> m_ioContext;
+        std::reference_wrapper<asio::io_context> m_workerContext;
+        channel_ptr_t m_channel;
+        std::deque<Transmission> m_receivedTransmissions;
+        std::exception_ptr m_workerError;
+        bool m_workerReceiving;
+        bool m_workerPaused;
+        bool m_asyncReceiving;
+    };
+}
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#pragma once
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace dots::tools
+{
+    /*!
+     * @class MpscQueue MpscQueue.h <dots/tools/MpscQueue.h>
+     *
+     * @brief Unbounded lock-free queue for multiple producers and a single
+     * consumer.
+     *
+     * The queue is implemented as an intrusive singly linked list with a
+     * stub node (also known as "Vyukov queue"). Pushing an element is
+     * wait-free and requires a single atomic exchange, so that any amount
+     * of threads can push elements concurrently. Popping an element must
+     * only be performed by a single thread at a time.
+     *
+     * Note that an element that is pushed by one producer is only visible
+     * to the consumer after all elements that were pushed before have been
+     * linked. If a producer is preempted while pushing, MpscQueue::tryPop()
+     * might therefore temporarily return std::nullopt even though the queue
+     * is not empty.
+     *
+     * @tparam T The type of the elements.
+     */
+    template <typename T>
+    struct MpscQueue
+    {
+        MpscQueue() :
+            m_head{ &m_stub },
+            m_tail{ &m_stub }
+        {
+            /* do nothing */
+        }
+
+        MpscQueue(const MpscQueue& other) = delete;
+        MpscQueue(MpscQueue&& other) = delete;
+
+        ~MpscQueue()
+        {
+            while (tryPop() != std::nullopt)
+            {
+                /* do nothing */
+            }
+
+            if (m_tail != &m_stub)
+            {
+                delete m_tail;
+            }
+        }
+
+        MpscQueue& operator = (const MpscQueue& rhs) = delete;
+        MpscQueue& operator = (MpscQueue&& rhs) = delete;
+
+        /*!
+         * @brief Push an element to the back of the queue.
+         *
+         * This function can be called from any thread.
+         *
+         * @param value The element to push.
+         */
+        void push(T value)
+        {
+            node* n = new node{ std::move(value) };
+            node* previous = m_head.exchange(n, std::memory_order_acq_rel);
+            previous->next.store(n, std::memory_order_release);
+        }
+
+        /*!
+         * @brief Pop an element from the front of the queue.
+         *
+         * This function must only be called by the consumer.
+         *
+         * @return std::optional<T> The popped element or std::nullopt if no
+         * element is available.
+         */
+        std::optional<T> tryPop()
+        {
+            node* tail = m_tail;
+            node* next = tail->next.load(std::memory_order_acquire);
+
+            if (next == nullptr)
+            {
+                return std::nullopt;
+            }
+
+            // note: the popped node remains in the list as the new stub node
+            // until the next element has been popped
+            std::optional<T> value = std::move(next->value);
+            next->value.reset();
+            m_tail = next;
+
+            if (tail != &m_stub)
+            {
+                delete tail;
+            }
+
+            return value;
+        }
+
+    private:
+
+        struct node
+        {
+            node() = default;
+
+            node(T value) :
+                value{ std::move(value) }
+            {
+                /* do nothing */
+            }
+
+            std::optional<T> value;
+            std::atomic<node*> next = nullptr;
+        };
+
+        node m_stub;
+        std::atomic<node*> m_head;
+        node* m_tail;
+    };
+}
@@ -1,9 +1,12 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #pragma once
+#include <atomic>
 #include <memory>
 #include <optional>
+#include <shared_mutex>
 #include <type_traits>
+#include <vector>
 #include <dots/type/DescriptorMap.h>
 #include <dots/type/FundamentalTypes.h>
 #include <dots/type/EnumDescriptor.h>
@@ -24,10 +27,21 @@ namespace dots::type
         };
 
         Registry(std::optional<new_type_handler_t> newTypeHandler = std::nullopt, StaticTypePolicy staticTypePolicy = StaticTypePolicy::All);
+        Registry(const Registry& other) = delete;
+        Registry(Registry&& other) = default;
+        ~Registry();
+
+        Registry& operator = (const Registry& rhs) = delete;
+        Registry& operator = (Registry&& rhs);
 
         /*!
          * @brief Get a constant iterator to the beginning of the Registry.
          *
+         * Note that in contrast to the lookup and registration functions,
+         * iterating the Registry is not synchronized and must not be done
+         * while types are concurrently registered from other threads (see
+         * Registry::forEach() for a synchronized alternative).
+         *
          * @return const_iterator_t A constant iterator to the beginning of the
          * Registry.
          */
@@ -65,9 +79,8 @@ namespace dots::type
 
             if constexpr (IsTypeHandler)
             {
-                for (const auto& [name, descriptor] : m_types)
+                for (const std::shared_ptr<Descriptor<>>& descriptor : snapshot())
                 {
-                    (void)name;
                     handler(*descriptor);
                 }
             }
@@ -128,6 +141,21 @@ namespace dots::type
         EnumDescriptor* findEnumType(std::string_view name, bool assertNotNull = false);
         StructDescriptor* findStructType(std::string_view name, bool assertNotNull = false);
 
+        /*!
+         * @brief Find a registered struct type by its interned type id.
+         *
+         * In contrast to the lookup by name, this is a constant time lookup
+         * in a flat array (see StructDescriptor::typeId()).
+         *
+         * @param typeId The type id of the struct type.
+         *
+         * @return const StructDescriptor* A pointer to the descriptor of the
+         * struct type or nullptr if no struct type with the given id is
+         * registered.
+         */
+        const StructDescriptor* findStructType(StructDescriptor::type_id_t typeId) const;
+        StructDescriptor* findStructType(StructDescriptor::type_id_t typeId);
+
         const Descriptor<>& getType(std::string_view name) const;
         const EnumDescriptor& getEnumType(std::string_view name) const;
         const StructDescriptor& getStructType(std::string_view name) const;
@@ -139,6 +167,20 @@ namespace dots::type
         bool hasType(std::string_view name) const;
         size_t size() const;
 
+        /*!
+         * @brief Get the total amount of types that have been deregistered.
+         *
+         * This can be used to detect that descriptors which were looked up
+         * previously might no longer be registered (e.g. to invalidate a
+         * cache of descriptors).
+         *
+         * Note that in contrast to the lookup functions, this does not
+         * acquire a lock.
+         *
+         * @return uint64_t The amount of deregistered types.
+         */
+        uint64_t deregistrations() const;
+
         Descriptor<>& registerType(Descriptor<>& descriptor, bool assertNewType = true);
         Descriptor<>& registerType(std::shared_ptr<Descriptor<>> descriptor, bool assertNewType = true);
 
@@ -153,9 +195,19 @@ namespace dots::type
 
     private:
 
+        std::vector<std::shared_ptr<Descriptor<>>> snapshot() const;
+        Descriptor<>& registerTypeUnsynchronized(Descriptor<>& descriptor, bool assertNewType, std::vector<Descriptor<>*>& newTypes);
+
+        void indexType(Descriptor<>& descriptor);
+        void deindexType(std::string_view name);
+        void deindexTypes();
+
         static bool IsUserType(const Descriptor<>& descriptor);
 
         std::optional<new_type_handler_t> m_newTypeHandler;
+        std::unique_ptr<std::shared_mutex> m_mutex;
+        std::unique_ptr<std::atomic<uint64_t>> m_deregistrations;
         DescriptorMap m_types;
+        std::vector<StructDescriptor*> m_structTypes;
     };
 }
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #pragma once
+#include <atomic>
+#include <limits>
 #include <dots/type/Descriptor.h>
 #include <dots/type/StaticDescriptor.h>
 #include <dots/type/Property.h>
@@ -12,6 +14,8 @@ namespace dots::type
 
     struct StructDescriptor : StaticDescriptor
     {
+        using type_id_t = uint32_t;
+
         static const uint8_t Uncached      = 0b0000'0000;
         static const uint8_t Cached        = 0b0000'0001;
         static const uint8_t Internal      = 0b0000'0010;
@@ -23,7 +27,7 @@ namespace dots::type
         StructDescriptor(key_t key, std::string name, uint8_t flags, const property_descriptor_container_t& propertyDescriptors, size_t areaOffset, size_t size, size_t alignment);
         StructDescriptor(const StructDescriptor& other) = delete;
         StructDescriptor(StructDescriptor&& other) = delete;
-        ~StructDescriptor() override = default;
+        ~StructDescriptor() override;
 
         StructDescriptor& operator = (const StructDescriptor& rhs) = delete;
         StructDescriptor& operator = (StructDescriptor&& rhs) = delete;
@@ -99,6 +103,31 @@ namespace dots::type
         virtual const PropertyArea& propertyArea(const Struct& instance) const = 0;
         virtual PropertyArea& propertyArea(Struct& instance) const = 0;
 
+        /*!
+         * @brief Get the interned type id of the struct type.
+         *
+         * Type ids are assigned when the type is registered (see
+         * Registry::registerType()) or used for the first time and are
+         * densely allocated from the ids that are currently not in use.
+         * They can therefore be used to index flat arrays.
+         *
+         * The id of a static type is retained for the lifetime of the
+         * process, while the id of a dynamic type is released when the type
+         * is deregistered from the last registry or destroyed and might then
+         * be reused for another type.
+         *
+         * @return type_id_t The type id of the struct type.
+         */
+        type_id_t typeId() const
+        {
+            if (type_id_t typeId = m_typeId.load(std::memory_order_acquire); typeId != NoTypeId)
+            {
+                return typeId;
+            }
+
+            return acquireTypeId(false);
+        }
+
         uint8_t flags() const
         {
             return m_flags;
@@ -250,6 +279,19 @@ namespace dots::type
 
     private:
 
+        friend struct Registry;
+
+        static constexpr type_id_t NoTypeId = std::numeric_limits<type_id_t>::max();
+
+        type_id_t acquireTypeId(bool registration) const;
+        void releaseTypeId() const;
+
+        // note: type ids are allocated from a single pool rather than per
+        // registry, because static descriptors are shared between all
+        // registries and must have the same id in each of them
+        mutable std::atomic<type_id_t> m_typeId;
+        mutable uint32_t m_numRegistrations;
+        mutable bool m_pinnedTypeId;
         uint8_t m_flags;
         property_descriptor_container_t m_propertyDescriptors;
         size_t m_areaOffset;
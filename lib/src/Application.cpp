@@ -16,6 +16,9 @@ namespace dots
     };
 
     Application::Application(const std::string& name, int argc, char* argv[], std::optional<GuestTransceiver> guestTransceiver/* = std::nullopt*/, bool handleExitSignals/* = true*/) :
+        m_hostDeltaUpdates(false),
+        m_multicast(false),
+        m_reconnect(false),
         m_exitCode(EXIT_SUCCESS),
         m_transceiver(nullptr),
         m_guestTransceiverStorage{ std::move(guestTransceiver) }
@@ -32,12 +35,50 @@ namespace dots
                 type::Registry::StaticTypePolicy::All,
                 transition_handler_t{ &Application::handleGuestTransceiverTransition, this }
             );
-            transceiver->open(io::global_publish_types(), io::global_subscribe_types(), *m_openEndpoint);
+
+            if (m_multicast)
+            {
+                transceiver->setMulticast(true, m_multicastInterface);
+            }
+
+            if (m_handlerThreads != std::nullopt)
+            {
+                transceiver->setHandlerThreads(*m_handlerThreads);
+            }
+
+            if (m_reconnect)
+            {
+                transceiver->setReconnect(true);
+                transceiver->asyncOpen(io::global_publish_types(), io::global_subscribe_types(), *m_openEndpoint);
+            }
+            else
+            {
+                transceiver->open(io::global_publish_types(), io::global_subscribe_types(), *m_openEndpoint);
+            }
         }
         else
         {
             transceiver = &*m_guestTransceiverStorage;
-            transceiver->open(*m_openEndpoint);
+
+            if (m_multicast)
+            {
+                transceiver->setMulticast(true, m_multicastInterface);
+            }
+
+            if (m_handlerThreads != std::nullopt)
+            {
+                transceiver->setHandlerThreads(*m_handlerThreads);
+            }
+
+            if (m_reconnect)
+            {
+                transceiver->setReconnect(true);
+                transceiver->asyncOpen(*m_openEndpoint);
+            }
+            else
+            {
+                transceiver->open(*m_openEndpoint);
+            }
         }
 
         m_transceiver = transceiver;
@@ -48,6 +89,13 @@ namespace dots
             m_signals->signalSet.async_wait([this](boost::system::error_code/* error*/, int/* signalNumber*/){ exit(); });
         }
 
+        // note: when reconnecting, the connection is established while the
+        // application is executed
+        if (m_reconnect)
+        {
+            return;
+        }
+
         for (;;)
         {
             if (m_guestConnectionError != nullptr)
@@ -75,12 +123,46 @@ namespace dots
     }
 
     Application::Application(int argc, char* argv[], HostTransceiver hostTransceiver, bool handleExitSignals) :
+        m_hostDeltaUpdates(false),
+        m_multicast(false),
+        m_reconnect(false),
         m_exitCode(EXIT_SUCCESS),
         m_transceiver(nullptr),
         m_hostTransceiverStorage{ std::move(hostTransceiver) }
     {
         parseHostTransceiverArgs(argc, argv);
         m_transceiver = &*m_hostTransceiverStorage;
+
+        if (m_hostThreads != std::nullopt)
+        {
+            m_hostTransceiverStorage->setWorkerThreads(*m_hostThreads);
+        }
+
+        if (m_hostWriteQueueSize != std::nullopt || m_hostWriteQueuePolicy != std::nullopt)
+        {
+            m_hostTransceiverStorage->setWriteQueueLimit(m_hostWriteQueueSize.value_or(io::Channel::DefaultWriteQueueMaxSize), m_hostWriteQueuePolicy.value_or(DotsWriteQueuePolicy::disconnect));
+        }
+
+        if (m_hostConflationThreshold != std::nullopt)
+        {
+            m_hostTransceiverStorage->setConflationThreshold(*m_hostConflationThreshold);
+        }
+
+        if (m_hostDeltaUpdates)
+        {
+            m_hostTransceiverStorage->setDeltaUpdates(true);
+        }
+
+        for (const std::string& typeName : m_hostDeltaUpdateTypes)
+        {
+            m_hostTransceiverStorage->setDeltaUpdates(typeName, true);
+        }
+
+        for (const auto& [typeName, groupEndpoint] : m_hostMulticastTypes)
+        {
+            m_hostTransceiverStorage->setMulticast(typeName, groupEndpoint, m_multicastInterface);
+        }
+
         m_hostTransceiverStorage->listen(m_listenEndpoints);
 
         if (handleExitSignals)
@@ -153,6 +235,18 @@ namespace dots
 
     void Application::handleGuestTransceiverTransition(const Connection& connection, std::exception_ptr ePtr)
     {
+        if (m_reconnect)
+        {
+            // note: the transceiver will reconnect after the connection was
+            // closed, so the application keeps running
+            if (connection.connected())
+            {
+                m_transceiver->publish(DotsClient{ .id = connection.selfId(), .running = true });
+            }
+
+            return;
+        }
+
         m_guestConnectionError = ePtr;
 
         if (connection.closed())
@@ -169,6 +263,10 @@ namespace dots
         options.add_options()
             ("dots-auth-secret", po::value<std::string>(), "secret used during authentication (this can also be given as part of the --dots-endpoint argument)")
             ("dots-endpoint", po::value<std::string>(), "remote endpoint URI to open for host connection (e.g. tcp://127.0.0.1, ws://127.0.0.1:11233, uds:/run/dots.socket")
+            ("dots-multicast", "request to receive uncached types via UDP multicast if the host offers it")
+            ("dots-multicast-interface", po::value<std::string>(), "address of the local interface to join multicast groups on (e.g. 127.0.0.1)")
+            ("dots-reconnect", "connect to the host without blocking and reconnect if the connection is lost")
+            ("dots-handler-threads", po::value<size_t>(), "amount of worker threads to invoke subscription handlers on, each type being handled by a single thread (0 = invoke all handlers on the main thread)")
             ("dots-log-level", po::value<int>(), "log level to use (data = 1, debug = 2, info = 3, notice = 4, warn = 5, error = 6, crit = 7, emerg = 8)")
         ;
 
@@ -202,6 +300,19 @@ namespace dots
             m_openEndpoint->setUserPassword(dotsAuthSecret);
         }
 
+        m_multicast = args.count("dots-multicast") > 0;
+        m_reconnect = args.count("dots-reconnect") > 0;
+
+        if (auto it = args.find("dots-handler-threads"); it != args.end())
+        {
+            m_handlerThreads = it->second.as<size_t>();
+        }
+
+        if (auto it = args.find("dots-multicast-interface"); it != args.end())
+        {
+            m_multicastInterface = it->second.as<std::string>();
+        }
+
         if (auto it = args.find("dots-log-level"); it != args.end())
         {
             tools::loggingFrontend().setLogLevel(it->second.as<int>());
@@ -215,6 +326,14 @@ namespace dots
         po::options_description options{ "Allowed options" };
         options.add_options()
             ("dots-endpoint", po::value<std::vector<std::string>>(), "local endpoint URI to listen on for incoming guest connections (e.g. tcp://127.0.0.1, ws://127.0.0.1:11233, uds:/run/dots.socket")
+            ("dots-threads", po::value<size_t>(), "amount of worker threads to distribute the IO of guest connections across (0 = handle all connections on the main thread)")
+            ("dots-write-queue-size", po::value<size_t>(), "maximum size of the write queue of each guest connection in bytes (default: 10485760)")
+            ("dots-write-queue-policy", po::value<std::string>(), "policy to apply when the write queue of a guest connection exceeds its maximum size (disconnect, drop_oldest, pause_reading)")
+            ("dots-conflation-threshold", po::value<size_t>(), "size of the write queue of a guest connection in bytes above which updates of cached types are conflated (0 = disabled)")
+            ("dots-delta-updates", "reduce updates of all cached types to the properties that actually changed")
+            ("dots-delta-update-type", po::value<std::vector<std::string>>(), "name of a cached type whose updates are reduced to the properties that actually changed (can be given multiple times)")
+            ("dots-multicast-type", po::value<std::vector<std::string>>(), "name of an uncached type and multicast endpoint to distribute it on (e.g. Foo=udp://239.255.0.1:11240, can be given multiple times)")
+            ("dots-multicast-interface", po::value<std::string>(), "address of the local interface to send multicast datagrams from (e.g. 127.0.0.1)")
             ("dots-log-level", po::value<int>(), "log level to use (data = 1, debug = 2, info = 3, notice = 4, warn = 5, error = 6, crit = 7, emerg = 8)")
         ;
 
@@ -242,6 +361,68 @@ namespace dots
             m_listenEndpoints.emplace_back("tcp://127.0.0.1");
         }
 
+        if (auto it = args.find("dots-threads"); it != args.end())
+        {
+            m_hostThreads = it->second.as<size_t>();
+        }
+
+        if (auto it = args.find("dots-write-queue-size"); it != args.end())
+        {
+            m_hostWriteQueueSize = it->second.as<size_t>();
+        }
+
+        if (auto it = args.find("dots-write-queue-policy"); it != args.end())
+        {
+            if (const std::string& policy = it->second.as<std::string>(); policy == "disconnect")
+            {
+                m_hostWriteQueuePolicy = DotsWriteQueuePolicy::disconnect;
+            }
+            else if (policy == "drop_oldest")
+            {
+                m_hostWriteQueuePolicy = DotsWriteQueuePolicy::drop_oldest;
+            }
+            else if (policy == "pause_reading")
+            {
+                m_hostWriteQueuePolicy = DotsWriteQueuePolicy::pause_reading;
+            }
+            else
+            {
+                throw std::runtime_error{ "unknown write queue policy: '" + policy + "'" };
+            }
+        }
+
+        if (auto it = args.find("dots-conflation-threshold"); it != args.end())
+        {
+            m_hostConflationThreshold = it->second.as<size_t>();
+        }
+
+        m_hostDeltaUpdates = args.count("dots-delta-updates") > 0;
+
+        if (auto it = args.find("dots-delta-update-type"); it != args.end())
+        {
+            m_hostDeltaUpdateTypes = it->second.as<std::vector<std::string>>();
+        }
+
+        if (auto it = args.find("dots-multicast-type"); it != args.end())
+        {
+            for (const std::string& multicastType : it->second.as<std::vector<std::string>>())
+            {
+                size_t separator = multicastType.find('=');
+
+                if (separator == std::string::npos || separator == 0)
+                {
+                    throw std::runtime_error{ "invalid multicast type: '" + multicastType + "' (expected <type>=<endpoint>)" };
+                }
+
+                m_hostMulticastTypes.emplace_back(multicastType.substr(0, separator), io::Endpoint{ multicastType.substr(separator + 1) });
+            }
+        }
+
+        if (auto it = args.find("dots-multicast-interface"); it != args.end())
+        {
+            m_multicastInterface = it->second.as<std::string>();
+        }
+
         if (auto it = args.find("dots-log-level"); it != args.end())
         {
             tools::loggingFrontend().setLogLevel(it->second.as<int>());
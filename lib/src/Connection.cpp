@@ -195,11 +195,81 @@ namespace dots
         m_channel->transmit(transmission);
     }
 
+    void Connection::transmit(const DotsHeader& header, const io::Channel::instance_batch_t& instances)
+    {
+        #if defined(DOTS_ENABLE_TRANSMISSION_LOGGING)
+        for (const type::Struct& instance : instances)
+        {
+            LOG_TRANSMIT_TRANSMISSION(header, instance);
+        }
+        #endif
+
+        m_channel->transmit(header, instances);
+    }
+
+    void Connection::transmit(const std::vector<io::Transmission>& transmissions)
+    {
+        #if defined(DOTS_ENABLE_TRANSMISSION_LOGGING)
+        for (const io::Transmission& transmission : transmissions)
+        {
+            LOG_TRANSMIT_TRANSMISSION(transmission.header(), *transmission.instance());
+        }
+        #endif
+
+        m_channel->transmit(transmissions);
+    }
+
     void Connection::transmit(const type::StructDescriptor& descriptor)
     {
         m_channel->transmit(descriptor);
     }
 
+    void Connection::setWriteQueueLimit(size_t maxSize, DotsWriteQueuePolicy policy, std::optional<write_queue_handler_t> drainHandler/* = std::nullopt*/)
+    {
+        m_writeQueueHandler = std::move(drainHandler);
+        m_channel->setWriteQueueLimit(maxSize, policy, io::Channel::write_queue_handler_t{ &Connection::handleWriteQueueDrained, this });
+    }
+
+    void Connection::setConflationThreshold(size_t threshold)
+    {
+        m_channel->setConflationThreshold(threshold);
+    }
+
+    DotsWriteQueueStatus Connection::writeQueueStatus() const
+    {
+        return m_channel->writeQueueStatus();
+    }
+
+    DotsStatistics Connection::receivedStatistics() const
+    {
+        return m_channel->receivedStatistics();
+    }
+
+    DotsStatistics Connection::sentStatistics() const
+    {
+        return m_channel->sentStatistics();
+    }
+
+    bool Connection::writeQueueCongested() const
+    {
+        return m_channel->writeQueueCongested();
+    }
+
+    bool Connection::awaitWriteQueueDrain()
+    {
+        return m_channel->awaitWriteQueueDrain();
+    }
+
+    void Connection::pauseReceive()
+    {
+        m_channel->pauseReceive();
+    }
+
+    void Connection::resumeReceive()
+    {
+        m_channel->resumeReceive();
+    }
+
     void Connection::handleError(std::exception_ptr ePtr)
     {
         if (m_connectionState == DotsConnectionState::connected)
@@ -237,10 +307,12 @@ namespace dots
             return false;
         }
 
-        const type::Struct& instance = transmission.instance();
+        const type::StructDescriptor& descriptor = transmission.descriptor();
 
-        if (instance._isAny<DotsMsgHello, DotsMsgConnect, DotsMsgConnectResponse, DotsMsgError>())
+        if (descriptor.internal() && transmission.instance()->_isAny<DotsMsgHello, DotsMsgConnect, DotsMsgConnectResponse, DotsMsgError>())
         {
+            const type::Struct& instance = transmission.instance();
+
             if (auto* dotsMsgError = instance._as<DotsMsgError>())
             {
                 handlePeerError(*dotsMsgError);
@@ -260,9 +332,19 @@ namespace dots
         {
             if (m_connectionState == DotsConnectionState::connected || m_connectionState == DotsConnectionState::early_subscribe)
             {
-                instance._assertHasProperties(instance._keyProperties());
                 DotsHeader& header = transmission.header();
 
+                // note: undecoded transmissions are checked based on the
+                // included properties (see io::Channel::setPassThrough())
+                if (transmission.payload() == nullptr)
+                {
+                    transmission.instance()->_assertHasProperties(descriptor.keyProperties());
+                }
+                else if (!header.attributes.isValid() || !(descriptor.keyProperties() <= *header.attributes))
+                {
+                    throw std::logic_error{ descriptor.name() + " transmission is missing key properties" };
+                }
+
                 if (m_selfId == HostId)
                 {
                     header.sender = m_peerId;
@@ -299,11 +381,19 @@ namespace dots
             }
             else
             {
-                throw std::logic_error{ "received instance of non-system type " + instance._descriptor().name() + " while not in early_subscribe or connected state " + to_string(m_connectionState) };
+                throw std::logic_error{ "received instance of non-system type " + descriptor.name() + " while not in early_subscribe or connected state " + to_string(m_connectionState) };
             }
         }
     }
 
+    void Connection::handleWriteQueueDrained()
+    {
+        if (m_writeQueueHandler != std::nullopt)
+        {
+            (*m_writeQueueHandler)(*this);
+        }
+    }
+
     void Connection::handleClose(std::exception_ptr ePtr)
     {
         m_receiveHandler = std::nullopt;
@@ -2,10 +2,112 @@
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #include <dots/Container.h>
 #include <algorithm>
+#include <bit>
+#include <cstring>
 #include <numeric>
 
 namespace dots
 {
+    namespace
+    {
+        size_t mix_hash(uint64_t value)
+        {
+            // note: this is the finalizer of the SplitMix64 generator, which
+            // distributes the bits of consecutive keys across the entire
+            // hash
+            value ^= value >> 30;
+            value *= 0xbf58476d1ce4e5b9;
+            value ^= value >> 27;
+            value *= 0x94d049bb133111eb;
+            value ^= value >> 31;
+
+            return static_cast<size_t>(value);
+        }
+
+        size_t hash_bytes(const type::Typeless& value, size_t size)
+        {
+            uint64_t hash = 0;
+            const auto* data = reinterpret_cast<const unsigned char*>(&value);
+
+            for (size_t offset = 0; offset < size; offset += sizeof(uint64_t))
+            {
+                uint64_t chunk = 0;
+                std::memcpy(&chunk, data + offset, std::min(size - offset, sizeof(uint64_t)));
+                hash = mix_hash(hash ^ chunk);
+            }
+
+            return static_cast<size_t>(hash);
+        }
+
+        size_t hash_value(const type::Descriptor<>& descriptor, const type::Typeless& value)
+        {
+            switch (descriptor.type())
+            {
+                case type::Type::float32:
+                {
+                    // note: positive and negative zero are equal and must
+                    // therefore yield the same hash
+                    types::float32_t value_ = value.to<types::float32_t>();
+                    return value_ == 0.0f ? 0 : mix_hash(std::bit_cast<uint32_t>(value_));
+                }
+                case type::Type::float64:
+                case type::Type::timepoint:
+                case type::Type::steady_timepoint:
+                case type::Type::duration:
+                {
+                    types::float64_t value_ = value.to<types::float64_t>();
+                    return value_ == 0.0 ? 0 : mix_hash(std::bit_cast<uint64_t>(value_));
+                }
+                case type::Type::string:
+                    return std::hash<types::string_t>{}(value.to<types::string_t>());
+                case type::Type::boolean:
+                case type::Type::int8:
+                case type::Type::uint8:
+                case type::Type::int16:
+                case type::Type::uint16:
+                case type::Type::int32:
+                case type::Type::uint32:
+                case type::Type::int64:
+                case type::Type::uint64:
+                case type::Type::property_set:
+                case type::Type::uuid:
+                case type::Type::Enum:
+                    return hash_bytes(value, descriptor.size());
+                case type::Type::Vector:
+                case type::Type::Struct:
+                default:
+                    // note: compound keys do not contribute to the hash and
+                    // are only considered when comparing keys for equality
+                    return 0;
+            }
+        }
+    }
+
+    Container<type::Struct>::hash_table_t::hash_table_t(hash_table_t&& other) noexcept :
+        values{ std::exchange(other.values, {}) },
+        hashes{ std::exchange(other.hashes, {}) },
+        size{ std::exchange(other.size, 0) }
+    {
+        /* do nothing */
+    }
+
+    Container<type::Struct>::hash_table_t::~hash_table_t()
+    {
+        for (value_t* value : values)
+        {
+            delete value;
+        }
+    }
+
+    auto Container<type::Struct>::hash_table_t::operator = (hash_table_t&& rhs) noexcept -> hash_table_t&
+    {
+        std::swap(values, rhs.values);
+        std::swap(hashes, rhs.hashes);
+        std::swap(size, rhs.size);
+
+        return *this;
+    }
+
     Container<type::Struct>::key_compare::key_compare(const type::StructDescriptor& descriptor)
     {
         for (const type::PropertyDescriptor& propertyDescriptor : descriptor.propertyDescriptors())
@@ -58,13 +160,20 @@ namespace dots
         return (*this)(static_cast<const type::Struct&>(lhs), static_cast<const type::Struct&>(rhs));
     }
 
-    Container<type::Struct>::Container(const type::StructDescriptor& descriptor) :
+    Container<type::Struct>::Container(const type::StructDescriptor& descriptor, std::shared_ptr<peer_references_t> peerReferences/* = nullptr*/) :
         m_descriptor(&descriptor),
-        m_instances{ descriptor }
+        m_storage{ Storage::Ordered },
+        m_instances{ descriptor },
+        m_peerReferences{ peerReferences == nullptr ? std::make_shared<peer_references_t>() : std::move(peerReferences) },
+        m_projection{ descriptor.properties() }
     {
         for (const type::PropertyDescriptor& propertyDescriptor : descriptor.propertyDescriptors())
         {
-            if (!propertyDescriptor.isKey())
+            if (propertyDescriptor.isKey())
+            {
+                m_keyPropertyDescriptors.emplace_back(propertyDescriptor);
+            }
+            else
             {
                 m_noKeyPropertyDescriptors.emplace_back(propertyDescriptor);
             }
@@ -78,38 +187,105 @@ namespace dots
 
     auto Container<type::Struct>::begin() const & -> const_iterator_t
     {
-        return m_instances.begin();
+        if (m_storage == Storage::Ordered)
+        {
+            return m_instances.begin();
+        }
+        else
+        {
+            const std::vector<value_t*>& values = m_hashedInstances.values;
+            return { values.data(), values.data() + values.size() };
+        }
     }
 
     auto Container<type::Struct>::end() const & -> const_iterator_t
     {
-        return m_instances.end();
+        if (m_storage == Storage::Ordered)
+        {
+            return m_instances.end();
+        }
+        else
+        {
+            const std::vector<value_t*>& values = m_hashedInstances.values;
+            return { values.data() + values.size(), values.data() + values.size() };
+        }
     }
 
     auto Container<type::Struct>::cbegin() const & -> const_iterator_t
     {
-        return m_instances.cbegin();
+        return begin();
     }
 
     auto Container<type::Struct>::cend() const & -> const_iterator_t
     {
-        return m_instances.cend();
+        return end();
+    }
+
+    auto Container<type::Struct>::orderedBegin() const & -> const_iterator_t
+    {
+        if (m_storage == Storage::Ordered)
+        {
+            return m_instances.begin();
+        }
+        else
+        {
+            const std::vector<value_t*>& values = orderedView();
+            return { values.data(), values.data() + values.size() };
+        }
+    }
+
+    auto Container<type::Struct>::orderedEnd() const & -> const_iterator_t
+    {
+        if (m_storage == Storage::Ordered)
+        {
+            return m_instances.end();
+        }
+        else
+        {
+            const std::vector<value_t*>& values = orderedView();
+            return { values.data() + values.size(), values.data() + values.size() };
+        }
+    }
+
+    auto Container<type::Struct>::storage() const & -> Storage
+    {
+        return m_storage;
+    }
+
+    void Container<type::Struct>::setStorage(Storage storage) &
+    {
+        if (!empty())
+        {
+            throw std::logic_error{ "attempt to change storage of non-empty container for type: " + m_descriptor->name() };
+        }
+
+        m_storage = storage;
+        m_hashedInstances = hash_table_t{};
+        m_orderedView.reset();
     }
 
     bool Container<type::Struct>::empty() const &
     {
-        return m_instances.empty();
+        return size() == 0;
     }
 
     size_t Container<type::Struct>::size() const &
     {
-        return m_instances.size();
+        return m_storage == Storage::Ordered ? m_instances.size() : m_hashedInstances.size;
     }
 
     auto Container<type::Struct>::findClone(const type::Struct& instance) const & -> const value_t*
     {
-        auto it = m_instances.find(instance);
-        return it == m_instances.end() ? nullptr : &*it;
+        if (m_storage == Storage::Ordered)
+        {
+            auto it = m_instances.find(instance);
+            return it == m_instances.end() ? nullptr : &*it;
+        }
+        else
+        {
+            std::optional<size_t> slot = findSlot(instance, hashKey(instance));
+            return slot == std::nullopt ? nullptr : m_hashedInstances.values[*slot];
+        }
     }
 
     auto Container<type::Struct>::getClone(const type::Struct& instance) const & -> const value_t &
@@ -130,6 +306,53 @@ namespace dots
         return clone == nullptr ? nullptr : &clone->first.get();
     }
 
+    auto Container<type::Struct>::upperBound(const type::Struct& instance) const & -> const_iterator_t
+    {
+        if (m_storage == Storage::Ordered)
+        {
+            return m_instances.upper_bound(instance);
+        }
+        else
+        {
+            const std::vector<value_t*>& values = orderedView();
+            const key_compare& keyCompare = m_instances.key_comp();
+            auto it = std::upper_bound(values.begin(), values.end(), instance, [&keyCompare](const type::Struct& lhs, const value_t* rhs)
+            {
+                return keyCompare(lhs, rhs->first);
+            });
+
+            return { values.data() + (it - values.begin()), values.data() + values.size() };
+        }
+    }
+
+    std::vector<const type::Struct*> Container<type::Struct>::findOwned(uint32_t peerId) const &
+    {
+        if (auto it = m_ownerIndex.find(peerId); it == m_ownerIndex.end())
+        {
+            return {};
+        }
+        else
+        {
+            return { it->second.begin(), it->second.end() };
+        }
+    }
+
+    size_t Container<type::Struct>::referenceCount(uint32_t peerId) const &
+    {
+        auto it = m_peerReferences->counts.find(peerId);
+        return it == m_peerReferences->counts.end() ? 0 : it->second;
+    }
+
+    property_set_t Container<type::Struct>::projection() const &
+    {
+        return m_projection;
+    }
+
+    void Container<type::Struct>::setProjection(property_set_t projection) &
+    {
+        m_projection = (projection + m_descriptor->keyProperties()) ^ m_descriptor->properties();
+    }
+
     const type::Struct& Container<type::Struct>::get(const type::Struct& instance) const &
     {
         return getClone(instance).first;
@@ -137,34 +360,48 @@ namespace dots
 
     auto Container<type::Struct>::insert(const DotsHeader& header, const type::Struct& instance) & -> const value_t &
     {
+        if (m_storage == Storage::Hashed)
+        {
+            // note: the hash is calculated only once and used for both the
+            // lookup and the emplacement of the clone
+            size_t hash = hashKey(instance);
+
+            if (std::optional<size_t> slot = findSlot(instance, hash); slot == std::nullopt)
+            {
+                value_t& created = emplaceSlot(std::make_unique<value_t>(projectInstance(instance), createCloneInfo(header)), hash);
+                indexOwner(created.first, created.second);
+                referencePeers(created.second);
+
+                return created;
+            }
+            else
+            {
+                // note: the clones of the hash table are updated in place,
+                // because only non-key properties are modified
+                value_t& existing = *m_hashedInstances.values[*slot];
+                updateClone(header, instance, const_cast<type::Struct&>(*existing.first), existing.second);
+
+                return existing;
+            }
+        }
+
         auto [itLower, itUpper] = m_instances.equal_range(instance);
         bool unknownInstance = itLower == itUpper;
 
         if (unknownInstance)
         {
-            auto itCreated = m_instances.emplace_hint(itUpper, instance, DotsCloneInformation{
-                .lastOperation = DotsMt::create,
-                .lastUpdateFrom = header.sender,
-                .created = header.sentTime,
-                .createdFrom = header.sender,
-                .modified = header.sentTime,
-                .localUpdateTime = timepoint_t::Now()
-            });
+            auto itCreated = m_instances.emplace_hint(itUpper, projectInstance(instance), createCloneInfo(header));
+            indexOwner(itCreated->first, itCreated->second);
+            referencePeers(itCreated->second);
 
             return *itCreated;
         }
         else
         {
-            node_t node = m_instances.extract(itLower);
-            type::Struct& existing = node.key();
-            DotsCloneInformation& cloneInfo = node.mapped();
-
-            updateWithoutKeys(existing, instance, *header.attributes);
-            cloneInfo.lastOperation = DotsMt::update;
-            cloneInfo.lastUpdateFrom = header.sender;
-            cloneInfo.modified = header.sentTime;
-            cloneInfo.localUpdateTime = timepoint_t::Now();
-
+            // note: the clone remains at the same address when the node is
+            // reinserted, so the owner index stays valid
+            container_t::node_type node = m_instances.extract(itLower);
+            updateClone(header, instance, node.key(), node.mapped());
             auto itUpdated = m_instances.insert(itUpper, std::move(node));
 
             return *itUpdated;
@@ -173,13 +410,25 @@ namespace dots
 
     auto Container<type::Struct>::remove(const DotsHeader& header, const type::Struct& instance) & -> node_t
     {
-        node_t node = m_instances.extract(instance);
+        node_t node;
+
+        if (m_storage == Storage::Ordered)
+        {
+            node = m_instances.extract(instance);
+        }
+        else if (std::optional<size_t> slot = findSlot(instance, hashKey(instance)); slot != std::nullopt)
+        {
+            node = std::unique_ptr<value_t>{ m_hashedInstances.values[*slot] };
+            eraseSlot(*slot);
+        }
 
         if (!node.empty())
         {
-            type::Struct& removed = node.key();
+            type::Struct& removed = const_cast<type::Struct&>(*node.key());
             DotsCloneInformation& cloneInfo = node.mapped();
 
+            deindexOwner(removed, cloneInfo);
+            releasePeers(cloneInfo);
             updateWithoutKeys(removed, instance, *header.attributes);
             cloneInfo.lastOperation = DotsMt::remove;
             cloneInfo.lastUpdateFrom = header.sender;
@@ -192,12 +441,21 @@ namespace dots
 
     void Container<type::Struct>::clear() &
     {
+        for (const auto& [instance, cloneInfo] : *this)
+        {
+            (void)instance;
+            releasePeers(cloneInfo);
+        }
+
         m_instances.clear();
+        m_hashedInstances = hash_table_t{};
+        m_orderedView.reset();
+        m_ownerIndex.clear();
     }
 
     void Container<type::Struct>::forEachClone(const std::function<void(const value_t&)>& f) const &
     {
-        std::for_each(m_instances.begin(), m_instances.end(), f);
+        std::for_each(begin(), end(), f);
     }
 
     void Container<type::Struct>::forEach(const std::function<void(const type::Struct&)>& f) const &
@@ -211,8 +469,8 @@ namespace dots
     size_t Container<type::Struct>::totalMemoryUsage() const &
     {
         size_t staticMemUsage = sizeof(Container<type::Struct>);
-        size_t dynElementMemUsage = m_instances.size() * sizeof(value_t);
-        size_t dynInstanceMemUsage = std::accumulate(m_instances.begin(), m_instances.end(), size_t{ 0 }, [](size_t size, const value_t& value)
+        size_t dynElementMemUsage = size() * sizeof(value_t) + m_hashedInstances.values.capacity() * (sizeof(value_t*) + sizeof(size_t));
+        size_t dynInstanceMemUsage = std::accumulate(begin(), end(), size_t{ 0 }, [](size_t size, const value_t& value)
         {
             return size + value.first->_totalMemoryUsage();
         });
@@ -220,6 +478,234 @@ namespace dots
         return staticMemUsage + dynElementMemUsage + dynInstanceMemUsage;
     }
 
+    type::AnyStruct Container<type::Struct>::projectInstance(const type::Struct& instance) const
+    {
+        if (m_projection == m_descriptor->properties())
+        {
+            return type::AnyStruct{ instance };
+        }
+        else
+        {
+            type::AnyStruct projected{ *m_descriptor };
+            projected->_copy(instance, m_projection);
+
+            return projected;
+        }
+    }
+
+    DotsCloneInformation Container<type::Struct>::createCloneInfo(const DotsHeader& header)
+    {
+        return DotsCloneInformation{
+            .lastOperation = DotsMt::create,
+            .lastUpdateFrom = header.sender,
+            .created = header.sentTime,
+            .createdFrom = header.sender,
+            .modified = header.sentTime,
+            .localUpdateTime = timepoint_t::Now()
+        };
+    }
+
+    void Container<type::Struct>::updateClone(const DotsHeader& header, const type::Struct& instance, type::Struct& existing, DotsCloneInformation& cloneInfo)
+    {
+        // note: the index only has to be updated if the owner changes
+        bool ownerChanged = cloneInfo.lastUpdateFrom != header.sender;
+        std::optional<DotsCloneInformation> previousCloneInfo;
+
+        if (ownerChanged)
+        {
+            deindexOwner(existing, cloneInfo);
+            previousCloneInfo.emplace(cloneInfo);
+        }
+
+        updateWithoutKeys(existing, instance, *header.attributes ^ m_projection);
+        cloneInfo.lastOperation = DotsMt::update;
+        cloneInfo.lastUpdateFrom = header.sender;
+        cloneInfo.modified = header.sentTime;
+        cloneInfo.localUpdateTime = timepoint_t::Now();
+
+        // note: the new references are added before the previous ones
+        // are released to avoid releasing peers that are still referenced
+        if (ownerChanged)
+        {
+            indexOwner(existing, cloneInfo);
+            referencePeers(cloneInfo);
+            releasePeers(*previousCloneInfo);
+        }
+    }
+
+    size_t Container<type::Struct>::hashKey(const type::Struct& instance) const
+    {
+        const type::PropertyArea& propertyArea = instance._propertyArea();
+        property_set_t validProperties = propertyArea.validProperties();
+        size_t hash = 0;
+
+        for (const auto& propertyDescriptor_ : m_keyPropertyDescriptors)
+        {
+            const type::PropertyDescriptor& propertyDescriptor = propertyDescriptor_.get();
+
+            if (propertyDescriptor.set() <= validProperties)
+            {
+                const auto& value = propertyArea.getProperty<type::Typeless>(propertyDescriptor.offset());
+                hash ^= hash_value(propertyDescriptor.valueDescriptor(), value) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+            }
+        }
+
+        return hash;
+    }
+
+    bool Container<type::Struct>::equalKey(const type::Struct& lhs, const type::Struct& rhs) const
+    {
+        const type::PropertyArea& lhsPropertyArea = lhs._propertyArea();
+        const type::PropertyArea& rhsPropertyArea = rhs._propertyArea();
+        property_set_t lhsValidProperties = lhsPropertyArea.validProperties();
+        property_set_t rhsValidProperties = rhsPropertyArea.validProperties();
+
+        for (const auto& propertyDescriptor_ : m_keyPropertyDescriptors)
+        {
+            const type::PropertyDescriptor& propertyDescriptor = propertyDescriptor_.get();
+            property_set_t propertySet = propertyDescriptor.set();
+            bool lhsValid = propertySet <= lhsValidProperties;
+
+            if (lhsValid != (propertySet <= rhsValidProperties))
+            {
+                return false;
+            }
+
+            if (lhsValid)
+            {
+                const auto& lhsValue = lhsPropertyArea.getProperty<type::Typeless>(propertyDescriptor.offset());
+                const auto& rhsValue = rhsPropertyArea.getProperty<type::Typeless>(propertyDescriptor.offset());
+
+                if (!propertyDescriptor.valueDescriptor().equal(lhsValue, rhsValue))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    std::optional<size_t> Container<type::Struct>::findSlot(const type::Struct& instance, size_t hash) const
+    {
+        const std::vector<value_t*>& values = m_hashedInstances.values;
+        const std::vector<size_t>& hashes = m_hashedInstances.hashes;
+
+        if (values.empty())
+        {
+            return std::nullopt;
+        }
+
+        size_t mask = values.size() - 1;
+
+        for (size_t slot = hash & mask; values[slot] != nullptr; slot = (slot + 1) & mask)
+        {
+            if (hashes[slot] == hash && equalKey(values[slot]->first, instance))
+            {
+                return slot;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    auto Container<type::Struct>::emplaceSlot(std::unique_ptr<value_t> value, size_t hash) -> value_t&
+    {
+        // note: the load factor is limited to 1/2 to keep probe sequences
+        // short
+        if (size_t capacity = m_hashedInstances.values.size(); (m_hashedInstances.size + 1) * 2 > capacity)
+        {
+            rehash(std::max(HashTableMinCapacity, capacity * 2));
+        }
+
+        std::vector<value_t*>& values = m_hashedInstances.values;
+        size_t mask = values.size() - 1;
+        size_t slot = hash & mask;
+
+        while (values[slot] != nullptr)
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        values[slot] = value.release();
+        m_hashedInstances.hashes[slot] = hash;
+        ++m_hashedInstances.size;
+        m_orderedView.reset();
+
+        return *values[slot];
+    }
+
+    void Container<type::Struct>::eraseSlot(size_t slot)
+    {
+        std::vector<value_t*>& values = m_hashedInstances.values;
+        std::vector<size_t>& hashes = m_hashedInstances.hashes;
+        size_t mask = values.size() - 1;
+
+        values[slot] = nullptr;
+        --m_hashedInstances.size;
+        m_orderedView.reset();
+
+        // note: subsequent clones of the probe sequence are shifted back
+        // instead of leaving a tombstone. a clone can be shifted into the
+        // free slot if the slot lies between its ideal slot and its current
+        // slot
+        for (size_t next = (slot + 1) & mask; values[next] != nullptr; next = (next + 1) & mask)
+        {
+            if (size_t ideal = hashes[next] & mask; ((next - ideal) & mask) >= ((next - slot) & mask))
+            {
+                values[slot] = std::exchange(values[next], nullptr);
+                hashes[slot] = hashes[next];
+                slot = next;
+            }
+        }
+    }
+
+    void Container<type::Struct>::rehash(size_t capacity)
+    {
+        hash_table_t hashedInstances;
+        hashedInstances.values.resize(capacity, nullptr);
+        hashedInstances.hashes.resize(capacity, 0);
+        hashedInstances.size = m_hashedInstances.size;
+        size_t mask = capacity - 1;
+
+        // note: the precomputed hashes are reused, so that the key
+        // properties are not accessed again
+        for (size_t i = 0; i < m_hashedInstances.values.size(); ++i)
+        {
+            if (m_hashedInstances.values[i] != nullptr)
+            {
+                size_t slot = m_hashedInstances.hashes[i] & mask;
+
+                while (hashedInstances.values[slot] != nullptr)
+                {
+                    slot = (slot + 1) & mask;
+                }
+
+                hashedInstances.values[slot] = std::exchange(m_hashedInstances.values[i], nullptr);
+                hashedInstances.hashes[slot] = m_hashedInstances.hashes[i];
+            }
+        }
+
+        m_hashedInstances = std::move(hashedInstances);
+    }
+
+    auto Container<type::Struct>::orderedView() const -> const std::vector<value_t*>&
+    {
+        if (m_orderedView == std::nullopt)
+        {
+            std::vector<value_t*>& orderedView = m_orderedView.emplace();
+            orderedView.reserve(m_hashedInstances.size);
+            std::copy_if(m_hashedInstances.values.begin(), m_hashedInstances.values.end(), std::back_inserter(orderedView), [](const value_t* value){ return value != nullptr; });
+            const key_compare& keyCompare = m_instances.key_comp();
+            std::sort(orderedView.begin(), orderedView.end(), [&keyCompare](const value_t* lhs, const value_t* rhs)
+            {
+                return keyCompare(lhs->first, rhs->first);
+            });
+        }
+
+        return *m_orderedView;
+    }
+
     void Container<type::Struct>::updateWithoutKeys(type::Struct& lhs, const type::Struct& rhs, property_set_t includedSet)
     {
         using namespace type;
@@ -263,4 +749,73 @@ namespace dots
             }
         }
     }
+
+    void Container<type::Struct>::indexOwner(const type::Struct& instance, const DotsCloneInformation& cloneInfo)
+    {
+        if (cloneInfo.lastUpdateFrom.isValid())
+        {
+            m_ownerIndex[*cloneInfo.lastUpdateFrom].emplace(&instance);
+        }
+    }
+
+    void Container<type::Struct>::deindexOwner(const type::Struct& instance, const DotsCloneInformation& cloneInfo)
+    {
+        if (!cloneInfo.lastUpdateFrom.isValid())
+        {
+            return;
+        }
+
+        if (auto it = m_ownerIndex.find(*cloneInfo.lastUpdateFrom); it != m_ownerIndex.end())
+        {
+            it->second.erase(&instance);
+
+            if (it->second.empty())
+            {
+                m_ownerIndex.erase(it);
+            }
+        }
+    }
+
+    void Container<type::Struct>::referencePeers(const DotsCloneInformation& cloneInfo)
+    {
+        if (cloneInfo.createdFrom.isValid())
+        {
+            ++m_peerReferences->counts[*cloneInfo.createdFrom];
+        }
+
+        if (cloneInfo.lastUpdateFrom.isValid() && cloneInfo.lastUpdateFrom != cloneInfo.createdFrom)
+        {
+            ++m_peerReferences->counts[*cloneInfo.lastUpdateFrom];
+        }
+    }
+
+    void Container<type::Struct>::releasePeers(const DotsCloneInformation& cloneInfo)
+    {
+        if (cloneInfo.createdFrom.isValid())
+        {
+            releasePeer(*cloneInfo.createdFrom);
+        }
+
+        if (cloneInfo.lastUpdateFrom.isValid() && cloneInfo.lastUpdateFrom != cloneInfo.createdFrom)
+        {
+            releasePeer(*cloneInfo.lastUpdateFrom);
+        }
+    }
+
+    void Container<type::Struct>::releasePeer(uint32_t peerId)
+    {
+        auto it = m_peerReferences->counts.find(peerId);
+
+        if (it == m_peerReferences->counts.end() || --it->second > 0)
+        {
+            return;
+        }
+
+        m_peerReferences->counts.erase(it);
+
+        if (m_peerReferences->releaseHandler)
+        {
+            (*m_peerReferences->releaseHandler)(peerId);
+        }
+    }
 }
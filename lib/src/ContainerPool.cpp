@@ -7,6 +7,12 @@
 
 namespace dots
 {
+    ContainerPool::ContainerPool() :
+        m_peerReferences{ std::make_shared<Container<>::peer_references_t>() }
+    {
+        /* do nothing */
+    }
+
     auto ContainerPool::begin() const -> const_iterator_t
     {
         return m_pool.begin();
@@ -49,22 +55,33 @@ namespace dots
 
     const Container<>* ContainerPool::find(const type::StructDescriptor& descriptor) const
     {
-        auto it = m_pool.find(&descriptor);
-        return it == m_pool.end() ? nullptr : &it->second;
+        type::StructDescriptor::type_id_t typeId = descriptor.typeId();
+        const Container<>* container = typeId < m_typeIdCache.size() ? m_typeIdCache[typeId] : nullptr;
+
+        // note: the id of a deregistered dynamic type might have been reused
+        // for another type, so the cached container has to be verified
+        return container != nullptr && &container->descriptor() == &descriptor ? container : nullptr;
     }
 
     const Container<>& ContainerPool::get(const type::StructDescriptor& descriptor, bool insertIfNotExist/* = true*/) const
     {
         if (insertIfNotExist)
         {
-            auto [it, emplaced] = m_pool.try_emplace(&descriptor, descriptor);
-            auto& [descriptorPtr, container] = *it;
+            if (const Container<>* container = find(descriptor); container != nullptr)
+            {
+                return *container;
+            }
+
+            auto& [descriptorPtr, container] = *m_pool.try_emplace(&descriptor, descriptor, m_peerReferences).first;
+            m_nameCache.emplace(descriptorPtr->name(), &container);
 
-            if (emplaced)
+            if (type::StructDescriptor::type_id_t typeId = descriptorPtr->typeId(); typeId >= m_typeIdCache.size())
             {
-                m_nameCache.emplace(descriptorPtr->name(), &container);
+                m_typeIdCache.resize(typeId + 1, nullptr);
             }
 
+            m_typeIdCache[descriptorPtr->typeId()] = &container;
+
             return container;
         }
         else
@@ -127,6 +144,16 @@ namespace dots
             throw std::runtime_error{ "container pool does not contain an element for the given type: " + descriptor.name() };
         }
 
+        if (type::StructDescriptor::type_id_t typeId = descriptor.typeId(); typeId < m_typeIdCache.size() && m_typeIdCache[typeId] == &node.mapped())
+        {
+            m_typeIdCache[typeId] = nullptr;
+        }
+
+        if (auto it = m_nameCache.find(descriptor.name()); it != m_nameCache.end() && it->second == &node.mapped())
+        {
+            m_nameCache.erase(it);
+        }
+
         return node;
     }
 
@@ -145,4 +172,15 @@ namespace dots
             return size + value.second.totalMemoryUsage();
         });
     }
+
+    size_t ContainerPool::referenceCount(uint32_t peerId) const
+    {
+        auto it = m_peerReferences->counts.find(peerId);
+        return it == m_peerReferences->counts.end() ? 0 : it->second;
+    }
+
+    void ContainerPool::setReleaseHandler(std::optional<release_handler_t> handler)
+    {
+        m_peerReferences->releaseHandler = std::move(handler);
+    }
 }
@@ -1,9 +1,156 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #include <dots/Dispatcher.h>
+#include <algorithm>
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <dots/asio.h>
 
 namespace dots
 {
+    struct Dispatcher::worker_state_t
+    {
+        struct handler_t
+        {
+            handler_t(event_handler_t<> handler) :
+                handler{ std::move(handler) }
+            {
+                /* do nothing */
+            }
+
+            event_handler_t<> handler;
+            std::mutex mutex;
+            std::condition_variable released;
+            uint32_t numInvocations = 0;
+            bool removed = false;
+        };
+
+        using handlers_t = std::vector<std::pair<id_t, std::shared_ptr<handler_t>>>;
+
+        using strand_t = asio::strand<asio::thread_pool::executor_type>;
+
+        struct type_t
+        {
+            strand_t strand;
+            std::shared_ptr<const handlers_t> handlers;
+        };
+
+        // note: the header and the transmitted instance are shared with the
+        // dispatched transmission. the updated instance only has to be
+        // copied if it differs from the transmitted instance (i.e. if it is
+        // owned by a container and might be changed by subsequent events)
+        struct event_snapshot_t
+        {
+            io::Transmission transmission;
+            std::optional<type::AnyStruct> updated;
+            DotsCloneInformation cloneInfo;
+            DotsMt mt;
+        };
+
+        worker_state_t(size_t numThreads, error_handler_t errorHandler) :
+            errorHandler{ std::move(errorHandler) },
+            threadPool{ numThreads }
+        {
+            /* do nothing */
+        }
+
+        type_t* findType(const type::StructDescriptor& descriptor)
+        {
+            type::StructDescriptor::type_id_t typeId = descriptor.typeId();
+            return typeId < types.size() && types[typeId] != std::nullopt ? &*types[typeId] : nullptr;
+        }
+
+        type_t& getType(const type::StructDescriptor& descriptor)
+        {
+            if (type::StructDescriptor::type_id_t typeId = descriptor.typeId(); typeId >= types.size())
+            {
+                types.resize(typeId + 1);
+            }
+
+            std::optional<type_t>& type = types[descriptor.typeId()];
+
+            if (type == std::nullopt)
+            {
+                type.emplace(type_t{ asio::make_strand(threadPool), std::make_shared<const handlers_t>() });
+            }
+
+            return *type;
+        }
+
+        void post(const type::StructDescriptor& descriptor, const strand_t& strand, std::shared_ptr<const handlers_t> handlers, std::vector<event_snapshot_t> snapshots)
+        {
+            asio::post(strand, [this, descriptor{ &descriptor }, handlers{ std::move(handlers) }, snapshots{ std::move(snapshots) }]
+            {
+                for (const event_snapshot_t& snapshot : snapshots)
+                {
+                    invoke(*descriptor, *handlers, snapshot);
+                }
+            });
+        }
+
+        void invoke(const type::StructDescriptor& descriptor, const handlers_t& handlers, const event_snapshot_t& snapshot)
+        {
+            const type::Struct& transmitted = *snapshot.transmission.instance();
+            const type::Struct& updated = snapshot.updated == std::nullopt ? transmitted : **snapshot.updated;
+            Event<> event{ snapshot.transmission.header(), transmitted, updated, snapshot.cloneInfo, snapshot.mt };
+
+            for (auto itHandler = handlers.rbegin(); itHandler != handlers.rend(); ++itHandler)
+            {
+                handler_t& handler = *itHandler->second;
+
+                {
+                    std::lock_guard lock{ handler.mutex };
+
+                    // note: the snapshot of the handlers might still contain
+                    // handlers that have been removed after it was posted
+                    if (handler.removed)
+                    {
+                        continue;
+                    }
+
+                    ++handler.numInvocations;
+                }
+
+                // note: the lock is not held while the handler is invoked, so
+                // that the handler can remove itself or other handlers
+                const handler_t* previousHandler = std::exchange(M_currentHandler, &handler);
+
+                try
+                {
+                    handler.handler(event);
+                }
+                catch (...)
+                {
+                    errorHandler(descriptor, std::current_exception());
+                }
+
+                M_currentHandler = previousHandler;
+
+                {
+                    std::lock_guard lock{ handler.mutex };
+
+                    if (--handler.numInvocations == 0)
+                    {
+                        handler.released.notify_all();
+                    }
+                }
+            }
+        }
+
+        inline static thread_local const handler_t* M_currentHandler = nullptr;
+
+        error_handler_t errorHandler;
+        std::mutex mutex;
+        std::vector<std::optional<type_t>> types;
+
+        // note: the thread pool is destroyed first, so that pending handlers
+        // are destroyed before the state they refer to
+        asio::thread_pool threadPool;
+    };
+
     Dispatcher::Dispatcher(error_handler_t handler) :
         m_nextId(0),
         m_errorHandler{ std::move(handler) }
@@ -11,6 +158,11 @@ namespace dots
         /* do nothing */
     }
 
+    Dispatcher::Dispatcher(Dispatcher&& other) noexcept = default;
+    Dispatcher::~Dispatcher() = default;
+
+    Dispatcher& Dispatcher::operator = (Dispatcher&& rhs) noexcept = default;
+
     const ContainerPool& Dispatcher::pool() const
     {
         return m_containerPool;
@@ -34,16 +186,62 @@ namespace dots
     auto Dispatcher::addTransmissionHandler(const type::StructDescriptor& descriptor, transmission_handler_t handler) -> id_t
     {
         id_t id = m_nextId++;
-        m_transmissionHandlerPool[&descriptor].emplace(id, std::move(handler));
+        addHandler(getHandlers(m_transmissionHandlerPool, descriptor), id, std::move(handler));
 
         return id;
     }
 
     auto Dispatcher::addEventHandler(const type::StructDescriptor& descriptor, event_handler_t<> handler) -> id_t
     {
+        if (m_workers != nullptr)
+        {
+            id_t id = m_nextId++;
+            std::optional<worker_state_t::strand_t> strand;
+            std::shared_ptr<const worker_state_t::handlers_t> handlers;
+
+            {
+                std::lock_guard lock{ m_workers->mutex };
+                worker_state_t::type_t& type = m_workers->getType(descriptor);
+                auto handlers_ = std::make_shared<worker_state_t::handlers_t>(*type.handlers);
+                const auto& handler_ = handlers_->emplace_back(id, std::make_shared<worker_state_t::handler_t>(std::move(handler)));
+                handlers = std::make_shared<const worker_state_t::handlers_t>(worker_state_t::handlers_t{ handler_ });
+                type.handlers = std::move(handlers_);
+                strand.emplace(type.strand);
+            }
+
+            // note: the current content of the container is posted to the
+            // new handler only, which ensures that it is handled before any
+            // subsequent events of the type
+            const Container<>& container = m_containerPool.get(descriptor);
+
+            if (!container.empty())
+            {
+                DotsHeader header{
+                    .typeName = descriptor.name(),
+                    .fromCache = static_cast<uint32_t>(container.size()),
+                    .removeObj = false,
+                    .isFromMyself = false
+                };
+
+                std::vector<worker_state_t::event_snapshot_t> snapshots;
+                snapshots.reserve(container.size());
+
+                for (const auto& [instance, cloneInfo] : container)
+                {
+                    header.attributes = instance->_validProperties();
+                    --*header.fromCache;
+                    snapshots.emplace_back(worker_state_t::event_snapshot_t{ io::Transmission{ header, type::AnyStruct{ *instance } }, std::nullopt, cloneInfo, DotsMt::create });
+                }
+
+                m_workers->post(descriptor, *strand, std::move(handlers), std::move(snapshots));
+            }
+
+            return id;
+        }
+
         id_t id = m_nextId++;
-        event_handlers_t& handlers = m_eventHandlerPool[&descriptor];
-        const event_handler_t<>& handler_ = handlers.emplace(id, std::move(handler)).first->second;
+        event_handlers_t& handlers = getHandlers(m_eventHandlerPool, descriptor);
+        const event_handlers_t::entry_t& entry = addHandler(handlers, id, std::move(handler));
 
         const Container<>& container = m_containerPool.get(descriptor);
 
@@ -56,12 +254,31 @@ namespace dots
                 .isFromMyself = false
             };
 
-            for (const auto& [instance, cloneInfo] : container)
+            // note: the table is treated as being dispatched to, so that
+            // the handler is not moved if it adds further handlers
+            ++handlers.dispatching;
+
+            try
+            {
+                for (const auto& [instance, cloneInfo] : container)
+                {
+                    if (entry.removed)
+                    {
+                        break;
+                    }
+
+                    header.attributes = instance->_validProperties();
+                    --*header.fromCache;
+                    entry.handler(Event<>{ header, instance, instance, cloneInfo, DotsMt::create });
+                }
+            }
+            catch (...)
             {
-                header.attributes = instance->_validProperties();
-                --*header.fromCache;
-                handler_(Event<>{ header, instance, instance, cloneInfo, DotsMt::create });
+                finishDispatch(handlers);
+                throw;
             }
+
+            finishDispatch(handlers);
         }
 
         return id;
@@ -74,31 +291,144 @@ namespace dots
 
     void Dispatcher::removeEventHandler(const type::StructDescriptor& descriptor, id_t id)
     {
-        removeHandler(m_eventHandlerPool, descriptor, id);
+        if (m_workers == nullptr)
+        {
+            removeHandler(m_eventHandlerPool, descriptor, id);
+            return;
+        }
+
+        std::shared_ptr<worker_state_t::handler_t> handler;
+
+        {
+            std::lock_guard lock{ m_workers->mutex };
+            worker_state_t::type_t* type = m_workers->findType(descriptor);
+
+            auto isHandler = [id](const auto& handler){ return handler.first == id; };
+
+            if (type == nullptr || std::none_of(type->handlers->begin(), type->handlers->end(), isHandler))
+            {
+                throw std::logic_error{ "cannot remove unknown handler for type: " + descriptor.name() };
+            }
+
+            auto handlers = std::make_shared<worker_state_t::handlers_t>(*type->handlers);
+            auto itHandler = std::find_if(handlers->begin(), handlers->end(), isHandler);
+            handler = std::move(itHandler->second);
+            handlers->erase(itHandler);
+            type->handlers = std::move(handlers);
+        }
+
+        // note: a concurrent invocation on a worker thread is waited for, so
+        // that the handler is never invoked after it has been removed. this
+        // does not apply if the handler removes itself, because its own
+        // invocation can only complete after the removal
+        uint32_t numOwnInvocations = handler.get() == worker_state_t::M_currentHandler ? 1 : 0;
+        std::unique_lock lock{ handler->mutex };
+        handler->removed = true;
+        handler->released.wait(lock, [&]{ return handler->numInvocations <= numOwnInvocations; });
+    }
+
+    void Dispatcher::setWorkerThreads(size_t numThreads)
+    {
+        bool hasHandlers = std::any_of(m_eventHandlerPool.begin(), m_eventHandlerPool.end(), [](const event_handlers_t& handlers){ return !handlers.empty(); });
+
+        if (m_workers != nullptr)
+        {
+            std::lock_guard lock{ m_workers->mutex };
+            hasHandlers = hasHandlers || std::any_of(m_workers->types.begin(), m_workers->types.end(), [](const std::optional<worker_state_t::type_t>& type)
+            {
+                return type != std::nullopt && !type->handlers->empty();
+            });
+        }
+
+        if (hasHandlers)
+        {
+            throw std::logic_error{ "attempt to change worker threads while event handlers are registered" };
+        }
+
+        m_workers = numThreads == 0 ? nullptr : std::make_unique<worker_state_t>(numThreads, m_errorHandler);
     }
 
     void Dispatcher::dispatch(const io::Transmission& transmission)
     {
         dispatchTransmission(transmission);
-        dispatchEvent(transmission.header(), transmission.instance());
+
+        // note: instances of uncached types are only accessed if there are
+        // event handlers for the type, which allows undecoded transmissions
+        // to be dispatched without decoding them (see io::Transmission)
+        const type::StructDescriptor& descriptor = transmission.descriptor();
+
+        if (descriptor.cached() || transmission.header().removeObj == true || hasEventHandlers(descriptor))
+        {
+            dispatchEvent(transmission);
+        }
+    }
+
+    template <typename HandlerPool>
+    typename HandlerPool::value_type* Dispatcher::findHandlers(HandlerPool& handlerPool, const type::StructDescriptor& descriptor)
+    {
+        type::StructDescriptor::type_id_t typeId = descriptor.typeId();
+        return typeId < handlerPool.size() ? &handlerPool[typeId] : nullptr;
+    }
+
+    template <typename HandlerPool>
+    typename HandlerPool::value_type& Dispatcher::getHandlers(HandlerPool& handlerPool, const type::StructDescriptor& descriptor)
+    {
+        if (type::StructDescriptor::type_id_t typeId = descriptor.typeId(); typeId >= handlerPool.size())
+        {
+            handlerPool.resize(typeId + 1);
+        }
+
+        return handlerPool[descriptor.typeId()];
+    }
+
+    template <typename Handler>
+    auto Dispatcher::addHandler(handler_table_t<Handler>& handlers, id_t id, Handler handler) -> typename handler_table_t<Handler>::entry_t&
+    {
+        ++handlers.numHandlers;
+
+        // note: ids are strictly increasing, so appending the handler keeps
+        // the table sorted
+        if (handlers.dispatching > 0)
+        {
+            return handlers.deferred.emplace_back(typename handler_table_t<Handler>::entry_t{ id, std::move(handler), false });
+        }
+        else
+        {
+            return handlers.entries.emplace_back(typename handler_table_t<Handler>::entry_t{ id, std::move(handler), false });
+        }
     }
 
     template <typename HandlerPool>
     void Dispatcher::removeHandler(HandlerPool& handlerPool, const type::StructDescriptor& descriptor, id_t id)
     {
-        if (auto itHandlers = handlerPool.find(&descriptor); itHandlers != handlerPool.end())
+        if (auto* handlers_ = findHandlers(handlerPool, descriptor); handlers_ != nullptr)
         {
-            auto& handlers = itHandlers->second;
+            auto& handlers = *handlers_;
+            typename HandlerPool::value_type::entry_t* entry = nullptr;
 
-            if (auto itHandler = handlers.find(id); itHandler != handlers.end())
+            if (auto itEntry = std::lower_bound(handlers.entries.begin(), handlers.entries.end(), id, [](const auto& entry_, id_t id_){ return entry_.id < id_; }); itEntry != handlers.entries.end() && itEntry->id == id)
             {
-                if (id == m_currentlyDispatchingId)
+                entry = &*itEntry;
+            }
+            else if (auto itDeferred = std::find_if(handlers.deferred.begin(), handlers.deferred.end(), [id](const auto& entry_){ return entry_.id == id; }); itDeferred != handlers.deferred.end())
+            {
+                entry = &*itDeferred;
+            }
+
+            if (entry != nullptr && !entry->removed)
+            {
+                --handlers.numHandlers;
+
+                // note: deferred handlers only exist while the table is being
+                // dispatched to and are therefore always marked as removed
+                if (handlers.dispatching > 0)
                 {
-                    m_removeIds.emplace_back(id);
+                    entry->removed = true;
+                    ++handlers.numRemoved;
                 }
                 else
                 {
-                    handlers.erase(itHandler);
+                    handlers.entries.erase(handlers.entries.begin() + (entry - handlers.entries.data()));
                 }
 
                 return;
@@ -108,25 +438,62 @@ namespace dots
         throw std::logic_error{ "cannot remove unknown handler for type: " + descriptor.name() };
     }
 
+    template <typename Handler>
+    void Dispatcher::finishDispatch(handler_table_t<Handler>& handlers)
+    {
+        if (--handlers.dispatching > 0)
+        {
+            return;
+        }
+
+        if (handlers.numRemoved > 0)
+        {
+            auto isRemoved = [](const auto& entry){ return entry.removed; };
+            handlers.entries.erase(std::remove_if(handlers.entries.begin(), handlers.entries.end(), isRemoved), handlers.entries.end());
+            handlers.deferred.erase(std::remove_if(handlers.deferred.begin(), handlers.deferred.end(), isRemoved), handlers.deferred.end());
+            handlers.numRemoved = 0;
+        }
+
+        std::move(handlers.deferred.begin(), handlers.deferred.end(), std::back_inserter(handlers.entries));
+        handlers.deferred.clear();
+    }
+
+    bool Dispatcher::hasEventHandlers(const type::StructDescriptor& descriptor)
+    {
+        if (m_workers != nullptr)
+        {
+            std::lock_guard lock{ m_workers->mutex };
+            const worker_state_t::type_t* type = m_workers->findType(descriptor);
+
+            return type != nullptr && !type->handlers->empty();
+        }
+        else
+        {
+            const event_handlers_t* handlers = findHandlers(m_eventHandlerPool, descriptor);
+            return handlers != nullptr && !handlers->empty();
+        }
+    }
+
     void Dispatcher::dispatchTransmission(const io::Transmission& transmission)
     {
-        const type::StructDescriptor& descriptor = transmission.instance()->_descriptor();
+        const type::StructDescriptor& descriptor = transmission.descriptor();
 
-        auto itHandlers = m_transmissionHandlerPool.find(&descriptor);
+        transmission_handlers_t* handlers = findHandlers(m_transmissionHandlerPool, descriptor);
 
-        if (itHandlers == m_transmissionHandlerPool.end())
+        if (handlers == nullptr || handlers->empty())
         {
             return;
         }
 
-        transmission_handlers_t& handlers = itHandlers->second;
-        dispatchToHandlers(descriptor, handlers, transmission);
+        dispatchToHandlers(descriptor, *handlers, transmission);
     }
 
-    void Dispatcher::dispatchEvent(const DotsHeader& header, const type::AnyStruct& instance)
+    void Dispatcher::dispatchEvent(const io::Transmission& transmission)
     {
+        const DotsHeader& header = transmission.header();
+        const type::AnyStruct& instance = transmission.instance();
         const type::StructDescriptor& descriptor = instance->_descriptor();
-        event_handlers_t& handlers = m_eventHandlerPool[&descriptor];
+        event_handlers_t* handlers = findHandlers(m_eventHandlerPool, descriptor);
 
         if (descriptor.cached())
         {
@@ -136,13 +503,13 @@ namespace dots
             {
                 if (Container<>::node_t removed = container.remove(header, instance); !removed.empty())
                 {
-                    dispatchToHandlers(descriptor, handlers, Event<>{ header, instance, removed.key(), removed.mapped() });
+                    dispatchEvent(descriptor, handlers, transmission, Event<>{ header, instance, removed.key(), removed.mapped() });
                 }
             }
             else
             {
                 const auto& [updated, cloneInfo] = container.insert(header, instance);
-                dispatchToHandlers(descriptor, handlers, Event<>{ header, instance, updated, cloneInfo });
+                dispatchEvent(descriptor, handlers, transmission, Event<>{ header, instance, updated, cloneInfo });
             }
         }
         else
@@ -159,33 +526,72 @@ namespace dots
                 .localUpdateTime = timepoint_t::Now()
             };
 
-            dispatchToHandlers(descriptor, handlers, Event<>{ header, instance, instance, cloneInfo });
+            dispatchEvent(descriptor, handlers, transmission, Event<>{ header, instance, instance, cloneInfo });
         }
     }
 
-    template <typename Handlers, typename Dispatchable>
-    void Dispatcher::dispatchToHandlers(const type::StructDescriptor& descriptor, Handlers& handlers, const Dispatchable& dispatchable)
+    void Dispatcher::dispatchEvent(const type::StructDescriptor& descriptor, event_handlers_t* handlers, const io::Transmission& transmission, const Event<>& event)
     {
-        for (const auto& [id, handler] : handlers)
+        if (m_workers == nullptr)
         {
-            try
+            if (handlers != nullptr && !handlers->empty())
             {
-                m_currentlyDispatchingId = id;
-                handler(dispatchable);
+                dispatchToHandlers(descriptor, *handlers, event);
             }
-            catch (...)
+
+            return;
+        }
+
+        std::optional<worker_state_t::strand_t> strand;
+        std::shared_ptr<const worker_state_t::handlers_t> workerHandlers;
+
+        {
+            std::lock_guard lock{ m_workers->mutex };
+            const worker_state_t::type_t* type = m_workers->findType(descriptor);
+
+            if (type == nullptr || type->handlers->empty())
             {
-                m_errorHandler(descriptor, std::current_exception());
+                return;
             }
 
-            m_currentlyDispatchingId = std::nullopt;
+            strand.emplace(type->strand);
+            workerHandlers = type->handlers;
         }
 
-        for (id_t id : m_removeIds)
+        std::optional<type::AnyStruct> updated;
+
+        if (&event.updated() != &event.transmitted())
         {
-            handlers.erase(id);
+            updated.emplace(event.updated());
+        }
+
+        std::vector<worker_state_t::event_snapshot_t> snapshots;
+        snapshots.emplace_back(worker_state_t::event_snapshot_t{ transmission.share(), std::move(updated), event.cloneInfo(), event.mt() });
+        m_workers->post(descriptor, *strand, std::move(workerHandlers), std::move(snapshots));
+    }
+
+    template <typename Handler, typename Dispatchable>
+    void Dispatcher::dispatchToHandlers(const type::StructDescriptor& descriptor, handler_table_t<Handler>& handlers, const Dispatchable& dispatchable)
+    {
+        ++handlers.dispatching;
+
+        for (auto itEntry = handlers.entries.rbegin(); itEntry != handlers.entries.rend(); ++itEntry)
+        {
+            if (itEntry->removed)
+            {
+                continue;
+            }
+
+            try
+            {
+                itEntry->handler(dispatchable);
+            }
+            catch (...)
+            {
+                m_errorHandler(descriptor, std::current_exception());
+            }
         }
 
-        m_removeIds.clear();
+        finishDispatch(handlers);
     }
 }
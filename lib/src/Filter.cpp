@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/Filter.h>
+#include <algorithm>
+#include <dots/serialization/StringSerializer.h>
+
+namespace dots
+{
+    Filter::Filter(const type::StructDescriptor& descriptor, const std::vector<DotsFilterCondition>& conditions) :
+        m_descriptor(&descriptor)
+    {
+        for (const DotsFilterCondition& condition : conditions)
+        {
+            condition._assertHasProperties(DotsFilterCondition::propertyName_p + DotsFilterCondition::comparison_p + DotsFilterCondition::values_p);
+
+            const type::property_descriptor_container_t& propertyDescriptors = descriptor.propertyDescriptors();
+            auto itProperty = std::find_if(propertyDescriptors.begin(), propertyDescriptors.end(), [&](const type::PropertyDescriptor& propertyDescriptor)
+            {
+                return propertyDescriptor.name() == *condition.propertyName;
+            });
+
+            if (itProperty == propertyDescriptors.end())
+            {
+                throw std::runtime_error{ "filter refers to unknown property '" + *condition.propertyName + "' of type '" + descriptor.name() + "'" };
+            }
+
+            const type::PropertyDescriptor& propertyDescriptor = *itProperty;
+
+            bool multipleValues = condition.comparison == DotsFilterComparison::oneOf || condition.comparison == DotsFilterComparison::noneOf;
+
+            if (condition.values->empty() || (!multipleValues && condition.values->size() > 1))
+            {
+                throw std::runtime_error{ "filter condition on property '" + *condition.propertyName + "' has an invalid amount of values: " + std::to_string(condition.values->size()) };
+            }
+
+            condition_t& filterCondition = m_conditions.emplace_back(condition_t{
+                .property = propertyDescriptor.set(),
+                .comparison = *condition.comparison,
+                .values = {}
+            });
+
+            for (const std::string& value : *condition.values)
+            {
+                type::AnyStruct& operand = filterCondition.values.emplace_back(descriptor);
+                type::ProxyProperty<> property{ *operand, propertyDescriptor };
+                const type::Descriptor<>& valueDescriptor = propertyDescriptor.valueDescriptor();
+
+                // note: values of string properties are used verbatim to
+                // spare users from having to quote them
+                if (valueDescriptor.type() == type::Type::string)
+                {
+                    property.emplace(type::Typeless::From(value));
+                }
+                else
+                {
+                    try
+                    {
+                        from_string(value, property.emplace(), valueDescriptor);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        throw std::runtime_error{ "filter condition on property '" + *condition.propertyName + "' has invalid value '" + value + "' -> " + e.what() };
+                    }
+                }
+            }
+
+            m_properties += filterCondition.property;
+        }
+    }
+
+    const type::StructDescriptor& Filter::descriptor() const
+    {
+        return *m_descriptor;
+    }
+
+    property_set_t Filter::properties() const
+    {
+        return m_properties;
+    }
+
+    bool Filter::matches(const type::Struct& instance) const
+    {
+        return std::all_of(m_conditions.begin(), m_conditions.end(), [&](const condition_t& condition)
+        {
+            return Matches(condition, instance);
+        });
+    }
+
+    bool Filter::Matches(const condition_t& condition, const type::Struct& instance)
+    {
+        if (!instance._hasProperties(condition.property))
+        {
+            return false;
+        }
+
+        auto equals = [&](const type::AnyStruct& value){ return instance._equal(value, condition.property); };
+        const type::Struct& value = condition.values.front();
+
+        switch (condition.comparison)
+        {
+            case DotsFilterComparison::equal:        return instance._equal(value, condition.property);
+            case DotsFilterComparison::notEqual:     return !instance._equal(value, condition.property);
+            case DotsFilterComparison::less:         return instance._less(value, condition.property);
+            case DotsFilterComparison::lessEqual:    return instance._lessEqual(value, condition.property);
+            case DotsFilterComparison::greater:      return instance._greater(value, condition.property);
+            case DotsFilterComparison::greaterEqual: return instance._greaterEqual(value, condition.property);
+            case DotsFilterComparison::oneOf:        return std::any_of(condition.values.begin(), condition.values.end(), equals);
+            case DotsFilterComparison::noneOf:       return std::none_of(condition.values.begin(), condition.values.end(), equals);
+        }
+
+        return false;
+    }
+}
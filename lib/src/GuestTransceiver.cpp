@@ -1,7 +1,9 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #include <dots/GuestTransceiver.h>
+#include <algorithm>
 #include <dots/tools/logging.h>
+#include <dots/io/WorkerPool.h>
 #include <dots/serialization/AsciiSerialization.h>
 #include <DotsMember.dots.h>
 #include <DotsCacheInfo.dots.h>
@@ -12,9 +14,20 @@ namespace dots
                                        asio::io_context& ioContext,
                                        type::Registry::StaticTypePolicy staticTypePolicy /*= type::Registry::StaticTypePolicy::All*/,
                                        std::optional<transition_handler_t> transitionHandler/* = std::nullopt*/) :
-        Transceiver(std::move(selfName), ioContext, staticTypePolicy, std::move(transitionHandler))
+        Transceiver(std::move(selfName), ioContext, staticTypePolicy, std::move(transitionHandler)),
+        m_latencyRecording(false),
+        m_multicast(false),
+        m_reconnect(false),
+        m_connecting(false),
+        m_rejoin(false),
+        m_minReconnectBackoff(std::chrono::milliseconds{ 100 }),
+        m_maxReconnectBackoff(std::chrono::seconds{ 10 }),
+        m_reconnectBackoff(m_minReconnectBackoff),
+        m_reconnectTimer{ ioContext },
+        m_publishQueue{ std::make_shared<publish_queue_t>() }
     {
         type::Descriptor<DotsCacheInfo>::Instance();
+        type::Descriptor<DotsMulticast>::Instance();
     }
 
     GuestTransceiver::~GuestTransceiver()
@@ -44,6 +57,7 @@ namespace dots
 
         m_preloadPublishTypes = std::move(preloadPublishTypes);
         m_preloadSubscribeTypes = std::move(preloadSubscribeTypes);
+        m_connecting = false;
 
         m_hostConnection = std::make_unique<Connection>(std::move(channel), false, std::move(authSecret));
         m_hostConnection->asyncReceive(registry(), nullptr, selfName(),
@@ -61,6 +75,14 @@ namespace dots
 
     void GuestTransceiver::publish(const type::Struct& instance, std::optional<property_set_t> includedProperties/* = std::nullopt*/, bool remove/* = false*/)
     {
+        // note: handlers that are invoked on worker threads (see
+        // setHandlerThreads()) cannot access the connection directly
+        if (io::WorkerPool::RunningInWorkerThread())
+        {
+            postPublish(instance, includedProperties, remove);
+            return;
+        }
+
         if (const type::StructDescriptor& descriptor = instance._descriptor(); descriptor.substructOnly())
         {
             throw std::logic_error{ "attempt to publish substruct-only type '" + descriptor.name() + "'" };
@@ -96,14 +118,127 @@ namespace dots
         }
     }
 
+    void GuestTransceiver::publish(const io::Channel::instance_batch_t& instances, std::optional<property_set_t> includedProperties/* = std::nullopt*/, bool remove/* = false*/)
+    {
+        if (instances.empty())
+        {
+            return;
+        }
+
+        if (io::WorkerPool::RunningInWorkerThread())
+        {
+            for (const type::Struct& instance : instances)
+            {
+                postPublish(instance, includedProperties, remove);
+            }
+
+            return;
+        }
+
+        const type::StructDescriptor& descriptor = instances.front().get()._descriptor();
+
+        if (descriptor.substructOnly())
+        {
+            throw std::logic_error{ "attempt to publish substruct-only type '" + descriptor.name() + "'" };
+        }
+
+        for (const type::Struct& instance : instances)
+        {
+            if (&instance._descriptor() != &descriptor)
+            {
+                throw std::logic_error{ "attempt to publish instances of different types '" + descriptor.name() + "' and '" + instance._descriptor().name() + "' at once" };
+            }
+
+            if (!(instance._keyProperties() <= instance._validProperties()))
+            {
+                throw std::runtime_error("attempt to publish instance with missing key properties '" + (instance._keyProperties() - instance._validProperties()).toString() + "'");
+            }
+        }
+
+        if (includedProperties != std::nullopt)
+        {
+            *includedProperties += descriptor.keyProperties();
+            *includedProperties ^= descriptor.properties();
+        }
+
+        if (m_hostConnection == nullptr)
+        {
+            throw std::runtime_error{ "attempt to publish on closed connection" };
+        }
+
+        try
+        {
+            for (auto itBegin = instances.begin(); itBegin != instances.end();)
+            {
+                auto itEnd = instances.end();
+                property_set_t batchProperties;
+
+                if (includedProperties == std::nullopt)
+                {
+                    batchProperties = itBegin->get()._validProperties();
+                    itEnd = std::find_if(std::next(itBegin), instances.end(), [&batchProperties](const type::Struct& instance)
+                    {
+                        return instance._validProperties() != batchProperties;
+                    });
+                }
+                else
+                {
+                    batchProperties = *includedProperties;
+                }
+
+                DotsHeader header{
+                    .typeName = descriptor.name(),
+                    .sentTime = timepoint_t::Now(),
+                    .attributes = batchProperties,
+                    .removeObj = remove
+                };
+
+                if (itBegin == instances.begin() && itEnd == instances.end())
+                {
+                    m_hostConnection->transmit(header, instances);
+                }
+                else
+                {
+                    m_hostConnection->transmit(header, io::Channel::instance_batch_t(itBegin, itEnd));
+                }
+
+                itBegin = itEnd;
+            }
+        }
+        catch (...)
+        {
+            m_hostConnection->handleError(std::current_exception());
+        }
+    }
+
+    void GuestTransceiver::postPublish(const type::Struct& instance, std::optional<property_set_t> includedProperties/* = std::nullopt*/, bool remove/* = false*/)
+    {
+        submitPublish(type::AnyStruct{ instance }, includedProperties, remove);
+    }
+
+    void GuestTransceiver::postPublish(type::Struct&& instance, std::optional<property_set_t> includedProperties/* = std::nullopt*/, bool remove/* = false*/)
+    {
+        type::AnyStruct instance_{ instance._descriptor() };
+        instance_->_assign(std::move(instance));
+        submitPublish(std::move(instance_), includedProperties, remove);
+    }
+
     void GuestTransceiver::joinGroup(std::string_view name)
     {
         if (m_joinedGroups.count(std::string(name)) == 0)
         {
-            publish(DotsMember{
-                .groupName = name,
-                .event = DotsMemberEvent::join
-            });
+            // note: groups that are joined while no connection is open (e.g.
+            // while reconnecting) are joined after the connection has been
+            // established
+            if (m_hostConnection == nullptr)
+            {
+                m_rejoin = true;
+            }
+            else
+            {
+                transmitJoin(name);
+            }
+
             m_joinedGroups.insert(std::string(name));
         }
     }
@@ -112,26 +247,637 @@ namespace dots
     {
         if (m_joinedGroups.count(std::string(name)))
         {
-            publish(DotsMember{
-                .groupName = name,
-                .event = DotsMemberEvent::leave
-            });
+            if (m_hostConnection != nullptr)
+            {
+                publish(DotsMember{
+                    .groupName = name,
+                    .event = DotsMemberEvent::leave
+                });
+            }
+
             m_joinedGroups.erase(std::string(name));
+
+            if (auto it = m_multicastGroups.find(name); it != m_multicastGroups.end())
+            {
+                m_multicastGroups.erase(it);
+            }
+        }
+    }
+
+    void GuestTransceiver::setFilter(const type::StructDescriptor& descriptor, std::vector<DotsFilterCondition> conditions)
+    {
+        if (descriptor.substructOnly())
+        {
+            throw std::logic_error{ "attempt to filter substruct-only type '" + descriptor.name() + "'" };
+        }
+
+        if (conditions.empty())
+        {
+            m_filters.erase(descriptor.name());
+        }
+        else
+        {
+            m_filters.insert_or_assign(descriptor.name(), std::move(conditions));
+        }
+
+        if (m_joinedGroups.count(descriptor.name()) > 0 && m_hostConnection != nullptr)
+        {
+            transmitJoin(descriptor.name());
+        }
+    }
+
+    void GuestTransceiver::setProjection(const type::StructDescriptor& descriptor, std::optional<property_set_t> projection)
+    {
+        if (descriptor.substructOnly() || !descriptor.cached())
+        {
+            throw std::logic_error{ "attempt to project substruct-only or uncached type '" + descriptor.name() + "'" };
+        }
+
+        if (projection == std::nullopt)
+        {
+            m_projections.erase(descriptor.name());
+            dispatcher().pool().get(descriptor).setProjection(property_set_t::All);
+        }
+        else
+        {
+            m_projections.insert_or_assign(descriptor.name(), *projection);
+            dispatcher().pool().get(descriptor).setProjection(*projection);
+        }
+
+        if (m_joinedGroups.count(descriptor.name()) > 0 && m_hostConnection != nullptr)
+        {
+            transmitJoin(descriptor.name());
+        }
+    }
+
+    void GuestTransceiver::transmitJoin(std::string_view name)
+    {
+        // note: joining a group again ends the reception via multicast, so
+        // the transmissions that have not yet been received are requested
+        // via the connection first
+        fallBackFromMulticast(name);
+
+        DotsMember member{
+            .groupName = name,
+            .event = DotsMemberEvent::join
+        };
+
+        auto itFilter = m_filters.find(name);
+        auto itProjection = m_projections.find(name);
+
+        if (m_multicast && itFilter == m_filters.end())
+        {
+            member.multicast = true;
+        }
+
+        if (itFilter != m_filters.end())
+        {
+            member.filter = vector_t<DotsFilterCondition>{ itFilter->second.begin(), itFilter->second.end() };
+        }
+
+        if (itProjection != m_projections.end())
+        {
+            member.projection = itProjection->second;
+        }
+
+        // note: the host can only evaluate filters and projections of types
+        // it knows, so the descriptor is exported before joining the group
+        if ((itFilter != m_filters.end() || itProjection != m_projections.end()) && m_hostConnection != nullptr)
+        {
+            m_hostConnection->transmit(registry().getStructType(name));
+        }
+
+        publish(member);
+    }
+
+    void GuestTransceiver::setMulticast(bool enabled, std::optional<std::string> interfaceAddress/* = std::nullopt*/)
+    {
+        m_multicast = enabled;
+        m_multicastInterface = std::move(interfaceAddress);
+    }
+
+    void GuestTransceiver::asyncOpen(type::DescriptorMap preloadPublishTypes, type::DescriptorMap preloadSubscribeTypes, io::Endpoint endpoint)
+    {
+        if (m_hostConnection != nullptr || m_connecting)
+        {
+            throw std::logic_error{ "attempt to open connection while already connected" };
+        }
+
+        m_preloadPublishTypes = std::move(preloadPublishTypes);
+        m_preloadSubscribeTypes = std::move(preloadSubscribeTypes);
+        m_openEndpoint = std::move(endpoint);
+        m_reconnectBackoff = m_minReconnectBackoff;
+        m_connecting = true;
+
+        asyncConnect();
+    }
+
+    void GuestTransceiver::asyncOpen(io::Endpoint endpoint)
+    {
+        asyncOpen({}, {}, std::move(endpoint));
+    }
+
+    void GuestTransceiver::setReconnect(bool enabled, std::chrono::milliseconds minBackoff/* = std::chrono::milliseconds{ 100 }*/, std::chrono::milliseconds maxBackoff/* = std::chrono::seconds{ 10 }*/)
+    {
+        if (minBackoff.count() <= 0 || maxBackoff < minBackoff)
+        {
+            throw std::logic_error{ "reconnect backoff must be positive and the maximum must not be less than the minimum" };
+        }
+
+        m_reconnect = enabled;
+        m_minReconnectBackoff = minBackoff;
+        m_maxReconnectBackoff = maxBackoff;
+        m_reconnectBackoff = minBackoff;
+    }
+
+    void GuestTransceiver::setHandlerThreads(size_t numThreads)
+    {
+        dispatcher().setWorkerThreads(numThreads);
+    }
+
+    void GuestTransceiver::setLatencyRecording(bool enabled)
+    {
+        m_latencyRecording = enabled;
+    }
+
+    std::vector<DotsTypeLatency> GuestTransceiver::typeLatencies() const
+    {
+        std::vector<DotsTypeLatency> typeLatencies;
+
+        for (type::StructDescriptor::type_id_t typeId = 0; typeId < m_typeLatencies.size(); ++typeId)
+        {
+            const LatencyHistogram* delivery = m_typeLatencies[typeId].get();
+
+            if (delivery == nullptr || delivery->count() == 0)
+            {
+                continue;
+            }
+
+            if (const type::StructDescriptor* descriptor = registry().findStructType(typeId); descriptor != nullptr)
+            {
+                typeLatencies.emplace_back(DotsTypeLatency{
+                    .typeName = descriptor->name(),
+                    .delivery = delivery->statistics()
+                });
+            }
+        }
+
+        return typeLatencies;
+    }
+
+    void GuestTransceiver::resetLatencies()
+    {
+        for (const std::unique_ptr<LatencyHistogram>& delivery : m_typeLatencies)
+        {
+            if (delivery != nullptr)
+            {
+                delivery->reset();
+            }
         }
     }
 
     bool GuestTransceiver::handleTransmission(Connection&/* connection*/, io::Transmission transmission)
     {
+        if (&transmission.descriptor() == &DotsMulticast::_Descriptor())
+        {
+            handleMulticastMessage(*transmission.instance().as<DotsMulticast>());
+            return true;
+        }
+
+        if (m_latencyRecording)
+        {
+            recordLatency(transmission);
+        }
+
+        if (!m_resyncs.empty())
+        {
+            if (&transmission.descriptor() == &DotsCacheInfo::_Descriptor())
+            {
+                completeResync(*transmission.instance().as<DotsCacheInfo>());
+            }
+            else if (!resyncTransmission(transmission))
+            {
+                return true;
+            }
+        }
+
         dispatcher().dispatch(transmission);
         return true;
     }
 
+    bool GuestTransceiver::resyncTransmission(io::Transmission& transmission)
+    {
+        auto it = m_resyncs.find(&transmission.descriptor());
+
+        if (it == m_resyncs.end())
+        {
+            return true;
+        }
+
+        const type::Struct& instance = transmission.instance();
+
+        if (auto itStale = it->second.find(instance); itStale != it->second.end())
+        {
+            it->second.erase(itStale);
+        }
+
+        DotsHeader& header = transmission.header();
+
+        // note: only instances of the snapshot are complete, whereas regular
+        // updates that are received in the meantime are dispatched as usual
+        if (header.removeObj == true || !header.fromCache.isValid())
+        {
+            return true;
+        }
+
+        const Container<>::value_t* clone = dispatcher().pool().get(transmission.descriptor()).findClone(instance);
+
+        if (clone == nullptr)
+        {
+            return true;
+        }
+
+        // note: the clone might have been updated by the host while the
+        // connection was lost, so only the properties that actually differ
+        // (including properties that are no longer valid) are dispatched
+        const type::Struct& cloneInstance = clone->first;
+        property_set_t keyProperties = instance._keyProperties();
+        property_set_t changedProperties = instance._diffProperties(cloneInstance, (*header.attributes + cloneInstance._validProperties()) - keyProperties);
+
+        if (changedProperties.empty())
+        {
+            return false;
+        }
+
+        header.attributes = keyProperties + changedProperties;
+
+        return true;
+    }
+
+    void GuestTransceiver::completeResync(const DotsCacheInfo& cacheInfo)
+    {
+        if (cacheInfo.endTransmission != true || !cacheInfo.typeName.isValid())
+        {
+            return;
+        }
+
+        const type::StructDescriptor* descriptor = registry().findStructType(*cacheInfo.typeName);
+
+        if (descriptor == nullptr)
+        {
+            return;
+        }
+
+        auto it = m_resyncs.find(descriptor);
+
+        if (it == m_resyncs.end())
+        {
+            return;
+        }
+
+        // note: instances that were not part of the snapshot no longer exist
+        // at the host and are therefore removed
+        auto staleInstances = std::move(it->second);
+        m_resyncs.erase(it);
+
+        for (const type::AnyStruct& instance : staleInstances)
+        {
+            DotsHeader header{
+                .typeName = descriptor->name(),
+                .sentTime = timepoint_t::Now(),
+                .attributes = instance->_keyProperties(),
+                .sender = Connection::HostId,
+                .removeObj = true,
+                .isFromMyself = false
+            };
+
+            dispatcher().dispatch(io::Transmission{ std::move(header), instance });
+        }
+
+        LOG_DEBUG_S("resynchronized cache of type '" << descriptor->name() << "' with host (removed " << staleInstances.size() << " stale instances)");
+    }
+
+    void GuestTransceiver::rejoinGroups(Connection& connection)
+    {
+        m_rejoin = false;
+
+        for (const std::string& name : m_joinedGroups)
+        {
+            const type::StructDescriptor* descriptor = registry().findStructType(name);
+
+            // note: the keys of all instances that are cached while
+            // reconnecting are recorded, so that the instances that are
+            // missing in the snapshot of the host can be removed afterwards
+            if (descriptor != nullptr && descriptor->cached())
+            {
+                const Container<>& container = dispatcher().container(*descriptor);
+                auto& staleInstances = m_resyncs.try_emplace(descriptor, Container<>::key_compare{ *descriptor }).first->second;
+
+                for (const auto& [instance, cloneInfo] : container)
+                {
+                    (void)cloneInfo;
+                    type::AnyStruct key{ *descriptor };
+                    key->_copy(*instance, instance->_keyProperties());
+                    staleInstances.emplace(std::move(key));
+                }
+            }
+
+            // note: the host might have been restarted and therefore no
+            // longer know the descriptor
+            if (descriptor != nullptr && !descriptor->internal())
+            {
+                connection.transmit(*descriptor);
+            }
+
+            transmitJoin(name);
+        }
+    }
+
+    void GuestTransceiver::submitPublish(type::AnyStruct instance, std::optional<property_set_t> includedProperties, bool remove)
+    {
+        if (const type::StructDescriptor& descriptor = instance->_descriptor(); descriptor.substructOnly())
+        {
+            throw std::logic_error{ "attempt to publish substruct-only type '" + descriptor.name() + "'" };
+        }
+
+        if (!(instance->_keyProperties() <= instance->_validProperties()))
+        {
+            throw std::runtime_error("attempt to publish instance with missing key properties '" + (instance->_keyProperties() - instance->_validProperties()).toString() + "'");
+        }
+
+        m_publishQueue->requests.push(publish_request_t{ std::move(instance), includedProperties, remove });
+        schedulePublishDrain();
+    }
+
+    void GuestTransceiver::schedulePublishDrain()
+    {
+        // note: a drain is only posted for the first request that is
+        // submitted after the queue has last been drained, so that the
+        // event loop is not flooded with handlers
+        if (m_publishQueue->drainPending.exchange(true, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        asio::post(ioContext(), [this, publishQueue{ std::weak_ptr<publish_queue_t>{ m_publishQueue } }]
+        {
+            if (publishQueue.lock() != nullptr)
+            {
+                drainPublishQueue();
+            }
+        });
+    }
+
+    void GuestTransceiver::drainPublishQueue()
+    {
+        // note: the flag is reset before the queue is drained, so that
+        // requests that are submitted in the meantime post another drain
+        m_publishQueue->drainPending.exchange(false, std::memory_order_acq_rel);
+
+        std::vector<publish_request_t> requests;
+
+        while (requests.size() < PublishQueueDrainSize)
+        {
+            std::optional<publish_request_t> request = m_publishQueue->requests.tryPop();
+
+            if (request == std::nullopt)
+            {
+                break;
+            }
+
+            requests.emplace_back(std::move(*request));
+        }
+
+        // note: the amount of requests that are handled at once is limited
+        // to not starve other handlers of the event loop
+        if (requests.size() == PublishQueueDrainSize)
+        {
+            schedulePublishDrain();
+        }
+
+        io::Channel::instance_batch_t batch;
+
+        for (auto itBegin = requests.begin(); itBegin != requests.end();)
+        {
+            if (m_hostConnection == nullptr)
+            {
+                LOG_WARN_S("discarding " << std::distance(itBegin, requests.end()) << " instances that were published from other threads while no connection was open");
+                break;
+            }
+
+            auto itEnd = std::find_if(std::next(itBegin), requests.end(), [&itBegin](const publish_request_t& request)
+            {
+                return &request.instance->_descriptor() != &itBegin->instance->_descriptor() || request.includedProperties != itBegin->includedProperties || request.remove != itBegin->remove;
+            });
+
+            batch.clear();
+
+            for (auto it = itBegin; it != itEnd; ++it)
+            {
+                batch.emplace_back(*it->instance);
+            }
+
+            // note: the drain is invoked by the IO context, so errors must
+            // not escape, because that would discard the remaining requests
+            try
+            {
+                publish(batch, itBegin->includedProperties, itBegin->remove);
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR_S("error while publishing " << batch.size() << " instances of type '" << itBegin->instance->_descriptor().name() << "' -> " << e.what());
+            }
+            catch (...)
+            {
+                LOG_ERROR_S("error while publishing " << batch.size() << " instances of type '" << itBegin->instance->_descriptor().name() << "' -> <unknown>");
+            }
+
+            itBegin = itEnd;
+        }
+    }
+
+    void GuestTransceiver::handleMulticastMessage(const DotsMulticast& multicast)
+    {
+        multicast._assertHasProperties(DotsMulticast::groupName_p + DotsMulticast::event_p);
+        const std::string& groupName = *multicast.groupName;
+
+        if (multicast.event == DotsMulticastEvent::offer)
+        {
+            multicast._assertHasProperties(DotsMulticast::endpoint_p);
+
+            // note: the group might have been left or joined again in the
+            // meantime, in which case the host will send another offer
+            if (!m_multicast || m_joinedGroups.count(groupName) == 0 || m_multicastGroups.count(groupName) > 0)
+            {
+                return;
+            }
+
+            try
+            {
+                auto receiver = std::make_unique<io::MulticastReceiver>(ioContext(), io::Endpoint{ *multicast.endpoint }, registry().getStructType(groupName), m_multicastInterface);
+                receiver->asyncReceive(
+                    { &GuestTransceiver::handleMulticastTransmission, this, groupName },
+                    { &GuestTransceiver::handleMulticastError, this, groupName }
+                );
+                m_multicastGroups.emplace(groupName, multicast_group_t{ std::move(receiver) });
+            }
+            catch (const std::exception& e)
+            {
+                LOG_WARN_S("could not receive group '" << groupName << "' via multicast -> " << e.what());
+                return;
+            }
+
+            publish(DotsMulticast{
+                .groupName = groupName,
+                .event = DotsMulticastEvent::join
+            });
+        }
+        else if (multicast.event == DotsMulticastEvent::start)
+        {
+            multicast._assertHasProperties(DotsMulticast::sequence_p);
+
+            if (auto it = m_multicastGroups.find(groupName); it != m_multicastGroups.end())
+            {
+                it->second.nextSequence = *multicast.sequence;
+                std::deque<std::pair<uint64_t, io::Transmission>> pending = std::move(it->second.pending);
+                LOG_DEBUG_S("receiving group '" << groupName << "' via multicast starting at sequence " << *multicast.sequence);
+
+                for (auto& [sequence, transmission] : pending)
+                {
+                    handleMulticastTransmission(groupName, sequence, std::move(transmission));
+                }
+            }
+        }
+        else
+        {
+            LOG_WARN_S("received unexpected multicast event for group '" << groupName << "'");
+        }
+    }
+
+    void GuestTransceiver::handleMulticastTransmission(const std::string& groupName, uint64_t sequence, io::Transmission transmission)
+    {
+        auto it = m_multicastGroups.find(groupName);
+
+        if (it == m_multicastGroups.end() || m_hostConnection == nullptr)
+        {
+            return;
+        }
+
+        multicast_group_t& multicastGroup = it->second;
+
+        // note: transmissions that are received before the start sequence is
+        // known might already be part of the multicast sequence and are
+        // therefore retained until then
+        if (multicastGroup.nextSequence == std::nullopt)
+        {
+            multicastGroup.pending.emplace_back(sequence, std::move(transmission));
+
+            if (multicastGroup.pending.size() > MulticastPendingSize)
+            {
+                multicastGroup.pending.pop_front();
+            }
+
+            return;
+        }
+
+        if (sequence < *multicastGroup.nextSequence)
+        {
+            return;
+        }
+
+        if (sequence > *multicastGroup.nextSequence)
+        {
+            LOG_DEBUG_S("detected gap in multicast sequence of group '" << groupName << "' (expected: " << *multicastGroup.nextSequence << ", received: " << sequence << ")");
+            fallBackFromMulticast(groupName);
+            return;
+        }
+
+        ++*multicastGroup.nextSequence;
+
+        DotsHeader& header = transmission.header();
+        header.isFromMyself = header.sender == m_hostConnection->selfId();
+
+        handleTransmission(*m_hostConnection, std::move(transmission));
+    }
+
+    void GuestTransceiver::handleMulticastError(const std::string& groupName, std::exception_ptr ePtr)
+    {
+        try
+        {
+            std::rethrow_exception(ePtr);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARN_S("error while receiving group '" << groupName << "' via multicast -> " << e.what());
+        }
+
+        fallBackFromMulticast(groupName);
+    }
+
+    void GuestTransceiver::fallBackFromMulticast(std::string_view groupName)
+    {
+        auto it = m_multicastGroups.find(groupName);
+
+        if (it == m_multicastGroups.end())
+        {
+            return;
+        }
+
+        DotsMulticast fallback{
+            .groupName = std::string{ groupName },
+            .event = DotsMulticastEvent::fallback
+        };
+
+        // note: the host falls back to the start sequence if it is not yet
+        // known to the guest
+        if (it->second.nextSequence != std::nullopt)
+        {
+            fallback.sequence = *it->second.nextSequence;
+        }
+
+        m_multicastGroups.erase(it);
+
+        if (m_hostConnection != nullptr)
+        {
+            publish(fallback);
+        }
+    }
+
+    void GuestTransceiver::recordLatency(const io::Transmission& transmission)
+    {
+        const DotsHeader& header = transmission.header();
+
+        if (!header.serverSentTime.isValid())
+        {
+            return;
+        }
+
+        type::StructDescriptor::type_id_t typeId = transmission.descriptor().typeId();
+
+        if (typeId >= m_typeLatencies.size())
+        {
+            m_typeLatencies.resize(typeId + 1);
+        }
+
+        if (m_typeLatencies[typeId] == nullptr)
+        {
+            m_typeLatencies[typeId] = std::make_unique<LatencyHistogram>();
+        }
+
+        m_typeLatencies[typeId]->record(timepoint_t::Now() - *header.serverSentTime);
+    }
+
     void GuestTransceiver::handleTransitionImpl(Connection& connection, std::exception_ptr/* e*/) noexcept
     {
         try
         {
             if (connection.state() == DotsConnectionState::early_subscribe)
             {
+                if (m_rejoin)
+                {
+                    rejoinGroups(connection);
+                }
+
                 for (const auto& [name, descriptor] : m_preloadPublishTypes)
                 {
                     (void)name;
@@ -147,11 +893,35 @@ namespace dots
                 m_preloadPublishTypes.clear();
                 m_preloadSubscribeTypes.clear();
             }
+            else if (connection.state() == DotsConnectionState::connected)
+            {
+                // note: hosts that do not support preloading skip the
+                // early_subscribe state
+                if (m_rejoin)
+                {
+                    rejoinGroups(connection);
+                }
+
+                m_reconnectBackoff = m_minReconnectBackoff;
+            }
             else if (connection.state() == DotsConnectionState::closed)
             {
+                m_multicastGroups.clear();
+                m_resyncs.clear();
+
+                // note: the connection has already been reset if it was
+                // closed locally (e.g. because the transceiver is destroyed)
                 if (m_hostConnection != nullptr)
                 {
                     m_hostConnection = nullptr;
+
+                    if (m_reconnect && m_openEndpoint != std::nullopt)
+                    {
+                        m_rejoin = true;
+                        m_connecting = true;
+                        LOG_NOTICE_S("lost connection to host, reconnecting in " << m_reconnectBackoff.count() << "ms");
+                        scheduleReconnect();
+                    }
                 }
             }
         }
@@ -168,6 +938,12 @@ namespace dots
 #if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
 #include <dots/io/channels/UdsChannel.h>
 #endif
+#if defined(__linux__)
+#include <dots/io/channels/ShmChannel.h>
+#endif
+#if defined(DOTS_ENABLE_IO_URING)
+#include <dots/io/channels/UringChannel.h>
+#endif
 
 namespace dots
 {
@@ -180,37 +956,114 @@ namespace dots
             authSecret = endpoint.userPassword();
         }
 
+        const Connection& connection = open(std::move(preloadPublishTypes), std::move(preloadSubscribeTypes), std::move(authSecret), makeChannel(endpoint));
+        m_openEndpoint = std::move(endpoint);
+
+        return connection;
+    }
+
+    const Connection& GuestTransceiver::open(io::Endpoint endpoint)
+    {
+        return open({}, {}, std::move(endpoint));
+    }
+
+    io::channel_ptr_t GuestTransceiver::makeChannel(const io::Endpoint& endpoint)
+    {
         std::string_view scheme = endpoint.scheme();
 
         if (scheme == "tcp")
         {
-            return open<io::TcpChannel>(std::move(preloadPublishTypes), std::move(preloadSubscribeTypes), std::move(authSecret), std::move(endpoint));
+            return io::make_channel<io::TcpChannel>(ioContext(), endpoint);
         }
         else if (scheme == "tcp-v2")
         {
-            return open<io::v2::TcpChannel>(std::move(preloadPublishTypes), std::move(preloadSubscribeTypes), std::move(authSecret), std::move(endpoint));
+            return io::make_channel<io::v2::TcpChannel>(ioContext(), endpoint);
+        }
+        else if (scheme == "tcp-v3")
+        {
+            return io::make_channel<io::v3::TcpChannel>(ioContext(), endpoint);
         }
         else if (scheme == "tcp-v1")
         {
-            return open<io::v1::TcpChannel>(std::move(preloadPublishTypes), std::move(preloadSubscribeTypes), std::move(authSecret), std::move(endpoint));
+            return io::make_channel<io::v1::TcpChannel>(ioContext(), endpoint);
         }
         #if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
         else if (scheme == "uds")
         {
-            return open<io::posix::UdsChannel>(std::move(preloadPublishTypes), std::move(preloadSubscribeTypes), std::move(authSecret), std::move(endpoint));
+            return io::make_channel<io::posix::UdsChannel>(ioContext(), endpoint);
         }
         else if (scheme == "uds-v2")
         {
-            return open<io::posix::v2::UdsChannel>(std::move(preloadPublishTypes), std::move(preloadSubscribeTypes), std::move(authSecret), std::move(endpoint));
+            return io::make_channel<io::posix::v2::UdsChannel>(ioContext(), endpoint);
+        }
+        else if (scheme == "uds-v3")
+        {
+            return io::make_channel<io::posix::v3::UdsChannel>(ioContext(), endpoint);
         }
         else if (scheme == "uds-v1")
         {
-            return open<io::posix::v1::UdsChannel>(std::move(preloadPublishTypes), std::move(preloadSubscribeTypes), std::move(authSecret), std::move(endpoint));
+            return io::make_channel<io::posix::v1::UdsChannel>(ioContext(), endpoint);
+        }
+        #endif
+        #if defined(__linux__)
+        else if (scheme == "shm")
+        {
+            return io::make_channel<io::posix::ShmChannel>(ioContext(), endpoint);
+        }
+        else if (scheme == "shm-v2")
+        {
+            return io::make_channel<io::posix::v2::ShmChannel>(ioContext(), endpoint);
+        }
+        else if (scheme == "shm-v3")
+        {
+            return io::make_channel<io::posix::v3::ShmChannel>(ioContext(), endpoint);
+        }
+        else if (scheme == "shm-v1")
+        {
+            return io::make_channel<io::posix::v1::ShmChannel>(ioContext(), endpoint);
+        }
+        #endif
+        #if defined(DOTS_ENABLE_IO_URING)
+        else if (scheme == "tcp-uring")
+        {
+            return io::make_channel<io::posix::UringTcpChannel>(ioContext(), endpoint);
+        }
+        else if (scheme == "tcp-uring-v2")
+        {
+            return io::make_channel<io::posix::v2::UringTcpChannel>(ioContext(), endpoint);
+        }
+        else if (scheme == "tcp-uring-v3")
+        {
+            return io::make_channel<io::posix::v3::UringTcpChannel>(ioContext(), endpoint);
+        }
+        else if (scheme == "tcp-uring-v1")
+        {
+            return io::make_channel<io::posix::v1::UringTcpChannel>(ioContext(), endpoint);
+        }
+        else if (scheme == "uds-uring")
+        {
+            return io::make_channel<io::posix::UringUdsChannel>(ioContext(), endpoint);
+        }
+        else if (scheme == "uds-uring-v2")
+        {
+            return io::make_channel<io::posix::v2::UringUdsChannel>(ioContext(), endpoint);
+        }
+        else if (scheme == "uds-uring-v3")
+        {
+            return io::make_channel<io::posix::v3::UringUdsChannel>(ioContext(), endpoint);
+        }
+        else if (scheme == "uds-uring-v1")
+        {
+            return io::make_channel<io::posix::v1::UringUdsChannel>(ioContext(), endpoint);
         }
         #endif
         else if (scheme == "ws")
         {
-            return open<io::WebSocketChannel>(std::move(preloadPublishTypes), std::move(preloadSubscribeTypes), std::move(authSecret), std::move(endpoint));
+            return io::make_channel<io::WebSocketChannel>(ioContext(), endpoint);
+        }
+        else if (scheme == "ws-cbor")
+        {
+            return io::make_channel<io::WebSocketCborChannel>(ioContext(), endpoint);
         }
         else
         {
@@ -218,8 +1071,126 @@ namespace dots
         }
     }
 
-    const Connection& GuestTransceiver::open(io::Endpoint endpoint)
+    template <typename TChannel>
+    void GuestTransceiver::asyncConnect(std::optional<std::string> authSecret)
     {
-        return open({}, {}, std::move(endpoint));
+        const io::Endpoint& endpoint = *m_openEndpoint;
+        std::string_view port = endpoint.port().empty() ? TChannel::DefaultPort : endpoint.port();
+
+        m_connectingChannel = io::make_channel<TChannel>(ioContext(), endpoint.host(), port, [this, authSecret{ std::move(authSecret) }](const boost::system::error_code& error)
+        {
+            // note: the handler is invoked with an aborted operation when the
+            // channel is destroyed, in which case the transceiver might no
+            // longer exist
+            if (error == asio::error::operation_aborted)
+            {
+                return;
+            }
+
+            io::channel_ptr_t channel = std::move(m_connectingChannel);
+
+            if (error)
+            {
+                handleConnectError(std::make_exception_ptr(boost::system::system_error{ error, "could not open TCP connection" }));
+                return;
+            }
+
+            try
+            {
+                open(std::move(m_preloadPublishTypes), std::move(m_preloadSubscribeTypes), authSecret, std::move(channel));
+            }
+            catch (...)
+            {
+                handleConnectError(std::current_exception());
+            }
+        });
+    }
+
+    void GuestTransceiver::asyncConnect()
+    {
+        const io::Endpoint& endpoint = *m_openEndpoint;
+        std::optional<std::string> authSecret;
+
+        if (!endpoint.userPassword().empty())
+        {
+            authSecret = endpoint.userPassword();
+        }
+
+        try
+        {
+            if (std::string_view scheme = endpoint.scheme(); scheme == "tcp")
+            {
+                asyncConnect<io::TcpChannel>(std::move(authSecret));
+            }
+            else if (scheme == "tcp-v2")
+            {
+                asyncConnect<io::v2::TcpChannel>(std::move(authSecret));
+            }
+            else if (scheme == "tcp-v3")
+            {
+                asyncConnect<io::v3::TcpChannel>(std::move(authSecret));
+            }
+            else if (scheme == "tcp-v1")
+            {
+                asyncConnect<io::v1::TcpChannel>(std::move(authSecret));
+            }
+            else
+            {
+                // note: channels of other schemes can only be created
+                // synchronously, which is deferred to the event loop so that
+                // asyncOpen() never blocks
+                m_reconnectTimer.expires_after(std::chrono::milliseconds{ 0 });
+                m_reconnectTimer.async_wait([this, authSecret{ std::move(authSecret) }](boost::system::error_code error)
+                {
+                    if (error == asio::error::operation_aborted)
+                    {
+                        return;
+                    }
+
+                    try
+                    {
+                        open(std::move(m_preloadPublishTypes), std::move(m_preloadSubscribeTypes), authSecret, makeChannel(*m_openEndpoint));
+                    }
+                    catch (...)
+                    {
+                        handleConnectError(std::current_exception());
+                    }
+                });
+            }
+        }
+        catch (...)
+        {
+            handleConnectError(std::current_exception());
+        }
+    }
+
+    void GuestTransceiver::handleConnectError(std::exception_ptr ePtr)
+    {
+        try
+        {
+            std::rethrow_exception(ePtr);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARN_S("could not connect to host at '" << m_openEndpoint->uriStr() << "', retrying in " << m_reconnectBackoff.count() << "ms -> " << e.what());
+        }
+
+        scheduleReconnect();
+    }
+
+    void GuestTransceiver::scheduleReconnect()
+    {
+        m_reconnectTimer.expires_after(m_reconnectBackoff);
+        m_reconnectTimer.async_wait([this](boost::system::error_code error)
+        {
+            if (error == asio::error::operation_aborted)
+            {
+                return;
+            }
+
+            asyncConnect();
+        });
+
+        m_reconnectBackoff = std::min(m_reconnectBackoff * 2, m_maxReconnectBackoff);
     }
 }
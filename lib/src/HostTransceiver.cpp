@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #include <dots/HostTransceiver.h>
+#include <algorithm>
+#include <utility>
 #include <vector>
 #include <dots/tools/logging.h>
 #include <DotsCacheInfo.dots.h>
@@ -12,13 +14,19 @@ namespace dots
                                      asio::io_context& ioContext,
                                      type::Registry::StaticTypePolicy staticTypePolicy /*= type::Registry::StaticTypePolicy::All*/,
                                      std::optional<transition_handler_t> transitionHandler/* = std::nullopt*/) :
-        Transceiver(std::move(selfName), ioContext, staticTypePolicy, std::move(transitionHandler))
+        Transceiver(std::move(selfName), ioContext, staticTypePolicy, std::move(transitionHandler)),
+        m_writeQueueMaxSize(io::Channel::DefaultWriteQueueMaxSize),
+        m_writeQueuePolicy(DotsWriteQueuePolicy::disconnect),
+        m_conflationThreshold(0),
+        m_latencyRecording(false),
+        m_deltaUpdates(false)
     {
-        /* do nothing */
+        type::Descriptor<DotsMulticast>::Instance();
     }
 
     HostTransceiver::~HostTransceiver()
     {
+        m_groupIndex.clear();
         m_groups.clear();
         connection_map_t guestConnections = std::move(m_guestConnections);
         guestConnections.clear();
@@ -29,6 +37,11 @@ namespace dots
         io::Listener* listenerPtr = listener.get();
         m_listeners.emplace(listenerPtr, std::move(listener));
 
+        if (m_workerPool != nullptr)
+        {
+            listenerPtr->setWorkerPool(m_workerPool);
+        }
+
         listenerPtr->asyncAccept(
             { &HostTransceiver::handleListenAccept, this },
             { &HostTransceiver::handleListenError, this }
@@ -37,6 +50,180 @@ namespace dots
         return *listenerPtr;
     }
 
+    void HostTransceiver::setWorkerThreads(size_t numThreads)
+    {
+        if (numThreads == 0)
+        {
+            m_workerPool = nullptr;
+        }
+        else
+        {
+            m_workerPool = std::make_shared<io::WorkerPool>(numThreads);
+        }
+    }
+
+    void HostTransceiver::setWriteQueueLimit(size_t maxSize, DotsWriteQueuePolicy policy)
+    {
+        if (maxSize == 0)
+        {
+            throw std::logic_error{ "write queue limit must not be zero" };
+        }
+
+        m_writeQueueMaxSize = maxSize;
+        m_writeQueuePolicy = policy;
+    }
+
+    void HostTransceiver::setConflationThreshold(size_t threshold)
+    {
+        m_conflationThreshold = threshold;
+    }
+
+    void HostTransceiver::setDeltaUpdates(bool enabled)
+    {
+        m_deltaUpdates = enabled;
+        m_deltaUpdateIndex.clear();
+    }
+
+    void HostTransceiver::setDeltaUpdates(std::string_view typeName, bool enabled)
+    {
+        m_deltaUpdateTypes.insert_or_assign(std::string{ typeName }, enabled);
+        m_deltaUpdateIndex.clear();
+    }
+
+    void HostTransceiver::setMulticast(std::string_view typeName, std::optional<io::Endpoint> groupEndpoint, std::optional<std::string> interfaceAddress/* = std::nullopt*/)
+    {
+        if (auto it = m_multicastGroups.find(std::string{ typeName }); it != m_multicastGroups.end() && !it->second.members.empty())
+        {
+            throw std::logic_error{ "attempt to change multicast group of type '" + std::string{ typeName } + "' while it is used by guests" };
+        }
+
+        if (groupEndpoint == std::nullopt)
+        {
+            m_multicastGroups.erase(std::string{ typeName });
+        }
+        else
+        {
+            auto sender = std::make_unique<io::MulticastSender>(ioContext(), *groupEndpoint, std::move(interfaceAddress));
+            m_multicastGroups.insert_or_assign(std::string{ typeName }, multicast_group_t{ std::move(*groupEndpoint), std::move(sender) });
+        }
+
+        m_multicastIndex.clear();
+    }
+
+    void HostTransceiver::setPeerReleaseHandler(std::optional<ContainerPool::release_handler_t> handler)
+    {
+        dispatcher().pool().setReleaseHandler(std::move(handler));
+    }
+
+    std::vector<const Connection*> HostTransceiver::guestConnections() const
+    {
+        std::vector<const Connection*> guestConnections;
+        guestConnections.reserve(m_guestConnections.size());
+
+        for (const auto& [connectionPtr, connection] : m_guestConnections)
+        {
+            (void)connection;
+            guestConnections.emplace_back(connectionPtr);
+        }
+
+        return guestConnections;
+    }
+
+    std::vector<DotsTypeStatistics> HostTransceiver::typeStatistics() const
+    {
+        std::vector<DotsTypeStatistics> typeStatistics;
+
+        for (type::StructDescriptor::type_id_t typeId = 0; typeId < m_typeTraffic.size(); ++typeId)
+        {
+            const type_traffic_t& traffic = m_typeTraffic[typeId];
+
+            if (traffic.receivedPackages == 0 && traffic.sentPackages == 0)
+            {
+                continue;
+            }
+
+            if (const type::StructDescriptor* descriptor = registry().findStructType(typeId); descriptor != nullptr)
+            {
+                typeStatistics.emplace_back(DotsTypeStatistics{
+                    .typeName = descriptor->name(),
+                    .received = DotsStatistics{ .bytes = traffic.receivedBytes, .packages = traffic.receivedPackages },
+                    .sent = DotsStatistics{ .bytes = traffic.sentBytes, .packages = traffic.sentPackages }
+                });
+            }
+        }
+
+        return typeStatistics;
+    }
+
+    void HostTransceiver::setLatencyRecording(bool enabled)
+    {
+        m_latencyRecording = enabled;
+    }
+
+    std::vector<DotsTypeLatency> HostTransceiver::typeLatencies() const
+    {
+        std::vector<DotsTypeLatency> typeLatencies;
+
+        for (type::StructDescriptor::type_id_t typeId = 0; typeId < m_typeLatencies.size(); ++typeId)
+        {
+            const latency_histograms_t* latencies = m_typeLatencies[typeId].get();
+
+            if (latencies == nullptr || latencies->transport.count() == 0)
+            {
+                continue;
+            }
+
+            if (const type::StructDescriptor* descriptor = registry().findStructType(typeId); descriptor != nullptr)
+            {
+                typeLatencies.emplace_back(DotsTypeLatency{
+                    .typeName = descriptor->name(),
+                    .transport = latencies->transport.statistics(),
+                    .processing = latencies->processing.statistics()
+                });
+            }
+        }
+
+        return typeLatencies;
+    }
+
+    std::vector<DotsClientLatency> HostTransceiver::clientLatencies() const
+    {
+        std::vector<DotsClientLatency> clientLatencies;
+
+        for (const auto& [connection, latencies] : m_connectionLatencies)
+        {
+            if (latencies.transport.count() > 0)
+            {
+                clientLatencies.emplace_back(DotsClientLatency{
+                    .id = connection->peerId(),
+                    .transport = latencies.transport.statistics(),
+                    .processing = latencies.processing.statistics()
+                });
+            }
+        }
+
+        return clientLatencies;
+    }
+
+    void HostTransceiver::resetLatencies()
+    {
+        for (const std::unique_ptr<latency_histograms_t>& latencies : m_typeLatencies)
+        {
+            if (latencies != nullptr)
+            {
+                latencies->transport.reset();
+                latencies->processing.reset();
+            }
+        }
+
+        for (auto& [connection, latencies] : m_connectionLatencies)
+        {
+            (void)connection;
+            latencies.transport.reset();
+            latencies.processing.reset();
+        }
+    }
+
     void HostTransceiver::publish(const type::Struct& instance, std::optional<property_set_t> includedProperties/* = std::nullopt*/, bool remove/* = false*/)
     {
         if (const type::StructDescriptor& descriptor = instance._descriptor(); descriptor.substructOnly())
@@ -84,18 +271,54 @@ namespace dots
         /* do nothing */
     }
 
-    void HostTransceiver::transmit(const io::Transmission& transmission)
+    bool HostTransceiver::transmit(const io::Transmission& transmission)
     {
         using dirty_connection_t = std::pair<Connection*, std::exception_ptr>;
         std::vector<dirty_connection_t> dirtyConnections;
+        bool congested = false;
+        uint64_t numTransmitted = 0;
+        group_t* group = findGroup(transmission.descriptor());
+
+        if (group == nullptr)
+        {
+            return false;
+        }
+
+        multicast_group_t* multicastGroup = m_multicastGroups.empty() ? nullptr : findMulticastGroup(transmission.descriptor());
 
-        for (Connection* destinationConnection : m_groups[*transmission.header().typeName])
+        if (multicastGroup != nullptr && !multicastGroup->members.empty())
         {
-            if (destinationConnection->state() != DotsConnectionState::closed)
+            transmitMulticast(*multicastGroup, transmission);
+        }
+
+        derived_transmissions_t derived;
+
+        for (Connection* destinationConnection : *group)
+        {
+            if (multicastGroup != nullptr && multicastGroup->members.count(destinationConnection) > 0)
             {
+                continue;
+            }
+
+            if (destinationConnection->state() != DotsConnectionState::closed && (m_snapshots.empty() || !isPendingInSnapshot(*destinationConnection, transmission)))
+            {
+                const io::Transmission* destinationTransmission = deriveTransmission(*destinationConnection, transmission, derived);
+
+                if (destinationTransmission == nullptr)
+                {
+                    continue;
+                }
+
                 try
                 {
-                    destinationConnection->transmit(transmission);
+                    destinationConnection->transmit(*destinationTransmission);
+                    ++numTransmitted;
+
+                    if (destinationConnection->writeQueueCongested())
+                    {
+                        m_congestedConnections.emplace(destinationConnection);
+                        congested = true;
+                    }
                 }
                 catch (...)
                 {
@@ -104,6 +327,136 @@ namespace dots
             }
         }
 
+        if (numTransmitted > 0)
+        {
+            type_traffic_t& traffic = typeTraffic(transmission.descriptor());
+            traffic.sentBytes += numTransmitted * transmission.encodedSize();
+            traffic.sentPackages += numTransmitted;
+        }
+
+        if (!dirtyConnections.empty())
+        {
+            for (const auto& [connection, e] : dirtyConnections)
+            {
+                connection->handleError(e);
+            }
+        }
+
+        return congested;
+    }
+
+    bool HostTransceiver::transmit(const std::vector<io::Transmission>& transmissions)
+    {
+        using dirty_connection_t = std::pair<Connection*, std::exception_ptr>;
+        std::vector<dirty_connection_t> dirtyConnections;
+        bool congested = false;
+        uint64_t numTransmitted = 0;
+        uint64_t sentBytes = 0;
+        const type::StructDescriptor& descriptor = transmissions.front().descriptor();
+        group_t* group = findGroup(descriptor);
+
+        if (group == nullptr)
+        {
+            return false;
+        }
+
+        uint64_t batchEncodedSize = 0;
+
+        for (const io::Transmission& transmission : transmissions)
+        {
+            batchEncodedSize += transmission.encodedSize();
+        }
+
+        const DotsHeader& batchHeader = transmissions.front().header();
+        bool uniform = std::all_of(transmissions.begin() + 1, transmissions.end(), [&batchHeader](const io::Transmission& transmission)
+        {
+            const DotsHeader& header = transmission.header();
+            return header.attributes == batchHeader.attributes && header.removeObj == batchHeader.removeObj;
+        });
+
+        multicast_group_t* multicastGroup = m_multicastGroups.empty() ? nullptr : findMulticastGroup(descriptor);
+
+        if (multicastGroup != nullptr && !multicastGroup->members.empty())
+        {
+            for (const io::Transmission& transmission : transmissions)
+            {
+                transmitMulticast(*multicastGroup, transmission);
+            }
+        }
+
+        std::vector<derived_transmissions_t> derived;
+
+        for (Connection* destinationConnection : *group)
+        {
+            if (destinationConnection->state() == DotsConnectionState::closed)
+            {
+                continue;
+            }
+
+            if (multicastGroup != nullptr && multicastGroup->members.count(destinationConnection) > 0)
+            {
+                continue;
+            }
+
+            // note: the batch can only be transmitted as a unit if it is
+            // transmitted unaltered and all of its transmissions share the
+            // same header (e.g. unless some of them have been reduced to
+            // their changed properties). otherwise its transmissions are
+            // transmitted individually
+            bool derive = !uniform ||
+                          (!m_snapshots.empty() && m_snapshots.count({ destinationConnection, &descriptor }) > 0) ||
+                          (!m_filters.empty() && findFilter(*destinationConnection, descriptor) != nullptr) ||
+                          (!m_projections.empty() && findProjection(*destinationConnection, descriptor) != nullptr);
+
+            try
+            {
+                if (derive)
+                {
+                    derived.resize(transmissions.size());
+
+                    for (size_t i = 0; i < transmissions.size(); ++i)
+                    {
+                        const io::Transmission& transmission = transmissions[i];
+
+                        if (!m_snapshots.empty() && isPendingInSnapshot(*destinationConnection, transmission))
+                        {
+                            continue;
+                        }
+
+                        if (const io::Transmission* destinationTransmission = deriveTransmission(*destinationConnection, transmission, derived[i]); destinationTransmission != nullptr)
+                        {
+                            destinationConnection->transmit(*destinationTransmission);
+                            ++numTransmitted;
+                            sentBytes += transmission.encodedSize();
+                        }
+                    }
+                }
+                else
+                {
+                    destinationConnection->transmit(transmissions);
+                    numTransmitted += transmissions.size();
+                    sentBytes += batchEncodedSize;
+                }
+
+                if (destinationConnection->writeQueueCongested())
+                {
+                    m_congestedConnections.emplace(destinationConnection);
+                    congested = true;
+                }
+            }
+            catch (...)
+            {
+                dirtyConnections.emplace_back(destinationConnection, std::current_exception());
+            }
+        }
+
+        if (numTransmitted > 0)
+        {
+            type_traffic_t& traffic = typeTraffic(descriptor);
+            traffic.sentBytes += sentBytes;
+            traffic.sentPackages += numTransmitted;
+        }
+
         if (!dirtyConnections.empty())
         {
             for (const auto& [connection, e] : dirtyConnections)
@@ -111,11 +464,40 @@ namespace dots
                 connection->handleError(e);
             }
         }
+
+        return congested;
+    }
+
+    auto HostTransceiver::findGroup(const type::StructDescriptor& descriptor) -> group_t*
+    {
+        type::StructDescriptor::type_id_t typeId = descriptor.typeId();
+
+        if (typeId >= m_groupIndex.size())
+        {
+            m_groupIndex.resize(typeId + 1);
+        }
+
+        // note: groups are resolved by name only once per type, because
+        // guests might join groups of types that are not yet known to the host
+        std::optional<group_t*>& group = m_groupIndex[typeId];
+
+        if (group == std::nullopt)
+        {
+            auto it = m_groups.find(descriptor.name());
+            group = it == m_groups.end() ? nullptr : &it->second;
+        }
+
+        return *group;
     }
 
     bool HostTransceiver::handleListenAccept(io::Listener&/* listener*/, io::channel_ptr_t channel)
     {
+        // note: transmissions of uncached types are forwarded to the guests
+        // without being decoded unless they are accessed by the host itself
+        channel->setPassThrough(true);
         auto connection = std::make_shared<Connection>(std::move(channel), true);
+        connection->setWriteQueueLimit(m_writeQueueMaxSize, m_writeQueuePolicy, Connection::write_queue_handler_t{ &HostTransceiver::handleWriteQueueDrained, this });
+        connection->setConflationThreshold(m_conflationThreshold);
         connection->asyncReceive(registry(), m_authManager.get(), selfName(),
             { &HostTransceiver::handleTransmission, this },
             { &HostTransceiver::handleTransition, this }
@@ -147,10 +529,14 @@ namespace dots
         connection_ptr_t connectionPtr = m_guestConnections.find(&connection)->second;
         (void)connectionPtr;
 
-        const auto& [header, instance] = transmission;
+        type_traffic_t& traffic = typeTraffic(transmission.descriptor());
+        traffic.receivedBytes += transmission.encodedSize();
+        ++traffic.receivedPackages;
 
-        if (instance->_descriptor().internal())
+        if (transmission.descriptor().internal())
         {
+            const type::AnyStruct& instance = transmission.instance();
+
             if (auto* member = instance.as<DotsMember>())
             {
                 handleMemberMessage(connection, *member);
@@ -170,10 +556,79 @@ namespace dots
                 handleEchoRequest(connection, *echoRequest);
                 return !connection.closed();
             }
+            else if (auto* multicast = instance.as<DotsMulticast>())
+            {
+                handleMulticastMessage(connection, *multicast);
+                return !connection.closed();
+            }
         }
 
+        // note: unchanged updates are still dispatched, so that local
+        // subscribers and the clone information of the instance are not
+        // affected by delta updates. they are only omitted from distribution
+        bool unchanged = transmission.descriptor().cached() && deltaUpdates(transmission.descriptor()) && !reduceTransmission(transmission);
         dispatcher().dispatch(transmission);
-        transmit(transmission);
+
+        std::optional<std::vector<io::Transmission>> batch;
+
+        // note: transmissions that were received as part of a batch are
+        // distributed as a unit once the last transmission of the batch has
+        // been received
+        if (transmission.batchRemaining() > 0 || m_batches.count(&connection) > 0)
+        {
+            bool complete = transmission.batchRemaining() == 0;
+            std::vector<io::Transmission>& pendingBatch = m_batches[&connection];
+
+            if (!unchanged)
+            {
+                pendingBatch.emplace_back(std::move(transmission));
+            }
+
+            if (!complete)
+            {
+                return !connection.closed();
+            }
+
+            batch.emplace(std::move(pendingBatch));
+            m_batches.erase(&connection);
+
+            if (batch->empty())
+            {
+                return !connection.closed();
+            }
+        }
+        else if (unchanged)
+        {
+            return !connection.closed();
+        }
+
+        bool congested = batch == std::nullopt ? transmit(transmission) : transmit(*batch);
+
+        // note: guests that publish to congested connections are paused
+        // until all congested connections have been drained
+        if (congested && !connection.closed())
+        {
+            if (auto [it, emplaced] = m_pausedConnections.emplace(&connection); emplaced)
+            {
+                LOG_DEBUG_S("pausing " << connection.peerDescription() << " because of congested connections");
+                connection.pauseReceive();
+            }
+        }
+
+        if (m_latencyRecording)
+        {
+            if (batch == std::nullopt)
+            {
+                recordLatency(connection, transmission);
+            }
+            else
+            {
+                for (const io::Transmission& batchTransmission : *batch)
+                {
+                    recordLatency(connection, batchTransmission);
+                }
+            }
+        }
 
         return !connection.closed();
     }
@@ -189,40 +644,81 @@ namespace dots
                     group.erase(&connection);
                 }
 
-                std::vector<const type::Struct*> cleanupInstances;
+                for (auto& [typeName, multicastGroup] : m_multicastGroups)
+                {
+                    leaveMulticastGroup(connection, multicastGroup);
+                }
 
-                for (const auto& [descriptor, container] : pool())
+                // note: the transmissions of an incomplete batch have already
+                // been dispatched and are therefore distributed as well
+                if (auto it = m_batches.find(&connection); it != m_batches.end())
                 {
-                    if (descriptor->cleanup())
+                    std::vector<io::Transmission> batch = std::move(it->second);
+                    m_batches.erase(it);
+
+                    if (!batch.empty())
                     {
-                        for (const auto& [instance, cloneInfo] : container)
-                        {
-                            if (connection.peerId() == cloneInfo.lastUpdateFrom)
-                            {
-                                cleanupInstances.emplace_back(&*instance);
-                            }
-                        }
+                        transmit(batch);
                     }
                 }
 
-                for (const type::Struct* instance : cleanupInstances)
+                for (auto it = m_snapshots.lower_bound({ &connection, nullptr }); it != m_snapshots.end() && it->first.first == &connection;)
                 {
-                    remove(*instance);
+                    it = m_snapshots.erase(it);
                 }
 
-                m_guestConnections.erase(&connection);
-            }
-        }
-        catch (const std::exception& e)
-        {
-            LOG_ERROR_S("error while handling transition for connection " << connection.peerDescription() << " -> " << e.what());
-        }
-    }
+                for (auto it = m_filters.lower_bound({ &connection, nullptr }); it != m_filters.end() && it->first.first == &connection;)
+                {
+                    it = m_filters.erase(it);
+                }
+
+                for (auto it = m_projections.lower_bound({ &connection, nullptr }); it != m_projections.end() && it->first.first == &connection;)
+                {
+                    it = m_projections.erase(it);
+                }
+
+                m_congestedConnections.erase(&connection);
+                m_pausedConnections.erase(&connection);
+                m_connectionLatencies.erase(&connection);
+                resumePausedConnections();
+
+                std::vector<const type::Struct*> cleanupInstances;
+
+                for (const auto& [descriptor, container] : pool())
+                {
+                    if (descriptor->cleanup())
+                    {
+                        std::vector<const type::Struct*> ownedInstances = container.findOwned(connection.peerId());
+                        cleanupInstances.insert(cleanupInstances.end(), ownedInstances.begin(), ownedInstances.end());
+                    }
+                }
+
+                for (const type::Struct* instance : cleanupInstances)
+                {
+                    remove(*instance);
+                }
+
+                m_guestConnections.erase(&connection);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR_S("error while handling transition for connection " << connection.peerDescription() << " -> " << e.what());
+        }
+    }
+
+    void HostTransceiver::handleWriteQueueDrained(Connection& connection)
+    {
+        m_congestedConnections.erase(&connection);
+        resumeSnapshots(connection);
+        resumePausedConnections();
+    }
 
     void HostTransceiver::handleMemberMessage(Connection& connection, const DotsMember& member)
     {
         member._assertHasProperties(DotsMember::groupName_p + DotsMember::event_p);
         const std::string& groupName = *member.groupName;
+        const type::StructDescriptor* structDescriptor = registry().findStructType(groupName);
 
         if (member.event == DotsMemberEvent::kill)
         {
@@ -230,14 +726,68 @@ namespace dots
         }
         else if (member.event == DotsMemberEvent::leave)
         {
-            if (size_t removed = m_groups[groupName].erase(&connection); removed == 0)
+            if (auto it = m_groups.find(groupName); it == m_groups.end() || it->second.erase(&connection) == 0)
             {
                 LOG_WARN_S(connection.peerDescription() << " is not a member of group '" << groupName << "'");
             }
+
+            if (structDescriptor != nullptr)
+            {
+                m_snapshots.erase({ &connection, structDescriptor });
+                m_filters.erase({ &connection, structDescriptor });
+                m_projections.erase({ &connection, structDescriptor });
+
+                if (multicast_group_t* multicastGroup = m_multicastGroups.empty() ? nullptr : findMulticastGroup(*structDescriptor); multicastGroup != nullptr)
+                {
+                    leaveMulticastGroup(connection, *multicastGroup);
+                }
+            }
         }
         else if (member.event == DotsMemberEvent::join)
         {
-            if (auto [it, emplaced] = m_groups[groupName].emplace(&connection); emplaced)
+            // note: joining a group again replaces the filter of the previous
+            // join, including when the previous join was unfiltered
+            if (member.filter.isValid() && !member.filter->empty())
+            {
+                if (structDescriptor == nullptr)
+                {
+                    throw std::runtime_error{ "attempt to filter group of unknown type '" + groupName + "'" };
+                }
+
+                m_filters.insert_or_assign({ &connection, structDescriptor }, Filter{ *structDescriptor, *member.filter });
+                LOG_DEBUG_S(connection.peerDescription() << " filters group '" << groupName << "' by properties " << m_filters.at({ &connection, structDescriptor }).properties().toString());
+            }
+            else if (structDescriptor != nullptr)
+            {
+                m_filters.erase({ &connection, structDescriptor });
+            }
+
+            if (member.projection.isValid())
+            {
+                if (structDescriptor == nullptr)
+                {
+                    throw std::runtime_error{ "attempt to project group of unknown type '" + groupName + "'" };
+                }
+
+                property_set_t projection = (*member.projection + structDescriptor->keyProperties()) ^ structDescriptor->properties();
+                m_projections.insert_or_assign({ &connection, structDescriptor }, projection);
+                LOG_DEBUG_S(connection.peerDescription() << " projects group '" << groupName << "' to properties " << projection.toString());
+            }
+            else if (structDescriptor != nullptr)
+            {
+                m_projections.erase({ &connection, structDescriptor });
+            }
+
+            auto [itGroup, emplacedGroup] = m_groups.try_emplace(groupName);
+
+            // note: the group of the type might already have been resolved
+            // while there were no members
+            if (emplacedGroup && structDescriptor != nullptr && structDescriptor->typeId() < m_groupIndex.size())
+            {
+                m_groupIndex[structDescriptor->typeId()] = &itGroup->second;
+            }
+
+            if (auto [it, emplaced] = itGroup->second.emplace(&connection); emplaced)
             {
                 LOG_DEBUG_S(connection.peerDescription() << " is now a member of group '" << groupName << "'");
             }
@@ -248,18 +798,25 @@ namespace dots
 
             // note: transmitting the container content even when the guest has already joined the group is currently
             // necessary to retain backwards compatibility
-            auto structDescriptor = registry().findStructType(groupName);
-            if (structDescriptor && structDescriptor->cached())
+            if (structDescriptor != nullptr && structDescriptor->cached())
             {
-                if (const Container<> *container = pool().find(*structDescriptor); container != nullptr)
+                transmitSnapshot(connection, *structDescriptor);
+            }
+
+            // note: joining a group again also ends the reception via
+            // multicast, so the guest has to request it again
+            if (multicast_group_t* multicastGroup = structDescriptor == nullptr || m_multicastGroups.empty() ? nullptr : findMulticastGroup(*structDescriptor); multicastGroup != nullptr)
+            {
+                leaveMulticastGroup(connection, *multicastGroup);
+
+                if (member.multicast == true && !structDescriptor->cached() && (m_filters.empty() || findFilter(connection, *structDescriptor) == nullptr))
                 {
-                    transmitContainer(connection, *container);
+                    connection.transmit(DotsMulticast{
+                        .groupName = groupName,
+                        .event = DotsMulticastEvent::offer,
+                        .endpoint = std::string{ multicastGroup->endpoint.uriStr() }
+                    });
                 }
-
-                connection.transmit(DotsCacheInfo{
-                    .typeName = member.groupName,
-                    .endTransmission = true
-                });
             }
         }
     }
@@ -327,29 +884,608 @@ namespace dots
         }
     }
 
-    void HostTransceiver::transmitContainer(Connection& connection, const Container<>& container)
+    void HostTransceiver::handleMulticastMessage(Connection& connection, const DotsMulticast& multicast)
     {
-        if (container.empty())
+        multicast._assertHasProperties(DotsMulticast::groupName_p + DotsMulticast::event_p);
+        const std::string& groupName = *multicast.groupName;
+        const type::StructDescriptor* structDescriptor = registry().findStructType(groupName);
+        multicast_group_t* multicastGroup = structDescriptor == nullptr ? nullptr : findMulticastGroup(*structDescriptor);
+
+        if (multicastGroup == nullptr)
         {
+            LOG_WARN_S(connection.peerDescription() << " requested multicast of group '" << groupName << "', which is not distributed via multicast");
             return;
         }
 
-        DotsHeader header{
-            .typeName = container.descriptor().name(),
-            .fromCache = static_cast<uint32_t>(container.size()),
-            .removeObj = false
-        };
+        if (multicast.event == DotsMulticastEvent::join)
+        {
+            if (group_t* group = findGroup(*structDescriptor); group == nullptr || group->count(&connection) == 0)
+            {
+                LOG_WARN_S(connection.peerDescription() << " attempted to join multicast group of group '" << groupName << "' without being a member");
+                return;
+            }
+
+            // note: the transmissions before the start sequence have been (or
+            // will be) transmitted via the connection
+            multicastGroup->members.insert_or_assign(&connection, multicastGroup->sequence);
+            connection.transmit(DotsMulticast{
+                .groupName = groupName,
+                .event = DotsMulticastEvent::start,
+                .sequence = multicastGroup->sequence
+            });
+
+            LOG_DEBUG_S(connection.peerDescription() << " receives group '" << groupName << "' via multicast starting at sequence " << multicastGroup->sequence);
+        }
+        else if (multicast.event == DotsMulticastEvent::fallback)
+        {
+            auto itMember = multicastGroup->members.find(&connection);
+
+            if (itMember == multicastGroup->members.end())
+            {
+                LOG_WARN_S(connection.peerDescription() << " attempted to fall back from multicast group of group '" << groupName << "' without receiving it");
+                return;
+            }
+
+            // note: guests that fall back before they know the start sequence
+            // have not received anything via multicast
+            uint64_t sequence = multicast.sequence.isValid() ? *multicast.sequence : itMember->second;
+            uint64_t oldestSequence = multicastGroup->history.empty() ? multicastGroup->sequence : multicastGroup->history.front().first;
+
+            if (sequence < oldestSequence)
+            {
+                LOG_WARN_S(connection.peerDescription() << " missed " << oldestSequence - sequence << " transmissions of group '" << groupName << "' that are no longer retained");
+            }
+
+            for (const auto& [retainedSequence, transmission] : multicastGroup->history)
+            {
+                if (retainedSequence >= sequence)
+                {
+                    connection.transmit(transmission);
+                }
+            }
+
+            leaveMulticastGroup(connection, *multicastGroup);
+            LOG_DEBUG_S(connection.peerDescription() << " receives group '" << groupName << "' via connection starting at sequence " << sequence);
+        }
+        else
+        {
+            LOG_WARN_S(connection.peerDescription() << " sent unexpected multicast event for group '" << groupName << "'");
+        }
+    }
+
+    void HostTransceiver::transmitSnapshot(Connection& connection, const type::StructDescriptor& descriptor)
+    {
+        auto [it, emplaced] = m_snapshots.try_emplace({ &connection, &descriptor }, snapshot_t{
+            .keyCompare = Container<>::key_compare{ descriptor },
+            .lastKey = std::nullopt,
+            .transmitted = 0,
+            .awaitingDrain = false
+        });
+
+        // note: if a snapshot of the type is still being transmitted (i.e.
+        // the guest has joined the group again), it is restarted without
+        // scheduling another chunk
+        if (!emplaced)
+        {
+            it->second.lastKey = std::nullopt;
+            it->second.transmitted = 0;
+            return;
+        }
+
+        transmitSnapshotChunk(connection, descriptor);
+    }
+
+    void HostTransceiver::transmitSnapshotChunk(Connection& connection, const type::StructDescriptor& descriptor)
+    {
+        auto itSnapshot = m_snapshots.find({ &connection, &descriptor });
+
+        if (itSnapshot == m_snapshots.end())
+        {
+            return;
+        }
+
+        snapshot_t& snapshot = itSnapshot->second;
+        snapshot.awaitingDrain = false;
+        bool completed = true;
+        const Filter* filter = findFilter(connection, descriptor);
+        const property_set_t* projection = findProjection(connection, descriptor);
+
+        if (const Container<>* container = pool().find(descriptor); container != nullptr)
+        {
+            Container<>::const_iterator_t it = snapshot.lastKey == std::nullopt ? container->orderedBegin() : container->upperBound(*snapshot.lastKey);
+            Container<>::const_iterator_t end = container->orderedEnd();
+            const type::Struct* lastInstance = nullptr;
+            size_t numScanned = 0;
+            uint64_t numTransmitted = 0;
+
+            DotsHeader header{
+                .typeName = descriptor.name(),
+                .removeObj = false
+            };
+
+            // note: filtered instances count towards the chunk size to
+            // bound the processing time of each chunk. however, the next
+            // matching instance is always looked up before transmitting the
+            // current one, so that the last matching instance is transmitted
+            // with a terminal 'fromCache' value of 0 even if all subsequent
+            // instances are filtered
+            auto skip_filtered = [&](Container<>::const_iterator_t it_)
+            {
+                for (; it_ != end && filter != nullptr && !filter->matches(*it_->first); ++it_)
+                {
+                    ++numScanned;
+                    ++snapshot.transmitted;
+                    lastInstance = &*it_->first;
+                }
+
+                return it_;
+            };
+
+            for (it = skip_filtered(it); it != end && numScanned < SnapshotChunkSize;)
+            {
+                const auto& [instance, cloneInfo] = *it;
+                ++numScanned;
+                ++snapshot.transmitted;
+                lastInstance = &*instance;
+
+                Container<>::const_iterator_t next = skip_filtered(std::next(it));
+
+                // note: the container might change between chunks, so the
+                // amount of remaining instances is only an estimate until the
+                // last matching instance has been reached
+                header.fromCache = static_cast<uint32_t>(next == end ? 0 : std::max(container->size() - std::min(snapshot.transmitted, container->size()), size_t{ 1 }));
+                header.sentTime = *cloneInfo.modified;
+                header.serverSentTime = timepoint_t::Now();
+                header.attributes = projection == nullptr ? instance->_validProperties() : instance->_validProperties() ^ *projection;
+                header.sender = *cloneInfo.lastUpdateFrom;
+
+                connection.transmit(header, instance);
+                ++numTransmitted;
+                it = next;
+            }
+
+            if (numTransmitted > 0)
+            {
+                typeTraffic(descriptor).sentPackages += numTransmitted;
+            }
+
+            if (it != end)
+            {
+                completed = false;
+                snapshot.lastKey.emplace(descriptor);
+                (*snapshot.lastKey)->_copy(*lastInstance, lastInstance->_keyProperties());
+            }
+        }
+
+        if (completed)
+        {
+            m_snapshots.erase(itSnapshot);
+            connection.transmit(DotsCacheInfo{
+                .typeName = descriptor.name(),
+                .endTransmission = true
+            });
+        }
+        else if (connection.awaitWriteQueueDrain())
+        {
+            snapshot.awaitingDrain = true;
+        }
+        else
+        {
+            postSnapshotChunk(connection, descriptor);
+        }
+    }
+
+    void HostTransceiver::postSnapshotChunk(Connection& connection, const type::StructDescriptor& descriptor)
+    {
+        auto it = m_guestConnections.find(&connection);
+
+        if (it == m_guestConnections.end())
+        {
+            return;
+        }
+
+        // note: chunks are transmitted deferred to allow other transmissions
+        // to be processed in between
+        asio::post(ioContext(), [this, connectionWeak{ std::weak_ptr<Connection>{ it->second } }, descriptor{ &descriptor }]
+        {
+            if (connection_ptr_t connection = connectionWeak.lock(); connection != nullptr && !connection->closed())
+            {
+                try
+                {
+                    transmitSnapshotChunk(*connection, *descriptor);
+                }
+                catch (...)
+                {
+                    connection->handleError(std::current_exception());
+                }
+            }
+        });
+    }
+
+    void HostTransceiver::resumeSnapshots(Connection& connection)
+    {
+        for (auto it = m_snapshots.lower_bound({ &connection, nullptr }); it != m_snapshots.end() && it->first.first == &connection; ++it)
+        {
+            if (snapshot_t& snapshot = it->second; snapshot.awaitingDrain)
+            {
+                snapshot.awaitingDrain = false;
+                postSnapshotChunk(connection, *it->first.second);
+            }
+        }
+    }
+
+    bool HostTransceiver::isPendingInSnapshot(Connection& connection, const io::Transmission& transmission) const
+    {
+        auto it = m_snapshots.find({ &connection, &transmission.descriptor() });
+
+        if (it == m_snapshots.end())
+        {
+            return false;
+        }
+
+        // note: instances that have not yet been transmitted as part of the
+        // snapshot will be transmitted with their latest state later on
+        const snapshot_t& snapshot = it->second;
+        return snapshot.lastKey == std::nullopt || snapshot.keyCompare(*snapshot.lastKey, transmission.instance());
+    }
+
+    const Filter* HostTransceiver::findFilter(Connection& connection, const type::StructDescriptor& descriptor) const
+    {
+        auto it = m_filters.find({ &connection, &descriptor });
+        return it == m_filters.end() ? nullptr : &it->second;
+    }
+
+    const io::Transmission* HostTransceiver::filterTransmission(const Filter& filter, const io::Transmission& transmission, derived_transmissions_t& derived) const
+    {
+        const DotsHeader& header = transmission.header();
+        const type::StructDescriptor& descriptor = transmission.descriptor();
+
+        // note: removes usually only contain the key properties of an
+        // instance, so they can only be filtered if the filter does not refer
+        // to any other properties
+        if (header.removeObj == true)
+        {
+            if (filter.properties() <= descriptor.keyProperties() && !filter.matches(transmission.instance()))
+            {
+                return nullptr;
+            }
+
+            return &transmission;
+        }
+
+        if (!descriptor.cached())
+        {
+            return filter.matches(transmission.instance()) ? &transmission : nullptr;
+        }
+
+        const Container<>::value_t* clone = resolveClone(transmission, derived);
+        bool matches = clone != nullptr && filter.matches(*clone->first);
+        bool filterUpdated = !(*header.attributes ^ filter.properties()).empty();
+
+        if (!filterUpdated)
+        {
+            return matches ? &transmission : nullptr;
+        }
+        else if (matches)
+        {
+            if (derived.update == std::nullopt)
+            {
+                DotsHeader updateHeader = header;
+                updateHeader.attributes = clone->first->_validProperties();
+                derived.update.emplace(std::move(updateHeader), clone->first);
+            }
+
+            return &*derived.update;
+        }
+        else
+        {
+            if (derived.remove == std::nullopt)
+            {
+                DotsHeader removeHeader = header;
+                removeHeader.attributes = descriptor.keyProperties();
+                removeHeader.removeObj = true;
+                derived.remove.emplace(std::move(removeHeader), transmission.instance());
+            }
+
+            return &*derived.remove;
+        }
+    }
 
-        for (const auto& [instance, cloneInfo] : container)
+    const io::Transmission* HostTransceiver::deriveTransmission(Connection& connection, const io::Transmission& transmission, derived_transmissions_t& derived) const
+    {
+        const io::Transmission* destinationTransmission = &transmission;
+
+        if (!m_filters.empty())
+        {
+            if (const Filter* filter = findFilter(connection, transmission.descriptor()); filter != nullptr)
+            {
+                destinationTransmission = filterTransmission(*filter, transmission, derived);
+
+                if (destinationTransmission == nullptr)
+                {
+                    return nullptr;
+                }
+            }
+        }
+
+        if (!m_projections.empty())
+        {
+            if (const property_set_t* projection = findProjection(connection, transmission.descriptor()); projection != nullptr)
+            {
+                destinationTransmission = projectTransmission(*projection, *destinationTransmission, derived);
+            }
+        }
+
+        return destinationTransmission;
+    }
+
+    const property_set_t* HostTransceiver::findProjection(Connection& connection, const type::StructDescriptor& descriptor) const
+    {
+        auto it = m_projections.find({ &connection, &descriptor });
+        return it == m_projections.end() ? nullptr : &it->second;
+    }
+
+    const io::Transmission* HostTransceiver::projectTransmission(property_set_t projection, const io::Transmission& transmission, derived_transmissions_t& derived) const
+    {
+        const DotsHeader& header = transmission.header();
+        property_set_t attributes = *header.attributes ^ projection;
+
+        if (attributes == *header.attributes)
+        {
+            return &transmission;
+        }
+
+        // note: updates that do not contain any projected property are
+        // omitted, unless they create the instance from the perspective of
+        // the guest (i.e. an actual create or an instance that started
+        // matching the filter of the guest)
+        if (header.removeObj != true && (attributes - transmission.descriptor().keyProperties()).empty())
+        {
+            bool created = &transmission == (derived.update == std::nullopt ? nullptr : &*derived.update);
+
+            if (!created && transmission.descriptor().cached())
+            {
+                const Container<>::value_t* clone = resolveClone(transmission, derived);
+                created = clone != nullptr && clone->second.lastOperation == DotsMt::create;
+            }
+
+            if (!created)
+            {
+                return nullptr;
+            }
+        }
+
+        auto it = std::find_if(derived.projections.begin(), derived.projections.end(), [&](const projected_transmission_t& projected)
+        {
+            return projected.source == &transmission && *projected.transmission.header().attributes == attributes;
+        });
+
+        if (it == derived.projections.end())
+        {
+            DotsHeader projectedHeader = header;
+            projectedHeader.attributes = attributes;
+            it = derived.projections.insert(derived.projections.end(), projected_transmission_t{
+                .source = &transmission,
+                .transmission = io::Transmission{ std::move(projectedHeader), transmission.instance() }
+            });
+        }
+
+        return &it->transmission;
+    }
+
+    auto HostTransceiver::resolveClone(const io::Transmission& transmission, derived_transmissions_t& derived) const -> const Container<>::value_t*
+    {
+        // note: transmissions are distributed after they have been
+        // dispatched, so the clone reflects the state after the update
+        if (!derived.resolved)
+        {
+            derived.resolved = true;
+
+            if (const Container<>* container = pool().find(transmission.descriptor()); container != nullptr)
+            {
+                derived.clone = container->findClone(transmission.instance());
+            }
+        }
+
+        return derived.clone;
+    }
+
+    bool HostTransceiver::deltaUpdates(const type::StructDescriptor& descriptor)
+    {
+        type::StructDescriptor::type_id_t typeId = descriptor.typeId();
+
+        if (typeId >= m_deltaUpdateIndex.size())
+        {
+            m_deltaUpdateIndex.resize(typeId + 1);
+        }
+
+        // note: overrides are resolved by name only once per type, because
+        // they might be specified for types that are not yet known to the
+        // host
+        std::optional<bool>& deltaUpdates = m_deltaUpdateIndex[typeId];
+
+        if (deltaUpdates == std::nullopt)
+        {
+            auto it = m_deltaUpdateTypes.find(descriptor.name());
+            deltaUpdates = it == m_deltaUpdateTypes.end() ? m_deltaUpdates : it->second;
+        }
+
+        return *deltaUpdates;
+    }
+
+    auto HostTransceiver::findMulticastGroup(const type::StructDescriptor& descriptor) -> multicast_group_t*
+    {
+        type::StructDescriptor::type_id_t typeId = descriptor.typeId();
+
+        if (typeId >= m_multicastIndex.size())
+        {
+            m_multicastIndex.resize(typeId + 1);
+        }
+
+        std::optional<multicast_group_t*>& multicastGroup = m_multicastIndex[typeId];
+
+        if (multicastGroup == std::nullopt)
+        {
+            auto it = m_multicastGroups.find(descriptor.name());
+            multicastGroup = it == m_multicastGroups.end() ? nullptr : &it->second;
+        }
+
+        return *multicastGroup;
+    }
+
+    void HostTransceiver::transmitMulticast(multicast_group_t& multicastGroup, const io::Transmission& transmission)
+    {
+        uint64_t sequence = multicastGroup.sequence++;
+
+        // note: transmissions that could not be sent are retained as well, so
+        // they can be retransmitted when the members detect the gap
+        if (multicastGroup.sender->send(sequence, transmission))
+        {
+            type_traffic_t& traffic = typeTraffic(transmission.descriptor());
+            traffic.sentBytes += transmission.encodedSize();
+            ++traffic.sentPackages;
+        }
+
+        multicastGroup.history.emplace_back(sequence, transmission.share());
+
+        if (multicastGroup.history.size() > MulticastHistorySize)
+        {
+            multicastGroup.history.pop_front();
+        }
+    }
+
+    void HostTransceiver::leaveMulticastGroup(Connection& connection, multicast_group_t& multicastGroup)
+    {
+        if (multicastGroup.members.erase(&connection) > 0 && multicastGroup.members.empty())
+        {
+            multicastGroup.history.clear();
+        }
+    }
+
+    bool HostTransceiver::reduceTransmission(io::Transmission& transmission) const
+    {
+        const DotsHeader& header = std::as_const(transmission).header();
+
+        if (header.removeObj == true)
+        {
+            return true;
+        }
+
+        const Container<>* container = pool().find(transmission.descriptor());
+
+        if (container == nullptr)
+        {
+            return true;
+        }
+
+        // note: the transmission has not yet been dispatched, so the clone
+        // reflects the state before the update
+        const Container<>::value_t* clone = container->findClone(transmission.instance());
+
+        if (clone == nullptr)
+        {
+            return true;
+        }
+
+        property_set_t keyProperties = transmission.descriptor().keyProperties();
+        property_set_t updatedProperties = *header.attributes - keyProperties;
+        property_set_t changedProperties = transmission.instance()->_diffProperties(*clone->first, updatedProperties);
+
+        if (changedProperties == updatedProperties)
+        {
+            return true;
+        }
+
+        if (changedProperties.empty() && clone->second.lastUpdateFrom == header.sender)
+        {
+            return false;
+        }
+
+        DotsHeader reducedHeader = header;
+        reducedHeader.attributes = keyProperties + changedProperties;
+        uint32_t batchRemaining = transmission.batchRemaining();
+
+        transmission = io::Transmission{ std::move(reducedHeader), std::move(transmission).instance() };
+        transmission.setBatchRemaining(batchRemaining);
+
+        return true;
+    }
+
+    auto HostTransceiver::typeTraffic(const type::StructDescriptor& descriptor) -> type_traffic_t&
+    {
+        type::StructDescriptor::type_id_t typeId = descriptor.typeId();
+
+        if (typeId >= m_typeTraffic.size())
+        {
+            m_typeTraffic.resize(typeId + 1);
+        }
+
+        return m_typeTraffic[typeId];
+    }
+
+    void HostTransceiver::recordLatency(Connection& connection, const io::Transmission& transmission)
+    {
+        const DotsHeader& header = transmission.header();
+
+        if (!header.sentTime.isValid() || !header.serverSentTime.isValid())
+        {
+            return;
+        }
+
+        duration_t transport = *header.serverSentTime - *header.sentTime;
+        duration_t processing = timepoint_t::Now() - *header.serverSentTime;
+
+        type::StructDescriptor::type_id_t typeId = transmission.descriptor().typeId();
+
+        if (typeId >= m_typeLatencies.size())
         {
-            header.sentTime = *cloneInfo.modified;
-            header.serverSentTime = timepoint_t::Now();
-            header.attributes = instance->_validProperties();
-            header.sender = *cloneInfo.lastUpdateFrom;
-            --*header.fromCache;
+            m_typeLatencies.resize(typeId + 1);
+        }
 
-            connection.transmit(header, instance);
+        if (m_typeLatencies[typeId] == nullptr)
+        {
+            m_typeLatencies[typeId] = std::make_unique<latency_histograms_t>();
         }
+
+        for (latency_histograms_t* latencies : { m_typeLatencies[typeId].get(), &m_connectionLatencies[&connection] })
+        {
+            latencies->transport.record(transport);
+            latencies->processing.record(processing);
+        }
+    }
+
+    void HostTransceiver::resumePausedConnections()
+    {
+        if (!m_congestedConnections.empty() || m_pausedConnections.empty())
+        {
+            return;
+        }
+
+        std::vector<std::weak_ptr<Connection>> pausedConnections;
+
+        for (Connection* pausedConnection : m_pausedConnections)
+        {
+            if (auto it = m_guestConnections.find(pausedConnection); it != m_guestConnections.end())
+            {
+                pausedConnections.emplace_back(it->second);
+            }
+        }
+
+        m_pausedConnections.clear();
+
+        // note: resuming is deferred, because receiving might be performed
+        // synchronously and the host might currently be processing a
+        // transmission
+        asio::post(ioContext(), [pausedConnections{ std::move(pausedConnections) }]
+        {
+            for (const std::weak_ptr<Connection>& pausedConnection : pausedConnections)
+            {
+                if (connection_ptr_t connection = pausedConnection.lock(); connection != nullptr && !connection->closed())
+                {
+                    connection->resumeReceive();
+                }
+            }
+        });
     }
 }
 
@@ -359,6 +1495,12 @@ namespace dots
 #if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
 #include <dots/io/channels/UdsListener.h>
 #endif
+#if defined(__linux__)
+#include <dots/io/channels/ShmListener.h>
+#endif
+#if defined(DOTS_ENABLE_IO_URING)
+#include <dots/io/channels/UringListener.h>
+#endif
 
 namespace dots
 {
@@ -384,6 +1526,14 @@ namespace dots
                 if (listenEndpoint.port().empty())
                     listenEndpoint.setPort(std::string{ io::v2::TcpListener::DefaultPort });
             }
+            else if (scheme == "tcp-v3")
+            {
+                listen<io::v3::TcpListener>(listenEndpoint);
+
+                // workaround for including default port in log output below
+                if (listenEndpoint.port().empty())
+                    listenEndpoint.setPort(std::string{ io::v3::TcpListener::DefaultPort });
+            }
             else if (scheme == "tcp-v1")
             {
                 listen<io::v1::TcpListener>(listenEndpoint);
@@ -401,11 +1551,83 @@ namespace dots
             {
                 listen<io::posix::v2::UdsListener>(listenEndpoint);
             }
+            else if (scheme == "uds-v3")
+            {
+                listen<io::posix::v3::UdsListener>(listenEndpoint);
+            }
             else if (scheme == "uds-v1")
             {
                 listen<io::posix::v1::UdsListener>(listenEndpoint);
             }
             #endif
+            #if defined(__linux__)
+            else if (scheme == "shm")
+            {
+                listen<io::posix::ShmListener>(listenEndpoint);
+            }
+            else if (scheme == "shm-v2")
+            {
+                listen<io::posix::v2::ShmListener>(listenEndpoint);
+            }
+            else if (scheme == "shm-v3")
+            {
+                listen<io::posix::v3::ShmListener>(listenEndpoint);
+            }
+            else if (scheme == "shm-v1")
+            {
+                listen<io::posix::v1::ShmListener>(listenEndpoint);
+            }
+            #endif
+            #if defined(DOTS_ENABLE_IO_URING)
+            else if (scheme == "tcp-uring")
+            {
+                listen<io::posix::UringTcpListener>(listenEndpoint);
+
+                // workaround for including default port in log output below
+                if (listenEndpoint.port().empty())
+                    listenEndpoint.setPort(std::string{ io::posix::UringTcpListener::DefaultPort });
+            }
+            else if (scheme == "tcp-uring-v2")
+            {
+                listen<io::posix::v2::UringTcpListener>(listenEndpoint);
+
+                // workaround for including default port in log output below
+                if (listenEndpoint.port().empty())
+                    listenEndpoint.setPort(std::string{ io::posix::v2::UringTcpListener::DefaultPort });
+            }
+            else if (scheme == "tcp-uring-v3")
+            {
+                listen<io::posix::v3::UringTcpListener>(listenEndpoint);
+
+                // workaround for including default port in log output below
+                if (listenEndpoint.port().empty())
+                    listenEndpoint.setPort(std::string{ io::posix::v3::UringTcpListener::DefaultPort });
+            }
+            else if (scheme == "tcp-uring-v1")
+            {
+                listen<io::posix::v1::UringTcpListener>(listenEndpoint);
+
+                // workaround for including default port in log output below
+                if (listenEndpoint.port().empty())
+                    listenEndpoint.setPort(std::string{ io::posix::v1::UringTcpListener::DefaultPort });
+            }
+            else if (scheme == "uds-uring")
+            {
+                listen<io::posix::UringUdsListener>(listenEndpoint);
+            }
+            else if (scheme == "uds-uring-v2")
+            {
+                listen<io::posix::v2::UringUdsListener>(listenEndpoint);
+            }
+            else if (scheme == "uds-uring-v3")
+            {
+                listen<io::posix::v3::UringUdsListener>(listenEndpoint);
+            }
+            else if (scheme == "uds-uring-v1")
+            {
+                listen<io::posix::v1::UringUdsListener>(listenEndpoint);
+            }
+            #endif
             else if (scheme == "ws")
             {
                 listen<io::WebSocketListener>(listenEndpoint);
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/LatencyHistogram.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace dots
+{
+    LatencyHistogram::LatencyHistogram() :
+        m_count(0),
+        m_min(0),
+        m_max(0)
+    {
+        /* do nothing */
+    }
+
+    void LatencyHistogram::record(duration_t latency)
+    {
+        double microseconds = std::clamp(latency.count() * 1e6, 0.0, static_cast<double>(MaxValue));
+        auto value = static_cast<uint64_t>(std::llround(microseconds));
+
+        size_t index = BucketIndex(value);
+
+        if (index >= m_buckets.size())
+        {
+            m_buckets.resize(index + 1, 0);
+        }
+
+        ++m_buckets[index];
+        m_min = m_count == 0 ? value : std::min(m_min, value);
+        m_max = m_count == 0 ? value : std::max(m_max, value);
+        ++m_count;
+    }
+
+    void LatencyHistogram::reset()
+    {
+        std::fill(m_buckets.begin(), m_buckets.end(), 0);
+        m_count = 0;
+        m_min = 0;
+        m_max = 0;
+    }
+
+    uint64_t LatencyHistogram::count() const
+    {
+        return m_count;
+    }
+
+    duration_t LatencyHistogram::min() const
+    {
+        return ToDuration(m_min);
+    }
+
+    duration_t LatencyHistogram::max() const
+    {
+        return ToDuration(m_max);
+    }
+
+    duration_t LatencyHistogram::percentile(double percentile) const
+    {
+        if (m_count == 0)
+        {
+            return ToDuration(0);
+        }
+
+        auto target = static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(m_count)));
+        target = std::max(target, uint64_t{ 1 });
+        uint64_t accumulated = 0;
+
+        for (size_t index = 0; index < m_buckets.size(); ++index)
+        {
+            accumulated += m_buckets[index];
+
+            if (accumulated >= target)
+            {
+                return ToDuration(std::clamp(BucketUpperBound(index), m_min, m_max));
+            }
+        }
+
+        return ToDuration(m_max);
+    }
+
+    DotsLatencyStatistics LatencyHistogram::statistics() const
+    {
+        if (m_count == 0)
+        {
+            return DotsLatencyStatistics{ .count = 0 };
+        }
+
+        return DotsLatencyStatistics{
+            .count = m_count,
+            .min = min(),
+            .p50 = percentile(50.0),
+            .p90 = percentile(90.0),
+            .p99 = percentile(99.0),
+            .p999 = percentile(99.9),
+            .max = max()
+        };
+    }
+
+    size_t LatencyHistogram::BucketIndex(uint64_t value)
+    {
+        // note: values below the sub bucket count are stored linearly. larger
+        // values are stored in buckets of width 2^shift, with each magnitude
+        // covering the upper half of the sub buckets
+        if (value < SubBucketCount)
+        {
+            return static_cast<size_t>(value);
+        }
+
+        auto shift = static_cast<uint64_t>(std::bit_width(value)) - SubBucketBits;
+        return static_cast<size_t>(shift * (SubBucketCount / 2) + (value >> shift));
+    }
+
+    uint64_t LatencyHistogram::BucketUpperBound(size_t index)
+    {
+        if (index < SubBucketCount)
+        {
+            return index;
+        }
+
+        uint64_t shift = index / (SubBucketCount / 2) - 1;
+        uint64_t subBucket = index - shift * (SubBucketCount / 2);
+
+        return ((subBucket + 1) << shift) - 1;
+    }
+
+    duration_t LatencyHistogram::ToDuration(uint64_t value)
+    {
+        return duration_t{ static_cast<double>(value) * 1e-6 };
+    }
+}
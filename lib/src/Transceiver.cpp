@@ -2,6 +2,7 @@
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #include <dots/Transceiver.h>
 #include <dots/tools/logging.h>
+#include <dots/io/WorkerPool.h>
 #include <dots/serialization/AsciiSerialization.h>
 #include <DotsMember.dots.h>
 
@@ -13,7 +14,26 @@ namespace dots
                              std::optional<transition_handler_t> transitionHandler/* = std::nullopt*/) :
         m_nextId(0),
         m_this(std::make_shared<Transceiver*>(this)),
-        m_registry{ [this_{ m_this }](const type::Descriptor<>& descriptor){ (*this_)->handleNewType(descriptor); }, staticTypePolicy },
+        m_registry{ [this_{ m_this }](const type::Descriptor<>& descriptor)
+        {
+            // note: types can be registered by channels that are operated by
+            // worker threads, in which case the handlers are invoked on the
+            // IO context of the transceiver instead
+            if (io::WorkerPool::RunningInWorkerThread())
+            {
+                asio::post((*this_)->ioContext(), [this_{ std::weak_ptr<Transceiver*>{ this_ } }, &descriptor]
+                {
+                    if (auto transceiver = this_.lock(); transceiver != nullptr)
+                    {
+                        (*transceiver)->handleNewType(descriptor);
+                    }
+                });
+            }
+            else
+            {
+                (*this_)->handleNewType(descriptor);
+            }
+        }, staticTypePolicy },
         m_dispatcher{ [this_{ m_this }](const type::StructDescriptor& descriptor, std::exception_ptr ePtr){ (*this_)->handleDispatchError(descriptor, ePtr); } },
         m_selfName{ std::move(selfName) },
         m_ioContext(std::ref(ioContext)),
@@ -112,6 +132,11 @@ namespace dots
         return m_dispatcher.container(descriptor);
     }
 
+    void Transceiver::setContainerStorage(const type::StructDescriptor& descriptor, Container<>::Storage storage)
+    {
+        m_dispatcher.container(descriptor).setStorage(storage);
+    }
+
     Subscription Transceiver::subscribe(const type::StructDescriptor& descriptor, transmission_handler_t handler)
     {
         if (descriptor.substructOnly())
@@ -10,9 +10,15 @@ namespace dots::io
 {
     Channel::Channel(key_t key) :
         shared_ptr_only(key),
+        m_structTypesDeregistrations(0),
         m_asyncReceiving(false),
+        m_receivePaused(false),
+        m_receiveSuspended(false),
         m_initialized(false),
-        m_registry(nullptr)
+        m_passThrough(false),
+        m_registry(nullptr),
+        m_writeQueueState{ std::make_shared<WriteQueueState>() },
+        m_trafficState{ std::make_shared<TrafficState>() }
     {
         /* do nothing */
     }
@@ -81,15 +87,139 @@ namespace dots::io
     void Channel::transmit(const Transmission& transmission)
     {
         assert(m_initialized);
-        exportDependencies(transmission.instance()->_descriptor());
+        exportDependencies(transmission.descriptor());
         transmitImpl(transmission);
     }
 
+    void Channel::transmit(const DotsHeader& header, const instance_batch_t& instances)
+    {
+        assert(m_initialized);
+
+        if (instances.empty())
+        {
+            return;
+        }
+
+        exportDependencies(instances.front().get()._descriptor());
+        transmitImpl(header, instances);
+    }
+
+    void Channel::transmit(const std::vector<Transmission>& transmissions)
+    {
+        assert(m_initialized);
+
+        if (transmissions.empty())
+        {
+            return;
+        }
+
+        exportDependencies(transmissions.front().descriptor());
+        transmitImpl(transmissions);
+    }
+
     void Channel::transmit(const type::Descriptor<>& descriptor)
     {
         exportDependencies(descriptor);
     }
 
+    void Channel::setWriteQueueLimit(size_t maxSize, DotsWriteQueuePolicy policy, std::optional<write_queue_handler_t> drainHandler/* = std::nullopt*/)
+    {
+        if (maxSize == 0)
+        {
+            throw std::logic_error{ "write queue limit must not be zero" };
+        }
+
+        m_writeQueueState->maxSize = maxSize;
+        m_writeQueueState->policy = policy;
+        m_writeQueueHandler = std::move(drainHandler);
+    }
+
+    void Channel::setConflationThreshold(size_t threshold)
+    {
+        m_writeQueueState->conflationThreshold = threshold;
+    }
+
+    void Channel::setPassThrough(bool passThrough)
+    {
+        m_passThrough = passThrough;
+    }
+
+    DotsWriteQueueStatus Channel::writeQueueStatus() const
+    {
+        return DotsWriteQueueStatus{
+            .policy = m_writeQueueState->policy.load(),
+            .maxSize = m_writeQueueState->maxSize.load(),
+            .size = m_writeQueueState->size.load(),
+            .depth = m_writeQueueState->depth.load(),
+            .dropped = m_writeQueueState->dropped.load(),
+            .congestions = m_writeQueueState->congestions.load(),
+            .conflationThreshold = m_writeQueueState->conflationThreshold.load(),
+            .conflated = m_writeQueueState->conflated.load()
+        };
+    }
+
+    bool Channel::writeQueueCongested() const
+    {
+        return m_writeQueueState->congested;
+    }
+
+    bool Channel::awaitWriteQueueDrain()
+    {
+        WriteQueueState& state = *m_writeQueueState;
+        state.drainRequested = true;
+
+        // note: the write queue might be operated concurrently (e.g. by a
+        // worker thread), so the request is withdrawn via an exchange to
+        // ensure that the drain handler is invoked at most once
+        if (state.size <= state.maxSize / 2)
+        {
+            return !state.drainRequested.exchange(false);
+        }
+
+        return true;
+    }
+
+    DotsStatistics Channel::receivedStatistics() const
+    {
+        return DotsStatistics{
+            .bytes = m_trafficState->receivedBytes.load(std::memory_order_relaxed),
+            .packages = m_trafficState->receivedPackages.load(std::memory_order_relaxed)
+        };
+    }
+
+    DotsStatistics Channel::sentStatistics() const
+    {
+        return DotsStatistics{
+            .bytes = m_trafficState->sentBytes.load(std::memory_order_relaxed),
+            .packages = m_trafficState->sentPackages.load(std::memory_order_relaxed)
+        };
+    }
+
+    void Channel::pauseReceive()
+    {
+        m_receivePaused = true;
+    }
+
+    void Channel::resumeReceive()
+    {
+        if (!m_receivePaused)
+        {
+            return;
+        }
+
+        m_receivePaused = false;
+
+        if (m_receiveSuspended)
+        {
+            m_receiveSuspended = false;
+
+            if (m_asyncReceiving)
+            {
+                asyncReceiveImpl();
+            }
+        }
+    }
+
     void Channel::initEndpoints(Endpoint localEndpoint, Endpoint remoteEndpoint)
     {
         if (m_localEndpoint != std::nullopt)
@@ -113,23 +243,99 @@ namespace dots::io
         return *m_registry;
     }
 
+    const type::StructDescriptor& Channel::resolveStructType(const std::string& name)
+    {
+        // note: resolved descriptors are cached to avoid locking the registry
+        // for every received transmission. the cache is invalidated whenever
+        // a type has been deregistered, because the cached descriptors might
+        // no longer be valid
+        if (uint64_t deregistrations = registry().deregistrations(); deregistrations != m_structTypesDeregistrations)
+        {
+            m_structTypes.clear();
+            m_structTypesDeregistrations = deregistrations;
+        }
+
+        if (auto it = m_structTypes.find(name); it != m_structTypes.end())
+        {
+            return *it->second;
+        }
+
+        const type::StructDescriptor& descriptor = registry().getStructType(name);
+        m_structTypes.emplace(name, &descriptor);
+
+        return descriptor;
+    }
+
+    bool Channel::passThrough(const type::StructDescriptor& descriptor) const
+    {
+        // note: internal types are always decoded, because they might be
+        // required to be processed by the channel or the connection
+        return m_passThrough && !descriptor.cached() && !descriptor.internal();
+    }
+
+    bool Channel::Droppable(const type::StructDescriptor& descriptor)
+    {
+        return !descriptor.cached() && !descriptor.internal();
+    }
+
+    auto Channel::writeQueueState() const -> const WriteQueueState&
+    {
+        return *m_writeQueueState;
+    }
+
+    auto Channel::writeQueueState() -> WriteQueueState&
+    {
+        return *m_writeQueueState;
+    }
+
+    auto Channel::trafficState() -> TrafficState&
+    {
+        return *m_trafficState;
+    }
+
     void Channel::transmitImpl(const Transmission& transmission)
     {
         transmitImpl(transmission.header(), transmission.instance());
     }
 
+    void Channel::transmitImpl(const DotsHeader& header, const instance_batch_t& instances)
+    {
+        for (const type::Struct& instance : instances)
+        {
+            transmitImpl(header, instance);
+        }
+    }
+
+    void Channel::transmitImpl(const std::vector<Transmission>& transmissions)
+    {
+        for (const Transmission& transmission : transmissions)
+        {
+            transmitImpl(transmission);
+        }
+    }
+
     void Channel::processReceive(Transmission transmission) noexcept
     {
         try
         {
-            importDependencies(transmission.instance());
+            if (transmission.descriptor().internal())
+            {
+                importDependencies(transmission.instance());
+            }
 
             // note: if the receive handler yields 'false', the channel must no
             // longer be accessed afterwards, because it might have already been
             // deleted by the callee prior to returning
             if ((*m_receiveHandler)(std::move(transmission)))
             {
-                asyncReceiveImpl();
+                if (m_receivePaused)
+                {
+                    m_receiveSuspended = true;
+                }
+                else
+                {
+                    asyncReceiveImpl();
+                }
             }
         }
         catch (...)
@@ -156,6 +362,14 @@ namespace dots::io
         processError(std::make_exception_ptr(std::runtime_error{ what }));
     }
 
+    void Channel::processWriteQueueDrained()
+    {
+        if (m_writeQueueHandler != std::nullopt)
+        {
+            (*m_writeQueueHandler)();
+        }
+    }
+
     void Channel::verifyErrorCode(std::error_code errorCode)
     {
         if (errorCode)
@@ -164,6 +378,41 @@ namespace dots::io
         }
     }
 
+    void Channel::applyWriteQueuePolicy(size_t size)
+    {
+        WriteQueueState& state = writeQueueState();
+        size_t maxSize = state.maxSize;
+
+        if (size <= maxSize)
+        {
+            return;
+        }
+
+        if (DotsWriteQueuePolicy policy = state.policy; policy == DotsWriteQueuePolicy::drop_oldest)
+        {
+            throw std::runtime_error{ "write queue exceeded maximum size of " + std::to_string(maxSize) + " bytes and no transmissions can be dropped" };
+        }
+        else if (policy == DotsWriteQueuePolicy::pause_reading)
+        {
+            if (!state.congested.exchange(true))
+            {
+                ++state.congestions;
+            }
+
+            // note: the write queue can still grow while publishers are
+            // paused (e.g. because of transmissions of the host itself), so
+            // the connection is closed as a last resort
+            if (size > 2 * maxSize)
+            {
+                throw std::runtime_error{ "write queue exceeded twice its maximum size of " + std::to_string(maxSize) + " bytes while being congested" };
+            }
+        }
+        else
+        {
+            throw std::runtime_error{ "write queue exceeded maximum size of " + std::to_string(maxSize) + " bytes" };
+        }
+    }
+
     void Channel::importDependencies(const type::Struct& instance)
     {
         if (auto* structDescriptorData = instance._as<StructDescriptorData>())
@@ -26,7 +26,10 @@ namespace dots::io
             enumerators.emplace_back(*enumeratorData.tag, *enumeratorData.name, static_cast<type::DynamicEnum>(*enumeratorData.enum_value));
         }
 
-        return m_registry.get().registerType<type::Descriptor<type::DynamicEnum>>(*enumData.name, std::move(enumerators));
+        // note: the type is registered without asserting that it is new, because it might have been registered concurrently by
+        // another thread in the meantime, in which case the already registered type is used
+        auto descriptor = type::make_descriptor<type::Descriptor<type::DynamicEnum>>(*enumData.name, std::move(enumerators));
+        return static_cast<type::EnumDescriptor&>(m_registry.get().registerType(std::move(descriptor), false));
     }
 
     type::StructDescriptor& DescriptorConverter::operator () (const StructDescriptorData& structData) const
@@ -111,7 +114,10 @@ namespace dots::io
 
         size_t size = type::PropertyOffset::Next(alignment, last->offset(), last->valueDescriptor().size());
 
-        return m_registry.get().registerType<type::Descriptor<type::DynamicStruct>>(*structData.name, flags, propertyDescriptors, sizeof(type::DynamicStruct) + size);
+        // note: the type is registered without asserting that it is new, because it might have been registered concurrently by
+        // another thread in the meantime, in which case the already registered type is used
+        auto descriptor = type::make_descriptor<type::Descriptor<type::DynamicStruct>>(*structData.name, flags, propertyDescriptors, sizeof(type::DynamicStruct) + size);
+        return static_cast<type::StructDescriptor&>(m_registry.get().registerType(std::move(descriptor), false));
     }
 
     EnumDescriptorData DescriptorConverter::operator () (const type::EnumDescriptor& enumDescriptor)
@@ -17,6 +17,16 @@ namespace dots::io
         asyncAcceptImpl();
     }
 
+    void Listener::setWorkerPool(std::shared_ptr<WorkerPool> workerPool)
+    {
+        m_workerPool = std::move(workerPool);
+    }
+
+    WorkerPool* Listener::workerPool()
+    {
+        return m_workerPool.get();
+    }
+
     void Listener::processAccept(channel_ptr_t channel)
     {
         if ((*m_acceptHandler)(*this, std::move(channel)))
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/io/MulticastReceiver.h>
+#include <array>
+#include <dots/io/MulticastSender.h>
+#include <dots/serialization/CborSerializer.h>
+
+namespace dots::io
+{
+    struct MulticastReceiver::state : std::enable_shared_from_this<state>
+    {
+        state(asio::io_context& ioContext, const type::StructDescriptor& descriptor) :
+            socket{ ioContext },
+            descriptor{ &descriptor }
+        {
+            /* do nothing */
+        }
+
+        void asyncReceive()
+        {
+            socket.async_receive(asio::buffer(buffer), [this_ = shared_from_this()](boost::system::error_code error, size_t bytesReceived)
+            {
+                this_->handleReceive(error, bytesReceived);
+            });
+        }
+
+        void handleReceive(boost::system::error_code error, size_t bytesReceived)
+        {
+            // note: the socket is closed when the receiver is destroyed,
+            // which might also happen while one of the handlers is invoked.
+            // the state itself is kept alive until the handler returns
+            if (!socket.is_open())
+            {
+                return;
+            }
+
+            if (error)
+            {
+                if (error != asio::error::operation_aborted)
+                {
+                    (*errorHandler)(std::make_exception_ptr(boost::system::system_error{ error, "failed receiving multicast datagram" }));
+                }
+
+                return;
+            }
+
+            std::optional<std::pair<uint64_t, Transmission>> received;
+
+            try
+            {
+                serializer.setInput(buffer.data(), bytesReceived);
+                auto sequence = serializer.deserialize<uint64_t>();
+                auto header = serializer.deserialize<DotsHeader>();
+
+                if (!header.typeName.isValid() || *header.typeName != descriptor->name())
+                {
+                    throw std::runtime_error{ "received multicast datagram of unexpected type '" + header.typeName.valueOrDefault("<unknown>") + "'" };
+                }
+
+                type::AnyStruct instance{ *descriptor };
+                serializer.deserialize(*instance);
+
+                Transmission transmission{ std::move(header), std::move(instance) };
+                transmission.setEncodedSize(bytesReceived);
+                received.emplace(sequence, std::move(transmission));
+            }
+            catch (...)
+            {
+                (*errorHandler)(std::current_exception());
+            }
+
+            if (received != std::nullopt && socket.is_open())
+            {
+                (*receiveHandler)(received->first, std::move(received->second));
+            }
+
+            if (socket.is_open())
+            {
+                asyncReceive();
+            }
+        }
+
+        asio::ip::udp::socket socket;
+        const type::StructDescriptor* descriptor;
+        std::array<uint8_t, MulticastSender::MaxDatagramSize> buffer;
+        serialization::CborSerializer serializer;
+        std::optional<receive_handler_t> receiveHandler;
+        std::optional<error_handler_t> errorHandler;
+    };
+
+    MulticastReceiver::MulticastReceiver(asio::io_context& ioContext, const Endpoint& endpoint, const type::StructDescriptor& descriptor, std::optional<std::string> interfaceAddress/* = std::nullopt*/) :
+        m_state{ std::make_shared<state>(ioContext, descriptor) }
+    {
+        try
+        {
+            asio::ip::address_v4 address = asio::ip::make_address_v4(endpoint.host());
+
+            if (!address.is_multicast())
+            {
+                throw std::runtime_error{ "address is not an IPv4 multicast address" };
+            }
+
+            asio::ip::udp::socket& socket = m_state->socket;
+            socket.open(asio::ip::udp::v4());
+            socket.set_option(asio::ip::udp::socket::reuse_address(true));
+            socket.bind(asio::ip::udp::endpoint{ asio::ip::address_v4::any(), static_cast<uint16_t>(std::stoul(std::string{ endpoint.port() })) });
+
+            if (interfaceAddress == std::nullopt)
+            {
+                socket.set_option(asio::ip::multicast::join_group(address));
+            }
+            else
+            {
+                socket.set_option(asio::ip::multicast::join_group(address, asio::ip::make_address_v4(*interfaceAddress)));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            throw std::runtime_error{ "failed creating multicast receiver for endpoint '" + std::string{ endpoint.uriStr() } + "' -> " + e.what() };
+        }
+    }
+
+    MulticastReceiver::~MulticastReceiver()
+    {
+        boost::system::error_code error;
+        m_state->socket.close(error);
+    }
+
+    void MulticastReceiver::asyncReceive(receive_handler_t receiveHandler, error_handler_t errorHandler)
+    {
+        if (m_state->receiveHandler != std::nullopt)
+        {
+            throw std::logic_error{ "attempt to receive from multicast group while already receiving" };
+        }
+
+        m_state->receiveHandler.emplace(std::move(receiveHandler));
+        m_state->errorHandler.emplace(std::move(errorHandler));
+        m_state->asyncReceive();
+    }
+}
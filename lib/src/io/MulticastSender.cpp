@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/io/MulticastSender.h>
+
+namespace dots::io
+{
+    MulticastSender::MulticastSender(asio::io_context& ioContext, const Endpoint& endpoint, std::optional<std::string> interfaceAddress/* = std::nullopt*/) :
+        m_socket{ ioContext }
+    {
+        try
+        {
+            asio::ip::address_v4 address = asio::ip::make_address_v4(endpoint.host());
+
+            if (!address.is_multicast())
+            {
+                throw std::runtime_error{ "address is not an IPv4 multicast address" };
+            }
+
+            m_endpoint = asio::ip::udp::endpoint{ address, static_cast<uint16_t>(std::stoul(std::string{ endpoint.port() })) };
+            m_socket.open(m_endpoint.protocol());
+            m_socket.set_option(asio::ip::multicast::enable_loopback(true));
+
+            if (interfaceAddress != std::nullopt)
+            {
+                m_socket.set_option(asio::ip::multicast::outbound_interface(asio::ip::make_address_v4(*interfaceAddress)));
+            }
+
+            m_socket.non_blocking(true);
+        }
+        catch (const std::exception& e)
+        {
+            throw std::runtime_error{ "failed creating multicast sender for endpoint '" + std::string{ endpoint.uriStr() } + "' -> " + e.what() };
+        }
+    }
+
+    bool MulticastSender::send(uint64_t sequence, const Transmission& transmission)
+    {
+        const DotsHeader& header = transmission.header();
+        m_serializer.output().clear();
+        m_serializer.serialize(sequence);
+        m_serializer.serialize(header);
+
+        if (const Transmission::payload_t* payload = transmission.payload(); payload == nullptr)
+        {
+            m_serializer.serialize(*transmission.instance(), *header.attributes);
+        }
+        else
+        {
+            m_serializer.output().insert(m_serializer.output().end(), payload->begin(), payload->end());
+        }
+
+        if (m_serializer.output().size() > MaxDatagramSize)
+        {
+            return false;
+        }
+
+        boost::system::error_code error;
+        m_socket.send_to(asio::buffer(m_serializer.output()), m_endpoint, 0, error);
+
+        return !error;
+    }
+}
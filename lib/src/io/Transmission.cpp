@@ -1,11 +1,36 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #include <dots/io/Transmission.h>
+#include <dots/serialization/CborSerializer.h>
 
 namespace dots::io
 {
     Transmission::Transmission(DotsHeader header, type::AnyStruct instance) :
-        m_data{ std::make_unique<TransmissionData>(TransmissionData{ ++M_LastId, std::move(header), std::move(instance) }) }
+        m_data{ std::make_shared<TransmissionData>() }
+    {
+        m_data->id = ++M_LastId;
+        m_data->header = std::move(header);
+        m_data->descriptor = &instance->_descriptor();
+        m_data->encodedSize = 0;
+        m_data->batchRemaining = 0;
+        m_data->instance.emplace(std::move(instance));
+        m_data->decoded = true;
+    }
+
+    Transmission::Transmission(DotsHeader header, const type::StructDescriptor& descriptor, payload_t payload) :
+        m_data{ std::make_shared<TransmissionData>() }
+    {
+        m_data->id = ++M_LastId;
+        m_data->header = std::move(header);
+        m_data->descriptor = &descriptor;
+        m_data->payload.emplace(std::move(payload));
+        m_data->encodedSize = 0;
+        m_data->batchRemaining = 0;
+        m_data->decoded = false;
+    }
+
+    Transmission::Transmission(std::shared_ptr<TransmissionData> data) :
+        m_data{ std::move(data) }
     {
         /* do nothing */
     }
@@ -15,6 +40,14 @@ namespace dots::io
         return m_data->id;
     }
 
+    Transmission Transmission::share() const
+    {
+        // note: shared transmissions refer to the same underlying data, which
+        // is copied before it is modified through any of them (see
+        // Transmission::mutableData())
+        return Transmission{ m_data };
+    }
+
     const DotsHeader& Transmission::header() const&
     {
         return m_data->header;
@@ -22,21 +55,149 @@ namespace dots::io
 
     DotsHeader& Transmission::header() &
     {
-        return m_data->header;
+        return mutableData().header;
     }
 
     DotsHeader Transmission::header() &&
     {
-        return DotsHeader{ std::move(m_data->header) };
+        if (exclusive())
+        {
+            return DotsHeader{ std::move(m_data->header) };
+        }
+        else
+        {
+            return m_data->header;
+        }
+    }
+
+    const type::StructDescriptor& Transmission::descriptor() const
+    {
+        return *m_data->descriptor;
+    }
+
+    auto Transmission::payload() const -> const payload_t*
+    {
+        return m_data->payload == std::nullopt ? nullptr : &*m_data->payload;
+    }
+
+    bool Transmission::decoded() const
+    {
+        // note: the flag is only set after the instance has been decoded, so
+        // it can be queried while the instance is decoded on another thread
+        return m_data->decoded.load(std::memory_order_acquire);
+    }
+
+    size_t Transmission::encodedSize() const
+    {
+        return m_data->encodedSize;
+    }
+
+    void Transmission::setEncodedSize(size_t encodedSize)
+    {
+        // note: the encoded size is only known if the transmission was
+        // received through a channel that sets it
+        mutableData().encodedSize = encodedSize;
+    }
+
+    uint32_t Transmission::batchRemaining() const
+    {
+        return m_data->batchRemaining;
+    }
+
+    void Transmission::setBatchRemaining(uint32_t batchRemaining)
+    {
+        // note: the amount of remaining transmissions is only known if the
+        // transmission was received as part of a batch (see
+        // io::TransmissionFormat::v3)
+        mutableData().batchRemaining = batchRemaining;
     }
 
     const type::AnyStruct& Transmission::instance() const&
     {
-        return m_data->instance;
+        decode();
+        return *m_data->instance;
     }
 
     type::AnyStruct Transmission::instance() &&
     {
-        return type::AnyStruct{ std::move(m_data->instance) };
+        decode();
+
+        if (exclusive())
+        {
+            return type::AnyStruct{ std::move(*m_data->instance) };
+        }
+        else
+        {
+            return type::AnyStruct{ *m_data->instance };
+        }
+    }
+
+    bool Transmission::exclusive() const
+    {
+        if (m_data.use_count() == 1)
+        {
+            // note: other owners might have released the data concurrently,
+            // so their accesses must be visible before it is modified
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    auto Transmission::mutableData() -> TransmissionData&
+    {
+        if (exclusive())
+        {
+            return *m_data;
+        }
+
+        // note: the copy is a distinct transmission with a new id, because
+        // the id of the shared data might already be associated with its
+        // encoded payload (e.g. by the payload cache of a channel)
+        auto data = std::make_shared<TransmissionData>();
+        data->id = ++M_LastId;
+        data->header = m_data->header;
+        data->descriptor = m_data->descriptor;
+        data->payload = m_data->payload;
+        data->encodedSize = m_data->encodedSize;
+        data->batchRemaining = m_data->batchRemaining;
+
+        if (m_data->decoded.load(std::memory_order_acquire))
+        {
+            data->instance.emplace(*m_data->instance);
+            data->decoded = true;
+        }
+        else
+        {
+            data->decoded = false;
+        }
+
+        m_data = std::move(data);
+
+        return *m_data;
+    }
+
+    void Transmission::decode() const
+    {
+        if (m_data->payload == std::nullopt || m_data->decoded.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        // note: the payload of undecoded transmissions is decoded on first
+        // access. this might occur concurrently if the transmission is
+        // shared among multiple threads
+        std::call_once(m_data->decodeFlag, [&data = *m_data]
+        {
+            type::AnyStruct instance{ *data.descriptor };
+            serialization::CborSerializer serializer;
+            serializer.setInput(data.payload->data(), data.payload->size());
+            serializer.deserialize(*instance);
+            data.instance.emplace(std::move(instance));
+            data.decoded.store(true, std::memory_order_release);
+        });
     }
 }
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/io/WorkerPool.h>
+#include <dots/tools/logging.h>
+
+namespace dots::io
+{
+    WorkerPool::WorkerPool(size_t numWorkers) :
+        m_nextWorker(0),
+        m_started(false)
+    {
+        if (numWorkers == 0)
+        {
+            throw std::logic_error{ "worker pool requires at least one worker" };
+        }
+
+        for (size_t i = 0; i < numWorkers; ++i)
+        {
+            m_workers.emplace_back(std::make_unique<Worker>());
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        for (auto& worker : m_workers)
+        {
+            worker->workGuard = std::nullopt;
+            worker->ioContext.stop();
+        }
+
+        for (auto& worker : m_workers)
+        {
+            if (worker->thread.joinable())
+            {
+                worker->thread.join();
+            }
+        }
+    }
+
+    size_t WorkerPool::size() const
+    {
+        return m_workers.size();
+    }
+
+    asio::io_context& WorkerPool::ioContext(size_t index)
+    {
+        return m_workers.at(index)->ioContext;
+    }
+
+    size_t WorkerPool::next()
+    {
+        if (!m_started)
+        {
+            start();
+        }
+
+        size_t index = m_nextWorker;
+        m_nextWorker = (m_nextWorker + 1) % m_workers.size();
+
+        return index;
+    }
+
+    bool WorkerPool::RunningInWorkerThread()
+    {
+        return M_isWorkerThread;
+    }
+
+    void WorkerPool::start()
+    {
+        for (auto& worker : m_workers)
+        {
+            worker->workGuard.emplace(worker->ioContext.get_executor());
+            worker->thread = std::thread{ [&ioContext = worker->ioContext]
+            {
+                M_isWorkerThread = true;
+
+                for (;;)
+                {
+                    try
+                    {
+                        ioContext.run();
+                        break;
+                    }
+                    catch (const std::exception& e)
+                    {
+                        LOG_ERROR_S("error in worker thread -> " << e.what());
+                    }
+                }
+            } };
+        }
+
+        m_started = true;
+    }
+}
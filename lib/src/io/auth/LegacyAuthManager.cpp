@@ -29,7 +29,7 @@ namespace dots::io
                 return std::nullopt;
             }
         }
-        else if (remoteEndpoint.scheme() == "uds")
+        else if (remoteEndpoint.scheme() == "uds" || remoteEndpoint.scheme() == "shm")
         {
             return std::nullopt;
         }
@@ -63,7 +63,7 @@ namespace dots::io
 
             return verifyResponse(asio::ip::address::from_string(std::string{ remoteEndpoint.host() }), nonce.value(), connect);
         }
-        else if (remoteEndpoint.scheme() == "uds")
+        else if (remoteEndpoint.scheme() == "uds" || remoteEndpoint.scheme() == "shm")
         {
             return true;
         }
@@ -52,7 +52,12 @@ namespace dots::io
             }
         }
 
-        asio::post(other->m_ioContext.get(), [peer = m_peer, header = header, data = to_cbor(instance, *header.attributes)]() mutable
+        // note: the instance is copied instead of serialized, so it can be handed over to the peer as-is if both registries use
+        // the same descriptor (e.g. for static types in the same process)
+        type::AnyStruct instance_{ instance._descriptor() };
+        instance_->_copy(instance, *header.attributes);
+
+        asio::post(other->m_ioContext.get(), [peer = m_peer, header = header, instance_ = std::move(instance_)]() mutable
         {
             auto other = peer.lock();
 
@@ -70,10 +75,15 @@ namespace dots::io
                     throw std::runtime_error{ "encountered unknown type: " + *header.typeName };
                 }
 
-                // note: a serialization roundtrip is performed here to ensure that the descriptor of the local registry is used. this is
-                // required, because descriptors are not guaranteed to be identical (e.g. when mixing static and dynamic descriptors).
-                type::AnyStruct instance_{ *descriptor };
-                from_cbor(data, instance_.get());
+                // note: a serialization roundtrip is performed here if the descriptor of the local registry differs from the one of
+                // the instance. this is required, because descriptors are not guaranteed to be identical (e.g. when mixing static and
+                // dynamic descriptors).
+                if (descriptor != &instance_->_descriptor())
+                {
+                    type::AnyStruct converted{ *descriptor };
+                    from_cbor(to_cbor(*instance_, *header.attributes), converted.get());
+                    instance_ = std::move(converted);
+                }
 
                 other->processReceive(Transmission{ std::move(header), std::move(instance_) });
             }
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <dots/io/channels/ShmChannel.h>
+
+namespace dots::io::posix::details
+{
+    template <typename Serializer, TransmissionFormat TransmissionFormat>
+    GenericShmChannel<Serializer, TransmissionFormat>::GenericShmChannel(key_t key, asio::io_context& ioContext, const Endpoint& endpoint) :
+        GenericShmChannel(key, ioContext, endpoint.path())
+    {
+        /* do nothing */
+    }
+
+    template <typename Serializer, TransmissionFormat TransmissionFormat>
+    GenericShmChannel<Serializer, TransmissionFormat>::GenericShmChannel(key_t key, asio::io_context& ioContext, std::string_view path) :
+        base_t(key, Connect(ioContext, path), nullptr)
+    {
+        initEndpoints(Endpoint{ "shm", std::string{ path } }, Endpoint{ "shm", std::string{ path } });
+    }
+
+    template <typename Serializer, TransmissionFormat TransmissionFormat>
+    GenericShmChannel<Serializer, TransmissionFormat>::GenericShmChannel(key_t key, ShmStream&& stream_, payload_cache_t* payloadCache) :
+        base_t(key, std::move(stream_), payloadCache)
+    {
+        initEndpoints(Endpoint{ "shm", stream().socket().local_endpoint().path() }, Endpoint{ "shm", stream().socket().local_endpoint().path() });
+    }
+
+    template <typename Serializer, TransmissionFormat TransmissionFormat>
+    ShmStream GenericShmChannel<Serializer, TransmissionFormat>::Connect(asio::io_context& ioContext, std::string_view path)
+    {
+        try
+        {
+            asio::local::stream_protocol::socket socket{ ioContext };
+            socket.connect(asio::local::stream_protocol::endpoint{ std::string{ path } });
+
+            return ShmStream{ std::move(socket) };
+        }
+        catch (const std::exception& e)
+        {
+            throw std::runtime_error{ "could not open shared memory connection '" + std::string{ path } + "': " + e.what() };
+        }
+    }
+
+    template struct GenericShmChannel<serialization::CborSerializer, TransmissionFormat::v1>;
+    template struct GenericShmChannel<serialization::CborSerializer, TransmissionFormat::v2>;
+    template struct GenericShmChannel<serialization::CborSerializer, TransmissionFormat::v3>;
+}
+#endif
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <dots/io/channels/ShmListener.h>
+#include <dots/io/channels/WorkerChannel.h>
+#include <dots/tools/logging.h>
+
+namespace dots::io::posix::details
+{
+    template <typename TChannel>
+    GenericShmListener<TChannel>::GenericShmListener(asio::io_context& ioContext, const Endpoint& endpoint, std::optional<int> backlog/* = std::nullopt*/, size_t capacity/* = ShmStream::DefaultCapacity*/) :
+        GenericShmListener(ioContext, endpoint.path(), backlog, capacity)
+    {
+        /* do nothing */
+    }
+
+    template <typename TChannel>
+    GenericShmListener<TChannel>::GenericShmListener(asio::io_context& ioContext, std::string_view path, std::optional<int> backlog/* = std::nullopt*/, size_t capacity/* = ShmStream::DefaultCapacity*/) :
+        m_endpoint{ std::string{ path } },
+        m_acceptor{ ioContext },
+        m_ioContext{ std::ref(ioContext) },
+        m_socket{ ioContext },
+        m_capacity(capacity),
+        m_payloadCache{ 0, nullptr }
+    {
+        try
+        {
+            m_acceptor.open(m_endpoint.protocol());
+            m_acceptor.set_option(asio::local::stream_protocol::acceptor::reuse_address(true));
+            m_acceptor.bind(m_endpoint);
+
+            if (backlog == std::nullopt)
+            {
+                m_acceptor.listen();
+            }
+            else
+            {
+                m_acceptor.listen(*backlog);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            throw std::runtime_error{ "failed creating shared memory listener at path '" + m_endpoint.path() + "' -> " + e.what() };
+        }
+    }
+
+    template <typename TChannel>
+    GenericShmListener<TChannel>::~GenericShmListener()
+    {
+        ::unlink(m_endpoint.path().data());
+    }
+
+    template <typename TChannel>
+    void GenericShmListener<TChannel>::asyncAcceptImpl()
+    {
+        std::optional<size_t> worker;
+
+        if (WorkerPool* workerPool_ = workerPool(); workerPool_ != nullptr)
+        {
+            worker = workerPool_->next();
+            m_socket = asio::local::stream_protocol::socket{ workerPool_->ioContext(*worker) };
+            m_workerPayloadCaches.resize(workerPool_->size(), payload_cache_t{ 0, nullptr });
+        }
+
+        m_acceptor.async_accept(m_socket, [this, worker](const boost::system::error_code& error)
+        {
+            if (error == asio::error::operation_aborted || !m_acceptor.is_open())
+            {
+                return;
+            }
+
+            if (error)
+            {
+                processError(std::make_exception_ptr(std::runtime_error{ "failed listening on shared memory endpoint at path '" + m_endpoint.path() + "' -> " + error.message() }));
+                return;
+            }
+
+            std::optional<ShmStream> stream;
+
+            try
+            {
+                // note: the shared memory segment is created per connection
+                // and handed over to the guest via the accepted socket
+                stream.emplace(std::move(m_socket), m_capacity);
+            }
+            catch (const std::exception& e)
+            {
+                // note: a failed handshake only affects the connecting
+                // guest, so the listener continues to accept connections
+                LOG_WARN_S("failed to perform shared memory handshake at path '" << m_endpoint.path() << "' -> " << e.what());
+                boost::system::error_code closeError;
+                m_socket.close(closeError);
+                asyncAcceptImpl();
+                return;
+            }
+
+            try
+            {
+                if (worker == std::nullopt)
+                {
+                    processAccept(make_channel<TChannel>(std::move(*stream), &m_payloadCache));
+                }
+                else
+                {
+                    // note: the socket is associated with the IO context of the worker, so the channel is operated by the worker
+                    // and handed over to the IO context of the listener via a worker channel
+                    channel_ptr_t channel = make_channel<TChannel>(std::move(*stream), &m_workerPayloadCaches[*worker]);
+                    processAccept(make_channel<WorkerChannel>(m_ioContext.get(), workerPool()->ioContext(*worker), std::move(channel)));
+                }
+            }
+            catch (const std::exception& e)
+            {
+                processError(std::string{ "failed to create shared memory channel -> " } + e.what());
+            }
+        });
+    }
+
+    template struct GenericShmListener<v1::ShmChannel>;
+    template struct GenericShmListener<v2::ShmChannel>;
+    template struct GenericShmListener<v3::ShmChannel>;
+}
+#endif
@@ -0,0 +1,571 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <dots/io/channels/ShmStream.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dots::io::posix
+{
+    namespace
+    {
+        constexpr uint32_t HandshakeMagic = 0x444F5453; // "DOTS"
+        constexpr uint32_t HandshakeVersion = 1;
+        constexpr size_t CacheLineSize = 64;
+
+        struct handshake_t
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t capacity;
+        };
+
+        static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free, "shared memory streams require address-free atomics");
+
+        /*
+         * note: the positions are monotonically increasing byte counts, so
+         * the ring is empty if both are equal and full if they differ by the
+         * capacity. each member is placed on its own cache line to avoid
+         * false sharing between the producer and the consumer
+         */
+        struct ring_header_t
+        {
+            alignas(CacheLineSize) std::atomic<uint64_t> head;
+            alignas(CacheLineSize) std::atomic<uint64_t> tail;
+            alignas(CacheLineSize) std::atomic<uint32_t> consumerWaiting;
+            alignas(CacheLineSize) std::atomic<uint32_t> producerWaiting;
+        };
+
+        struct ring_t
+        {
+            ring_header_t* header;
+            std::byte* data;
+            uint64_t capacity;
+
+            // note: the positions are written by different processes, so
+            // the distance between them is clamped to the capacity to never
+            // access memory outside of the ring, even if the peer violates
+            // the invariants of the ring (see ring_t::consistent())
+            uint64_t available() const
+            {
+                return std::min(header->head.load(std::memory_order_acquire) - header->tail.load(std::memory_order_relaxed), capacity);
+            }
+
+            uint64_t space() const
+            {
+                return capacity - std::min(header->head.load(std::memory_order_relaxed) - header->tail.load(std::memory_order_acquire), capacity);
+            }
+
+            bool consistent() const
+            {
+                return header->head.load(std::memory_order_acquire) - header->tail.load(std::memory_order_acquire) <= capacity;
+            }
+
+            size_t read(const std::vector<asio::mutable_buffer>& buffers)
+            {
+                uint64_t tail = header->tail.load(std::memory_order_relaxed);
+                uint64_t available_ = available();
+                size_t numBytes = 0;
+
+                for (const asio::mutable_buffer& buffer : buffers)
+                {
+                    size_t size = static_cast<size_t>(std::min<uint64_t>(buffer.size(), available_ - numBytes));
+                    copy(static_cast<std::byte*>(buffer.data()), tail + numBytes, size);
+                    numBytes += size;
+
+                    if (numBytes == available_)
+                    {
+                        break;
+                    }
+                }
+
+                header->tail.store(tail + numBytes, std::memory_order_release);
+                return numBytes;
+            }
+
+            size_t write(const std::vector<asio::const_buffer>& buffers)
+            {
+                uint64_t head = header->head.load(std::memory_order_relaxed);
+                uint64_t space_ = space();
+                size_t numBytes = 0;
+
+                for (const asio::const_buffer& buffer : buffers)
+                {
+                    size_t size = static_cast<size_t>(std::min<uint64_t>(buffer.size(), space_ - numBytes));
+                    copy(head + numBytes, static_cast<const std::byte*>(buffer.data()), size);
+                    numBytes += size;
+
+                    if (numBytes == space_)
+                    {
+                        break;
+                    }
+                }
+
+                header->head.store(head + numBytes, std::memory_order_release);
+                return numBytes;
+            }
+
+        private:
+
+            void copy(std::byte* dst, uint64_t position, size_t size) const
+            {
+                size_t offset = static_cast<size_t>(position & (capacity - 1));
+                size_t first = std::min<size_t>(size, static_cast<size_t>(capacity) - offset);
+                std::memcpy(dst, data + offset, first);
+                std::memcpy(dst + first, data, size - first);
+            }
+
+            void copy(uint64_t position, const std::byte* src, size_t size)
+            {
+                size_t offset = static_cast<size_t>(position & (capacity - 1));
+                size_t first = std::min<size_t>(size, static_cast<size_t>(capacity) - offset);
+                std::memcpy(data + offset, src, first);
+                std::memcpy(data, src + first, size - first);
+            }
+        };
+
+        constexpr size_t RingSize(uint64_t capacity)
+        {
+            return sizeof(ring_header_t) + static_cast<size_t>(capacity);
+        }
+
+        [[noreturn]] void ThrowSystemError(const char* what)
+        {
+            throw std::system_error{ errno, std::system_category(), what };
+        }
+
+        struct fd_guard_t
+        {
+            fd_guard_t(int fd) : fd{ fd } {}
+            fd_guard_t(const fd_guard_t& other) = delete;
+            ~fd_guard_t() { if (fd != -1) ::close(fd); }
+            fd_guard_t& operator = (const fd_guard_t& rhs) = delete;
+            int release() { return std::exchange(fd, -1); }
+            int fd;
+        };
+    }
+
+    struct ShmStream::state : std::enable_shared_from_this<state>
+    {
+        struct read_op_t
+        {
+            std::vector<asio::mutable_buffer> buffers;
+            handler_t handler;
+        };
+
+        struct write_op_t
+        {
+            std::vector<asio::const_buffer> buffers;
+            handler_t handler;
+        };
+
+        state(asio::local::stream_protocol::socket&& socket_, int memoryFd, uint64_t capacity, int eventFd, int peerEventFd, bool accepting) :
+            socket{ std::move(socket_) },
+            event{ this->socket.get_executor(), eventFd },
+            peerEventFd{ peerEventFd },
+            memory{ nullptr },
+            memorySize{ 2 * RingSize(capacity) },
+            eventWaiting{ false },
+            peerClosed{ false },
+            inconsistent{ false }
+        {
+            memory = ::mmap(nullptr, memorySize, PROT_READ | PROT_WRITE, MAP_SHARED, memoryFd, 0);
+
+            if (memory == MAP_FAILED)
+            {
+                std::system_error error{ errno, std::system_category(), "could not map shared memory" };
+                ::close(peerEventFd);
+                throw error;
+            }
+
+            auto* base = static_cast<std::byte*>(memory);
+            ring_t rings[2] = {
+                ring_t{ reinterpret_cast<ring_header_t*>(base), base + sizeof(ring_header_t), capacity },
+                ring_t{ reinterpret_cast<ring_header_t*>(base + RingSize(capacity)), base + RingSize(capacity) + sizeof(ring_header_t), capacity }
+            };
+
+            // note: the first ring is written by the accepting side and the
+            // second ring by the connecting side
+            if (accepting)
+            {
+                new (rings[0].header) ring_header_t{};
+                new (rings[1].header) ring_header_t{};
+                writeRing = rings[0];
+                readRing = rings[1];
+            }
+            else
+            {
+                readRing = rings[0];
+                writeRing = rings[1];
+            }
+        }
+
+        state(const state& other) = delete;
+        state(state&& other) = delete;
+
+        ~state()
+        {
+            ::munmap(memory, memorySize);
+            ::close(peerEventFd);
+        }
+
+        state& operator = (const state& rhs) = delete;
+        state& operator = (state&& rhs) = delete;
+
+        void init()
+        {
+            // note: the handshake socket is not used after the handshake, so
+            // it only becomes readable when the peer closes it
+            socket.async_wait(asio::local::stream_protocol::socket::wait_read, [this_{ weak_from_this() }](boost::system::error_code error)
+            {
+                if (auto state = this_.lock(); state != nullptr && error != asio::error::operation_aborted)
+                {
+                    state->peerClosed = true;
+                    state->process();
+                }
+            });
+        }
+
+        void asyncRead(std::vector<asio::mutable_buffer> buffers, handler_t handler)
+        {
+            readOp.emplace(read_op_t{ std::move(buffers), std::move(handler) });
+            tryRead();
+        }
+
+        void asyncWrite(std::vector<asio::const_buffer> buffers, handler_t handler)
+        {
+            writeOp.emplace(write_op_t{ std::move(buffers), std::move(handler) });
+            tryWrite();
+        }
+
+        void process()
+        {
+            if (readOp != std::nullopt)
+            {
+                tryRead();
+            }
+
+            if (writeOp != std::nullopt)
+            {
+                tryWrite();
+            }
+        }
+
+        void tryRead()
+        {
+            if (!checkConsistency())
+            {
+                complete(std::move(readOp->handler), boost::system::errc::make_error_code(boost::system::errc::protocol_error), 0);
+                readOp.reset();
+                return;
+            }
+
+            if (asio::buffer_size(readOp->buffers) == 0)
+            {
+                complete(std::move(readOp->handler), {}, 0);
+                readOp.reset();
+                return;
+            }
+
+            if (readRing.available() == 0)
+            {
+                if (!peerClosed)
+                {
+                    // note: the flag has to be visible to the peer before
+                    // the ring is checked again to avoid missing a wakeup
+                    readRing.header->consumerWaiting.store(1, std::memory_order_seq_cst);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                    if (readRing.available() == 0)
+                    {
+                        waitEvent();
+                        return;
+                    }
+
+                    readRing.header->consumerWaiting.store(0, std::memory_order_relaxed);
+                }
+                else
+                {
+                    complete(std::move(readOp->handler), asio::error::eof, 0);
+                    readOp.reset();
+                    return;
+                }
+            }
+
+            size_t numBytes = readRing.read(readOp->buffers);
+            complete(std::move(readOp->handler), {}, numBytes);
+            readOp.reset();
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (readRing.header->producerWaiting.load(std::memory_order_relaxed) != 0 && readRing.header->producerWaiting.exchange(0) != 0)
+            {
+                signalPeer();
+            }
+        }
+
+        void tryWrite()
+        {
+            if (!checkConsistency())
+            {
+                complete(std::move(writeOp->handler), boost::system::errc::make_error_code(boost::system::errc::protocol_error), 0);
+                writeOp.reset();
+                return;
+            }
+
+            if (peerClosed)
+            {
+                complete(std::move(writeOp->handler), asio::error::broken_pipe, 0);
+                writeOp.reset();
+                return;
+            }
+
+            if (asio::buffer_size(writeOp->buffers) == 0)
+            {
+                complete(std::move(writeOp->handler), {}, 0);
+                writeOp.reset();
+                return;
+            }
+
+            if (writeRing.space() == 0)
+            {
+                writeRing.header->producerWaiting.store(1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if (writeRing.space() == 0)
+                {
+                    waitEvent();
+                    return;
+                }
+
+                writeRing.header->producerWaiting.store(0, std::memory_order_relaxed);
+            }
+
+            size_t numBytes = writeRing.write(writeOp->buffers);
+            complete(std::move(writeOp->handler), {}, numBytes);
+            writeOp.reset();
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (writeRing.header->consumerWaiting.load(std::memory_order_relaxed) != 0 && writeRing.header->consumerWaiting.exchange(0) != 0)
+            {
+                signalPeer();
+            }
+        }
+
+        bool checkConsistency()
+        {
+            // note: the stream is closed permanently if the peer corrupted the
+            // positions of either ring, because the data in the rings can no
+            // longer be trusted
+            if (!inconsistent && (!readRing.consistent() || !writeRing.consistent()))
+            {
+                inconsistent = true;
+                boost::system::error_code closeError;
+                socket.close(closeError);
+            }
+
+            return !inconsistent;
+        }
+
+        void waitEvent()
+        {
+            if (eventWaiting)
+            {
+                return;
+            }
+
+            eventWaiting = true;
+            event.async_wait(asio::posix::stream_descriptor::wait_read, [this_{ weak_from_this() }](boost::system::error_code error)
+            {
+                if (auto state = this_.lock(); state != nullptr && error != asio::error::operation_aborted)
+                {
+                    uint64_t value;
+                    (void)::read(state->event.native_handle(), &value, sizeof(value));
+                    state->eventWaiting = false;
+                    state->process();
+                }
+            });
+        }
+
+        void signalPeer()
+        {
+            uint64_t value = 1;
+            (void)::write(peerEventFd, &value, sizeof(value));
+        }
+
+        void complete(handler_t handler, boost::system::error_code error, size_t numBytes)
+        {
+            asio::post(event.get_executor(), [handler{ std::move(handler) }, error, numBytes]
+            {
+                (*handler)(error, numBytes);
+            });
+        }
+
+        asio::local::stream_protocol::socket socket;
+        asio::posix::stream_descriptor event;
+        int peerEventFd;
+        void* memory;
+        size_t memorySize;
+        ring_t readRing;
+        ring_t writeRing;
+        std::optional<read_op_t> readOp;
+        std::optional<write_op_t> writeOp;
+        bool eventWaiting;
+        bool peerClosed;
+        bool inconsistent;
+    };
+
+    ShmStream::ShmStream(asio::local::stream_protocol::socket&& socket, size_t capacity)
+    {
+        uint64_t ringCapacity = 1;
+
+        while (ringCapacity < capacity)
+        {
+            ringCapacity <<= 1;
+        }
+
+        fd_guard_t memoryFd = ::memfd_create("dots-shm", MFD_CLOEXEC);
+
+        if (memoryFd.fd == -1)
+        {
+            ThrowSystemError("could not create shared memory");
+        }
+
+        if (::ftruncate(memoryFd.fd, static_cast<off_t>(2 * RingSize(ringCapacity))) == -1)
+        {
+            ThrowSystemError("could not resize shared memory");
+        }
+
+        fd_guard_t eventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        fd_guard_t peerEventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        if (eventFd.fd == -1 || peerEventFd.fd == -1)
+        {
+            ThrowSystemError("could not create eventfd");
+        }
+
+        handshake_t handshake{ .magic = HandshakeMagic, .version = HandshakeVersion, .capacity = ringCapacity };
+        int fds[] = { memoryFd.fd, peerEventFd.fd, eventFd.fd };
+
+        iovec iov{ .iov_base = &handshake, .iov_len = sizeof(handshake) };
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+        msghdr message{};
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        cmsghdr* controlMessage = CMSG_FIRSTHDR(&message);
+        controlMessage->cmsg_level = SOL_SOCKET;
+        controlMessage->cmsg_type = SCM_RIGHTS;
+        controlMessage->cmsg_len = CMSG_LEN(sizeof(fds));
+        std::memcpy(CMSG_DATA(controlMessage), fds, sizeof(fds));
+
+        if (::sendmsg(socket.native_handle(), &message, MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(handshake)))
+        {
+            ThrowSystemError("could not transmit shared memory");
+        }
+
+        // note: the eventfds are owned by the state once it has been
+        // constructed
+        m_state = std::make_shared<state>(std::move(socket), memoryFd.fd, ringCapacity, eventFd.release(), peerEventFd.release(), true);
+
+        m_state->init();
+    }
+
+    ShmStream::ShmStream(asio::local::stream_protocol::socket&& socket)
+    {
+        handshake_t handshake{};
+        int fds[3] = { -1, -1, -1 };
+
+        iovec iov{ .iov_base = &handshake, .iov_len = sizeof(handshake) };
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+        msghdr message{};
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        ssize_t received;
+
+        do
+        {
+            received = ::recvmsg(socket.native_handle(), &message, MSG_CMSG_CLOEXEC | MSG_WAITALL);
+        }
+        while (received == -1 && errno == EINTR);
+
+        if (received == -1)
+        {
+            ThrowSystemError("could not receive shared memory");
+        }
+
+        if (cmsghdr* controlMessage = CMSG_FIRSTHDR(&message); controlMessage != nullptr && controlMessage->cmsg_level == SOL_SOCKET && controlMessage->cmsg_type == SCM_RIGHTS)
+        {
+            std::memcpy(fds, CMSG_DATA(controlMessage), std::min(sizeof(fds), static_cast<size_t>(controlMessage->cmsg_len - CMSG_LEN(0))));
+        }
+
+        fd_guard_t memoryFd = fds[0];
+        fd_guard_t eventFd = fds[1];
+        fd_guard_t peerEventFd = fds[2];
+
+        if (received != static_cast<ssize_t>(sizeof(handshake)) || handshake.magic != HandshakeMagic || handshake.version != HandshakeVersion || memoryFd.fd == -1 || eventFd.fd == -1 || peerEventFd.fd == -1)
+        {
+            throw std::runtime_error{ "received invalid shared memory handshake" };
+        }
+
+        uint64_t capacity = handshake.capacity;
+        struct stat memoryStat{};
+
+        if (::fstat(memoryFd.fd, &memoryStat) == -1)
+        {
+            ThrowSystemError("could not determine size of shared memory");
+        }
+
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0 || static_cast<uint64_t>(memoryStat.st_size) < 2 * RingSize(capacity))
+        {
+            throw std::runtime_error{ "received shared memory with invalid capacity: " + std::to_string(capacity) };
+        }
+
+        m_state = std::make_shared<state>(std::move(socket), memoryFd.fd, capacity, eventFd.release(), peerEventFd.release(), false);
+
+        m_state->init();
+    }
+
+    auto ShmStream::get_executor() -> executor_type
+    {
+        return m_state->event.get_executor();
+    }
+
+    const asio::local::stream_protocol::socket& ShmStream::socket() const
+    {
+        return m_state->socket;
+    }
+
+    size_t ShmStream::capacity() const
+    {
+        return static_cast<size_t>(m_state->readRing.capacity);
+    }
+
+    void ShmStream::asyncReadSome(std::vector<asio::mutable_buffer> buffers, handler_t handler)
+    {
+        m_state->asyncRead(std::move(buffers), std::move(handler));
+    }
+
+    void ShmStream::asyncWriteSome(std::vector<asio::const_buffer> buffers, handler_t handler)
+    {
+        m_state->asyncWrite(std::move(buffers), std::move(handler));
+    }
+}
+#endif
@@ -44,6 +44,7 @@ namespace dots::io::details
             if (error)
             {
                 onConnect(error);
+                return;
             }
 
             stream().async_connect(*endpoint, [this, endpoint, onConnect{ std::move(onConnect) }](const boost::system::error_code& error) {
@@ -123,4 +124,5 @@ namespace dots::io::details
 
     template struct GenericTcpChannel<serialization::CborSerializer, TransmissionFormat::v1>;
     template struct GenericTcpChannel<serialization::CborSerializer, TransmissionFormat::v2>;
+    template struct GenericTcpChannel<serialization::CborSerializer, TransmissionFormat::v3>;
 }
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #include <dots/io/channels/TcpListener.h>
+#include <dots/io/channels/WorkerChannel.h>
 
 namespace dots::io::details
 {
@@ -16,8 +17,9 @@ namespace dots::io::details
         m_address{ std::move(address) },
         m_port{ std::move(port) },
         m_acceptor{ ioContext },
+        m_ioContext{ std::ref(ioContext) },
         m_socket{ ioContext },
-        m_payloadCache{ 0, buffer_t{} }
+        m_payloadCache{ 0, nullptr }
     {
         try
         {
@@ -46,7 +48,16 @@ namespace dots::io::details
     template <typename TChannel>
     void GenericTcpListener<TChannel>::asyncAcceptImpl()
     {
-        m_acceptor.async_accept(m_socket, [this](const boost::system::error_code& error)
+        std::optional<size_t> worker;
+
+        if (WorkerPool* workerPool_ = workerPool(); workerPool_ != nullptr)
+        {
+            worker = workerPool_->next();
+            m_socket = asio::ip::tcp::socket{ workerPool_->ioContext(*worker) };
+            m_workerPayloadCaches.resize(workerPool_->size(), payload_cache_t{ 0, nullptr });
+        }
+
+        m_acceptor.async_accept(m_socket, [this, worker](const boost::system::error_code& error)
         {
             if (error == asio::error::operation_aborted || !m_acceptor.is_open())
             {
@@ -75,7 +86,17 @@ namespace dots::io::details
                 }
 
                 // note: this move is explicitly allowed according to the Boost ASIO v1.72 documentation of the socket
-                processAccept(make_channel<TChannel>(std::move(m_socket), &m_payloadCache));
+                if (worker == std::nullopt)
+                {
+                    processAccept(make_channel<TChannel>(std::move(m_socket), &m_payloadCache));
+                }
+                else
+                {
+                    // note: the socket is associated with the IO context of the worker, so the channel is operated by the worker
+                    // and handed over to the IO context of the listener via a worker channel
+                    channel_ptr_t channel = make_channel<TChannel>(std::move(m_socket), &m_workerPayloadCaches[*worker]);
+                    processAccept(make_channel<WorkerChannel>(m_ioContext.get(), workerPool()->ioContext(*worker), std::move(channel)));
+                }
             }
             catch (const std::exception& e)
             {
@@ -96,4 +117,5 @@ namespace dots::io::details
 
     template struct GenericTcpListener<v1::TcpChannel>;
     template struct GenericTcpListener<v2::TcpChannel>;
+    template struct GenericTcpListener<v3::TcpChannel>;
 }
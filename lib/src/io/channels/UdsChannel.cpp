@@ -53,5 +53,6 @@ namespace dots::io::posix::details
 
     template struct GenericUdsChannel<serialization::CborSerializer, TransmissionFormat::v1>;
     template struct GenericUdsChannel<serialization::CborSerializer, TransmissionFormat::v2>;
+    template struct GenericUdsChannel<serialization::CborSerializer, TransmissionFormat::v3>;
 }
 #endif
@@ -3,6 +3,7 @@
 #include <dots/asio.h>
 #if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
 #include <dots/io/channels/UdsListener.h>
+#include <dots/io/channels/WorkerChannel.h>
 
 namespace dots::io::posix::details
 {
@@ -17,8 +18,9 @@ namespace dots::io::posix::details
     GenericUdsListener<TChannel>::GenericUdsListener(asio::io_context& ioContext, std::string_view path, std::optional<int> backlog/* = std::nullopt*/) :
         m_endpoint{ path.data() },
         m_acceptor{ ioContext },
+        m_ioContext{ std::ref(ioContext) },
         m_socket{ ioContext },
-        m_payloadCache{ 0, UdsChannel::buffer_t{} }
+        m_payloadCache{ 0, nullptr }
     {
         try
         {
@@ -50,7 +52,16 @@ namespace dots::io::posix::details
     template <typename TChannel>
     void GenericUdsListener<TChannel>::asyncAcceptImpl()
     {
-        m_acceptor.async_accept(m_socket, [this](const boost::system::error_code& error)
+        std::optional<size_t> worker;
+
+        if (WorkerPool* workerPool_ = workerPool(); workerPool_ != nullptr)
+        {
+            worker = workerPool_->next();
+            m_socket = asio::local::stream_protocol::socket{ workerPool_->ioContext(*worker) };
+            m_workerPayloadCaches.resize(workerPool_->size(), payload_cache_t{ 0, nullptr });
+        }
+
+        m_acceptor.async_accept(m_socket, [this, worker](const boost::system::error_code& error)
         {
             if (error == asio::error::operation_aborted || !m_acceptor.is_open())
             {
@@ -77,7 +88,17 @@ namespace dots::io::posix::details
                 }
 
                 // note: this move is explicitly allowed according to the ASIO v1.72 documentation of the socket
-                processAccept(make_channel<TChannel>(std::move(m_socket), &m_payloadCache));
+                if (worker == std::nullopt)
+                {
+                    processAccept(make_channel<TChannel>(std::move(m_socket), &m_payloadCache));
+                }
+                else
+                {
+                    // note: the socket is associated with the IO context of the worker, so the channel is operated by the worker
+                    // and handed over to the IO context of the listener via a worker channel
+                    channel_ptr_t channel = make_channel<TChannel>(std::move(m_socket), &m_workerPayloadCaches[*worker]);
+                    processAccept(make_channel<WorkerChannel>(m_ioContext.get(), workerPool()->ioContext(*worker), std::move(channel)));
+                }
             }
             catch (const std::exception& e)
             {
@@ -98,5 +119,6 @@ namespace dots::io::posix::details
 
     template struct GenericUdsListener<v1::UdsChannel>;
     template struct GenericUdsListener<v2::UdsChannel>;
+    template struct GenericUdsListener<v3::UdsChannel>;
 }
 #endif
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <dots/io/channels/UringChannel.h>
+#include <type_traits>
+
+namespace dots::io::posix::details
+{
+    template <typename Protocol, typename Serializer, TransmissionFormat TransmissionFormat>
+    GenericUringChannel<Protocol, Serializer, TransmissionFormat>::GenericUringChannel(key_t key, asio::io_context& ioContext, const Endpoint& endpoint) :
+        GenericUringChannel(key, Connect(ioContext, endpoint), nullptr)
+    {
+        /* do nothing */
+    }
+
+    template <typename Protocol, typename Serializer, TransmissionFormat TransmissionFormat>
+    GenericUringChannel<Protocol, Serializer, TransmissionFormat>::GenericUringChannel(key_t key, socket_t&& socket_, payload_cache_t* payloadCache) :
+        // note: the endpoints have to be determined before the native handle is released from the socket
+        GenericUringChannel(key, LocalEndpoint(socket_), RemoteEndpoint(socket_), std::move(socket_), payloadCache)
+    {
+        /* do nothing */
+    }
+
+    template <typename Protocol, typename Serializer, TransmissionFormat TransmissionFormat>
+    GenericUringChannel<Protocol, Serializer, TransmissionFormat>::GenericUringChannel(key_t key, Endpoint localEndpoint, Endpoint remoteEndpoint, socket_t&& socket_, payload_cache_t* payloadCache) :
+        base_t(key, UringStream{ std::move(socket_) }, payloadCache)
+    {
+        initEndpoints(std::move(localEndpoint), std::move(remoteEndpoint));
+    }
+
+    template <typename Protocol, typename Serializer, TransmissionFormat TransmissionFormat>
+    auto GenericUringChannel<Protocol, Serializer, TransmissionFormat>::Connect(asio::io_context& ioContext, const Endpoint& endpoint) -> socket_t
+    {
+        socket_t socket{ ioContext };
+
+        if constexpr (std::is_same_v<Protocol, asio::ip::tcp>)
+        {
+            std::string host{ endpoint.host() };
+            std::string port{ endpoint.port().empty() ? DefaultPort : endpoint.port() };
+
+            asio::ip::tcp::resolver resolver{ ioContext };
+            auto endpoints = resolver.resolve(asio::ip::tcp::socket::protocol_type::v4(), host, port, asio::ip::resolver_query_base::numeric_service);
+
+            for (const auto& endpoint_ : endpoints)
+            {
+                try
+                {
+                    socket.connect(endpoint_);
+                    socket.set_option(asio::ip::tcp::no_delay(true));
+                    socket.set_option(asio::ip::tcp::socket::keep_alive(true));
+                    socket.set_option(asio::socket_base::linger(true, 10));
+
+                    return socket;
+                }
+                catch (const std::exception&/* e*/)
+                {
+                    socket = socket_t{ ioContext };
+                }
+            }
+
+            throw std::runtime_error{ "could not open TCP connection: " + host + ":" + port };
+        }
+        else
+        {
+            try
+            {
+                socket.connect(typename Protocol::endpoint{ std::string{ endpoint.path() } });
+
+                return socket;
+            }
+            catch (const std::exception& e)
+            {
+                throw std::runtime_error{ "could not open UDS connection '" + std::string{ endpoint.path() } + "': " + e.what() };
+            }
+        }
+    }
+
+    template <typename Protocol, typename Serializer, TransmissionFormat TransmissionFormat>
+    Endpoint GenericUringChannel<Protocol, Serializer, TransmissionFormat>::LocalEndpoint(const socket_t& socket)
+    {
+        if constexpr (std::is_same_v<Protocol, asio::ip::tcp>)
+        {
+            return Endpoint{ socket.local_endpoint() };
+        }
+        else
+        {
+            return Endpoint{ "uds", socket.local_endpoint().path() };
+        }
+    }
+
+    template <typename Protocol, typename Serializer, TransmissionFormat TransmissionFormat>
+    Endpoint GenericUringChannel<Protocol, Serializer, TransmissionFormat>::RemoteEndpoint(const socket_t& socket)
+    {
+        if constexpr (std::is_same_v<Protocol, asio::ip::tcp>)
+        {
+            return Endpoint{ socket.remote_endpoint() };
+        }
+        else
+        {
+            // note: the peer of a UNIX domain socket is usually unnamed, so the local path is used for both endpoints
+            return Endpoint{ "uds", socket.local_endpoint().path() };
+        }
+    }
+
+    template struct GenericUringChannel<asio::ip::tcp, serialization::CborSerializer, TransmissionFormat::v1>;
+    template struct GenericUringChannel<asio::ip::tcp, serialization::CborSerializer, TransmissionFormat::v2>;
+    template struct GenericUringChannel<asio::ip::tcp, serialization::CborSerializer, TransmissionFormat::v3>;
+    template struct GenericUringChannel<asio::local::stream_protocol, serialization::CborSerializer, TransmissionFormat::v1>;
+    template struct GenericUringChannel<asio::local::stream_protocol, serialization::CborSerializer, TransmissionFormat::v2>;
+    template struct GenericUringChannel<asio::local::stream_protocol, serialization::CborSerializer, TransmissionFormat::v3>;
+}
+#endif
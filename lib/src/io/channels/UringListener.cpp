@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <dots/io/channels/UringListener.h>
+#include <dots/io/channels/WorkerChannel.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace dots::io::posix::details
+{
+    template <typename TChannel>
+    GenericUringListener<TChannel>::GenericUringListener(asio::io_context& ioContext, const Endpoint& endpoint, std::optional<int> backlog/* = std::nullopt*/) :
+        m_endpoint{ ResolveEndpoint(ioContext, endpoint) },
+        m_acceptor{ Listen(ioContext, m_endpoint, backlog) },
+        m_ioContext{ std::ref(ioContext) },
+        m_payloadCache{ 0, nullptr }
+    {
+        /* do nothing */
+    }
+
+    template <typename TChannel>
+    GenericUringListener<TChannel>::~GenericUringListener()
+    {
+        if constexpr (std::is_same_v<protocol_t, asio::local::stream_protocol>)
+        {
+            ::unlink(m_endpoint.path().data());
+        }
+    }
+
+    template <typename TChannel>
+    void GenericUringListener<TChannel>::asyncAcceptImpl()
+    {
+        std::optional<size_t> worker;
+
+        if (WorkerPool* workerPool_ = workerPool(); workerPool_ != nullptr)
+        {
+            worker = workerPool_->next();
+            m_workerPayloadCaches.resize(workerPool_->size(), payload_cache_t{ 0, nullptr });
+        }
+
+        m_acceptor.async_accept([this, worker](const boost::system::error_code& error, int nativeSocket)
+        {
+            if (error == asio::error::operation_aborted)
+            {
+                return;
+            }
+
+            if (error)
+            {
+                processError(std::make_exception_ptr(std::runtime_error{ "failed listening on io_uring endpoint at " + Description(m_endpoint) + " -> " + error.message() }));
+                return;
+            }
+
+            try
+            {
+                // note: the socket is associated with the IO context of the worker (if any), so the io_uring instance of
+                // the worker is used to operate the channel
+                asio::io_context& ioContext = worker == std::nullopt ? m_ioContext.get() : workerPool()->ioContext(*worker);
+                socket_t socket{ ioContext };
+
+                try
+                {
+                    socket.assign(m_endpoint.protocol(), nativeSocket);
+                }
+                catch (...)
+                {
+                    ::close(nativeSocket);
+                    throw;
+                }
+
+                if constexpr (std::is_same_v<protocol_t, asio::ip::tcp>)
+                {
+                    socket.set_option(asio::ip::tcp::no_delay(true));
+                    socket.set_option(asio::ip::tcp::socket::keep_alive(true));
+
+                    constexpr int MinimumSendBufferSize = 1024 * 1024;
+                    asio::socket_base::send_buffer_size sendBufferSize;
+                    socket.get_option(sendBufferSize);
+
+                    if (sendBufferSize.value() < MinimumSendBufferSize)
+                    {
+                        socket.set_option(asio::socket_base::send_buffer_size(MinimumSendBufferSize));
+                    }
+                }
+
+                if (worker == std::nullopt)
+                {
+                    processAccept(make_channel<TChannel>(std::move(socket), &m_payloadCache));
+                }
+                else
+                {
+                    channel_ptr_t channel = make_channel<TChannel>(std::move(socket), &m_workerPayloadCaches[*worker]);
+                    processAccept(make_channel<WorkerChannel>(m_ioContext.get(), workerPool()->ioContext(*worker), std::move(channel)));
+                }
+            }
+            catch (const std::exception& e)
+            {
+                processError(std::string{ "failed to configure io_uring socket -> " } + e.what());
+            }
+        });
+    }
+
+    template <typename TChannel>
+    auto GenericUringListener<TChannel>::ResolveEndpoint(asio::io_context& ioContext, const Endpoint& endpoint) -> endpoint_t
+    {
+        if constexpr (std::is_same_v<protocol_t, asio::ip::tcp>)
+        {
+            std::string address{ endpoint.host() };
+            std::string port{ endpoint.port().empty() ? DefaultPort : endpoint.port() };
+
+            try
+            {
+                asio::ip::tcp::resolver resolver{ ioContext };
+                return *resolver.resolve({ address, port });
+            }
+            catch (const std::exception& e)
+            {
+                throw std::runtime_error{ "failed creating io_uring TCP listener at address '" + address + ":" + port + "' -> " + e.what() };
+            }
+        }
+        else
+        {
+            (void)ioContext;
+            return endpoint_t{ std::string{ endpoint.path() } };
+        }
+    }
+
+    template <typename TChannel>
+    auto GenericUringListener<TChannel>::Listen(asio::io_context& ioContext, const endpoint_t& endpoint, std::optional<int> backlog) -> acceptor_t
+    {
+        try
+        {
+            acceptor_t acceptor{ ioContext };
+            acceptor.open(endpoint.protocol());
+            acceptor.set_option(typename acceptor_t::reuse_address(true));
+            acceptor.bind(endpoint);
+
+            if (backlog == std::nullopt)
+            {
+                acceptor.listen();
+            }
+            else
+            {
+                acceptor.listen(*backlog);
+            }
+
+            return acceptor;
+        }
+        catch (const std::exception& e)
+        {
+            throw std::runtime_error{ "failed creating io_uring listener at " + Description(endpoint) + " -> " + e.what() };
+        }
+    }
+
+    template <typename TChannel>
+    std::string GenericUringListener<TChannel>::Description(const endpoint_t& endpoint)
+    {
+        if constexpr (std::is_same_v<protocol_t, asio::ip::tcp>)
+        {
+            return "address '" + endpoint.address().to_string() + ":" + std::to_string(endpoint.port()) + "'";
+        }
+        else
+        {
+            return "path '" + endpoint.path() + "'";
+        }
+    }
+
+    template struct GenericUringListener<v1::UringTcpChannel>;
+    template struct GenericUringListener<v2::UringTcpChannel>;
+    template struct GenericUringListener<v3::UringTcpChannel>;
+    template struct GenericUringListener<v1::UringUdsChannel>;
+    template struct GenericUringListener<v2::UringUdsChannel>;
+    template struct GenericUringListener<v3::UringUdsChannel>;
+}
+#endif
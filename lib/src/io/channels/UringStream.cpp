@@ -0,0 +1,1145 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <dots/io/channels/UringStream.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <system_error>
+#include <utility>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace dots::io::posix
+{
+    namespace
+    {
+        constexpr unsigned SubmissionQueueEntries = 256;
+        constexpr unsigned CompletionQueueEntries = 4096;
+        constexpr uint16_t BufferGroup = 0;
+        constexpr uint16_t BufferCount = 256;
+        constexpr uint32_t BufferSize = 16 * 1024;
+        constexpr size_t MaxRetainedBuffers = 8;
+        constexpr size_t MaxRetainedSockets = 64;
+
+        [[noreturn]] void ThrowSystemError(const char* what)
+        {
+            throw std::system_error{ errno, std::system_category(), what };
+        }
+
+        boost::system::error_code MakeErrorCode(int result)
+        {
+            return boost::system::error_code{ -result, asio::error::get_system_category() };
+        }
+
+        template <typename T>
+        T LoadAcquire(T& value)
+        {
+            return std::atomic_ref<T>{ value }.load(std::memory_order_acquire);
+        }
+
+        template <typename T>
+        void StoreRelease(T& value, T desired)
+        {
+            std::atomic_ref<T>{ value }.store(desired, std::memory_order_release);
+        }
+
+        /*
+         * note: operations are owned by the service while they are in
+         * flight and are identified by their address in the user data of
+         * the submission and completion queue entries. multishot operations
+         * remain in flight until a completion without the 'more' flag is
+         * received
+         */
+        struct operation
+        {
+            operation() = default;
+            operation(const operation& other) = delete;
+            operation(operation&& other) = delete;
+            virtual ~operation() = default;
+
+            operation& operator = (const operation& rhs) = delete;
+            operation& operator = (operation&& rhs) = delete;
+
+            virtual void complete(int result, uint32_t flags) = 0;
+
+            operation* prev = nullptr;
+            operation* next = nullptr;
+        };
+
+        struct uring_service_t : asio::execution_context::service
+        {
+            static asio::execution_context::id id;
+
+            explicit uring_service_t(asio::io_context& ioContext) :
+                asio::execution_context::service(ioContext),
+                m_ioContext{ std::ref(ioContext) },
+                m_fd(-1),
+                m_sqRing(MAP_FAILED),
+                m_sqRingSize(0),
+                m_cqRing(MAP_FAILED),
+                m_cqRingSize(0),
+                m_sqes(static_cast<io_uring_sqe*>(MAP_FAILED)),
+                m_sqesSize(0),
+                m_sqTail(0),
+                m_bufferRing(static_cast<io_uring_buf*>(MAP_FAILED)),
+                m_buffers(MAP_FAILED),
+                m_bufferTail(0),
+                m_buffersAvailable(0),
+                m_event{ ioContext },
+                m_operations(nullptr),
+                m_flushing(false),
+                m_awaiting(false),
+                m_notifying(false),
+                m_shutdown(false)
+            {
+                try
+                {
+                    init();
+                }
+                catch (...)
+                {
+                    release();
+                    throw;
+                }
+            }
+
+            uring_service_t(const uring_service_t& other) = delete;
+            uring_service_t(uring_service_t&& other) = delete;
+
+            ~uring_service_t() override
+            {
+                release();
+            }
+
+            uring_service_t& operator = (const uring_service_t& rhs) = delete;
+            uring_service_t& operator = (uring_service_t&& rhs) = delete;
+
+            asio::io_context& context()
+            {
+                return m_ioContext;
+            }
+
+            template <typename Prepare>
+            operation* submit(std::unique_ptr<operation> op, Prepare&& prepare)
+            {
+                io_uring_sqe& sqe = nextEntry();
+                prepare(sqe);
+                sqe.user_data = reinterpret_cast<uint64_t>(op.get());
+
+                operation* op_ = op.release();
+                op_->next = m_operations;
+
+                if (m_operations != nullptr)
+                {
+                    m_operations->prev = op_;
+                }
+
+                m_operations = op_;
+                awaitCompletions();
+
+                return op_;
+            }
+
+            void cancel(operation* op)
+            {
+                io_uring_sqe& sqe = nextEntry();
+                sqe.opcode = IORING_OP_ASYNC_CANCEL;
+                sqe.fd = -1;
+                sqe.addr = reinterpret_cast<uint64_t>(op);
+            }
+
+            void cancel(int fd)
+            {
+                io_uring_sqe& sqe = nextEntry();
+                sqe.opcode = IORING_OP_ASYNC_CANCEL;
+                sqe.fd = fd;
+                sqe.cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+            }
+
+            const std::byte* buffer(uint16_t bid) const
+            {
+                return static_cast<const std::byte*>(m_buffers) + static_cast<size_t>(bid) * BufferSize;
+            }
+
+            uint16_t acquireBuffer(uint32_t flags)
+            {
+                --m_buffersAvailable;
+                return static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+            }
+
+            void releaseBuffer(uint16_t bid)
+            {
+                io_uring_buf& entry = m_bufferRing[m_bufferTail & (BufferCount - 1)];
+                entry.addr = reinterpret_cast<uint64_t>(buffer(bid));
+                entry.len = BufferSize;
+                entry.bid = bid;
+
+                // note: the tail of the buffer ring overlays the reserved
+                // field of the first entry
+                StoreRelease(m_bufferRing[0].resv, ++m_bufferTail);
+                ++m_buffersAvailable;
+
+                if (!m_bufferWaiters.empty())
+                {
+                    notifyBufferWaiters();
+                }
+            }
+
+            void awaitBuffers(std::function<void()> handler)
+            {
+                m_bufferWaiters.emplace_back(std::move(handler));
+
+                if (m_buffersAvailable > 0)
+                {
+                    notifyBufferWaiters();
+                }
+            }
+
+        private:
+
+            static int Setup(unsigned entries, io_uring_params& params)
+            {
+                return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+            }
+
+            static int Enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+            {
+                return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+            }
+
+            static int Register(int fd, unsigned opcode, const void* arg, unsigned numArgs)
+            {
+                return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, numArgs));
+            }
+
+            void init()
+            {
+                io_uring_params params{};
+                params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL;
+                params.cq_entries = CompletionQueueEntries;
+
+                if (m_fd = Setup(SubmissionQueueEntries, params); m_fd == -1)
+                {
+                    ThrowSystemError("could not create io_uring instance");
+                }
+
+                m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+                if (params.features & IORING_FEAT_SINGLE_MMAP)
+                {
+                    m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+                }
+
+                if (m_sqRing = ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING); m_sqRing == MAP_FAILED)
+                {
+                    ThrowSystemError("could not map io_uring submission queue");
+                }
+
+                if (params.features & IORING_FEAT_SINGLE_MMAP)
+                {
+                    m_cqRing = m_sqRing;
+                }
+                else if (m_cqRing = ::mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING); m_cqRing == MAP_FAILED)
+                {
+                    ThrowSystemError("could not map io_uring completion queue");
+                }
+
+                m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+                if (m_sqes = static_cast<io_uring_sqe*>(::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES)); m_sqes == MAP_FAILED)
+                {
+                    ThrowSystemError("could not map io_uring submission queue entries");
+                }
+
+                auto* sqRing = static_cast<std::byte*>(m_sqRing);
+                m_sqHead = reinterpret_cast<unsigned*>(sqRing + params.sq_off.head);
+                m_sqTailShared = reinterpret_cast<unsigned*>(sqRing + params.sq_off.tail);
+                m_sqFlags = reinterpret_cast<unsigned*>(sqRing + params.sq_off.flags);
+                m_sqMask = *reinterpret_cast<unsigned*>(sqRing + params.sq_off.ring_mask);
+                m_sqEntries = *reinterpret_cast<unsigned*>(sqRing + params.sq_off.ring_entries);
+                m_sqTail = *m_sqTailShared;
+
+                // note: submission queue entries are always placed at the
+                // index of the tail, so the indirection array is an identity
+                auto* sqArray = reinterpret_cast<unsigned*>(sqRing + params.sq_off.array);
+
+                for (unsigned i = 0; i < m_sqEntries; ++i)
+                {
+                    sqArray[i] = i;
+                }
+
+                auto* cqRing = static_cast<std::byte*>(m_cqRing);
+                m_cqHead = reinterpret_cast<unsigned*>(cqRing + params.cq_off.head);
+                m_cqTail = reinterpret_cast<unsigned*>(cqRing + params.cq_off.tail);
+                m_cqMask = *reinterpret_cast<unsigned*>(cqRing + params.cq_off.ring_mask);
+                m_cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+
+                int eventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+                if (eventFd == -1)
+                {
+                    ThrowSystemError("could not create eventfd");
+                }
+
+                m_event.assign(eventFd);
+
+                if (Register(m_fd, IORING_REGISTER_EVENTFD, &eventFd, 1) == -1)
+                {
+                    ThrowSystemError("could not register eventfd with io_uring instance");
+                }
+
+                if (m_bufferRing = static_cast<io_uring_buf*>(::mmap(nullptr, BufferCount * sizeof(io_uring_buf), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)); m_bufferRing == MAP_FAILED)
+                {
+                    ThrowSystemError("could not allocate io_uring buffer ring");
+                }
+
+                if (m_buffers = ::mmap(nullptr, BufferCount * BufferSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0); m_buffers == MAP_FAILED)
+                {
+                    ThrowSystemError("could not allocate io_uring buffers");
+                }
+
+                io_uring_buf_reg bufferRing{};
+                bufferRing.ring_addr = reinterpret_cast<uint64_t>(m_bufferRing);
+                bufferRing.ring_entries = BufferCount;
+                bufferRing.bgid = BufferGroup;
+
+                if (Register(m_fd, IORING_REGISTER_PBUF_RING, &bufferRing, 1) == -1)
+                {
+                    ThrowSystemError("could not register io_uring buffer ring (requires Linux 5.19 or later)");
+                }
+
+                for (uint16_t bid = 0; bid < BufferCount; ++bid)
+                {
+                    releaseBuffer(bid);
+                }
+            }
+
+            void release()
+            {
+                if (m_buffers != MAP_FAILED)
+                {
+                    ::munmap(m_buffers, BufferCount * BufferSize);
+                }
+
+                if (m_bufferRing != MAP_FAILED)
+                {
+                    ::munmap(m_bufferRing, BufferCount * sizeof(io_uring_buf));
+                }
+
+                if (m_sqes != MAP_FAILED)
+                {
+                    ::munmap(m_sqes, m_sqesSize);
+                }
+
+                if (m_cqRing != MAP_FAILED && m_cqRing != m_sqRing)
+                {
+                    ::munmap(m_cqRing, m_cqRingSize);
+                }
+
+                if (m_sqRing != MAP_FAILED)
+                {
+                    ::munmap(m_sqRing, m_sqRingSize);
+                }
+
+                if (m_fd != -1)
+                {
+                    ::close(m_fd);
+                }
+            }
+
+            void shutdown() override
+            {
+                // note: outstanding operations are destroyed without
+                // invoking their handlers, which is consistent with the
+                // behaviour of other Asio objects
+                m_shutdown = true;
+                m_bufferWaiters.clear();
+
+                while (m_operations != nullptr)
+                {
+                    unlink(m_operations);
+                }
+            }
+
+            std::unique_ptr<operation> unlink(operation* op)
+            {
+                if (op->prev == nullptr)
+                {
+                    m_operations = op->next;
+                }
+                else
+                {
+                    op->prev->next = op->next;
+                }
+
+                if (op->next != nullptr)
+                {
+                    op->next->prev = op->prev;
+                }
+
+                return std::unique_ptr<operation>{ op };
+            }
+
+            io_uring_sqe& nextEntry()
+            {
+                if (m_sqTail - LoadAcquire(*m_sqHead) == m_sqEntries)
+                {
+                    flush();
+
+                    if (m_sqTail - LoadAcquire(*m_sqHead) == m_sqEntries)
+                    {
+                        throw std::system_error{ EBUSY, std::system_category(), "io_uring submission queue is full" };
+                    }
+                }
+
+                io_uring_sqe& sqe = m_sqes[m_sqTail++ & m_sqMask];
+                std::memset(&sqe, 0, sizeof(sqe));
+
+                // note: entries are not submitted individually but all
+                // entries that are prepared while the IO context processes
+                // the current handlers are submitted at once
+                if (!m_flushing)
+                {
+                    m_flushing = true;
+                    asio::post(m_ioContext.get(), [this]
+                    {
+                        m_flushing = false;
+                        flush();
+                    });
+                }
+
+                return sqe;
+            }
+
+            void flush()
+            {
+                StoreRelease(*m_sqTailShared, m_sqTail);
+
+                if (unsigned toSubmit = m_sqTail - LoadAcquire(*m_sqHead); toSubmit > 0)
+                {
+                    int submitted;
+
+                    do
+                    {
+                        submitted = Enter(m_fd, toSubmit, 0, 0);
+                    }
+                    while (submitted == -1 && errno == EINTR);
+
+                    if (submitted == -1 && errno != EAGAIN && errno != EBUSY)
+                    {
+                        ThrowSystemError("could not submit io_uring operations");
+                    }
+                }
+            }
+
+            void awaitCompletions()
+            {
+                if (m_awaiting || m_operations == nullptr || m_shutdown)
+                {
+                    return;
+                }
+
+                m_awaiting = true;
+                m_event.async_wait(asio::posix::stream_descriptor::wait_read, [this](boost::system::error_code error)
+                {
+                    m_awaiting = false;
+
+                    if (error == asio::error::operation_aborted)
+                    {
+                        return;
+                    }
+
+                    uint64_t value;
+                    (void)::read(m_event.native_handle(), &value, sizeof(value));
+
+                    processCompletions();
+                });
+            }
+
+            void processCompletions()
+            {
+                // note: the completions are awaited again even if a handler
+                // throws, in which case the remaining completions are
+                // processed after the event has been signalled again
+                struct await_guard_t
+                {
+                    ~await_guard_t()
+                    {
+                        service.awaitCompletions();
+
+                        if (service.m_awaiting && *service.m_cqHead != LoadAcquire(*service.m_cqTail))
+                        {
+                            uint64_t value = 1;
+                            (void)::write(service.m_event.native_handle(), &value, sizeof(value));
+                        }
+                    }
+
+                    uring_service_t& service;
+                } awaitGuard{ *this };
+
+                bool overflowFlushed = false;
+
+                for (;;)
+                {
+                    unsigned head = *m_cqHead;
+
+                    if (head == LoadAcquire(*m_cqTail))
+                    {
+                        // note: completions that did not fit into the
+                        // completion queue are only flushed by the kernel
+                        // when explicitly requested
+                        if (!overflowFlushed && (std::atomic_ref<unsigned>{ *m_sqFlags }.load(std::memory_order_relaxed) & IORING_SQ_CQ_OVERFLOW))
+                        {
+                            overflowFlushed = true;
+                            (void)Enter(m_fd, 0, 0, IORING_ENTER_GETEVENTS);
+                            continue;
+                        }
+
+                        break;
+                    }
+
+                    io_uring_cqe cqe = m_cqes[head & m_cqMask];
+                    StoreRelease(*m_cqHead, head + 1);
+
+                    if (cqe.user_data == 0)
+                    {
+                        continue;
+                    }
+
+                    auto* op = reinterpret_cast<operation*>(cqe.user_data);
+
+                    if (cqe.flags & IORING_CQE_F_MORE)
+                    {
+                        op->complete(cqe.res, cqe.flags);
+                    }
+                    else
+                    {
+                        unlink(op)->complete(cqe.res, cqe.flags);
+                    }
+                }
+            }
+
+            void notifyBufferWaiters()
+            {
+                if (m_notifying || m_shutdown)
+                {
+                    return;
+                }
+
+                m_notifying = true;
+                asio::post(m_ioContext.get(), [this]
+                {
+                    m_notifying = false;
+
+                    for (auto& handler : std::exchange(m_bufferWaiters, {}))
+                    {
+                        handler();
+                    }
+                });
+            }
+
+            std::reference_wrapper<asio::io_context> m_ioContext;
+            int m_fd;
+            void* m_sqRing;
+            size_t m_sqRingSize;
+            void* m_cqRing;
+            size_t m_cqRingSize;
+            io_uring_sqe* m_sqes;
+            size_t m_sqesSize;
+            unsigned* m_sqHead = nullptr;
+            unsigned* m_sqTailShared = nullptr;
+            unsigned* m_sqFlags = nullptr;
+            unsigned m_sqMask = 0;
+            unsigned m_sqEntries = 0;
+            unsigned m_sqTail;
+            unsigned* m_cqHead = nullptr;
+            unsigned* m_cqTail = nullptr;
+            unsigned m_cqMask = 0;
+            io_uring_cqe* m_cqes = nullptr;
+            io_uring_buf* m_bufferRing;
+            void* m_buffers;
+            uint16_t m_bufferTail;
+            size_t m_buffersAvailable;
+            std::vector<std::function<void()>> m_bufferWaiters;
+            asio::posix::stream_descriptor m_event;
+            operation* m_operations;
+            bool m_flushing;
+            bool m_awaiting;
+            bool m_notifying;
+            bool m_shutdown;
+        };
+
+        asio::execution_context::id uring_service_t::id;
+    }
+
+    struct UringStream::state : std::enable_shared_from_this<state>
+    {
+        struct chunk_t
+        {
+            uint16_t bid;
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        struct read_op_t
+        {
+            std::vector<asio::mutable_buffer> buffers;
+            handler_t handler;
+        };
+
+        struct receive_op_t : operation
+        {
+            receive_op_t(std::shared_ptr<state> state_) : m_state{ std::move(state_) } {}
+            void complete(int result, uint32_t flags) override { m_state->handleReceive(result, flags); }
+            std::shared_ptr<state> m_state;
+        };
+
+        struct send_op_t : operation
+        {
+            send_op_t(std::shared_ptr<state> state_, handler_t handler) : m_state{ std::move(state_) }, m_handler{ std::move(handler) }, m_message{} {}
+            void complete(int result, uint32_t/* flags*/) override { m_state->handleSend(result, std::move(m_handler)); }
+            std::shared_ptr<state> m_state;
+            handler_t m_handler;
+            std::vector<iovec> m_iov;
+            msghdr m_message;
+        };
+
+        state(uring_service_t& service, int fd) :
+            service{ service },
+            fd{ fd },
+            receiveOp{ nullptr },
+            sendOp{ nullptr },
+            receiveCancelling{ false },
+            awaitingBuffers{ false },
+            closed{ false }
+        {
+            /* do nothing */
+        }
+
+        state(const state& other) = delete;
+        state(state&& other) = delete;
+
+        ~state()
+        {
+            for (const chunk_t& chunk : chunks)
+            {
+                service.releaseBuffer(chunk.bid);
+            }
+
+            ::close(fd);
+        }
+
+        state& operator = (const state& rhs) = delete;
+        state& operator = (state&& rhs) = delete;
+
+        void asyncRead(std::vector<asio::mutable_buffer> buffers, handler_t handler)
+        {
+            readOp.emplace(read_op_t{ std::move(buffers), std::move(handler) });
+
+            if (!chunks.empty() || receiveError || asio::buffer_size(readOp->buffers) == 0)
+            {
+                // note: the handler must not be invoked from within the
+                // initiating function
+                asio::post(service.context(), [this_{ shared_from_this() }]
+                {
+                    this_->processRead();
+                    this_->receive();
+                });
+            }
+            else
+            {
+                receive();
+            }
+        }
+
+        void asyncWrite(std::vector<asio::const_buffer> buffers, handler_t handler)
+        {
+            if (asio::buffer_size(buffers) == 0)
+            {
+                asio::post(service.context(), [handler{ std::move(handler) }]
+                {
+                    (*handler)(boost::system::error_code{}, 0);
+                });
+
+                return;
+            }
+
+            auto op = std::make_unique<send_op_t>(shared_from_this(), std::move(handler));
+            op->m_iov.reserve(std::min<size_t>(buffers.size(), IOV_MAX));
+
+            for (const asio::const_buffer& buffer : buffers)
+            {
+                if (op->m_iov.size() == IOV_MAX)
+                {
+                    break;
+                }
+
+                op->m_iov.emplace_back(iovec{ const_cast<void*>(buffer.data()), buffer.size() });
+            }
+
+            msghdr* message = &op->m_message;
+            message->msg_iov = op->m_iov.data();
+            message->msg_iovlen = op->m_iov.size();
+
+            sendOp = service.submit(std::move(op), [this, message](io_uring_sqe& sqe)
+            {
+                sqe.opcode = IORING_OP_SENDMSG;
+                sqe.fd = fd;
+                sqe.addr = reinterpret_cast<uint64_t>(message);
+                sqe.len = 1;
+                sqe.msg_flags = MSG_NOSIGNAL;
+            });
+        }
+
+        void close()
+        {
+            closed = true;
+
+            for (const chunk_t& chunk : chunks)
+            {
+                service.releaseBuffer(chunk.bid);
+            }
+
+            chunks.clear();
+
+            // note: the socket is closed once all outstanding operations
+            // have been completed and the state is released
+            if (receiveOp != nullptr || sendOp != nullptr)
+            {
+                service.cancel(fd);
+            }
+
+            if (readOp != std::nullopt)
+            {
+                asio::post(service.context(), [handler{ std::move(readOp->handler) }]
+                {
+                    (*handler)(asio::error::operation_aborted, 0);
+                });
+
+                readOp.reset();
+            }
+        }
+
+        void receive()
+        {
+            if (receiveOp != nullptr || awaitingBuffers || closed || receiveError || chunks.size() >= MaxRetainedBuffers)
+            {
+                return;
+            }
+
+            receiveOp = service.submit(std::make_unique<receive_op_t>(shared_from_this()), [this](io_uring_sqe& sqe)
+            {
+                sqe.opcode = IORING_OP_RECV;
+                sqe.fd = fd;
+                sqe.ioprio = IORING_RECV_MULTISHOT;
+                sqe.flags = IOSQE_BUFFER_SELECT;
+                sqe.buf_group = BufferGroup;
+            });
+        }
+
+        void handleReceive(int result, uint32_t flags)
+        {
+            if (!(flags & IORING_CQE_F_MORE))
+            {
+                receiveOp = nullptr;
+                receiveCancelling = false;
+            }
+
+            if (flags & IORING_CQE_F_BUFFER)
+            {
+                uint16_t bid = service.acquireBuffer(flags);
+
+                if (result > 0 && !closed)
+                {
+                    chunks.emplace_back(chunk_t{ bid, 0, static_cast<uint32_t>(result) });
+                }
+                else
+                {
+                    service.releaseBuffer(bid);
+                }
+            }
+
+            if (result == 0)
+            {
+                receiveError = asio::error::eof;
+            }
+            else if (result == -ENOBUFS)
+            {
+                // note: the buffers of the IO context are exhausted, so
+                // receiving is resumed as soon as buffers have been released
+                awaitingBuffers = true;
+                service.awaitBuffers([this_{ weak_from_this() }]
+                {
+                    if (auto state = this_.lock(); state != nullptr)
+                    {
+                        state->awaitingBuffers = false;
+                        state->receive();
+                    }
+                });
+            }
+            else if (result < 0 && result != -ECANCELED)
+            {
+                receiveError = MakeErrorCode(result);
+            }
+
+            if (closed)
+            {
+                return;
+            }
+
+            processRead();
+
+            // note: receiving is suspended if too much data has been
+            // retained and resumed by subsequent reads
+            if (receiveOp != nullptr && !receiveCancelling && chunks.size() >= MaxRetainedBuffers)
+            {
+                receiveCancelling = true;
+                service.cancel(receiveOp);
+            }
+
+            receive();
+        }
+
+        void handleSend(int result, handler_t handler)
+        {
+            sendOp = nullptr;
+
+            if (result < 0)
+            {
+                (*handler)(MakeErrorCode(result), 0);
+            }
+            else
+            {
+                (*handler)(boost::system::error_code{}, static_cast<size_t>(result));
+            }
+        }
+
+        void processRead()
+        {
+            if (readOp == std::nullopt || closed)
+            {
+                return;
+            }
+
+            boost::system::error_code error;
+            size_t numBytes = 0;
+
+            if (chunks.empty())
+            {
+                if (!receiveError && asio::buffer_size(readOp->buffers) > 0)
+                {
+                    return;
+                }
+
+                error = receiveError;
+            }
+
+            for (const asio::mutable_buffer& buffer : readOp->buffers)
+            {
+                auto* data = static_cast<std::byte*>(buffer.data());
+                size_t size = buffer.size();
+
+                while (size > 0 && !chunks.empty())
+                {
+                    chunk_t& chunk = chunks.front();
+                    size_t copySize = std::min<size_t>(size, chunk.size - chunk.offset);
+                    std::memcpy(data, service.buffer(chunk.bid) + chunk.offset, copySize);
+
+                    data += copySize;
+                    size -= copySize;
+                    numBytes += copySize;
+                    chunk.offset += static_cast<uint32_t>(copySize);
+
+                    if (chunk.offset == chunk.size)
+                    {
+                        service.releaseBuffer(chunk.bid);
+                        chunks.pop_front();
+                    }
+                }
+            }
+
+            handler_t handler = std::move(readOp->handler);
+            readOp.reset();
+            (*handler)(error, numBytes);
+        }
+
+        uring_service_t& service;
+        int fd;
+        std::deque<chunk_t> chunks;
+        std::optional<read_op_t> readOp;
+        operation* receiveOp;
+        operation* sendOp;
+        boost::system::error_code receiveError;
+        bool receiveCancelling;
+        bool awaitingBuffers;
+        bool closed;
+    };
+
+    struct UringAcceptor::state : std::enable_shared_from_this<state>
+    {
+        struct accept_op_t : operation
+        {
+            accept_op_t(std::shared_ptr<state> state_) : m_state{ std::move(state_) } {}
+            void complete(int result, uint32_t flags) override { m_state->handleAccept(result, flags); }
+            std::shared_ptr<state> m_state;
+        };
+
+        state(uring_service_t& service, int fd) :
+            service{ service },
+            fd{ fd },
+            acceptOp{ nullptr },
+            acceptCancelling{ false },
+            closed{ false }
+        {
+            /* do nothing */
+        }
+
+        state(const state& other) = delete;
+        state(state&& other) = delete;
+
+        ~state()
+        {
+            for (int socket : sockets)
+            {
+                ::close(socket);
+            }
+
+            ::close(fd);
+        }
+
+        state& operator = (const state& rhs) = delete;
+        state& operator = (state&& rhs) = delete;
+
+        void asyncAccept(accept_handler_t handler_)
+        {
+            handler.emplace(std::move(handler_));
+
+            if (!sockets.empty() || error)
+            {
+                asio::post(service.context(), [this_{ shared_from_this() }]
+                {
+                    this_->processAccept();
+                    this_->accept();
+                });
+            }
+            else
+            {
+                accept();
+            }
+        }
+
+        void close()
+        {
+            closed = true;
+
+            if (acceptOp != nullptr)
+            {
+                service.cancel(fd);
+            }
+
+            if (handler != std::nullopt)
+            {
+                asio::post(service.context(), [handler{ std::move(*handler) }]
+                {
+                    handler(asio::error::operation_aborted, -1);
+                });
+
+                handler.reset();
+            }
+        }
+
+        void accept()
+        {
+            if (acceptOp != nullptr || closed || error || sockets.size() >= MaxRetainedSockets)
+            {
+                return;
+            }
+
+            acceptOp = service.submit(std::make_unique<accept_op_t>(shared_from_this()), [this](io_uring_sqe& sqe)
+            {
+                sqe.opcode = IORING_OP_ACCEPT;
+                sqe.fd = fd;
+                sqe.ioprio = IORING_ACCEPT_MULTISHOT;
+                sqe.accept_flags = SOCK_CLOEXEC;
+            });
+        }
+
+        void handleAccept(int result, uint32_t flags)
+        {
+            if (!(flags & IORING_CQE_F_MORE))
+            {
+                acceptOp = nullptr;
+                acceptCancelling = false;
+            }
+
+            if (result >= 0)
+            {
+                sockets.emplace_back(result);
+            }
+            else if (result != -ECANCELED)
+            {
+                error = MakeErrorCode(result);
+            }
+
+            if (closed)
+            {
+                return;
+            }
+
+            processAccept();
+
+            if (acceptOp != nullptr && !acceptCancelling && sockets.size() >= MaxRetainedSockets)
+            {
+                acceptCancelling = true;
+                service.cancel(acceptOp);
+            }
+
+            accept();
+        }
+
+        void processAccept()
+        {
+            if (handler == std::nullopt || closed)
+            {
+                return;
+            }
+
+            if (sockets.empty() && !error)
+            {
+                return;
+            }
+
+            accept_handler_t handler_ = std::move(*handler);
+            handler.reset();
+
+            if (!sockets.empty())
+            {
+                int socket = sockets.front();
+                sockets.pop_front();
+                handler_(boost::system::error_code{}, socket);
+            }
+            else
+            {
+                handler_(std::exchange(error, {}), -1);
+            }
+        }
+
+        uring_service_t& service;
+        int fd;
+        std::deque<int> sockets;
+        std::optional<accept_handler_t> handler;
+        operation* acceptOp;
+        boost::system::error_code error;
+        bool acceptCancelling;
+        bool closed;
+    };
+
+    UringStream::UringStream(asio::io_context& ioContext, native_handle_type socket)
+    {
+        try
+        {
+            m_state = std::make_shared<state>(asio::use_service<uring_service_t>(ioContext), socket);
+        }
+        catch (...)
+        {
+            ::close(socket);
+            throw;
+        }
+    }
+
+    UringStream::~UringStream()
+    {
+        if (m_state != nullptr)
+        {
+            m_state->close();
+        }
+    }
+
+    UringStream& UringStream::operator = (UringStream&& rhs) noexcept
+    {
+        if (m_state != nullptr)
+        {
+            m_state->close();
+        }
+
+        m_state = std::move(rhs.m_state);
+
+        return *this;
+    }
+
+    auto UringStream::get_executor() -> executor_type
+    {
+        return m_state->service.context().get_executor();
+    }
+
+    auto UringStream::native_handle() const -> native_handle_type
+    {
+        return m_state->fd;
+    }
+
+    void UringStream::asyncReadSome(std::vector<asio::mutable_buffer> buffers, handler_t handler)
+    {
+        m_state->asyncRead(std::move(buffers), std::move(handler));
+    }
+
+    void UringStream::asyncWriteSome(std::vector<asio::const_buffer> buffers, handler_t handler)
+    {
+        m_state->asyncWrite(std::move(buffers), std::move(handler));
+    }
+
+    UringAcceptor::UringAcceptor(asio::io_context& ioContext, native_handle_type socket)
+    {
+        try
+        {
+            m_state = std::make_shared<state>(asio::use_service<uring_service_t>(ioContext), socket);
+        }
+        catch (...)
+        {
+            ::close(socket);
+            throw;
+        }
+    }
+
+    UringAcceptor::~UringAcceptor()
+    {
+        if (m_state != nullptr)
+        {
+            m_state->close();
+        }
+    }
+
+    UringAcceptor& UringAcceptor::operator = (UringAcceptor&& rhs) noexcept
+    {
+        if (m_state != nullptr)
+        {
+            m_state->close();
+        }
+
+        m_state = std::move(rhs.m_state);
+
+        return *this;
+    }
+
+    auto UringAcceptor::get_executor() -> executor_type
+    {
+        return m_state->service.context().get_executor();
+    }
+
+    void UringAcceptor::async_accept(accept_handler_t handler)
+    {
+        m_state->asyncAccept(std::move(handler));
+    }
+}
+#endif
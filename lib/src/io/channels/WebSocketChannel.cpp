@@ -13,38 +13,51 @@ namespace dots::io
     }
 
     WebSocketChannel::WebSocketChannel(key_t key, asio::io_context& ioContext, std::string_view host, std::string_view port) :
+        WebSocketChannel(key, Connect(ioContext, host, port, Subprotocol))
+    {
+        /* do nothing */
+    }
+
+    WebSocketChannel::WebSocketChannel(key_t key, ws_stream_t&& stream) :
         Channel(key),
-        m_stream{ ioContext },
-        m_serializer{ { serialization::TextOptions::Minified } }
+        m_stream(std::move(stream)),
+        m_serializer{ { serialization::TextOptions::Minified } },
+        m_writeQueueSize(0),
+        m_asyncWriting(false)
+    {
+        initEndpoints(Endpoint{ "ws", m_stream.next_layer().socket().local_endpoint() }, Endpoint{ "ws", m_stream.next_layer().socket().remote_endpoint() });
+    }
+
+    auto WebSocketChannel::Connect(asio::io_context& ioContext, std::string_view host, std::string_view port, std::string_view subprotocol) -> ws_stream_t
     {
         try
         {
-            asio::ip::tcp::resolver resolver{ m_stream.get_executor() };
+            ws_stream_t stream{ ioContext };
+            asio::ip::tcp::resolver resolver{ stream.get_executor() };
             auto endpoints = resolver.resolve(asio::ip::tcp::socket::protocol_type::v4(), host, port, asio::ip::resolver_query_base::numeric_service);
-            auto& tcpStream = m_stream.next_layer();
+            auto& tcpStream = stream.next_layer();
             tcpStream.connect(endpoints.begin(), endpoints.end());
-            initEndpoints(Endpoint{ "ws", m_stream.next_layer().socket().local_endpoint() }, Endpoint{ "ws", m_stream.next_layer().socket().remote_endpoint() });
 
-            m_stream.set_option(boost::beast::websocket::stream_base::timeout::suggested(boost::beast::role_type::client));
-            m_stream.set_option(boost::beast::websocket::stream_base::decorator([](boost::beast::websocket::request_type& req)
+            stream.set_option(boost::beast::websocket::stream_base::timeout::suggested(boost::beast::role_type::client));
+            stream.set_option(boost::beast::websocket::stream_base::decorator([subprotocol = std::string{ subprotocol }](boost::beast::websocket::request_type& req)
             {
                 req.set(boost::beast::http::field::user_agent, std::string(BOOST_BEAST_VERSION_STRING) + " DOTS WebSocket client");
-                req.set(boost::beast::http::field::sec_websocket_protocol, Subprotocol);
+                req.set(boost::beast::http::field::sec_websocket_protocol, subprotocol);
             }));
 
             boost::beast::websocket::response_type res;
-            m_stream.handshake(res, host.data(), "/");
+            stream.handshake(res, std::string{ host }, "/");
 
             if (auto it = res.find(boost::beast::http::field::sec_websocket_protocol); it == res.end())
             {
-                throw std::runtime_error{ "response is missing required subprotocol: " + std::string{ Subprotocol } };
+                throw std::runtime_error{ "response is missing required subprotocol: " + std::string{ subprotocol } };
             }
-            else if (it->value() != Subprotocol)
+            else if (it->value() != subprotocol)
             {
-                throw std::runtime_error{ std::string{ "response has specified incompatible subprotocol: " } + std::string{ it->value().begin(), it->value().end() } + " != " + Subprotocol };
+                throw std::runtime_error{ std::string{ "response has specified incompatible subprotocol: " } + std::string{ it->value().begin(), it->value().end() } + " != " + std::string{ subprotocol } };
             }
 
-            return;
+            return stream;
         }
         catch (const std::exception& e)
         {
@@ -52,17 +65,10 @@ namespace dots::io
         }
     }
 
-    WebSocketChannel::WebSocketChannel(key_t key, ws_stream_t&& stream) :
-        Channel(key),
-        m_stream(std::move(stream))
-    {
-        initEndpoints(Endpoint{ "ws", m_stream.next_layer().socket().local_endpoint() }, Endpoint{ "ws", m_stream.next_layer().socket().remote_endpoint() });
-    }
-
     void WebSocketChannel::asyncReceiveImpl()
     {
         m_buffer.consume(m_buffer.size());
-        m_stream.async_read(m_buffer, [&, this_{ weak_from_this() }](std::error_code ec, size_t/* bytes*/)
+        m_stream.async_read(m_buffer, [&, this_{ weak_from_this() }](std::error_code ec, size_t bytes)
         {
             try
             {
@@ -77,11 +83,17 @@ namespace dots::io
                 m_serializer.reader().readArrayBegin();
                 DotsHeader header;
                 m_serializer.deserialize(header);
-                type::AnyStruct instance{ registry().getStructType(*header.typeName) };
+                type::AnyStruct instance{ resolveStructType(*header.typeName) };
                 m_serializer.deserialize(*instance);
                 m_serializer.reader().readArrayEnd();
 
-                processReceive(Transmission{ std::move(header), std::move(instance) });
+                TrafficState& traffic = trafficState();
+                traffic.receivedBytes.fetch_add(bytes, std::memory_order_relaxed);
+                traffic.receivedPackages.fetch_add(1, std::memory_order_relaxed);
+
+                Transmission transmission{ std::move(header), std::move(instance) };
+                transmission.setEncodedSize(bytes);
+                processReceive(std::move(transmission));
             }
             catch (...)
             {
@@ -92,12 +104,111 @@ namespace dots::io
 
     void WebSocketChannel::transmitImpl(const DotsHeader& header, const type::Struct& instance)
     {
+        m_serializer.output().clear();
         m_serializer.writer().writeArrayBegin();
         m_serializer.serialize(header);
         m_serializer.serialize(instance);
         m_serializer.writer().writeArrayEnd();
 
-        m_stream.write(asio::buffer(m_serializer.output()));
-        m_serializer.output().clear();
+        std::string& data = m_serializer.output();
+        limitWriteQueue(data.size());
+
+        m_writeQueueSize += data.size();
+        m_writeQueue.emplace_back(queued_message_t{ std::move(data), Droppable(instance._descriptor()) });
+        data.clear();
+
+        if (!m_asyncWriting)
+        {
+            asyncWrite();
+        }
+        else
+        {
+            updateWriteQueueState();
+        }
+    }
+
+    void WebSocketChannel::asyncWrite()
+    {
+        if (m_writeQueue.empty())
+        {
+            m_asyncWriting = false;
+            updateWriteQueueState();
+            return;
+        }
+
+        m_asyncWriting = true;
+        updateWriteQueueState();
+
+        // note: the message at the front of the write queue must remain valid
+        // until the write has completed and is therefore never dropped
+        m_stream.async_write(asio::buffer(m_writeQueue.front().data), [&, this_{ shared_from_this() }](boost::system::error_code ec, size_t numBytes)
+        {
+            try
+            {
+                verifyErrorCode(ec);
+
+                TrafficState& traffic = trafficState();
+                traffic.sentBytes.fetch_add(numBytes, std::memory_order_relaxed);
+                traffic.sentPackages.fetch_add(1, std::memory_order_relaxed);
+
+                m_writeQueueSize -= m_writeQueue.front().data.size();
+                m_writeQueue.pop_front();
+                asyncWrite();
+            }
+            catch (...)
+            {
+                if (this_.use_count() > 1)
+                {
+                    processError(std::current_exception());
+                }
+            }
+        });
+    }
+
+    void WebSocketChannel::limitWriteQueue(size_t size)
+    {
+        auto first = m_writeQueue.begin();
+
+        // note: the message at the front of the write queue is currently
+        // being written and can therefore not be dropped
+        if (m_asyncWriting && first != m_writeQueue.end())
+        {
+            ++first;
+        }
+
+        m_writeQueueSize -= Channel::limitWriteQueue(m_writeQueueSize + size, m_writeQueue, first).first;
+    }
+
+    void WebSocketChannel::updateWriteQueueState()
+    {
+        WriteQueueState& state = writeQueueState();
+        state.size = m_writeQueueSize;
+        state.depth = static_cast<uint32_t>(m_writeQueue.size());
+
+        if (m_writeQueueSize <= state.maxSize / 2 && (state.congested || state.drainRequested))
+        {
+            bool congested = state.congested.exchange(false);
+            bool drainRequested = state.drainRequested.exchange(false);
+
+            // note: the drain handler must not be invoked if the channel is
+            // only kept alive by a pending write operation
+            if ((congested || drainRequested) && weak_from_this().use_count() > 1)
+            {
+                processWriteQueueDrained();
+            }
+        }
+    }
+
+    WebSocketCborChannel::WebSocketCborChannel(key_t key, asio::io_context& ioContext, const Endpoint& endpoint) :
+        WebSocketCborChannel(key, WebSocketChannel::Connect(ioContext, endpoint.host(), endpoint.port(), Subprotocol), nullptr)
+    {
+        /* do nothing */
+    }
+
+    WebSocketCborChannel::WebSocketCborChannel(key_t key, ws_stream_t&& stream, payload_cache_t* payloadCache) :
+        base_t(key, WebSocketStream{ std::move(stream) }, payloadCache)
+    {
+        boost::beast::tcp_stream& tcpStream = this->stream().ws().next_layer();
+        initEndpoints(Endpoint{ "ws-cbor", tcpStream.socket().local_endpoint() }, Endpoint{ "ws-cbor", tcpStream.socket().remote_endpoint() });
     }
 }
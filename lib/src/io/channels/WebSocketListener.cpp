@@ -1,8 +1,8 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #include <dots/io/channels/WebSocketListener.h>
-#include <algorithm>
-#include <dots/io/channels/WebSocketChannel.h>
+#include <chrono>
+#include <dots/tools/logging.h>
 
 namespace dots::io
 {
@@ -46,47 +46,130 @@ namespace dots::io
     {
         m_acceptor.async_accept(m_socket, [this](const boost::system::error_code& error)
         {
+            if (error == asio::error::operation_aborted || !m_acceptor.is_open())
+            {
+                return;
+            }
+
+            if (error)
+            {
+                processError(std::make_exception_ptr(std::runtime_error{ "failed listening on WebSocket endpoint at address '" + m_address + ":" + m_port + "' -> " + error.message() }));
+                return;
+            }
+
+            asyncHandshake();
+        });
+    }
+
+    void WebSocketListener::asyncHandshake()
+    {
+        // note: this move is explicitly allowed according to the Boost ASIO v1.72 documentation of the socket
+        m_stream.emplace(std::move(m_socket));
+        m_buffer.consume(m_buffer.size());
+        m_request = {};
+
+        boost::beast::tcp_stream& tcpStream = m_stream->next_layer();
+        tcpStream.expires_after(std::chrono::seconds{ 30 });
+
+        boost::beast::http::async_read(tcpStream, m_buffer, m_request, [this](const boost::system::error_code& error, size_t/* bytesRead*/)
+        {
+            if (error == asio::error::operation_aborted || !m_acceptor.is_open())
+            {
+                return;
+            }
+
             try
             {
-                if (error == asio::error::operation_aborted || !m_acceptor.is_open())
+                if (error)
                 {
-                    return;
+                    throw boost::system::system_error{ error };
                 }
 
-                if (error)
+                if (!boost::beast::websocket::is_upgrade(m_request))
                 {
-                    processError(std::make_exception_ptr(std::runtime_error{ "failed listening on WebSocket endpoint at address '" + m_address + ":" + m_port + "' -> " + error.message() }));
-                    return;
+                    throw std::runtime_error{ "request is not a WebSocket upgrade" };
                 }
 
-                // note: this move is explicitly allowed according to the Boost ASIO v1.72 documentation of the socket
-                WebSocketChannel::ws_stream_t stream{ std::move(m_socket) };
+                // note: clients that do not request a known subprotocol are
+                // operated via JSON to remain compatible with older clients
+                bool cbor = false;
 
-                stream.set_option(boost::beast::websocket::stream_base::timeout::suggested(boost::beast::role_type::server));
-                stream.set_option(boost::beast::websocket::stream_base::decorator([](boost::beast::websocket::response_type& res)
+                if (auto it = m_request.find(boost::beast::http::field::sec_websocket_protocol); it != m_request.end())
+                {
+                    for (const auto& subprotocol : boost::beast::http::token_list{ it->value() })
+                    {
+                        if (subprotocol == WebSocketCborChannel::Subprotocol)
+                        {
+                            cbor = true;
+                            break;
+                        }
+                    }
+                }
+
+                // note: the timeout of the TCP stream has to be disabled when
+                // the WebSocket stream uses its own timeouts
+                m_stream->next_layer().expires_never();
+                m_stream->set_option(boost::beast::websocket::stream_base::timeout::suggested(boost::beast::role_type::server));
+                m_stream->set_option(boost::beast::websocket::stream_base::decorator([subprotocol = cbor ? WebSocketCborChannel::Subprotocol : WebSocketChannel::Subprotocol](boost::beast::websocket::response_type& res)
                 {
                     res.set(boost::beast::http::field::server, std::string(BOOST_BEAST_VERSION_STRING) + " DOTS WebSocket server");
-                    res.set(boost::beast::http::field::sec_websocket_protocol, WebSocketChannel::Subprotocol);
+                    res.set(boost::beast::http::field::sec_websocket_protocol, subprotocol);
                 }));
 
-                stream.accept();
+                m_stream->async_accept(m_request, [this, cbor](const boost::system::error_code& error)
+                {
+                    if (error == asio::error::operation_aborted || !m_acceptor.is_open())
+                    {
+                        return;
+                    }
 
-                processAccept(make_channel<WebSocketChannel>(std::move(stream)));
+                    if (error)
+                    {
+                        LOG_WARN_S("failed to perform WebSocket handshake at address '" << m_address << ":" << m_port << "' -> " << error.message());
+                        closeSocket();
+                        asyncAcceptImpl();
+                        return;
+                    }
+
+                    WebSocketChannel::ws_stream_t stream = std::move(*m_stream);
+                    m_stream.reset();
+
+                    try
+                    {
+                        if (cbor)
+                        {
+                            processAccept(make_channel<WebSocketCborChannel>(std::move(stream), nullptr));
+                        }
+                        else
+                        {
+                            processAccept(make_channel<WebSocketChannel>(std::move(stream)));
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        processError(std::string{ "failed to create WebSocket channel -> " } + e.what());
+                    }
+                });
             }
             catch (const std::exception& e)
             {
-                try
-                {
-                    processError(std::string{ "failed to configure WebSocket stream -> " } + e.what());
-
-                    m_socket.shutdown(asio::ip::tcp::socket::shutdown_both);
-                    m_socket.close();
-                }
-                catch (const std::exception& e)
-                {
-                    processError(std::string{ "failed to shutdown and close WebSocket stream -> " } + e.what());
-                }
+                // note: a failed handshake only affects the connecting
+                // client, so the listener continues to accept connections
+                LOG_WARN_S("failed to perform WebSocket handshake at address '" << m_address << ":" << m_port << "' -> " << e.what());
+                closeSocket();
+                asyncAcceptImpl();
             }
         });
     }
+
+    void WebSocketListener::closeSocket()
+    {
+        if (m_stream != std::nullopt)
+        {
+            boost::system::error_code error;
+            m_stream->next_layer().socket().shutdown(asio::ip::tcp::socket::shutdown_both, error);
+            m_stream->next_layer().socket().close(error);
+            m_stream.reset();
+        }
+    }
 }
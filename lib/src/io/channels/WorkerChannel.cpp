@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/io/channels/WorkerChannel.h>
+#include <utility>
+
+namespace dots::io
+{
+    WorkerChannel::WorkerChannel(key_t key, asio::io_context& ioContext, asio::io_context& workerContext, channel_ptr_t channel) :
+        Channel(key),
+        m_ioContext{ std::ref(ioContext) },
+        m_workerContext{ std::ref(workerContext) },
+        m_channel{ std::move(channel) },
+        m_workerReceiving(false),
+        m_workerPaused(false),
+        m_asyncReceiving(false)
+    {
+        initEndpoints(m_channel->localEndpoint(), m_channel->remoteEndpoint());
+
+        // note: the write queue is operated by the wrapped channel, so its
+        // state is shared to allow it to be read on the owning IO context.
+        // the same applies to the traffic statistics
+        m_channel->m_writeQueueState = m_writeQueueState;
+        m_channel->m_trafficState = m_trafficState;
+    }
+
+    WorkerChannel::~WorkerChannel()
+    {
+        // note: the wrapped channel might still be in use by the worker and
+        // is therefore released on the worker thread
+        asio::post(m_workerContext.get(), [channel{ std::move(m_channel) }]{ (void)channel; });
+    }
+
+    void WorkerChannel::asyncReceiveImpl()
+    {
+        m_asyncReceiving = true;
+
+        // note: the wrapped channel receives continuously, so only the
+        // initial receive has to be handed over to the worker
+        if (m_workerReceiving)
+        {
+            if (!m_receivedTransmissions.empty() || m_workerError != nullptr)
+            {
+                asio::post(m_ioContext.get(), [this_{ weak_from_this() }]
+                {
+                    if (auto channel = std::static_pointer_cast<WorkerChannel>(this_.lock()); channel != nullptr)
+                    {
+                        channel->processReceivedTransmission();
+                    }
+                });
+            }
+
+            return;
+        }
+
+        m_workerReceiving = true;
+
+        asio::post(m_workerContext.get(), [this_{ weak_from_this() }, ioContext{ m_ioContext }, channel{ m_channel }, registry{ &registry() }, passThrough{ m_passThrough }]
+        {
+            channel->m_passThrough = passThrough;
+            channel->m_writeQueueHandler.emplace([this_, ioContext]
+            {
+                asio::post(ioContext.get(), [this_]
+                {
+                    if (auto channel = std::static_pointer_cast<WorkerChannel>(this_.lock()); channel != nullptr)
+                    {
+                        channel->processWriteQueueDrained();
+                    }
+                });
+            });
+
+            channel->init(*registry);
+            channel->asyncReceive(
+                [this_, ioContext](Transmission transmission)
+                {
+                    asio::post(ioContext.get(), [this_, transmission{ std::move(transmission) }]() mutable
+                    {
+                        if (auto channel = std::static_pointer_cast<WorkerChannel>(this_.lock()); channel != nullptr)
+                        {
+                            channel->handleWorkerReceive(std::move(transmission));
+                        }
+                    });
+
+                    return true;
+                },
+                [this_, ioContext](std::exception_ptr ePtr)
+                {
+                    asio::post(ioContext.get(), [this_, ePtr]
+                    {
+                        if (auto channel = std::static_pointer_cast<WorkerChannel>(this_.lock()); channel != nullptr)
+                        {
+                            channel->handleWorkerError(ePtr);
+                        }
+                    });
+                }
+            );
+        });
+    }
+
+    void WorkerChannel::transmitImpl(const DotsHeader& header, const type::Struct& instance)
+    {
+        transmitOnWorker(Transmission{ header, type::AnyStruct{ instance } });
+    }
+
+    void WorkerChannel::transmitImpl(const Transmission& transmission)
+    {
+        transmitOnWorker(transmission.share());
+    }
+
+    void WorkerChannel::transmitImpl(const std::vector<Transmission>& transmissions)
+    {
+        std::vector<Transmission> sharedTransmissions;
+        sharedTransmissions.reserve(transmissions.size());
+
+        for (const Transmission& transmission : transmissions)
+        {
+            sharedTransmissions.emplace_back(transmission.share());
+        }
+
+        transmitOnWorker(std::move(sharedTransmissions));
+    }
+
+    void WorkerChannel::transmitOnWorker(Transmission transmission)
+    {
+        asio::post(m_workerContext.get(), [this_{ weak_from_this() }, ioContext{ m_ioContext }, channel{ m_channel }, transmission{ std::move(transmission) }]
+        {
+            try
+            {
+                // note: dependencies have already been exported by this
+                // channel, so the wrapped channel must transmit directly
+                channel->transmitImpl(transmission);
+            }
+            catch (...)
+            {
+                asio::post(ioContext.get(), [this_, ePtr{ std::current_exception() }]
+                {
+                    if (auto channel = std::static_pointer_cast<WorkerChannel>(this_.lock()); channel != nullptr)
+                    {
+                        channel->handleWorkerError(ePtr);
+                    }
+                });
+            }
+        });
+    }
+
+    void WorkerChannel::transmitOnWorker(std::vector<Transmission> transmissions)
+    {
+        // note: batches are handed over as a unit, so the wrapped channel
+        // can transmit them as a single batch
+        asio::post(m_workerContext.get(), [this_{ weak_from_this() }, ioContext{ m_ioContext }, channel{ m_channel }, transmissions{ std::move(transmissions) }]
+        {
+            try
+            {
+                channel->transmitImpl(transmissions);
+            }
+            catch (...)
+            {
+                asio::post(ioContext.get(), [this_, ePtr{ std::current_exception() }]
+                {
+                    if (auto channel = std::static_pointer_cast<WorkerChannel>(this_.lock()); channel != nullptr)
+                    {
+                        channel->handleWorkerError(ePtr);
+                    }
+                });
+            }
+        });
+    }
+
+    void WorkerChannel::handleWorkerReceive(Transmission transmission)
+    {
+        m_receivedTransmissions.emplace_back(std::move(transmission));
+        processReceivedTransmission();
+    }
+
+    void WorkerChannel::processReceivedTransmission()
+    {
+        if (m_receivedTransmissions.empty())
+        {
+            // note: errors are processed after all transmissions that have
+            // been received before
+            if (m_workerError != nullptr && m_asyncReceiving)
+            {
+                m_asyncReceiving = false;
+                processError(std::exchange(m_workerError, nullptr));
+            }
+
+            return;
+        }
+
+        if (!m_asyncReceiving)
+        {
+            // note: transmissions are buffered while the channel is not
+            // receiving (e.g. because receiving has been paused), so the
+            // wrapped channel is paused as well to avoid unbounded buffering
+            if (!m_workerPaused)
+            {
+                m_workerPaused = true;
+                asio::post(m_workerContext.get(), [channel{ m_channel }]{ channel->pauseReceive(); });
+            }
+
+            return;
+        }
+
+        Transmission transmission = std::move(m_receivedTransmissions.front());
+        m_receivedTransmissions.pop_front();
+
+        if (m_receivedTransmissions.empty() && m_workerPaused)
+        {
+            m_workerPaused = false;
+            asio::post(m_workerContext.get(), [channel{ m_channel }]{ channel->resumeReceive(); });
+        }
+
+        // note: the flag will be set again by asyncReceiveImpl() if the
+        // receive handler requests further transmissions
+        m_asyncReceiving = false;
+        processReceive(std::move(transmission));
+    }
+
+    void WorkerChannel::handleWorkerError(std::exception_ptr ePtr)
+    {
+        if (m_workerError == nullptr)
+        {
+            m_workerError = ePtr;
+        }
+
+        processReceivedTransmission();
+    }
+}
@@ -13,7 +13,9 @@ namespace dots::type
 
 
     Registry::Registry( std::optional<new_type_handler_t> newTypeHandler/* = std::nullopt*/, StaticTypePolicy staticTypePolicy /* = StaticTypePolicy::All*/) :
-        m_newTypeHandler(std::move(newTypeHandler))
+        m_newTypeHandler(std::move(newTypeHandler)),
+        m_mutex{ std::make_unique<std::shared_mutex>() },
+        m_deregistrations{ std::make_unique<std::atomic<uint64_t>>(0) }
     {
         // ensure fundamental types are instantiated and added to static descriptor map
         // ensure fundamental vector types are instantiated and added to static descriptor map
@@ -48,12 +50,14 @@ namespace dots::type
                     if (descriptor->isFundamentalType())
                     {
                         m_types.emplace(descriptor);
+                        indexType(*descriptor);
                     }
                     else if (const auto *vectorDescriptor = descriptor->as<VectorDescriptor>(); vectorDescriptor != nullptr)
                     {
                         if (vectorDescriptor->valueDescriptor().isFundamentalType())
                         {
                             m_types.emplace(descriptor);
+                            indexType(*descriptor);
                         }
                     }
                 }
@@ -64,6 +68,7 @@ namespace dots::type
                     if (not IsUserType(*descriptor))
                     {
                         m_types.emplace(descriptor);
+                        indexType(*descriptor);
                     }
                 }
                 break;
@@ -71,12 +76,32 @@ namespace dots::type
                 for (auto&[name, descriptor]: static_descriptors())
                 {
                     m_types.emplace(descriptor);
+                    indexType(*descriptor);
                 }
                 break;
         }
 
     }
 
+    Registry::~Registry()
+    {
+        deindexTypes();
+    }
+
+    Registry& Registry::operator = (Registry&& rhs)
+    {
+        deindexTypes();
+
+        m_newTypeHandler = std::move(rhs.m_newTypeHandler);
+        m_mutex = std::move(rhs.m_mutex);
+        m_deregistrations = std::move(rhs.m_deregistrations);
+        m_types = std::move(rhs.m_types);
+        m_structTypes = std::move(rhs.m_structTypes);
+        rhs.m_structTypes.clear();
+
+        return *this;
+    }
+
     Registry::const_iterator_t Registry::begin() const
     {
         return m_types.begin();
@@ -99,6 +124,8 @@ namespace dots::type
 
     const Descriptor<>* Registry::findType(std::string_view name, bool assertNotNull/* = false*/) const
     {
+        std::shared_lock lock{ *m_mutex };
+
         if (const Descriptor<>* descriptor = m_types.find(name); descriptor == nullptr)
         {
             if (assertNotNull)
@@ -195,6 +222,17 @@ namespace dots::type
         return const_cast<StructDescriptor&>(std::as_const(*this).getStructType(name));
     }
 
+    const StructDescriptor* Registry::findStructType(StructDescriptor::type_id_t typeId) const
+    {
+        std::shared_lock lock{ *m_mutex };
+        return typeId < m_structTypes.size() ? m_structTypes[typeId] : nullptr;
+    }
+
+    StructDescriptor* Registry::findStructType(StructDescriptor::type_id_t typeId)
+    {
+        return const_cast<StructDescriptor*>(std::as_const(*this).findStructType(typeId));
+    }
+
     bool Registry::hasType(std::string_view name) const
     {
         return findType(name) != nullptr;
@@ -202,12 +240,77 @@ namespace dots::type
 
     size_t Registry::size() const
     {
+        std::shared_lock lock{ *m_mutex };
         return m_types.size();
     }
 
+    uint64_t Registry::deregistrations() const
+    {
+        return m_deregistrations->load(std::memory_order_acquire);
+    }
+
     Descriptor<>& Registry::registerType(Descriptor<>& descriptor, bool assertNewType/* = true*/)
     {
-        if (auto descriptor_ = findType(descriptor.name()); descriptor_ != nullptr)
+        std::vector<Descriptor<>*> newTypes;
+        Descriptor<>* registeredDescriptor;
+
+        {
+            std::unique_lock lock{ *m_mutex };
+            registeredDescriptor = &registerTypeUnsynchronized(descriptor, assertNewType, newTypes);
+        }
+
+        // note: the new type handler is invoked without holding the lock to
+        // allow the handler to access the registry
+        if (m_newTypeHandler != std::nullopt)
+        {
+            for (Descriptor<>* newType : newTypes)
+            {
+                (*m_newTypeHandler)(*newType);
+            }
+        }
+
+        return *registeredDescriptor;
+    }
+
+    Descriptor<>& Registry::registerType(std::shared_ptr<Descriptor<>> descriptor, bool assertNewType)
+    {
+        return registerType(*descriptor, assertNewType);
+    }
+
+    void Registry::deregisterType(const Descriptor<>& descriptor, bool assertRegisteredType/* = true*/)
+    {
+        std::unique_lock lock{ *m_mutex };
+        deindexType(descriptor.name());
+        m_types.erase(descriptor.name(), assertRegisteredType);
+        m_deregistrations->fetch_add(1, std::memory_order_release);
+    }
+
+    void Registry::deregisterType(std::string_view name, bool assertRegisteredType/* = true*/)
+    {
+        std::unique_lock lock{ *m_mutex };
+        deindexType(name);
+        m_types.erase(name, assertRegisteredType);
+        m_deregistrations->fetch_add(1, std::memory_order_release);
+    }
+
+    std::vector<std::shared_ptr<Descriptor<>>> Registry::snapshot() const
+    {
+        std::shared_lock lock{ *m_mutex };
+        std::vector<std::shared_ptr<Descriptor<>>> descriptors;
+        descriptors.reserve(m_types.size());
+
+        for (const auto& [name, descriptor] : m_types)
+        {
+            (void)name;
+            descriptors.emplace_back(descriptor);
+        }
+
+        return descriptors;
+    }
+
+    Descriptor<>& Registry::registerTypeUnsynchronized(Descriptor<>& descriptor, bool assertNewType, std::vector<Descriptor<>*>& newTypes)
+    {
+        if (auto descriptor_ = m_types.find(descriptor.name()); descriptor_ != nullptr)
         {
             if (assertNewType)
             {
@@ -220,44 +323,73 @@ namespace dots::type
         }
 
         m_types.emplace(descriptor);
+        indexType(descriptor);
 
         if (auto vectorDescriptor = descriptor.as<VectorDescriptor>(); vectorDescriptor != nullptr)
         {
-            registerType(vectorDescriptor->valueDescriptor(), false);
+            registerTypeUnsynchronized(vectorDescriptor->valueDescriptor(), false, newTypes);
         }
         else if (auto enumDescriptor = descriptor.as<EnumDescriptor>(); enumDescriptor != nullptr)
         {
-            registerType(enumDescriptor->underlyingDescriptor(), false);
+            registerTypeUnsynchronized(enumDescriptor->underlyingDescriptor(), false, newTypes);
         }
         else if (auto structDescriptor = descriptor.as<StructDescriptor>(); structDescriptor != nullptr)
         {
             for (PropertyDescriptor& propertyDescriptor : structDescriptor->propertyDescriptors())
             {
-                registerType(propertyDescriptor.valueDescriptor(), false);
+                registerTypeUnsynchronized(propertyDescriptor.valueDescriptor(), false, newTypes);
             }
         }
 
-        if (m_newTypeHandler != std::nullopt)
-        {
-            (*m_newTypeHandler)(descriptor);
-        }
+        newTypes.emplace_back(&descriptor);
 
         return descriptor;
     }
 
-    Descriptor<>& Registry::registerType(std::shared_ptr<Descriptor<>> descriptor, bool assertNewType)
+    void Registry::indexType(Descriptor<>& descriptor)
     {
-        return registerType(*descriptor, assertNewType);
+        if (auto* structDescriptor = descriptor.as<StructDescriptor>(); structDescriptor != nullptr)
+        {
+            // note: type ids are assigned when a type is registered, so that
+            // descriptors which are created but never registered (e.g. when
+            // a type is imported that has already been registered) do not
+            // allocate an id
+            if (StructDescriptor::type_id_t typeId = structDescriptor->acquireTypeId(true); typeId >= m_structTypes.size())
+            {
+                m_structTypes.resize(typeId + 1, nullptr);
+            }
+
+            m_structTypes[structDescriptor->typeId()] = structDescriptor;
+        }
     }
 
-    void Registry::deregisterType(const Descriptor<>& descriptor, bool assertRegisteredType/* = true*/)
+    void Registry::deindexType(std::string_view name)
     {
-        m_types.erase(descriptor.name(), assertRegisteredType);
+        if (Descriptor<>* descriptor = m_types.find(name); descriptor != nullptr)
+        {
+            if (auto* structDescriptor = descriptor->as<StructDescriptor>(); structDescriptor != nullptr)
+            {
+                if (StructDescriptor::type_id_t typeId = structDescriptor->typeId(); typeId < m_structTypes.size() && m_structTypes[typeId] == structDescriptor)
+                {
+                    m_structTypes[typeId] = nullptr;
+                }
+
+                structDescriptor->releaseTypeId();
+            }
+        }
     }
 
-    void Registry::deregisterType(std::string_view name, bool assertRegisteredType/* = true*/)
+    void Registry::deindexTypes()
     {
-        m_types.erase(name, assertRegisteredType);
+        for (StructDescriptor* structDescriptor : m_structTypes)
+        {
+            if (structDescriptor != nullptr)
+            {
+                structDescriptor->releaseTypeId();
+            }
+        }
+
+        m_structTypes.clear();
     }
 
     bool Registry::IsUserType(const Descriptor<>& descriptor)
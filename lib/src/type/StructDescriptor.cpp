@@ -1,14 +1,37 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #include <dots/type/StructDescriptor.h>
+#include <mutex>
+#include <set>
 #include <dots/type/Struct.h>
 #include <dots/io/DescriptorConverter.h>
 #include <dots/type/DynamicStruct.h>
 
 namespace dots::type
 {
+    namespace
+    {
+        struct type_id_pool_t
+        {
+            std::mutex mutex;
+            std::set<StructDescriptor::type_id_t> releasedTypeIds;
+            StructDescriptor::type_id_t nextTypeId = 0;
+        };
+
+        type_id_pool_t& TypeIdPool()
+        {
+            // note: the pool is intentionally leaked, so that it is still
+            // available when static descriptors are destroyed
+            static auto* Pool = new type_id_pool_t{};
+            return *Pool;
+        }
+    }
+
     StructDescriptor::StructDescriptor(key_t key, std::string name, uint8_t flags, const property_descriptor_container_t& propertyDescriptors, size_t areaOffset, size_t size, size_t alignment) :
         StaticDescriptor(key, Type::Struct, std::move(name), size, alignment),
+        m_typeId(NoTypeId),
+        m_numRegistrations(0),
+        m_pinnedTypeId(false),
         m_flags(flags),
         m_propertyDescriptors(propertyDescriptors),
         m_areaOffset(areaOffset),
@@ -35,6 +58,16 @@ namespace dots::type
         }
     }
 
+    StructDescriptor::~StructDescriptor()
+    {
+        if (m_typeId.load(std::memory_order_acquire) != NoTypeId && !m_pinnedTypeId)
+        {
+            type_id_pool_t& pool = TypeIdPool();
+            std::lock_guard lock{ pool.mutex };
+            pool.releasedTypeIds.emplace(m_typeId.load(std::memory_order_relaxed));
+        }
+    }
+
     Typeless& StructDescriptor::construct(Typeless& value) const
     {
         return Typeless::From(construct(value.to<Struct>()));
@@ -418,4 +451,55 @@ namespace dots::type
 
         return m_propertyPaths;
     }
+
+    auto StructDescriptor::acquireTypeId(bool registration) const -> type_id_t
+    {
+        type_id_pool_t& pool = TypeIdPool();
+        std::lock_guard lock{ pool.mutex };
+
+        if (registration)
+        {
+            ++m_numRegistrations;
+        }
+
+        type_id_t typeId = m_typeId.load(std::memory_order_relaxed);
+
+        if (typeId == NoTypeId)
+        {
+            // note: the lowest released id is reused first to keep the ids
+            // of the types that are in use as dense as possible
+            if (pool.releasedTypeIds.empty())
+            {
+                typeId = pool.nextTypeId++;
+            }
+            else
+            {
+                typeId = *pool.releasedTypeIds.begin();
+                pool.releasedTypeIds.erase(pool.releasedTypeIds.begin());
+            }
+
+            // note: the number of static types is bounded by the program, so
+            // their ids are never released. this also keeps the ids of static
+            // types stable for users that are not associated with a registry
+            m_pinnedTypeId = as<Descriptor<DynamicStruct>>() == nullptr;
+            m_typeId.store(typeId, std::memory_order_release);
+        }
+
+        return typeId;
+    }
+
+    void StructDescriptor::releaseTypeId() const
+    {
+        type_id_pool_t& pool = TypeIdPool();
+        std::lock_guard lock{ pool.mutex };
+
+        if (m_numRegistrations > 0 && --m_numRegistrations == 0 && !m_pinnedTypeId)
+        {
+            if (type_id_t typeId = m_typeId.load(std::memory_order_relaxed); typeId != NoTypeId)
+            {
+                pool.releasedTypeIds.emplace(typeId);
+                m_typeId.store(NoTypeId, std::memory_order_release);
+            }
+        }
+    }
 }
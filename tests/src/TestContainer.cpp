@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <algorithm>
 #include <dots/testing/gtest/gtest.h>
 #include <dots/Container.h>
 #include <DotsHeader.dots.h>
@@ -229,6 +230,108 @@ TEST(TestContainer, remove_RemoveWhenContained)
     ASSERT_LE(*cloneInfo.localUpdateTime, dots::timepoint_t::Now());
 }
 
+TEST(TestContainer, findOwned_YieldsInstancesLastUpdatedByPeer)
+{
+    dots::Container<DotsTestStruct> sut;
+
+    auto [header1, dts1] = test_helpers::make_instance(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 }, 42);
+    auto [header2, dts2] = test_helpers::make_instance(DotsTestStruct{ .stringField = "bar", .indKeyfField = 2 }, 42);
+    auto [header3, dts3] = test_helpers::make_instance(DotsTestStruct{ .stringField = "baz", .indKeyfField = 3 }, 21);
+    auto [header4, dts4] = test_helpers::make_instance(DotsTestStruct{ .stringField = "qux", .indKeyfField = 2 }, 21);
+    auto [header5, dts5] = test_helpers::make_instance(DotsTestStruct{ .indKeyfField = 1 }, 73, true);
+
+    const dots::type::Struct* instance1 = &sut.insert(header1, dts1).first.get();
+    sut.insert(header2, dts2);
+    const dots::type::Struct* instance3 = &sut.insert(header3, dts3).first.get();
+
+    EXPECT_EQ(sut.findOwned(42).size(), 2);
+    EXPECT_EQ(sut.findOwned(21), std::vector<const dots::type::Struct*>{ instance3 });
+
+    const dots::type::Struct* instance4 = &sut.insert(header4, dts4).first.get();
+
+    EXPECT_EQ(sut.findOwned(42), std::vector<const dots::type::Struct*>{ instance1 });
+    std::vector<const dots::type::Struct*> owned = sut.findOwned(21);
+    EXPECT_EQ(owned.size(), 2);
+    EXPECT_NE(std::find(owned.begin(), owned.end(), instance4), owned.end());
+
+    sut.remove(header5, dts5);
+
+    EXPECT_TRUE(sut.findOwned(42).empty());
+    EXPECT_TRUE(sut.findOwned(73).empty());
+    EXPECT_EQ(sut.findOwned(21).size(), 2);
+
+    sut.clear();
+
+    EXPECT_TRUE(sut.findOwned(21).empty());
+}
+
+TEST(TestContainer, referenceCount_CountsCreatorsAndLastUpdaters)
+{
+    auto peerReferences = std::make_shared<dots::Container<>::peer_references_t>();
+    std::vector<uint32_t> releasedPeers;
+    peerReferences->releaseHandler.emplace([&](uint32_t peerId){ releasedPeers.emplace_back(peerId); });
+
+    dots::Container<> sut1{ DotsTestStruct::_Descriptor(), peerReferences };
+    dots::Container<> sut2{ DotsTestStruct::_Descriptor(), peerReferences };
+
+    auto [header1, dts1] = test_helpers::make_instance(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 }, 42);
+    auto [header2, dts2] = test_helpers::make_instance(DotsTestStruct{ .stringField = "bar", .indKeyfField = 1 }, 21);
+    auto [header3, dts3] = test_helpers::make_instance(DotsTestStruct{ .stringField = "baz", .indKeyfField = 1 }, 73);
+    auto [header4, dts4] = test_helpers::make_instance(DotsTestStruct{ .indKeyfField = 1 }, 73, true);
+
+    sut1.insert(header1, dts1);
+    sut2.insert(header1, dts1);
+    sut1.insert(header2, dts2);
+
+    EXPECT_EQ(sut1.referenceCount(42), 2);
+    EXPECT_EQ(sut1.referenceCount(21), 1);
+    EXPECT_EQ(sut2.referenceCount(21), 1);
+
+    sut1.insert(header3, dts3);
+
+    EXPECT_EQ(sut1.referenceCount(42), 2);
+    EXPECT_EQ(sut1.referenceCount(21), 0);
+    EXPECT_EQ(sut1.referenceCount(73), 1);
+    EXPECT_EQ(releasedPeers, std::vector<uint32_t>{ 21 });
+
+    sut1.remove(header4, dts4);
+    sut2.clear();
+
+    EXPECT_EQ(sut1.referenceCount(42), 0);
+    EXPECT_EQ(sut1.referenceCount(73), 0);
+    EXPECT_EQ(releasedPeers, (std::vector<uint32_t>{ 21, 73, 42 }));
+}
+
+TEST(TestContainer, insert_OnlyStoreProjectedProperties)
+{
+    dots::Container<DotsTestStruct> sut;
+    sut.setProjection(DotsTestStruct::floatField_p);
+
+    EXPECT_EQ(sut.projection(), DotsTestStruct::indKeyfField_p + DotsTestStruct::floatField_p);
+
+    DotsTestStruct dts1{
+        .stringField = "foo",
+        .indKeyfField = 1,
+        .floatField = 3.1415f
+    };
+    DotsTestStruct dts2{
+        .stringField = "bar",
+        .indKeyfField = 1,
+        .floatField = 2.7183f
+    };
+
+    const auto& [created, createdCloneInfo] = sut.insert(test_helpers::make_header(dts1, 42), dts1);
+    (void)createdCloneInfo;
+
+    EXPECT_EQ(created->_validProperties(), DotsTestStruct::indKeyfField_p + DotsTestStruct::floatField_p);
+
+    const auto& [updated, updatedCloneInfo] = sut.insert(test_helpers::make_header(dts2, 42), dts2);
+    (void)updatedCloneInfo;
+
+    EXPECT_EQ(updated->_validProperties(), DotsTestStruct::indKeyfField_p + DotsTestStruct::floatField_p);
+    EXPECT_EQ(static_cast<const DotsTestStruct&>(*updated).floatField, 2.7183f);
+}
+
 TEST(TestContainer, begin_end_IterationYieldsExpectedInstances)
 {
     dots::Container<DotsTestStruct> sut;
@@ -294,3 +397,81 @@ TEST(TestContainer, forEach_IterationYieldsExpectedInstances)
         EXPECT_EQ(instance, *itExpected++);
     });
 }
+
+TEST(TestContainer, setStorage_ThrowWhenNotEmpty)
+{
+    dots::Container<DotsTestStruct> sut;
+    auto [header, dts] = test_helpers::make_instance(DotsTestStruct{ .indKeyfField = 1 }, 42);
+
+    EXPECT_NO_THROW(sut.setStorage(dots::Container<>::Storage::Hashed));
+    EXPECT_EQ(sut.storage(), dots::Container<>::Storage::Hashed);
+
+    sut.insert(header, dts);
+    EXPECT_THROW(sut.setStorage(dots::Container<>::Storage::Ordered), std::logic_error);
+}
+
+TEST(TestContainer, insert_remove_FindInstancesWhenUsingHashedStorage)
+{
+    constexpr int32_t NumInstances = 1000;
+
+    dots::Container<DotsTestStruct> sut;
+    sut.setStorage(dots::Container<>::Storage::Hashed);
+
+    for (int32_t i = 0; i < NumInstances; ++i)
+    {
+        auto [header, dts] = test_helpers::make_instance(DotsTestStruct{ .stringField = "foo", .indKeyfField = i }, 42);
+        ASSERT_EQ(sut.insert(header, dts).second.lastOperation, DotsMt::create);
+    }
+
+    auto [header1, dts1] = test_helpers::make_instance(DotsTestStruct{ .stringField = "bar", .indKeyfField = 7 }, 21);
+    const auto& [updated, cloneInfo] = sut.insert(header1, dts1);
+
+    EXPECT_EQ(sut.size(), static_cast<size_t>(NumInstances));
+    EXPECT_EQ(cloneInfo.lastOperation, DotsMt::update);
+    EXPECT_EQ(*updated.to<DotsTestStruct>().stringField, "bar");
+    EXPECT_EQ(sut.findOwned(21), std::vector<const dots::type::Struct*>{ &*updated });
+
+    for (int32_t i = 0; i < NumInstances; i += 2)
+    {
+        DotsTestStruct dts{ .indKeyfField = i };
+        ASSERT_FALSE(sut.remove(test_helpers::make_header(dts, 42, true), dts).empty());
+    }
+
+    EXPECT_EQ(sut.size(), static_cast<size_t>(NumInstances / 2));
+    EXPECT_EQ(sut.referenceCount(42), static_cast<size_t>(NumInstances / 2));
+
+    for (int32_t i = 0; i < NumInstances; ++i)
+    {
+        DotsTestStruct dts{ .indKeyfField = i };
+        EXPECT_EQ(sut.find(dts) != nullptr, i % 2 == 1);
+    }
+
+    EXPECT_EQ(std::distance(sut.begin(), sut.end()), NumInstances / 2);
+}
+
+TEST(TestContainer, orderedBegin_upperBound_IterationYieldsOrderedInstancesWhenUsingHashedStorage)
+{
+    dots::Container<DotsTestStruct> sut;
+    sut.setStorage(dots::Container<>::Storage::Hashed);
+
+    for (int32_t i : { 5, 3, 9, 1, 7 })
+    {
+        auto [header, dts] = test_helpers::make_instance(DotsTestStruct{ .indKeyfField = i }, 42);
+        sut.insert(header, dts);
+    }
+
+    std::vector<int32_t> keys;
+
+    for (auto it = sut.orderedBegin(); it != sut.orderedEnd(); ++it)
+    {
+        keys.emplace_back(*it->first.to<DotsTestStruct>().indKeyfField);
+    }
+
+    EXPECT_EQ(keys, (std::vector<int32_t>{ 1, 3, 5, 7, 9 }));
+
+    auto it = sut.upperBound(DotsTestStruct{ .indKeyfField = 4 });
+    ASSERT_NE(it, sut.orderedEnd());
+    EXPECT_EQ(*it->first.to<DotsTestStruct>().indKeyfField, 5);
+
+    EXPECT_EQ(sut.upperBound(DotsTestStruct{ .indKeyfField = 9 }), sut.orderedEnd());
+}
@@ -1,8 +1,13 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #include <dots/testing/gtest/gtest.h>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
 #include <dots/Dispatcher.h>
 #include <DotsHeader.dots.h>
+#include <DotsPersistentTestType.dots.h>
 #include <DotsTestStruct.dots.h>
 #include <DotsUncachedTestStruct.dots.h>
 
@@ -693,6 +698,34 @@ TEST_F(TestDispatcher, dispatch_RemoveOtherEventHandlerDuringDispatch)
     ASSERT_EQ(i, 4);
 }
 
+TEST_F(TestDispatcher, dispatch_AddEventHandlerDuringDispatch)
+{
+    DotsTestStruct dts{ .indKeyfField = 1 };
+    DotsHeader header = test_helpers::make_header(dts, 42);
+
+    size_t i = 0;
+    size_t j = 0;
+
+    m_sut.addEventHandler<DotsTestStruct>([&](const dots::Event<DotsTestStruct>&/* e*/)
+    {
+        if (++i == 1)
+        {
+            m_sut.addEventHandler<DotsTestStruct>([&](const dots::Event<DotsTestStruct>&/* e*/)
+            {
+                ++j;
+            });
+        }
+    });
+
+    m_sut.dispatch(dots::Transmission{ header, dts });
+    ASSERT_EQ(i, 1);
+    ASSERT_EQ(j, 1);
+
+    m_sut.dispatch(dots::Transmission{ header, dts });
+    ASSERT_EQ(i, 2);
+    ASSERT_EQ(j, 2);
+}
+
 TEST_F(TestDispatcher, dispatch_ExecptionInvokesErrorHandler)
 {
     DotsTestStruct dts{ .indKeyfField = 1 };
@@ -737,3 +770,203 @@ TEST_F(TestDispatcher, moveCtor_CreateEventAfterMoveContructWhenAddedHandlerForC
 
     ASSERT_EQ(i, 1);
 }
+
+TEST_F(TestDispatcher, dispatch_CreateEventsInOrderOnWorkerThreadWhenWorkerThreadsAreUsed)
+{
+    m_sut.setWorkerThreads(2);
+
+    std::promise<void> handled;
+    std::vector<int32_t> keys;
+    std::thread::id handlerThread;
+
+    dots::Dispatcher::id_t id = m_sut.addEventHandler<DotsTestStruct>([&](const dots::Event<DotsTestStruct>& e)
+    {
+        ASSERT_TRUE(e.isCreate());
+        keys.emplace_back(*e.updated().indKeyfField);
+        handlerThread = std::this_thread::get_id();
+
+        if (keys.size() == 10)
+        {
+            handled.set_value();
+        }
+    });
+    (void)id;
+
+    for (int32_t j = 0; j < 10; ++j)
+    {
+        DotsTestStruct dts{ .indKeyfField = j };
+        m_sut.dispatch(dots::Transmission{ test_helpers::make_header(dts, 42), dts });
+    }
+
+    ASSERT_EQ(handled.get_future().wait_for(std::chrono::seconds{ 5 }), std::future_status::ready);
+    EXPECT_EQ(keys, (std::vector<int32_t>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+    EXPECT_NE(handlerThread, std::this_thread::get_id());
+}
+
+TEST_F(TestDispatcher, dispatch_DoNotBlockOtherTypesWhileEventHandlerIsBusyOnWorkerThread)
+{
+    m_sut.setWorkerThreads(2);
+
+    std::promise<void> proceed;
+    std::shared_future<void> proceeding = proceed.get_future().share();
+    std::promise<void> handledUncached;
+    std::promise<void> handledPersistent;
+
+    dots::Dispatcher::id_t id1 = m_sut.addEventHandler<DotsTestStruct>([&](const dots::Event<DotsTestStruct>&/* e*/)
+    {
+        proceeding.wait();
+    });
+    dots::Dispatcher::id_t id2 = m_sut.addEventHandler<DotsUncachedTestStruct>([&](const dots::Event<DotsUncachedTestStruct>&/* e*/)
+    {
+        handledUncached.set_value();
+    });
+    dots::Dispatcher::id_t id3 = m_sut.addEventHandler<DotsPersistentTestType>([&](const dots::Event<DotsPersistentTestType>&/* e*/)
+    {
+        handledPersistent.set_value();
+    });
+    (void)id1;
+    (void)id2;
+    (void)id3;
+
+    // note: the handlers of the other types are invoked by any idle worker
+    // thread, regardless of the order in which the types were added
+    DotsTestStruct dts{ .indKeyfField = 0 };
+    DotsUncachedTestStruct duts{ .intKeyfField = 0 };
+    DotsPersistentTestType dptt{ .name = "foo" };
+    m_sut.dispatch(dots::Transmission{ test_helpers::make_header(dts, 42), dts });
+    m_sut.dispatch(dots::Transmission{ test_helpers::make_header(duts, 42), duts });
+    m_sut.dispatch(dots::Transmission{ test_helpers::make_header(dptt, 42), dptt });
+
+    EXPECT_EQ(handledUncached.get_future().wait_for(std::chrono::seconds{ 5 }), std::future_status::ready);
+    EXPECT_EQ(handledPersistent.get_future().wait_for(std::chrono::seconds{ 5 }), std::future_status::ready);
+    proceed.set_value();
+}
+
+TEST_F(TestDispatcher, dispatch_ShareTransmittedInstanceWithWorkerThread)
+{
+    m_sut.setWorkerThreads(1);
+
+    std::promise<const dots::type::Struct*> handled;
+
+    dots::Dispatcher::id_t id = m_sut.addEventHandler<DotsUncachedTestStruct>([&](const dots::Event<DotsUncachedTestStruct>& e)
+    {
+        EXPECT_EQ(&e.transmitted(), &e.updated());
+        handled.set_value(&e.transmitted());
+    });
+    (void)id;
+
+    DotsUncachedTestStruct duts{ .intKeyfField = 1, .value = "foo" };
+    dots::Transmission transmission{ test_helpers::make_header(duts, 42), duts };
+    m_sut.dispatch(transmission);
+
+    std::future<const dots::type::Struct*> transmitted = handled.get_future();
+    ASSERT_EQ(transmitted.wait_for(std::chrono::seconds{ 5 }), std::future_status::ready);
+    EXPECT_EQ(transmitted.get(), &*transmission.instance());
+}
+
+TEST_F(TestDispatcher, removeEventHandler_WaitForConcurrentInvocationOnWorkerThread)
+{
+    m_sut.setWorkerThreads(1);
+
+    std::promise<void> invoked;
+    std::promise<void> proceed;
+    std::shared_future<void> proceeding = proceed.get_future().share();
+    std::promise<void> handled;
+    std::atomic<bool> removed = false;
+    std::atomic<size_t> numInvocations = 0;
+    std::atomic<size_t> numInvocationsAfterRemoval = 0;
+
+    dots::Dispatcher::id_t id = m_sut.addEventHandler<DotsTestStruct>([&](const dots::Event<DotsTestStruct>&/* e*/)
+    {
+        if (++numInvocations == 1)
+        {
+            invoked.set_value();
+            proceeding.wait();
+        }
+
+        if (removed)
+        {
+            ++numInvocationsAfterRemoval;
+        }
+    });
+
+    dots::Dispatcher::id_t id2 = m_sut.addEventHandler<DotsTestStruct>([&](const dots::Event<DotsTestStruct>& e)
+    {
+        if (*e.updated().indKeyfField == 2)
+        {
+            handled.set_value();
+        }
+    });
+    (void)id2;
+
+    DotsTestStruct dts1{ .indKeyfField = 0 };
+    DotsTestStruct dts2{ .indKeyfField = 1 };
+    m_sut.dispatch(dots::Transmission{ test_helpers::make_header(dts1, 42), dts1 });
+    m_sut.dispatch(dots::Transmission{ test_helpers::make_header(dts2, 42), dts2 });
+    ASSERT_EQ(invoked.get_future().wait_for(std::chrono::seconds{ 5 }), std::future_status::ready);
+
+    // note: the handler is still being invoked while it is removed, so the
+    // removal only returns after the invocation has completed
+    std::thread releaser{ [&]
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+        proceed.set_value();
+    } };
+
+    m_sut.removeEventHandler(DotsTestStruct::_Descriptor(), id);
+    removed = true;
+    releaser.join();
+
+    DotsTestStruct dts3{ .indKeyfField = 2 };
+    m_sut.dispatch(dots::Transmission{ test_helpers::make_header(dts3, 42), dts3 });
+
+    ASSERT_EQ(handled.get_future().wait_for(std::chrono::seconds{ 5 }), std::future_status::ready);
+    EXPECT_EQ(numInvocations.load(), 1u);
+    EXPECT_EQ(numInvocationsAfterRemoval.load(), 0u);
+}
+
+TEST_F(TestDispatcher, removeEventHandler_RemoveCurrentEventHandlerOnWorkerThread)
+{
+    m_sut.setWorkerThreads(1);
+
+    std::promise<void> handled;
+    size_t numInvocations = 0;
+    dots::Dispatcher::id_t id = 0;
+
+    id = m_sut.addEventHandler<DotsTestStruct>([&](const dots::Event<DotsTestStruct>&/* e*/)
+    {
+        ++numInvocations;
+        m_sut.removeEventHandler(DotsTestStruct::_Descriptor(), id);
+    });
+
+    dots::Dispatcher::id_t id2 = m_sut.addEventHandler<DotsTestStruct>([&](const dots::Event<DotsTestStruct>& e)
+    {
+        if (*e.updated().indKeyfField == 1)
+        {
+            handled.set_value();
+        }
+    });
+    (void)id2;
+
+    for (int32_t j = 0; j < 2; ++j)
+    {
+        DotsTestStruct dts{ .indKeyfField = j };
+        m_sut.dispatch(dots::Transmission{ test_helpers::make_header(dts, 42), dts });
+    }
+
+    ASSERT_EQ(handled.get_future().wait_for(std::chrono::seconds{ 5 }), std::future_status::ready);
+    EXPECT_EQ(numInvocations, 1u);
+}
+
+TEST_F(TestDispatcher, setWorkerThreads_ThrowWhenEventHandlersAreRegistered)
+{
+    dots::Dispatcher::id_t id = m_sut.addEventHandler<DotsTestStruct>([](const dots::Event<DotsTestStruct>&/* e*/)
+    {
+        /* do nothing */
+    });
+
+    EXPECT_THROW(m_sut.setWorkerThreads(2), std::logic_error);
+
+    m_sut.removeEventHandler(DotsTestStruct::_Descriptor(), id);
+    EXPECT_NO_THROW(m_sut.setWorkerThreads(2));
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/testing/gtest/gtest.h>
+#include <dots/Filter.h>
+#include <DotsTestStruct.dots.h>
+
+namespace
+{
+    namespace test_helpers
+    {
+        dots::Filter make_filter(std::string propertyName, DotsFilterComparison comparison, dots::vector_t<dots::string_t> values)
+        {
+            return dots::Filter{ DotsTestStruct::_Descriptor(), {
+                DotsFilterCondition{
+                    .propertyName = std::move(propertyName),
+                    .comparison = comparison,
+                    .values = std::move(values)
+                }
+            } };
+        }
+    }
+}
+
+TEST(TestFilter, ctor_ThrowOnUnknownProperty)
+{
+    EXPECT_THROW(test_helpers::make_filter("unknownField", DotsFilterComparison::equal, { "1" }), std::runtime_error);
+}
+
+TEST(TestFilter, ctor_ThrowOnInvalidAmountOfValues)
+{
+    EXPECT_THROW(test_helpers::make_filter("indKeyfField", DotsFilterComparison::equal, {}), std::runtime_error);
+    EXPECT_THROW(test_helpers::make_filter("indKeyfField", DotsFilterComparison::less, { "1", "2" }), std::runtime_error);
+    EXPECT_NO_THROW(test_helpers::make_filter("indKeyfField", DotsFilterComparison::oneOf, { "1", "2" }));
+}
+
+TEST(TestFilter, ctor_ThrowOnInvalidValue)
+{
+    EXPECT_THROW(test_helpers::make_filter("indKeyfField", DotsFilterComparison::equal, { "foo" }), std::runtime_error);
+}
+
+TEST(TestFilter, properties_ContainsPropertiesOfAllConditions)
+{
+    dots::Filter sut{ DotsTestStruct::_Descriptor(), {
+        DotsFilterCondition{ .propertyName = "indKeyfField", .comparison = DotsFilterComparison::greaterEqual, .values = dots::vector_t<dots::string_t>{ "1" } },
+        DotsFilterCondition{ .propertyName = "stringField", .comparison = DotsFilterComparison::equal, .values = dots::vector_t<dots::string_t>{ "foo" } }
+    } };
+
+    EXPECT_EQ(sut.properties(), DotsTestStruct::indKeyfField_p + DotsTestStruct::stringField_p);
+}
+
+TEST(TestFilter, matches_EvaluateEquality)
+{
+    dots::Filter sutEqual = test_helpers::make_filter("stringField", DotsFilterComparison::equal, { "foo" });
+    dots::Filter sutNotEqual = test_helpers::make_filter("stringField", DotsFilterComparison::notEqual, { "foo" });
+
+    EXPECT_TRUE(sutEqual.matches(DotsTestStruct{ .stringField = "foo" }));
+    EXPECT_FALSE(sutEqual.matches(DotsTestStruct{ .stringField = "bar" }));
+    EXPECT_FALSE(sutNotEqual.matches(DotsTestStruct{ .stringField = "foo" }));
+    EXPECT_TRUE(sutNotEqual.matches(DotsTestStruct{ .stringField = "bar" }));
+}
+
+TEST(TestFilter, matches_EvaluateRange)
+{
+    dots::Filter sut{ DotsTestStruct::_Descriptor(), {
+        DotsFilterCondition{ .propertyName = "indKeyfField", .comparison = DotsFilterComparison::greaterEqual, .values = dots::vector_t<dots::string_t>{ "10" } },
+        DotsFilterCondition{ .propertyName = "indKeyfField", .comparison = DotsFilterComparison::less, .values = dots::vector_t<dots::string_t>{ "20" } }
+    } };
+
+    EXPECT_FALSE(sut.matches(DotsTestStruct{ .indKeyfField = 9 }));
+    EXPECT_TRUE(sut.matches(DotsTestStruct{ .indKeyfField = 10 }));
+    EXPECT_TRUE(sut.matches(DotsTestStruct{ .indKeyfField = 19 }));
+    EXPECT_FALSE(sut.matches(DotsTestStruct{ .indKeyfField = 20 }));
+}
+
+TEST(TestFilter, matches_EvaluateSetMembership)
+{
+    dots::Filter sutOneOf = test_helpers::make_filter("indKeyfField", DotsFilterComparison::oneOf, { "1", "3" });
+    dots::Filter sutNoneOf = test_helpers::make_filter("indKeyfField", DotsFilterComparison::noneOf, { "1", "3" });
+
+    EXPECT_TRUE(sutOneOf.matches(DotsTestStruct{ .indKeyfField = 1 }));
+    EXPECT_FALSE(sutOneOf.matches(DotsTestStruct{ .indKeyfField = 2 }));
+    EXPECT_TRUE(sutOneOf.matches(DotsTestStruct{ .indKeyfField = 3 }));
+    EXPECT_FALSE(sutNoneOf.matches(DotsTestStruct{ .indKeyfField = 1 }));
+    EXPECT_TRUE(sutNoneOf.matches(DotsTestStruct{ .indKeyfField = 2 }));
+}
+
+TEST(TestFilter, matches_FalseForInvalidProperty)
+{
+    dots::Filter sut = test_helpers::make_filter("stringField", DotsFilterComparison::notEqual, { "foo" });
+
+    EXPECT_FALSE(sut.matches(DotsTestStruct{ .indKeyfField = 1 }));
+}
@@ -1,8 +1,16 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <chrono>
+#include <cstdio>
 #include <sstream>
+#include <stdexcept>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 #include <dots/testing/gtest/EventTestBase.h>
+#include <dots/HostTransceiver.h>
+#include <dots/io/channels/UdsListener.h>
 #include <DotsTestStruct.dots.h>
 
 struct TestGuestTransceiver : dots::testing::EventTestBase
@@ -10,7 +18,63 @@ struct TestGuestTransceiver : dots::testing::EventTestBase
 
 protected:
 
+    static constexpr std::string_view ResyncHostPath = "/tmp/dots-test-guest-transceiver.sock";
+
+    struct resync_event_t
+    {
+        dots::int32_t indKeyfField;
+        bool remove;
+        dots::property_set_t updatedProperties;
+    };
+
+    // note: the host of the test base cannot be restarted, so a separate
+    // host is used to drop the connection of the guest and to change the
+    // instances while the guest is disconnected
+    dots::HostTransceiver& restartResyncHost()
+    {
+        m_resyncHost.reset();
+        std::remove(ResyncHostPath.data());
+        m_resyncHost.emplace("dots-resync-host", ioContext());
+        m_resyncHost->listen<dots::io::posix::UdsListener>(ResyncHostPath);
+
+        return *m_resyncHost;
+    }
+
+    dots::GuestTransceiver& resyncGuest()
+    {
+        if (m_resyncGuest == std::nullopt)
+        {
+            m_resyncGuest.emplace("dots-resync-guest", ioContext());
+            m_resyncGuest->setReconnect(true, std::chrono::milliseconds{ 10 });
+            m_resyncGuest->asyncOpen(dots::io::Endpoint{ "uds:" + std::string{ ResyncHostPath } });
+            m_resyncSubscription.emplace(m_resyncGuest->subscribe<DotsTestStruct>([this](const dots::Event<DotsTestStruct>& event)
+            {
+                m_resyncEvents.emplace_back(resync_event_t{ *event().indKeyfField, event.isRemove(), event.updatedProperties() });
+            }));
+            processEvents(std::chrono::milliseconds{ 50 });
+        }
+
+        return *m_resyncGuest;
+    }
+
+    void reconnectResyncGuest(const std::vector<DotsTestStruct>& instances)
+    {
+        m_resyncEvents.clear();
+        dots::HostTransceiver& host = restartResyncHost();
+
+        for (const DotsTestStruct& instance : instances)
+        {
+            host.publish(instance);
+        }
+
+        processEvents(std::chrono::milliseconds{ 200 });
+    }
+
     std::optional<dots::Subscription> m_testStructSubscription;
+    std::optional<dots::HostTransceiver> m_resyncHost;
+    std::optional<dots::GuestTransceiver> m_resyncGuest;
+    std::optional<dots::Subscription> m_resyncSubscription;
+    std::vector<resync_event_t> m_resyncEvents;
 };
 
 TEST_F(TestGuestTransceiver, IncrementPropertyOfCachedTypeOnSelfUpdate)
@@ -144,3 +208,113 @@ TEST_F(TestGuestTransceiver, PublishPartialInstanceWhenPropertiesAreGiven)
 
     processEvents();
 }
+
+TEST_F(TestGuestTransceiver, PublishRangeOfInstances)
+{
+    std::vector<DotsTestStruct> instances{
+        DotsTestStruct{ .indKeyfField = 1, .int64Field = 1 },
+        DotsTestStruct{ .indKeyfField = 2, .int64Field = 2 },
+        DotsTestStruct{ .stringField = "foo", .indKeyfField = 3 }
+    };
+
+    DOTS_EXPECTATION_SEQUENCE(
+        [&]
+        {
+            globalGuest().publish(instances);
+        },
+        EXPECT_DOTS_PUBLISH(instances[0]),
+        EXPECT_DOTS_PUBLISH(instances[1]),
+        EXPECT_DOTS_PUBLISH(instances[2]),
+        [&]
+        {
+            globalGuest().publish(instances, DotsTestStruct::int64Field_p);
+        },
+        EXPECT_DOTS_PUBLISH(instances[0], DotsTestStruct::indKeyfField_p + DotsTestStruct::int64Field_p),
+        EXPECT_DOTS_PUBLISH(instances[1], DotsTestStruct::indKeyfField_p + DotsTestStruct::int64Field_p),
+        EXPECT_DOTS_PUBLISH(instances[2], DotsTestStruct::indKeyfField_p + DotsTestStruct::int64Field_p)
+    );
+
+    processEvents();
+}
+
+TEST_F(TestGuestTransceiver, PostPublishRemainingInstancesAfterInvalidSubmission)
+{
+    DOTS_EXPECTATION_SEQUENCE(
+        [&]
+        {
+            globalGuest().postPublish(DotsTestStruct{ .indKeyfField = 1, .int64Field = 1 });
+            EXPECT_THROW(globalGuest().postPublish(DotsTestStruct{ .int64Field = 2 }), std::runtime_error);
+            globalGuest().postPublish(DotsTestStruct{ .indKeyfField = 3, .int64Field = 3 });
+        },
+        EXPECT_DOTS_PUBLISH(DotsTestStruct{ .indKeyfField = 1, .int64Field = 1 }),
+        EXPECT_DOTS_PUBLISH(DotsTestStruct{ .indKeyfField = 3, .int64Field = 3 })
+    );
+
+    processEvents();
+}
+
+TEST_F(TestGuestTransceiver, ResyncChangedInstancesAfterReconnectingToHost)
+{
+    dots::HostTransceiver& host = restartResyncHost();
+    host.publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1, .floatField = 1.0f });
+    dots::GuestTransceiver& guest = resyncGuest();
+    ASSERT_EQ(m_resyncEvents.size(), 1u);
+
+    reconnectResyncGuest({
+        DotsTestStruct{ .stringField = "foo", .indKeyfField = 1, .floatField = 2.0f },
+        DotsTestStruct{ .stringField = "bar", .indKeyfField = 2 }
+    });
+
+    EXPECT_TRUE(guest.connected());
+    ASSERT_EQ(m_resyncEvents.size(), 2u);
+    EXPECT_EQ(m_resyncEvents[0].indKeyfField, 1);
+    EXPECT_FALSE(m_resyncEvents[0].remove);
+    EXPECT_EQ(m_resyncEvents[0].updatedProperties, DotsTestStruct::indKeyfField_p + DotsTestStruct::floatField_p);
+    EXPECT_EQ(m_resyncEvents[1].indKeyfField, 2);
+    EXPECT_FALSE(m_resyncEvents[1].remove);
+
+    const DotsTestStruct* instance = guest.container<DotsTestStruct>().find(DotsTestStruct{ .indKeyfField = 1 });
+    ASSERT_NE(instance, nullptr);
+    EXPECT_EQ(instance->stringField, "foo");
+    EXPECT_EQ(instance->floatField, 2.0f);
+}
+
+TEST_F(TestGuestTransceiver, ResyncRemovesInstancesThatWereRemovedWhileDisconnected)
+{
+    dots::HostTransceiver& host = restartResyncHost();
+    host.publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 });
+    host.publish(DotsTestStruct{ .stringField = "bar", .indKeyfField = 2 });
+    dots::GuestTransceiver& guest = resyncGuest();
+    ASSERT_EQ(m_resyncEvents.size(), 2u);
+
+    reconnectResyncGuest({
+        DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 }
+    });
+
+    EXPECT_TRUE(guest.connected());
+    ASSERT_EQ(m_resyncEvents.size(), 1u);
+    EXPECT_EQ(m_resyncEvents[0].indKeyfField, 2);
+    EXPECT_TRUE(m_resyncEvents[0].remove);
+
+    EXPECT_EQ(guest.container<DotsTestStruct>().size(), 1u);
+    EXPECT_EQ(guest.container<DotsTestStruct>().find(DotsTestStruct{ .indKeyfField = 2 }), nullptr);
+}
+
+TEST_F(TestGuestTransceiver, ResyncDoesNotDispatchUnchangedInstances)
+{
+    dots::HostTransceiver& host = restartResyncHost();
+    host.publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1, .floatField = 1.0f });
+    dots::GuestTransceiver& guest = resyncGuest();
+    ASSERT_EQ(m_resyncEvents.size(), 1u);
+
+    reconnectResyncGuest({
+        DotsTestStruct{ .stringField = "foo", .indKeyfField = 1, .floatField = 1.0f }
+    });
+
+    EXPECT_TRUE(guest.connected());
+    EXPECT_TRUE(m_resyncEvents.empty());
+
+    const DotsTestStruct* instance = guest.container<DotsTestStruct>().find(DotsTestStruct{ .indKeyfField = 1 });
+    ASSERT_NE(instance, nullptr);
+    EXPECT_EQ(instance->floatField, 1.0f);
+}
@@ -1,12 +1,81 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <chrono>
+#include <cstdio>
+#include <map>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <dots/testing/gtest/gtest.h>
 #include <dots/testing/gtest/EventTestBase.h>
 #include <dots/HostTransceiver.h>
+#include <dots/io/channels/UdsChannel.h>
+#include <dots/io/channels/UdsListener.h>
+#include <DotsTestStruct.dots.h>
+#include <DotsTypeStatistics.dots.h>
 
 struct TestHostTransceiver : dots::testing::EventTestBase
 {
+protected:
+
+    static constexpr std::string_view StreamGuestPath = "/tmp/dots-test-host-transceiver.sock";
+    static constexpr std::string_view StreamGuestName = "dots-stream-guest";
+
+    // note: guests that are connected via a local channel do not have a
+    // write queue and always receive decoded transmissions, so stream
+    // channels are used to observe the write queue of the host and the
+    // forwarding of undecoded transmissions
+    dots::GuestTransceiver& streamGuest(std::string_view name = StreamGuestName)
+    {
+        if (auto it = m_streamGuests.find(name); it != m_streamGuests.end())
+        {
+            return it->second;
+        }
+
+        if (m_streamGuests.empty())
+        {
+            std::remove(StreamGuestPath.data());
+            host().listen<dots::io::posix::UdsListener>(StreamGuestPath);
+        }
+
+        dots::GuestTransceiver& streamGuest = m_streamGuests.try_emplace(std::string{ name }, std::string{ name }, ioContext()).first->second;
+        streamGuest.open<dots::io::posix::UdsChannel>(StreamGuestPath);
+        processEvents(std::chrono::milliseconds{ 50 });
+
+        return streamGuest;
+    }
+
+    const dots::Connection* streamGuestConnection(std::string_view name = StreamGuestName) const
+    {
+        for (const dots::Connection* connection : host().guestConnections())
+        {
+            if (connection->peerName() == name)
+            {
+                return connection;
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::optional<DotsTypeStatistics> typeStatistics(std::string_view typeName) const
+    {
+        for (DotsTypeStatistics& statistics : host().typeStatistics())
+        {
+            if (statistics.typeName == typeName)
+            {
+                return std::move(statistics);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+private:
+
+    std::map<std::string, dots::GuestTransceiver, std::less<>> m_streamGuests;
 };
 
 TEST_F(TestHostTransceiver, HandleEchoRequest)
@@ -47,3 +116,588 @@ TEST_F(TestHostTransceiver, HandleEchoRequest)
 
     processEvents();
 }
+
+TEST_F(TestHostTransceiver, FilteredGroupOnlyReceivesMatchingInstances)
+{
+    globalGuest().setFilter<DotsTestStruct>({
+        DotsFilterCondition{ .propertyName = "stringField", .comparison = DotsFilterComparison::oneOf, .values = dots::vector_t<dots::string_t>{ "foo", "baz" } }
+    });
+
+    host().publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 });
+    host().publish(DotsTestStruct{ .stringField = "bar", .indKeyfField = 2 });
+    processEvents();
+
+    dots::Subscription subscription = dots::subscribe<DotsTestStruct>([](const dots::Event<DotsTestStruct>&){});
+    processEvents();
+
+    const dots::Container<DotsTestStruct>& container = globalGuest().container<DotsTestStruct>();
+    EXPECT_EQ(container.size(), 1u);
+    EXPECT_NE(container.find(DotsTestStruct{ .indKeyfField = 1 }), nullptr);
+
+    // instance starts matching
+    host().publish(DotsTestStruct{ .indKeyfField = 2, .floatField = 1.0f });
+    host().publish(DotsTestStruct{ .stringField = "baz", .indKeyfField = 2 });
+    processEvents();
+
+    ASSERT_NE(container.find(DotsTestStruct{ .indKeyfField = 2 }), nullptr);
+    EXPECT_EQ(container.find(DotsTestStruct{ .indKeyfField = 2 })->floatField, 1.0f);
+
+    // instance stops matching
+    host().publish(DotsTestStruct{ .stringField = "bar", .indKeyfField = 1 });
+    processEvents();
+
+    EXPECT_EQ(container.find(DotsTestStruct{ .indKeyfField = 1 }), nullptr);
+    EXPECT_EQ(container.size(), 1u);
+}
+
+TEST_F(TestHostTransceiver, ProjectedGroupOnlyReceivesProjectedProperties)
+{
+    globalGuest().setProjection<DotsTestStruct>(DotsTestStruct::floatField_p);
+
+    host().publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1, .floatField = 1.0f });
+    processEvents();
+
+    size_t numEvents = 0;
+    dots::Subscription subscription = dots::subscribe<DotsTestStruct>([&](const dots::Event<DotsTestStruct>&){ ++numEvents; });
+    processEvents();
+
+    const dots::Container<DotsTestStruct>& container = globalGuest().container<DotsTestStruct>();
+    ASSERT_NE(container.find(DotsTestStruct{ .indKeyfField = 1 }), nullptr);
+    EXPECT_EQ(container.find(DotsTestStruct{ .indKeyfField = 1 })->_validProperties(), DotsTestStruct::indKeyfField_p + DotsTestStruct::floatField_p);
+    EXPECT_EQ(numEvents, 1u);
+
+    // update without projected properties is omitted
+    host().publish(DotsTestStruct{ .stringField = "bar", .indKeyfField = 1 });
+    processEvents();
+
+    EXPECT_EQ(numEvents, 1u);
+
+    // creation without projected properties is transmitted
+    host().publish(DotsTestStruct{ .stringField = "baz", .indKeyfField = 2 });
+    processEvents();
+
+    EXPECT_EQ(numEvents, 2u);
+    ASSERT_NE(container.find(DotsTestStruct{ .indKeyfField = 2 }), nullptr);
+    EXPECT_EQ(container.find(DotsTestStruct{ .indKeyfField = 2 })->_validProperties(), DotsTestStruct::indKeyfField_p);
+}
+
+TEST_F(TestHostTransceiver, FilteredSnapshotEndsWithLastMatchingInstance)
+{
+    globalGuest().setFilter<DotsTestStruct>({
+        DotsFilterCondition{ .propertyName = "stringField", .comparison = DotsFilterComparison::oneOf, .values = dots::vector_t<dots::string_t>{ "foo" } }
+    });
+
+    host().publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 });
+    host().publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = 2 });
+    host().publish(DotsTestStruct{ .stringField = "bar", .indKeyfField = 3 });
+    processEvents();
+
+    std::vector<std::pair<int32_t, uint32_t>> received;
+    dots::Subscription subscription = dots::subscribe<DotsTestStruct>([&](const dots::Event<DotsTestStruct>& event)
+    {
+        received.emplace_back(*event().indKeyfField, *event.header().fromCache);
+    });
+    processEvents();
+
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(received[0].first, 1);
+    EXPECT_NE(received[0].second, 0u);
+    EXPECT_EQ(received[1].first, 2);
+    EXPECT_EQ(received[1].second, 0u);
+}
+
+TEST_F(TestHostTransceiver, LiveUpdatesDuringChunkedSnapshotAreNotReordered)
+{
+    // note: the amount of instances has to exceed the snapshot chunk size
+    constexpr int32_t NumInstances = 2500;
+
+    for (int32_t i = 0; i < NumInstances; ++i)
+    {
+        host().publish(DotsTestStruct{ .indKeyfField = i, .floatField = 0.0f });
+    }
+
+    processEvents();
+
+    std::map<int32_t, std::vector<float>> received;
+    dots::Subscription subscription = dots::subscribe<DotsTestStruct>([&](const dots::Event<DotsTestStruct>& event)
+    {
+        received[*event().indKeyfField].emplace_back(*event().floatField);
+    });
+
+    while (received.empty())
+    {
+        ioContext().run_one();
+    }
+
+    ASSERT_LT(received.size(), static_cast<size_t>(NumInstances));
+
+    // note: the first instance has already been transmitted as part of the
+    // snapshot, while the last instance is still pending
+    host().publish(DotsTestStruct{ .indKeyfField = 0, .floatField = 1.0f });
+    host().publish(DotsTestStruct{ .indKeyfField = NumInstances - 1, .floatField = 1.0f });
+    processEvents();
+
+    ASSERT_EQ(received.size(), static_cast<size_t>(NumInstances));
+    EXPECT_EQ(received[0], (std::vector<float>{ 0.0f, 1.0f }));
+    EXPECT_EQ(received[NumInstances - 1], (std::vector<float>{ 1.0f }));
+
+    for (int32_t i = 1; i < NumInstances - 1; ++i)
+    {
+        EXPECT_EQ(received[i], (std::vector<float>{ 0.0f })) << "indKeyfField: " << i;
+    }
+
+    const DotsTestStruct* instance = globalGuest().container<DotsTestStruct>().find(DotsTestStruct{ .indKeyfField = 0 });
+    ASSERT_NE(instance, nullptr);
+    EXPECT_EQ(instance->floatField, 1.0f);
+}
+
+TEST_F(TestHostTransceiver, DeltaUpdatesOnlyContainChangedProperties)
+{
+    host().setDeltaUpdates(true);
+
+    std::vector<dots::property_set_t> updatedProperties;
+    dots::Subscription subscription = dots::subscribe<DotsTestStruct>([&](const dots::Event<DotsTestStruct>& event){ updatedProperties.emplace_back(event.updatedProperties()); });
+    processEvents();
+
+    dots::publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1, .floatField = 1.0f });
+    processEvents();
+
+    // update without changes is not distributed
+    dots::publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1, .floatField = 1.0f });
+    processEvents();
+
+    // update is reduced to changed properties
+    dots::publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1, .floatField = 2.0f });
+    processEvents();
+
+    ASSERT_EQ(updatedProperties.size(), 2u);
+    EXPECT_EQ(updatedProperties[0], DotsTestStruct::stringField_p + DotsTestStruct::indKeyfField_p + DotsTestStruct::floatField_p);
+    EXPECT_EQ(updatedProperties[1], DotsTestStruct::indKeyfField_p + DotsTestStruct::floatField_p);
+
+    const dots::Container<DotsTestStruct>& container = globalGuest().container<DotsTestStruct>();
+    ASSERT_NE(container.find(DotsTestStruct{ .indKeyfField = 1 }), nullptr);
+    EXPECT_EQ(container.find(DotsTestStruct{ .indKeyfField = 1 })->stringField, "foo");
+    EXPECT_EQ(container.find(DotsTestStruct{ .indKeyfField = 1 })->floatField, 2.0f);
+}
+
+TEST_F(TestHostTransceiver, DeltaUpdatesWithoutChangesAreDispatchedLocally)
+{
+    host().setDeltaUpdates(true);
+
+    size_t numHostEvents = 0;
+    dots::Subscription hostSubscription = host().subscribe<DotsTestStruct>([&](const dots::Event<DotsTestStruct>&){ ++numHostEvents; });
+
+    size_t numGuestEvents = 0;
+    dots::Subscription guestSubscription = dots::subscribe<DotsTestStruct>([&](const dots::Event<DotsTestStruct>&){ ++numGuestEvents; });
+    processEvents();
+
+    dots::publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 });
+    processEvents();
+
+    dots::publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 });
+    processEvents();
+
+    EXPECT_EQ(numHostEvents, 2u);
+    EXPECT_EQ(numGuestEvents, 1u);
+}
+
+TEST_F(TestHostTransceiver, MulticastGroupReceivesEachInstanceOnce)
+{
+    host().setMulticast(DotsUncachedTestStruct::_Name, dots::io::Endpoint{ "udp://239.255.0.1:11240" }, "127.0.0.1");
+    globalGuest().setMulticast(true, "127.0.0.1");
+
+    std::vector<int32_t> received;
+    dots::Subscription subscription = dots::subscribe<DotsUncachedTestStruct>([&](const dots::Event<DotsUncachedTestStruct>& event){ received.emplace_back(*event().intKeyfField); });
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    for (int32_t i = 1; i <= 3; ++i)
+    {
+        dots::publish(DotsUncachedTestStruct{ .intKeyfField = i, .value = "foo" });
+    }
+
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    EXPECT_EQ(received, (std::vector<int32_t>{ 1, 2, 3 }));
+}
+
+TEST_F(TestHostTransceiver, MulticastGroupFallsBackToConnectionForOversizedInstances)
+{
+    host().setMulticast(DotsUncachedTestStruct::_Name, dots::io::Endpoint{ "udp://239.255.0.1:11241" }, "127.0.0.1");
+    globalGuest().setMulticast(true, "127.0.0.1");
+
+    std::vector<int32_t> received;
+    dots::Subscription subscription = dots::subscribe<DotsUncachedTestStruct>([&](const dots::Event<DotsUncachedTestStruct>& event){ received.emplace_back(*event().intKeyfField); });
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    dots::publish(DotsUncachedTestStruct{ .intKeyfField = 1, .value = "foo" });
+    dots::publish(DotsUncachedTestStruct{ .intKeyfField = 2, .value = std::string(dots::io::MulticastSender::MaxDatagramSize + 1, 'x') });
+    dots::publish(DotsUncachedTestStruct{ .intKeyfField = 3, .value = "bar" });
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    // note: the gap of the oversized instance causes the guest to fall back
+    // to the connection, which retransmits all instances it has not received
+    dots::publish(DotsUncachedTestStruct{ .intKeyfField = 4, .value = "baz" });
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    EXPECT_EQ(received, (std::vector<int32_t>{ 1, 2, 3, 4 }));
+}
+
+TEST_F(TestHostTransceiver, WriteQueueDisconnectPolicyClosesLaggingConnection)
+{
+    host().setWriteQueueLimit(16 * 1024, DotsWriteQueuePolicy::disconnect);
+
+    size_t numReceived = 0;
+    dots::Subscription subscription = streamGuest().subscribe<DotsUncachedTestStruct>([&](const dots::Event<DotsUncachedTestStruct>&){ ++numReceived; });
+    processEvents(std::chrono::milliseconds{ 50 });
+    ASSERT_NE(streamGuestConnection(), nullptr);
+
+    // note: all transmissions are queued, because the write queue cannot be
+    // drained before the events are processed
+    for (int32_t i = 1; i <= 64; ++i)
+    {
+        host().publish(DotsUncachedTestStruct{ .intKeyfField = i, .value = std::string(1024, 'x') });
+    }
+
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    EXPECT_EQ(streamGuestConnection(), nullptr);
+    EXPECT_FALSE(streamGuest().connected());
+    EXPECT_LT(numReceived, 64u);
+}
+
+TEST_F(TestHostTransceiver, WriteQueueDropOldestPolicyDropsTransmissionsOfUncachedTypes)
+{
+    host().setWriteQueueLimit(16 * 1024, DotsWriteQueuePolicy::drop_oldest);
+
+    std::vector<int32_t> received;
+    dots::Subscription subscription = streamGuest().subscribe<DotsUncachedTestStruct>([&](const dots::Event<DotsUncachedTestStruct>& event){ received.emplace_back(*event().intKeyfField); });
+    processEvents(std::chrono::milliseconds{ 50 });
+    ASSERT_NE(streamGuestConnection(), nullptr);
+
+    for (int32_t i = 1; i <= 64; ++i)
+    {
+        host().publish(DotsUncachedTestStruct{ .intKeyfField = i, .value = std::string(1024, 'x') });
+    }
+
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    const dots::Connection* connection = streamGuestConnection();
+    ASSERT_NE(connection, nullptr);
+    EXPECT_TRUE(streamGuest().connected());
+
+    ASSERT_FALSE(received.empty());
+    EXPECT_LT(received.size(), 64u);
+    EXPECT_EQ(received.front(), 1);
+    EXPECT_EQ(received.back(), 64);
+    EXPECT_EQ(connection->writeQueueStatus().dropped, 64u - received.size());
+}
+
+TEST_F(TestHostTransceiver, WriteQueueDropOldestPolicyClosesConnectionInsteadOfDroppingTransmissionsOfCachedTypes)
+{
+    host().setWriteQueueLimit(16 * 1024, DotsWriteQueuePolicy::drop_oldest);
+
+    dots::Subscription subscription = streamGuest().subscribe<DotsTestStruct>([](const dots::Event<DotsTestStruct>&){});
+    processEvents(std::chrono::milliseconds{ 50 });
+    ASSERT_NE(streamGuestConnection(), nullptr);
+
+    for (int32_t i = 1; i <= 64; ++i)
+    {
+        host().publish(DotsTestStruct{ .stringField = std::string(1024, 'x'), .indKeyfField = i });
+    }
+
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    EXPECT_EQ(streamGuestConnection(), nullptr);
+    EXPECT_FALSE(streamGuest().connected());
+}
+
+TEST_F(TestHostTransceiver, WriteQueueDropOldestPolicyConflatesTransmissionsOfCachedTypes)
+{
+    host().setWriteQueueLimit(16 * 1024, DotsWriteQueuePolicy::drop_oldest);
+    host().setConflationThreshold(4 * 1024);
+
+    dots::Subscription subscription = streamGuest().subscribe<DotsTestStruct>([](const dots::Event<DotsTestStruct>&){});
+    processEvents(std::chrono::milliseconds{ 50 });
+    ASSERT_NE(streamGuestConnection(), nullptr);
+
+    for (int32_t i = 1; i <= 64; ++i)
+    {
+        host().publish(DotsTestStruct{ .stringField = std::string(1024, 'x'), .indKeyfField = 1, .floatField = static_cast<float>(i) });
+    }
+
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    const dots::Connection* connection = streamGuestConnection();
+    ASSERT_NE(connection, nullptr);
+    EXPECT_EQ(connection->writeQueueStatus().dropped, 0u);
+    EXPECT_GT(connection->writeQueueStatus().conflated, 0u);
+
+    const DotsTestStruct* instance = streamGuest().container<DotsTestStruct>().find(DotsTestStruct{ .indKeyfField = 1 });
+    ASSERT_NE(instance, nullptr);
+    EXPECT_EQ(instance->floatField, 64.0f);
+}
+
+TEST_F(TestHostTransceiver, WriteQueuePauseReadingPolicyMarksConnectionAsCongested)
+{
+    host().setWriteQueueLimit(16 * 1024, DotsWriteQueuePolicy::pause_reading);
+
+    std::vector<int32_t> received;
+    dots::Subscription subscription = streamGuest().subscribe<DotsUncachedTestStruct>([&](const dots::Event<DotsUncachedTestStruct>& event){ received.emplace_back(*event().intKeyfField); });
+    processEvents(std::chrono::milliseconds{ 50 });
+    ASSERT_NE(streamGuestConnection(), nullptr);
+
+    // note: the write queue exceeds its limit, but not twice its limit
+    for (int32_t i = 1; i <= 24; ++i)
+    {
+        host().publish(DotsUncachedTestStruct{ .intKeyfField = i, .value = std::string(1024, 'x') });
+    }
+
+    const dots::Connection* connection = streamGuestConnection();
+    ASSERT_NE(connection, nullptr);
+    EXPECT_TRUE(connection->writeQueueCongested());
+    EXPECT_EQ(connection->writeQueueStatus().congestions, 1u);
+
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    connection = streamGuestConnection();
+    ASSERT_NE(connection, nullptr);
+    EXPECT_FALSE(connection->writeQueueCongested());
+    EXPECT_EQ(connection->writeQueueStatus().dropped, 0u);
+    EXPECT_EQ(received.size(), 24u);
+}
+
+TEST_F(TestHostTransceiver, WriteQueuePauseReadingPolicyClosesConnectionThatExceedsTwiceTheLimit)
+{
+    host().setWriteQueueLimit(16 * 1024, DotsWriteQueuePolicy::pause_reading);
+
+    dots::Subscription subscription = streamGuest().subscribe<DotsUncachedTestStruct>([](const dots::Event<DotsUncachedTestStruct>&){});
+    processEvents(std::chrono::milliseconds{ 50 });
+    ASSERT_NE(streamGuestConnection(), nullptr);
+
+    for (int32_t i = 1; i <= 64; ++i)
+    {
+        host().publish(DotsUncachedTestStruct{ .intKeyfField = i, .value = std::string(1024, 'x') });
+    }
+
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    EXPECT_EQ(streamGuestConnection(), nullptr);
+    EXPECT_FALSE(streamGuest().connected());
+}
+
+TEST_F(TestHostTransceiver, ConflatedUpdatesContainUnionOfIncludedProperties)
+{
+    host().setConflationThreshold(4 * 1024);
+
+    std::vector<dots::property_set_t> updatedProperties;
+    dots::Subscription subscription = streamGuest().subscribe<DotsTestStruct>([&](const dots::Event<DotsTestStruct>& event)
+    {
+        if (*event().indKeyfField == 2)
+        {
+            updatedProperties.emplace_back(event.updatedProperties());
+        }
+    });
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    host().publish(DotsTestStruct{ .stringField = std::string(8 * 1024, 'x'), .indKeyfField = 1 });
+    host().publish(DotsTestStruct{ .indKeyfField = 2, .floatField = 1.0f });
+    host().publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = 2 });
+    host().publish(DotsTestStruct{ .indKeyfField = 2, .floatField = 2.0f });
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    const dots::Connection* connection = streamGuestConnection();
+    ASSERT_NE(connection, nullptr);
+    EXPECT_EQ(connection->writeQueueStatus().conflated, 2u);
+
+    ASSERT_EQ(updatedProperties.size(), 1u);
+    EXPECT_EQ(updatedProperties[0], DotsTestStruct::stringField_p + DotsTestStruct::indKeyfField_p + DotsTestStruct::floatField_p);
+
+    const DotsTestStruct* instance = streamGuest().container<DotsTestStruct>().find(DotsTestStruct{ .indKeyfField = 2 });
+    ASSERT_NE(instance, nullptr);
+    EXPECT_EQ(instance->stringField, "foo");
+    EXPECT_EQ(instance->floatField, 2.0f);
+}
+
+TEST_F(TestHostTransceiver, ConflatedUpdatesAreNotOvertakenByOtherTransmissions)
+{
+    host().setConflationThreshold(4 * 1024);
+
+    std::vector<std::string> received;
+    dots::Subscription cachedSubscription = streamGuest().subscribe<DotsTestStruct>([&](const dots::Event<DotsTestStruct>& event)
+    {
+        received.emplace_back("cached" + std::to_string(*event().indKeyfField));
+    });
+    dots::Subscription uncachedSubscription = streamGuest().subscribe<DotsUncachedTestStruct>([&](const dots::Event<DotsUncachedTestStruct>& event)
+    {
+        received.emplace_back("uncached" + std::to_string(*event().intKeyfField));
+    });
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    // note: the first transmission exceeds the threshold, so all subsequent
+    // updates of cached types are conflated until the write queue is drained
+    host().publish(DotsUncachedTestStruct{ .intKeyfField = 1, .value = std::string(8 * 1024, 'x') });
+    host().publish(DotsTestStruct{ .indKeyfField = 1, .floatField = 1.0f });
+    host().publish(DotsUncachedTestStruct{ .intKeyfField = 2, .value = "foo" });
+    host().publish(DotsTestStruct{ .indKeyfField = 2, .floatField = 1.0f });
+    host().publish(DotsTestStruct{ .indKeyfField = 1, .floatField = 2.0f });
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    EXPECT_EQ(received, (std::vector<std::string>{ "uncached1", "cached1", "uncached2", "cached2", "cached1" }));
+}
+
+TEST_F(TestHostTransceiver, ForwardTransmissionsOfUncachedTypesWithoutDecoding)
+{
+    std::vector<dots::io::Transmission> forwarded;
+    dots::Subscription hostSubscription = host().subscribe(DotsUncachedTestStruct::_Descriptor(), dots::Transceiver::transmission_handler_t{ [&](const dots::io::Transmission& transmission)
+    {
+        forwarded.emplace_back(transmission.share());
+    } });
+
+    std::vector<DotsUncachedTestStruct> received;
+    dots::Subscription subscription = streamGuest("dots-stream-subscriber").subscribe<DotsUncachedTestStruct>([&](const dots::Event<DotsUncachedTestStruct>& event)
+    {
+        received.emplace_back(event());
+    });
+    dots::GuestTransceiver& publisher = streamGuest("dots-stream-publisher");
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    publisher.publish(DotsUncachedTestStruct{ .intKeyfField = 1, .value = "foo" });
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    ASSERT_EQ(forwarded.size(), 1u);
+    ASSERT_NE(forwarded[0].payload(), nullptr);
+    EXPECT_FALSE(forwarded[0].decoded());
+
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0], (DotsUncachedTestStruct{ .intKeyfField = 1, .value = "foo" }));
+
+    // note: the host only decodes transmissions of uncached types once it
+    // subscribes to their events itself
+    size_t numHostEvents = 0;
+    dots::Subscription hostEventSubscription = host().subscribe<DotsUncachedTestStruct>([&](const dots::Event<DotsUncachedTestStruct>&){ ++numHostEvents; });
+
+    publisher.publish(DotsUncachedTestStruct{ .intKeyfField = 2, .value = "bar" });
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    ASSERT_EQ(forwarded.size(), 2u);
+    EXPECT_TRUE(forwarded[1].decoded());
+    EXPECT_EQ(numHostEvents, 1u);
+
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(received[1], (DotsUncachedTestStruct{ .intKeyfField = 2, .value = "bar" }));
+}
+
+TEST_F(TestHostTransceiver, ConnectionStatisticsCountReceivedAndSentTransmissions)
+{
+    dots::GuestTransceiver& guest = streamGuest();
+    dots::Subscription subscription = guest.subscribe<DotsUncachedTestStruct>([](const dots::Event<DotsUncachedTestStruct>&){});
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    // note: the descriptor of the type is only exchanged along with the first
+    // transmission of the type
+    guest.publish(DotsUncachedTestStruct{ .intKeyfField = 0 });
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    const dots::Connection* connection = streamGuestConnection();
+    ASSERT_NE(connection, nullptr);
+    DotsStatistics received = connection->receivedStatistics();
+    DotsStatistics sent = connection->sentStatistics();
+
+    guest.publish(DotsUncachedTestStruct{ .intKeyfField = 1, .value = "foo" });
+    guest.publish(DotsUncachedTestStruct{ .intKeyfField = 2, .value = "bar" });
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    // note: the guest receives its own transmissions, because it is a member
+    // of the group
+    EXPECT_EQ(*connection->receivedStatistics().packages, *received.packages + 2);
+    EXPECT_GT(*connection->receivedStatistics().bytes, *received.bytes);
+    EXPECT_EQ(*connection->sentStatistics().packages, *sent.packages + 2);
+    EXPECT_GT(*connection->sentStatistics().bytes, *sent.bytes);
+
+    // note: both sides count the same encoded transmissions
+    EXPECT_EQ(*connection->sentStatistics().bytes - *sent.bytes, *connection->receivedStatistics().bytes - *received.bytes);
+}
+
+TEST_F(TestHostTransceiver, TypeStatisticsCountTransmissionsReceivedFromGuests)
+{
+    dots::Subscription subscription = streamGuest("dots-stream-subscriber").subscribe<DotsUncachedTestStruct>([](const dots::Event<DotsUncachedTestStruct>&){});
+    dots::GuestTransceiver& publisher = streamGuest("dots-stream-publisher");
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    EXPECT_FALSE(typeStatistics(DotsUncachedTestStruct::_Name).has_value());
+
+    publisher.publish(DotsUncachedTestStruct{ .intKeyfField = 1, .value = "foo" });
+    publisher.publish(DotsUncachedTestStruct{ .intKeyfField = 2, .value = "bar" });
+    publisher.publish(DotsUncachedTestStruct{ .intKeyfField = 3, .value = "baz" });
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    std::optional<DotsTypeStatistics> statistics = typeStatistics(DotsUncachedTestStruct::_Name);
+    ASSERT_TRUE(statistics.has_value());
+    EXPECT_EQ(*statistics->received->packages, 3u);
+    EXPECT_GT(*statistics->received->bytes, 0u);
+    EXPECT_EQ(*statistics->sent->packages, 3u);
+    EXPECT_EQ(*statistics->sent->bytes, *statistics->received->bytes);
+}
+
+TEST_F(TestHostTransceiver, TypeStatisticsCountTransmissionsOriginatingFromHost)
+{
+    dots::Subscription subscription = dots::subscribe<DotsTestStruct>([](const dots::Event<DotsTestStruct>&){});
+    processEvents();
+
+    host().publish(DotsTestStruct{ .indKeyfField = 1 });
+    host().publish(DotsTestStruct{ .indKeyfField = 2 });
+    processEvents();
+
+    std::optional<DotsTypeStatistics> statistics = typeStatistics(DotsTestStruct::_Name);
+    ASSERT_TRUE(statistics.has_value());
+    EXPECT_EQ(*statistics->received->packages, 0u);
+    EXPECT_EQ(*statistics->sent->packages, 2u);
+    EXPECT_EQ(*statistics->sent->bytes, 0u);
+
+    // note: snapshots of containers are transmitted by the host as well
+    dots::Subscription streamSubscription = streamGuest().subscribe<DotsTestStruct>([](const dots::Event<DotsTestStruct>&){});
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    statistics = typeStatistics(DotsTestStruct::_Name);
+    ASSERT_TRUE(statistics.has_value());
+    EXPECT_EQ(*statistics->sent->packages, 4u);
+    EXPECT_EQ(*statistics->sent->bytes, 0u);
+}
+
+TEST_F(TestHostTransceiver, WorkerThreadsProcessEachTransmissionOnceAndFanOutToAllWorkers)
+{
+    // note: workers are assigned round-robin, so both subscribers are
+    // operated on different worker threads
+    host().setWorkerThreads(2);
+
+    size_t numHostEvents = 0;
+    dots::Subscription hostSubscription = host().subscribe<DotsTestStruct>([&](const dots::Event<DotsTestStruct>&){ ++numHostEvents; });
+
+    std::vector<int32_t> received1;
+    std::vector<int32_t> received2;
+    dots::Subscription subscription1 = streamGuest("dots-stream-subscriber-1").subscribe<DotsTestStruct>([&](const dots::Event<DotsTestStruct>& event){ received1.emplace_back(*event().indKeyfField); });
+    dots::Subscription subscription2 = streamGuest("dots-stream-subscriber-2").subscribe<DotsTestStruct>([&](const dots::Event<DotsTestStruct>& event){ received2.emplace_back(*event().indKeyfField); });
+    dots::GuestTransceiver& publisher = streamGuest("dots-stream-publisher");
+    processEvents(std::chrono::milliseconds{ 50 });
+
+    constexpr int32_t NumInstances = 100;
+    std::vector<int32_t> expected;
+
+    for (int32_t i = 0; i < NumInstances; ++i)
+    {
+        publisher.publish(DotsTestStruct{ .stringField = "foo", .indKeyfField = i });
+        expected.emplace_back(i);
+    }
+
+    processEvents(std::chrono::milliseconds{ 200 });
+
+    // note: the container of the host is updated once per transmission,
+    // regardless of the amount of workers the transmission is handed over to
+    EXPECT_EQ(numHostEvents, static_cast<size_t>(NumInstances));
+    EXPECT_EQ(host().container<DotsTestStruct>().size(), static_cast<size_t>(NumInstances));
+
+    EXPECT_EQ(received1, expected);
+    EXPECT_EQ(received2, expected);
+    EXPECT_EQ(streamGuest("dots-stream-subscriber-1").container<DotsTestStruct>().size(), static_cast<size_t>(NumInstances));
+    EXPECT_EQ(streamGuest("dots-stream-subscriber-2").container<DotsTestStruct>().size(), static_cast<size_t>(NumInstances));
+}
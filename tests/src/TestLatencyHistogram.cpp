@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/testing/gtest/gtest.h>
+#include <dots/LatencyHistogram.h>
+
+namespace
+{
+    constexpr double RelativeError = 1.0 / (dots::LatencyHistogram::SubBucketCount / 2);
+}
+
+TEST(TestLatencyHistogram, ctor_EmptyAfterDefaultConstruction)
+{
+    dots::LatencyHistogram sut;
+
+    EXPECT_EQ(sut.count(), 0u);
+    EXPECT_EQ(sut.min(), dots::duration_t{ 0.0 });
+    EXPECT_EQ(sut.max(), dots::duration_t{ 0.0 });
+    EXPECT_EQ(sut.percentile(50.0), dots::duration_t{ 0.0 });
+    EXPECT_EQ(sut.statistics(), DotsLatencyStatistics{ .count = 0 });
+}
+
+TEST(TestLatencyHistogram, record_TracksCountMinAndMax)
+{
+    dots::LatencyHistogram sut;
+
+    sut.record(dots::duration_t{ 0.002 });
+    sut.record(dots::duration_t{ 0.000005 });
+    sut.record(dots::duration_t{ 1.5 });
+
+    EXPECT_EQ(sut.count(), 3u);
+    EXPECT_DOUBLE_EQ(sut.min().count(), 0.000005);
+    EXPECT_DOUBLE_EQ(sut.max().count(), 1.5);
+}
+
+TEST(TestLatencyHistogram, record_ClampNegativeLatenciesToZero)
+{
+    dots::LatencyHistogram sut;
+
+    sut.record(dots::duration_t{ -0.5 });
+
+    EXPECT_EQ(sut.count(), 1u);
+    EXPECT_EQ(sut.min(), dots::duration_t{ 0.0 });
+    EXPECT_EQ(sut.max(), dots::duration_t{ 0.0 });
+}
+
+TEST(TestLatencyHistogram, percentile_WithinRelativeErrorOfExactValue)
+{
+    dots::LatencyHistogram sut;
+
+    // note: record latencies from 1us to 10ms in steps of 1us
+    for (int i = 1; i <= 10000; ++i)
+    {
+        sut.record(dots::duration_t{ i * 1e-6 });
+    }
+
+    for (double percentile : { 1.0, 10.0, 50.0, 90.0, 99.0, 99.9 })
+    {
+        double expected = percentile / 100.0 * 10000 * 1e-6;
+        EXPECT_NEAR(sut.percentile(percentile).count(), expected, expected * RelativeError);
+    }
+
+    EXPECT_DOUBLE_EQ(sut.percentile(100.0).count(), 0.01);
+}
+
+TEST(TestLatencyHistogram, percentile_ExactForSmallLatencies)
+{
+    dots::LatencyHistogram sut;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        sut.record(dots::duration_t{ i * 1e-6 });
+    }
+
+    EXPECT_DOUBLE_EQ(sut.percentile(50.0).count(), 4e-6);
+    EXPECT_DOUBLE_EQ(sut.percentile(90.0).count(), 8e-6);
+}
+
+TEST(TestLatencyHistogram, statistics_ContainsPercentiles)
+{
+    dots::LatencyHistogram sut;
+    sut.record(dots::duration_t{ 0.001 });
+
+    DotsLatencyStatistics statistics = sut.statistics();
+
+    EXPECT_EQ(*statistics.count, 1u);
+    EXPECT_EQ(*statistics.min, sut.min());
+    EXPECT_EQ(*statistics.p50, sut.max());
+    EXPECT_EQ(*statistics.p999, sut.max());
+    EXPECT_EQ(*statistics.max, sut.max());
+}
+
+TEST(TestLatencyHistogram, reset_EmptyAfterReset)
+{
+    dots::LatencyHistogram sut;
+    sut.record(dots::duration_t{ 0.001 });
+    sut.record(dots::duration_t{ 0.002 });
+
+    sut.reset();
+
+    EXPECT_EQ(sut.count(), 0u);
+    EXPECT_EQ(sut.max(), dots::duration_t{ 0.0 });
+
+    sut.record(dots::duration_t{ 0.003 });
+
+    EXPECT_EQ(sut.count(), 1u);
+    EXPECT_DOUBLE_EQ(sut.min().count(), 0.003);
+    EXPECT_DOUBLE_EQ(sut.percentile(50.0).count(), 0.003);
+}
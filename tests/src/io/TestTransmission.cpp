@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <utility>
+#include <dots/testing/gtest/gtest.h>
+#include <dots/io/Transmission.h>
+#include <dots/serialization/CborSerializer.h>
+#include <DotsTestStruct.dots.h>
+
+using dots::io::Transmission;
+
+struct TestTransmission : ::testing::Test
+{
+protected:
+
+    TestTransmission() :
+        m_header{
+            .typeName = DotsTestStruct::_Name,
+            .attributes = DotsTestStruct::stringField_p + DotsTestStruct::indKeyfField_p
+        },
+        m_instance{ .stringField = "foo", .indKeyfField = 1 }
+    {
+        /* do nothing */
+    }
+
+    DotsHeader m_header;
+    DotsTestStruct m_instance;
+};
+
+TEST_F(TestTransmission, share_ReferToSameData)
+{
+    Transmission sut{ m_header, dots::type::AnyStruct{ m_instance } };
+    Transmission shared = sut.share();
+
+    EXPECT_EQ(shared.id(), sut.id());
+    EXPECT_EQ(&std::as_const(shared).header(), &std::as_const(sut).header());
+    EXPECT_EQ(&shared.instance(), &sut.instance());
+}
+
+TEST_F(TestTransmission, header_CopySharedDataOnModification)
+{
+    Transmission sut{ m_header, dots::type::AnyStruct{ m_instance } };
+    Transmission shared = sut.share();
+
+    sut.header().removeObj = true;
+
+    EXPECT_NE(sut.id(), shared.id());
+    EXPECT_TRUE(sut.header().removeObj == true);
+    EXPECT_FALSE(shared.header().removeObj.isValid());
+    EXPECT_EQ(sut.instance().to<DotsTestStruct>(), m_instance);
+    EXPECT_EQ(shared.instance().to<DotsTestStruct>(), m_instance);
+}
+
+TEST_F(TestTransmission, header_DoNotCopyExclusiveDataOnModification)
+{
+    Transmission sut{ m_header, dots::type::AnyStruct{ m_instance } };
+    Transmission::id_t id = sut.id();
+
+    {
+        Transmission shared = sut.share();
+    }
+
+    sut.header().removeObj = true;
+
+    EXPECT_EQ(sut.id(), id);
+    EXPECT_TRUE(sut.header().removeObj == true);
+}
+
+TEST_F(TestTransmission, header_CopyUndecodedSharedDataOnModification)
+{
+    Transmission sut{ m_header, DotsTestStruct::_Descriptor(), dots::to_cbor(m_instance) };
+    Transmission shared = sut.share();
+
+    sut.header().removeObj = true;
+
+    EXPECT_FALSE(sut.decoded());
+    EXPECT_FALSE(shared.decoded());
+    EXPECT_EQ(sut.instance().to<DotsTestStruct>(), m_instance);
+    EXPECT_EQ(shared.instance().to<DotsTestStruct>(), m_instance);
+}
+
+TEST_F(TestTransmission, instance_DoNotMoveSharedInstance)
+{
+    Transmission sut{ m_header, dots::type::AnyStruct{ m_instance } };
+    Transmission shared = sut.share();
+
+    dots::type::AnyStruct instance = std::move(sut).instance();
+
+    EXPECT_EQ(instance.to<DotsTestStruct>(), m_instance);
+    EXPECT_EQ(shared.instance().to<DotsTestStruct>(), m_instance);
+}
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <dots/testing/gtest/gtest.h>
+#include <dots/io/WorkerPool.h>
+
+using dots::io::WorkerPool;
+
+TEST(TestWorkerPool, ctor_ThrowOnZeroWorkers)
+{
+    EXPECT_THROW(WorkerPool{ 0 }, std::logic_error);
+}
+
+TEST(TestWorkerPool, next_SelectWorkersRoundRobin)
+{
+    WorkerPool sut{ 3 };
+
+    EXPECT_EQ(sut.size(), 3u);
+    EXPECT_EQ(sut.next(), 0u);
+    EXPECT_EQ(sut.next(), 1u);
+    EXPECT_EQ(sut.next(), 2u);
+    EXPECT_EQ(sut.next(), 0u);
+}
+
+TEST(TestWorkerPool, ioContext_RunHandlersOnSeparateWorkerThreads)
+{
+    WorkerPool sut{ 2 };
+    sut.next();
+
+    auto run_on_worker = [&sut](size_t index)
+    {
+        std::promise<std::pair<std::thread::id, bool>> promise;
+        std::future<std::pair<std::thread::id, bool>> future = promise.get_future();
+
+        dots::asio::post(sut.ioContext(index), [&promise]
+        {
+            promise.set_value({ std::this_thread::get_id(), WorkerPool::RunningInWorkerThread() });
+        });
+
+        return future.get();
+    };
+
+    auto [threadId0, runningInWorkerThread0] = run_on_worker(0);
+    auto [threadId1, runningInWorkerThread1] = run_on_worker(1);
+
+    EXPECT_TRUE(runningInWorkerThread0);
+    EXPECT_TRUE(runningInWorkerThread1);
+    EXPECT_FALSE(WorkerPool::RunningInWorkerThread());
+
+    EXPECT_NE(threadId0, std::this_thread::get_id());
+    EXPECT_NE(threadId1, std::this_thread::get_id());
+    EXPECT_NE(threadId0, threadId1);
+}
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <dots/testing/gtest/gtest.h>
+#include <dots/io/channels/LocalChannel.h>
+#include <dots/serialization/CborSerializer.h>
+#include <dots/type/Registry.h>
+#include <DotsTestStruct.dots.h>
+
+using dots::io::LocalChannel;
+
+struct TestLocalChannel : ::testing::Test
+{
+protected:
+
+    void link(dots::type::Registry& receivingRegistry)
+    {
+        m_sendingChannel = dots::io::make_channel<LocalChannel>(m_ioContext);
+        m_receivingChannel = dots::io::make_channel<LocalChannel>(m_ioContext);
+        m_sendingChannel->link(*m_receivingChannel);
+        m_receivingChannel->link(*m_sendingChannel);
+        m_sendingChannel->init(m_sendingRegistry);
+        m_receivingChannel->init(receivingRegistry);
+
+        m_receivingChannel->asyncReceive([this](dots::io::Transmission transmission)
+        {
+            // note: descriptors of transmitted types are exchanged before the
+            // first instance of a type
+            if (!transmission.descriptor().internal())
+            {
+                m_received.emplace_back(std::move(transmission));
+            }
+
+            return true;
+        }, [](std::exception_ptr/* ePtr*/)
+        {
+            ADD_FAILURE() << "unexpected channel error";
+        });
+    }
+
+    const dots::io::Transmission& transmit(const DotsHeader& header, const dots::type::Struct& instance)
+    {
+        m_sendingChannel->transmit(header, instance);
+
+        while (m_received.empty())
+        {
+            m_ioContext.run_one();
+        }
+
+        return m_received.front();
+    }
+
+    dots::asio::io_context m_ioContext;
+    dots::type::Registry m_sendingRegistry;
+    std::shared_ptr<LocalChannel> m_sendingChannel;
+    std::shared_ptr<LocalChannel> m_receivingChannel;
+    std::vector<dots::io::Transmission> m_received;
+};
+
+TEST_F(TestLocalChannel, HandOverInstanceIfDescriptorsAreIdentical)
+{
+    dots::type::Registry receivingRegistry;
+    link(receivingRegistry);
+
+    DotsTestStruct instance{ .stringField = "foo", .indKeyfField = 1, .floatField = 1.0f };
+    DotsHeader header{
+        .typeName = DotsTestStruct::_Name,
+        .attributes = DotsTestStruct::stringField_p + DotsTestStruct::indKeyfField_p
+    };
+
+    const dots::io::Transmission& received = transmit(header, instance);
+
+    EXPECT_EQ(&received.descriptor(), &DotsTestStruct::_Descriptor());
+    EXPECT_EQ(&received.instance()->_descriptor(), &DotsTestStruct::_Descriptor());
+    EXPECT_EQ(received.instance().to<DotsTestStruct>(), (DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 }));
+}
+
+TEST_F(TestLocalChannel, ConvertInstanceIfDescriptorsDiffer)
+{
+    // note: the receiving registry does not contain the static descriptor,
+    // so it registers a dynamic descriptor that is exchanged by the channel
+    dots::type::Registry receivingRegistry{ std::nullopt, dots::type::Registry::StaticTypePolicy::InternalOnly };
+    link(receivingRegistry);
+
+    DotsTestStruct instance{ .stringField = "foo", .indKeyfField = 1, .floatField = 1.0f };
+    DotsHeader header{
+        .typeName = DotsTestStruct::_Name,
+        .attributes = DotsTestStruct::stringField_p + DotsTestStruct::indKeyfField_p
+    };
+
+    const dots::io::Transmission& received = transmit(header, instance);
+
+    const dots::type::StructDescriptor* descriptor = receivingRegistry.findStructType(DotsTestStruct::_Name);
+    ASSERT_NE(descriptor, nullptr);
+    EXPECT_NE(descriptor, &DotsTestStruct::_Descriptor());
+    EXPECT_EQ(&received.instance()->_descriptor(), descriptor);
+    EXPECT_EQ(dots::to_cbor(*received.instance()), dots::to_cbor(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 }));
+}
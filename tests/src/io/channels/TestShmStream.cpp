@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <cstring>
+#include <numeric>
+#include <optional>
+#include <vector>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <dots/testing/gtest/gtest.h>
+#include <dots/io/channels/ShmStream.h>
+
+using dots::io::posix::ShmStream;
+
+struct TestShmStream : ::testing::Test
+{
+protected:
+
+    TestShmStream()
+    {
+        dots::asio::local::stream_protocol::socket acceptingSocket{ m_ioContext };
+        dots::asio::local::stream_protocol::socket connectingSocket{ m_ioContext };
+        dots::asio::local::connect_pair(acceptingSocket, connectingSocket);
+
+        m_acceptingStream.emplace(std::move(acceptingSocket), 64);
+        m_connectingStream.emplace(std::move(connectingSocket));
+    }
+
+    dots::asio::io_context m_ioContext;
+    std::optional<ShmStream> m_acceptingStream;
+    std::optional<ShmStream> m_connectingStream;
+};
+
+TEST_F(TestShmStream, CapacityIsRoundedUpToPowerOfTwo)
+{
+    dots::asio::local::stream_protocol::socket acceptingSocket{ m_ioContext };
+    dots::asio::local::stream_protocol::socket connectingSocket{ m_ioContext };
+    dots::asio::local::connect_pair(acceptingSocket, connectingSocket);
+
+    ShmStream acceptingStream{ std::move(acceptingSocket), 100 };
+    ShmStream connectingStream{ std::move(connectingSocket) };
+
+    EXPECT_EQ(acceptingStream.capacity(), 128u);
+    EXPECT_EQ(connectingStream.capacity(), 128u);
+}
+
+TEST_F(TestShmStream, TransferDataLargerThanCapacityInBothDirections)
+{
+    std::vector<uint8_t> data(1000);
+    std::iota(data.begin(), data.end(), uint8_t{ 0 });
+
+    std::vector<uint8_t> receivedByConnecting(data.size());
+    std::vector<uint8_t> receivedByAccepting(data.size());
+    size_t numCompleted = 0;
+
+    auto complete = [&](boost::system::error_code error, size_t numBytes)
+    {
+        EXPECT_FALSE(error);
+        EXPECT_EQ(numBytes, data.size());
+        ++numCompleted;
+    };
+
+    dots::asio::async_write(*m_acceptingStream, dots::asio::buffer(data), complete);
+    dots::asio::async_read(*m_connectingStream, dots::asio::buffer(receivedByConnecting), complete);
+    dots::asio::async_write(*m_connectingStream, dots::asio::buffer(data), complete);
+    dots::asio::async_read(*m_acceptingStream, dots::asio::buffer(receivedByAccepting), complete);
+
+    while (numCompleted < 4)
+    {
+        m_ioContext.run_one();
+    }
+
+    EXPECT_EQ(receivedByConnecting, data);
+    EXPECT_EQ(receivedByAccepting, data);
+}
+
+TEST_F(TestShmStream, ReadRemainingDataBeforeEofWhenPeerCloses)
+{
+    std::vector<uint8_t> data{ 1, 2, 3 };
+    std::vector<uint8_t> received(8);
+    std::optional<boost::system::error_code> writeError;
+
+    dots::asio::async_write(*m_acceptingStream, dots::asio::buffer(data), [&](boost::system::error_code error, size_t/* numBytes*/){ writeError = error; });
+
+    while (writeError == std::nullopt)
+    {
+        m_ioContext.run_one();
+    }
+
+    m_acceptingStream.reset();
+
+    std::optional<std::pair<boost::system::error_code, size_t>> readResult;
+    m_connectingStream->async_read_some(dots::asio::buffer(received), [&](boost::system::error_code error, size_t numBytes){ readResult.emplace(error, numBytes); });
+
+    while (readResult == std::nullopt)
+    {
+        m_ioContext.run_one();
+    }
+
+    EXPECT_FALSE(readResult->first);
+    EXPECT_EQ(readResult->second, data.size());
+
+    readResult.reset();
+    m_connectingStream->async_read_some(dots::asio::buffer(received), [&](boost::system::error_code error, size_t numBytes){ readResult.emplace(error, numBytes); });
+
+    while (readResult == std::nullopt)
+    {
+        m_ioContext.run_one();
+    }
+
+    EXPECT_EQ(readResult->first, dots::asio::error::eof);
+}
+
+TEST_F(TestShmStream, CloseStreamWhenPeerCorruptsRingPositions)
+{
+    // note: the accepting peer is emulated by performing the handshake
+    // manually, so that the positions of the ring it writes to can be
+    // corrupted
+    constexpr uint64_t Capacity = 64;
+    constexpr size_t RingSize = 4 * 64 + Capacity;
+    constexpr size_t MemorySize = 2 * RingSize;
+
+    dots::asio::local::stream_protocol::socket acceptingSocket{ m_ioContext };
+    dots::asio::local::stream_protocol::socket connectingSocket{ m_ioContext };
+    dots::asio::local::connect_pair(acceptingSocket, connectingSocket);
+
+    int memoryFd = ::memfd_create("dots-test-shm", MFD_CLOEXEC);
+    ASSERT_NE(memoryFd, -1);
+    ASSERT_EQ(::ftruncate(memoryFd, static_cast<off_t>(MemorySize)), 0);
+
+    struct
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t capacity;
+    } handshake{ 0x444F5453, 1, Capacity };
+
+    int fds[] = { memoryFd, ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC), ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) };
+    iovec iov{ .iov_base = &handshake, .iov_len = sizeof(handshake) };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+    msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    cmsghdr* controlMessage = CMSG_FIRSTHDR(&message);
+    controlMessage->cmsg_level = SOL_SOCKET;
+    controlMessage->cmsg_type = SCM_RIGHTS;
+    controlMessage->cmsg_len = CMSG_LEN(sizeof(fds));
+    std::memcpy(CMSG_DATA(controlMessage), fds, sizeof(fds));
+    ASSERT_EQ(::sendmsg(acceptingSocket.native_handle(), &message, MSG_NOSIGNAL), static_cast<ssize_t>(sizeof(handshake)));
+
+    ShmStream connectingStream{ std::move(connectingSocket) };
+
+    void* memory = ::mmap(nullptr, MemorySize, PROT_READ | PROT_WRITE, MAP_SHARED, memoryFd, 0);
+    ASSERT_NE(memory, MAP_FAILED);
+
+    // note: the head of the first ring is written by the accepting side
+    *static_cast<uint64_t*>(memory) = 4 * Capacity;
+
+    std::vector<uint8_t> received(8);
+    std::optional<boost::system::error_code> readError;
+    connectingStream.async_read_some(dots::asio::buffer(received), [&](boost::system::error_code error, size_t/* numBytes*/){ readError = error; });
+
+    while (readError == std::nullopt)
+    {
+        m_ioContext.run_one();
+    }
+
+    EXPECT_EQ(*readError, boost::system::errc::make_error_code(boost::system::errc::protocol_error));
+
+    // note: the stream stays closed even if the positions become consistent
+    // again
+    *static_cast<uint64_t*>(memory) = 0;
+
+    std::vector<uint8_t> data{ 1, 2, 3 };
+    std::optional<boost::system::error_code> writeError;
+    connectingStream.async_write_some(dots::asio::buffer(data), [&](boost::system::error_code error, size_t/* numBytes*/){ writeError = error; });
+
+    while (writeError == std::nullopt)
+    {
+        m_ioContext.run_one();
+    }
+
+    EXPECT_EQ(*writeError, boost::system::errc::make_error_code(boost::system::errc::protocol_error));
+
+    ::munmap(memory, MemorySize);
+
+    for (int fd : fds)
+    {
+        ::close(fd);
+    }
+}
+#endif
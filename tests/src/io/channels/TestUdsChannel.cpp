@@ -0,0 +1,294 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/asio.h>
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <dots/testing/gtest/gtest.h>
+#include <dots/io/channels/UdsChannel.h>
+#include <dots/serialization/CborSerializer.h>
+#include <dots/type/Registry.h>
+#include <DotsTestStruct.dots.h>
+
+using dots::io::posix::UdsChannel;
+
+struct TestUdsChannel : ::testing::Test
+{
+protected:
+
+    using channel_pair_t = std::pair<std::shared_ptr<UdsChannel>, std::shared_ptr<UdsChannel>>;
+
+    channel_pair_t makeChannelPair()
+    {
+        dots::asio::local::stream_protocol::socket socket1{ m_ioContext };
+        dots::asio::local::stream_protocol::socket socket2{ m_ioContext };
+        dots::asio::local::connect_pair(socket1, socket2);
+
+        channel_pair_t channels{
+            dots::io::make_channel<UdsChannel>(std::move(socket1), nullptr),
+            dots::io::make_channel<UdsChannel>(std::move(socket2), nullptr)
+        };
+        channels.first->init(m_registry);
+        channels.second->init(m_registry);
+
+        return channels;
+    }
+
+    // note: the peer is a plain socket, so that raw (e.g. malformed) frames
+    // can be exchanged with the channel
+    template <typename Channel = dots::io::posix::v3::UdsChannel>
+    std::pair<dots::asio::local::stream_protocol::socket, std::shared_ptr<Channel>> makeChannelWithRawPeer(typename Channel::payload_cache_t* payloadCache = nullptr)
+    {
+        dots::asio::local::stream_protocol::socket socket{ m_ioContext };
+        dots::asio::local::stream_protocol::socket peerSocket{ m_ioContext };
+        dots::asio::local::connect_pair(socket, peerSocket);
+
+        auto channel = dots::io::make_channel<Channel>(std::move(socket), payloadCache);
+        channel->init(m_registry);
+
+        return { std::move(peerSocket), std::move(channel) };
+    }
+
+    static std::vector<uint8_t> MakeBatchFrame(uint32_t batchSize, const std::vector<DotsTestStruct>& instances)
+    {
+        auto append_uint32 = [](std::vector<uint8_t>& data, uint8_t head, uint32_t value)
+        {
+            data.emplace_back(head);
+
+            for (int16_t i = sizeof(uint32_t) - 1; i >= 0; --i)
+            {
+                data.emplace_back(static_cast<uint8_t>(value >> i * 8));
+            }
+        };
+
+        std::vector<uint8_t> payload = dots::to_cbor(DotsHeader{
+            .typeName = DotsTestStruct::_Name,
+            .attributes = DotsTestStruct::stringField_p + DotsTestStruct::indKeyfField_p
+        });
+        append_uint32(payload, 0x9A, batchSize);
+
+        for (const DotsTestStruct& instance : instances)
+        {
+            std::vector<uint8_t> instanceData = dots::to_cbor(instance);
+            payload.insert(payload.end(), instanceData.begin(), instanceData.end());
+        }
+
+        std::vector<uint8_t> frame;
+        append_uint32(frame, 0x1A, static_cast<uint32_t>(payload.size()));
+        frame.insert(frame.end(), payload.begin(), payload.end());
+
+        return frame;
+    }
+
+    void receiveUntilError(dots::io::Channel& channel, std::vector<dots::io::Transmission>& received, std::exception_ptr& error)
+    {
+        channel.asyncReceive([&received](dots::io::Transmission transmission)
+        {
+            received.emplace_back(std::move(transmission));
+            return true;
+        }, [&error](std::exception_ptr ePtr)
+        {
+            error = ePtr;
+        });
+
+        for (int i = 0; i < 100 && error == nullptr; ++i)
+        {
+            m_ioContext.run_one_for(std::chrono::milliseconds{ 10 });
+        }
+    }
+
+    void receive(dots::io::Channel& channel, std::vector<dots::io::Transmission>& received)
+    {
+        channel.asyncReceive([&received](dots::io::Transmission transmission)
+        {
+            // note: descriptors of transmitted types are exchanged before the
+            // first instance of a type
+            if (!transmission.descriptor().internal())
+            {
+                received.emplace_back(std::move(transmission));
+            }
+
+            return true;
+        }, [](std::exception_ptr/* ePtr*/)
+        {
+            ADD_FAILURE() << "unexpected channel error";
+        });
+    }
+
+    void processUntil(const std::vector<dots::io::Transmission>& received, size_t size)
+    {
+        while (received.size() < size)
+        {
+            m_ioContext.run_one();
+        }
+    }
+
+    // note: this requires all pending writes to have been completed (e.g.
+    // by running the IO context until it is out of work)
+    static std::vector<uint8_t> ReadAvailable(dots::asio::local::stream_protocol::socket& socket)
+    {
+        std::vector<uint8_t> data(socket.available());
+        dots::asio::read(socket, dots::asio::buffer(data));
+
+        return data;
+    }
+
+    dots::asio::io_context m_ioContext;
+    dots::type::Registry m_registry;
+};
+
+TEST_F(TestUdsChannel, ForwardUncachedTransmissionWithoutDecoding)
+{
+    auto [publisherChannel, hostInboundChannel] = makeChannelPair();
+    auto [hostOutboundChannel, subscriberChannel] = makeChannelPair();
+    hostInboundChannel->setPassThrough(true);
+    subscriberChannel->setPassThrough(true);
+
+    std::vector<dots::io::Transmission> receivedByHost;
+    std::vector<dots::io::Transmission> receivedBySubscriber;
+    receive(*hostInboundChannel, receivedByHost);
+    receive(*subscriberChannel, receivedBySubscriber);
+
+    DotsUncachedTestStruct instance{ .intKeyfField = 1, .value = "foo" };
+    publisherChannel->transmit(instance);
+    processUntil(receivedByHost, 1);
+
+    const dots::io::Transmission& forwarded = receivedByHost.front();
+    ASSERT_NE(forwarded.payload(), nullptr);
+    EXPECT_FALSE(forwarded.decoded());
+
+    hostOutboundChannel->transmit(forwarded);
+    processUntil(receivedBySubscriber, 1);
+
+    EXPECT_FALSE(forwarded.decoded());
+
+    const dots::io::Transmission& received = receivedBySubscriber.front();
+    ASSERT_NE(received.payload(), nullptr);
+    EXPECT_EQ(*received.payload(), *forwarded.payload());
+    EXPECT_EQ(*received.header().typeName, DotsUncachedTestStruct::_Name);
+
+    EXPECT_TRUE(received.instance()->_equal(instance));
+    EXPECT_TRUE(received.decoded());
+}
+
+TEST_F(TestUdsChannel, DecodeCachedTransmissionDespitePassThrough)
+{
+    auto [publisherChannel, hostInboundChannel] = makeChannelPair();
+    hostInboundChannel->setPassThrough(true);
+
+    std::vector<dots::io::Transmission> receivedByHost;
+    receive(*hostInboundChannel, receivedByHost);
+
+    DotsTestStruct instance{ .stringField = "foo", .indKeyfField = 1 };
+    publisherChannel->transmit(instance);
+    processUntil(receivedByHost, 1);
+
+    const dots::io::Transmission& received = receivedByHost.front();
+    EXPECT_EQ(received.payload(), nullptr);
+    EXPECT_TRUE(received.decoded());
+    EXPECT_TRUE(received.instance()->_equal(instance));
+}
+
+TEST_F(TestUdsChannel, FanOutCachedTransmissionWithSingleEncoding)
+{
+    UdsChannel::payload_cache_t payloadCache{ 0, nullptr };
+    auto [peerSocket1, channel1] = makeChannelWithRawPeer<UdsChannel>(&payloadCache);
+    auto [peerSocket2, channel2] = makeChannelWithRawPeer<UdsChannel>(&payloadCache);
+
+    DotsHeader header{
+        .typeName = DotsTestStruct::_Name,
+        .attributes = DotsTestStruct::stringField_p + DotsTestStruct::indKeyfField_p
+    };
+    dots::io::Transmission transmission{ header, dots::type::AnyStruct{ DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 } } };
+
+    channel1->transmit(transmission);
+    UdsChannel::shared_buffer_t encodedPayload = payloadCache.second;
+    ASSERT_NE(encodedPayload, nullptr);
+    EXPECT_EQ(payloadCache.first, transmission.id());
+
+    channel2->transmit(transmission);
+    EXPECT_EQ(payloadCache.second, encodedPayload);
+
+    m_ioContext.run_for(std::chrono::milliseconds{ 100 });
+    std::vector<uint8_t> received1 = ReadAvailable(peerSocket1);
+    std::vector<uint8_t> received2 = ReadAvailable(peerSocket2);
+
+    // note: the streams might also contain the exported descriptors, but
+    // must be identical and end with the shared payload
+    EXPECT_EQ(received1, received2);
+    ASSERT_GE(received1.size(), encodedPayload->size());
+    EXPECT_TRUE(std::equal(encodedPayload->begin(), encodedPayload->end(), received1.end() - static_cast<std::ptrdiff_t>(encodedPayload->size())));
+}
+
+TEST_F(TestUdsChannel, ReceiveBatchWithinFrame)
+{
+    auto [peerSocket, channel] = makeChannelWithRawPeer();
+    dots::asio::write(peerSocket, dots::asio::buffer(MakeBatchFrame(2, {
+        DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 },
+        DotsTestStruct{ .stringField = "bar", .indKeyfField = 2 }
+    })));
+
+    std::vector<dots::io::Transmission> received;
+    receive(*channel, received);
+    processUntil(received, 2);
+
+    EXPECT_EQ(received[0].instance().to<DotsTestStruct>(), (DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 }));
+    EXPECT_EQ(received[1].instance().to<DotsTestStruct>(), (DotsTestStruct{ .stringField = "bar", .indKeyfField = 2 }));
+}
+
+TEST_F(TestUdsChannel, RejectTruncatedBatch)
+{
+    auto [peerSocket, channel] = makeChannelWithRawPeer();
+
+    // note: the missing instance of the first batch must not be taken from
+    // the subsequent frame
+    dots::asio::write(peerSocket, dots::asio::buffer(MakeBatchFrame(3, {
+        DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 },
+        DotsTestStruct{ .stringField = "bar", .indKeyfField = 2 }
+    })));
+    dots::asio::write(peerSocket, dots::asio::buffer(MakeBatchFrame(1, {
+        DotsTestStruct{ .stringField = "baz", .indKeyfField = 3 }
+    })));
+
+    std::vector<dots::io::Transmission> received;
+    std::exception_ptr error;
+    receiveUntilError(*channel, received, error);
+
+    EXPECT_NE(error, nullptr);
+    EXPECT_LT(received.size(), 3u);
+}
+
+TEST_F(TestUdsChannel, RejectBatchWithOversizedCount)
+{
+    auto [peerSocket, channel] = makeChannelWithRawPeer();
+    dots::asio::write(peerSocket, dots::asio::buffer(MakeBatchFrame(1'000'000, {
+        DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 }
+    })));
+
+    std::vector<dots::io::Transmission> received;
+    std::exception_ptr error;
+    receiveUntilError(*channel, received, error);
+
+    EXPECT_NE(error, nullptr);
+    EXPECT_TRUE(received.empty());
+}
+
+TEST_F(TestUdsChannel, RejectBatchWithTrailingBytes)
+{
+    auto [peerSocket, channel] = makeChannelWithRawPeer();
+    dots::asio::write(peerSocket, dots::asio::buffer(MakeBatchFrame(1, {
+        DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 },
+        DotsTestStruct{ .stringField = "bar", .indKeyfField = 2 }
+    })));
+
+    std::vector<dots::io::Transmission> received;
+    std::exception_ptr error;
+    receiveUntilError(*channel, received, error);
+
+    EXPECT_NE(error, nullptr);
+    EXPECT_TRUE(received.empty());
+}
+#endif
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/asio.h>
+#if defined(__linux__)
+#include <numeric>
+#include <optional>
+#include <vector>
+#include <dots/testing/gtest/gtest.h>
+#include <dots/io/channels/UringStream.h>
+
+using dots::io::posix::UringAcceptor;
+using dots::io::posix::UringStream;
+
+struct TestUringStream : ::testing::Test
+{
+protected:
+
+    TestUringStream() :
+        m_workGuard{ dots::asio::make_work_guard(m_ioContext) }
+    {
+        dots::asio::local::stream_protocol::socket socketA{ m_ioContext };
+        dots::asio::local::stream_protocol::socket socketB{ m_ioContext };
+        dots::asio::local::connect_pair(socketA, socketB);
+
+        m_streamA.emplace(std::move(socketA));
+        m_streamB.emplace(std::move(socketB));
+    }
+
+    // note: the stream does not keep the IO context busy while no
+    // operations are outstanding
+    dots::asio::io_context m_ioContext;
+    dots::asio::executor_work_guard<dots::asio::io_context::executor_type> m_workGuard;
+    std::optional<UringStream> m_streamA;
+    std::optional<UringStream> m_streamB;
+};
+
+TEST_F(TestUringStream, TransferDataLargerThanRetainedBuffersInBothDirections)
+{
+    std::vector<uint8_t> data(1024 * 1024);
+    std::iota(data.begin(), data.end(), uint8_t{ 0 });
+
+    std::vector<uint8_t> receivedByA(data.size());
+    std::vector<uint8_t> receivedByB(data.size());
+    size_t numCompleted = 0;
+
+    auto complete = [&](boost::system::error_code error, size_t numBytes)
+    {
+        EXPECT_FALSE(error);
+        EXPECT_EQ(numBytes, data.size());
+        ++numCompleted;
+    };
+
+    dots::asio::async_write(*m_streamA, dots::asio::buffer(data), complete);
+    dots::asio::async_write(*m_streamB, dots::asio::buffer(data), complete);
+    dots::asio::async_read(*m_streamB, dots::asio::buffer(receivedByB), complete);
+    dots::asio::async_read(*m_streamA, dots::asio::buffer(receivedByA), complete);
+
+    while (numCompleted < 4)
+    {
+        m_ioContext.run_one();
+    }
+
+    EXPECT_EQ(receivedByA, data);
+    EXPECT_EQ(receivedByB, data);
+}
+
+TEST_F(TestUringStream, ReadRemainingDataBeforeEofWhenPeerCloses)
+{
+    std::vector<uint8_t> data{ 1, 2, 3 };
+    std::vector<uint8_t> received(8);
+    std::optional<boost::system::error_code> writeError;
+
+    dots::asio::async_write(*m_streamA, dots::asio::buffer(data), [&](boost::system::error_code error, size_t/* numBytes*/){ writeError = error; });
+
+    while (writeError == std::nullopt)
+    {
+        m_ioContext.run_one();
+    }
+
+    m_streamA.reset();
+
+    std::optional<std::pair<boost::system::error_code, size_t>> readResult;
+    m_streamB->async_read_some(dots::asio::buffer(received), [&](boost::system::error_code error, size_t numBytes){ readResult.emplace(error, numBytes); });
+
+    while (readResult == std::nullopt)
+    {
+        m_ioContext.run_one();
+    }
+
+    EXPECT_FALSE(readResult->first);
+    EXPECT_EQ(readResult->second, data.size());
+
+    readResult.reset();
+    m_streamB->async_read_some(dots::asio::buffer(received), [&](boost::system::error_code error, size_t numBytes){ readResult.emplace(error, numBytes); });
+
+    while (readResult == std::nullopt)
+    {
+        m_ioContext.run_one();
+    }
+
+    EXPECT_EQ(readResult->first, dots::asio::error::eof);
+}
+
+TEST_F(TestUringStream, AcceptMultipleConnections)
+{
+    dots::asio::ip::tcp::acceptor acceptor{ m_ioContext, dots::asio::ip::tcp::endpoint{ dots::asio::ip::address_v4::loopback(), 0 } };
+    dots::asio::ip::tcp::endpoint endpoint = acceptor.local_endpoint();
+    UringAcceptor uringAcceptor{ std::move(acceptor) };
+
+    std::vector<dots::asio::ip::tcp::socket> connectingSockets;
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        connectingSockets.emplace_back(m_ioContext).connect(endpoint);
+    }
+
+    std::vector<UringStream> acceptedStreams;
+
+    for (size_t i = 0; i < connectingSockets.size(); ++i)
+    {
+        std::optional<boost::system::error_code> acceptError;
+
+        uringAcceptor.async_accept([&](const boost::system::error_code& error, int socket)
+        {
+            acceptError = error;
+
+            if (!error)
+            {
+                acceptedStreams.emplace_back(m_ioContext, socket);
+            }
+        });
+
+        while (acceptError == std::nullopt)
+        {
+            m_ioContext.run_one();
+        }
+
+        EXPECT_FALSE(*acceptError);
+    }
+
+    ASSERT_EQ(acceptedStreams.size(), connectingSockets.size());
+
+    std::vector<uint8_t> data{ 4, 5, 6 };
+    std::vector<uint8_t> received(data.size());
+    std::optional<boost::system::error_code> readError;
+
+    dots::asio::write(connectingSockets.back(), dots::asio::buffer(data));
+    dots::asio::async_read(acceptedStreams.back(), dots::asio::buffer(received), [&](boost::system::error_code error, size_t/* numBytes*/){ readError = error; });
+
+    while (readError == std::nullopt)
+    {
+        m_ioContext.run_one();
+    }
+
+    EXPECT_FALSE(*readError);
+    EXPECT_EQ(received, data);
+}
+#endif
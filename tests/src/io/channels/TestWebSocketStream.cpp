@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <numeric>
+#include <optional>
+#include <vector>
+#include <dots/testing/gtest/gtest.h>
+#include <dots/io/channels/WebSocketStream.h>
+
+using dots::io::WebSocketStream;
+
+struct TestWebSocketStream : ::testing::Test
+{
+protected:
+
+    TestWebSocketStream()
+    {
+        dots::asio::ip::tcp::acceptor acceptor{ m_ioContext, { dots::asio::ip::make_address_v4("127.0.0.1"), 0 } };
+        dots::asio::ip::tcp::socket acceptedSocket{ m_ioContext };
+        acceptor.async_accept(acceptedSocket, [](boost::system::error_code error){ ASSERT_FALSE(error); });
+
+        WebSocketStream::ws_stream_t connectingStream{ m_ioContext };
+        connectingStream.next_layer().connect(acceptor.local_endpoint());
+        m_ioContext.run();
+        m_ioContext.restart();
+
+        WebSocketStream::ws_stream_t acceptingStream{ std::move(acceptedSocket) };
+        acceptingStream.async_accept([](boost::system::error_code error){ ASSERT_FALSE(error); });
+        connectingStream.async_handshake("127.0.0.1", "/", [](boost::system::error_code error){ ASSERT_FALSE(error); });
+        m_ioContext.run();
+        m_ioContext.restart();
+
+        m_acceptingStream.emplace(std::move(acceptingStream));
+        m_connectingStream.emplace(std::move(connectingStream));
+    }
+
+    dots::asio::io_context m_ioContext;
+    std::optional<WebSocketStream> m_acceptingStream;
+    std::optional<WebSocketStream> m_connectingStream;
+};
+
+TEST_F(TestWebSocketStream, WriteBufferSequenceAsSingleBinaryMessage)
+{
+    std::vector<uint8_t> first{ 1, 2, 3 };
+    std::vector<uint8_t> second{ 4, 5 };
+    std::vector<dots::asio::const_buffer> buffers{ dots::asio::buffer(first), dots::asio::buffer(second) };
+    std::optional<size_t> numBytesWritten;
+
+    dots::asio::async_write(*m_connectingStream, buffers, [&](boost::system::error_code error, size_t numBytes)
+    {
+        EXPECT_FALSE(error);
+        numBytesWritten = numBytes;
+    });
+
+    boost::beast::flat_buffer message;
+    bool read = false;
+    m_acceptingStream->ws().async_read(message, [&](boost::system::error_code error, size_t/* numBytes*/)
+    {
+        EXPECT_FALSE(error);
+        read = true;
+    });
+
+    while (!read || numBytesWritten == std::nullopt)
+    {
+        m_ioContext.run_one();
+    }
+
+    EXPECT_EQ(numBytesWritten, 5u);
+    EXPECT_TRUE(m_acceptingStream->ws().got_binary());
+    EXPECT_EQ(message.size(), 5u);
+}
+
+TEST_F(TestWebSocketStream, ReadDataOfConsecutiveMessagesAsStream)
+{
+    std::vector<uint8_t> data(1000);
+    std::iota(data.begin(), data.end(), uint8_t{ 0 });
+    std::vector<uint8_t> received(data.size());
+    size_t numCompleted = 0;
+
+    auto complete = [&](boost::system::error_code error, size_t/* numBytes*/)
+    {
+        EXPECT_FALSE(error);
+        ++numCompleted;
+    };
+
+    dots::asio::async_write(*m_connectingStream, dots::asio::buffer(data.data(), 400), [&](boost::system::error_code error, size_t numBytes)
+    {
+        complete(error, numBytes);
+        dots::asio::async_write(*m_connectingStream, dots::asio::buffer(data.data() + 400, 600), complete);
+    });
+    dots::asio::async_read(*m_acceptingStream, dots::asio::buffer(received), complete);
+
+    while (numCompleted < 3)
+    {
+        m_ioContext.run_one();
+    }
+
+    EXPECT_EQ(received, data);
+}
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/asio.h>
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+#include <memory>
+#include <utility>
+#include <vector>
+#include <dots/testing/gtest/gtest.h>
+#include <dots/io/WorkerPool.h>
+#include <dots/io/channels/UdsChannel.h>
+#include <dots/io/channels/WorkerChannel.h>
+#include <dots/type/Registry.h>
+#include <DotsTestStruct.dots.h>
+
+using dots::io::WorkerChannel;
+using dots::io::posix::UdsChannel;
+
+struct TestWorkerChannel : ::testing::Test
+{
+protected:
+
+    struct connection_t
+    {
+        std::shared_ptr<WorkerChannel> workerChannel;
+        std::shared_ptr<UdsChannel> peerChannel;
+        std::vector<dots::io::Transmission> receivedByWorker;
+        std::vector<dots::io::Transmission> receivedByPeer;
+    };
+
+    TestWorkerChannel() :
+        m_workerPool{ 2 }
+    {
+        /* do nothing */
+    }
+
+    // note: the socket of the wrapped channel is associated with the IO
+    // context of the worker, while the peer is operated on the IO context of
+    // the test
+    std::unique_ptr<connection_t> connect()
+    {
+        size_t worker = m_workerPool.next();
+        dots::asio::local::stream_protocol::socket workerSocket{ m_workerPool.ioContext(worker) };
+        dots::asio::local::stream_protocol::socket peerSocket{ m_ioContext };
+        dots::asio::local::connect_pair(workerSocket, peerSocket);
+
+        auto connection = std::make_unique<connection_t>();
+        dots::io::channel_ptr_t channel = dots::io::make_channel<UdsChannel>(std::move(workerSocket), nullptr);
+        connection->workerChannel = dots::io::make_channel<WorkerChannel>(m_ioContext, m_workerPool.ioContext(worker), std::move(channel));
+        connection->peerChannel = dots::io::make_channel<UdsChannel>(std::move(peerSocket), nullptr);
+        connection->workerChannel->init(m_registry);
+        connection->peerChannel->init(m_peerRegistry);
+
+        receive(*connection->workerChannel, connection->receivedByWorker);
+        receive(*connection->peerChannel, connection->receivedByPeer);
+
+        return connection;
+    }
+
+    void receive(dots::io::Channel& channel, std::vector<dots::io::Transmission>& received)
+    {
+        channel.asyncReceive([&received](dots::io::Transmission transmission)
+        {
+            EXPECT_FALSE(dots::io::WorkerPool::RunningInWorkerThread());
+
+            // note: descriptors of transmitted types are exchanged before the
+            // first instance of a type
+            if (!transmission.descriptor().internal())
+            {
+                received.emplace_back(std::move(transmission));
+            }
+
+            return true;
+        }, [](std::exception_ptr/* ePtr*/)
+        {
+            ADD_FAILURE() << "unexpected channel error";
+        });
+    }
+
+    void processUntil(const std::vector<dots::io::Transmission>& received, size_t size)
+    {
+        while (received.size() < size)
+        {
+            m_ioContext.run_one();
+        }
+    }
+
+    dots::asio::io_context m_ioContext;
+    dots::type::Registry m_registry;
+    dots::type::Registry m_peerRegistry;
+    dots::io::WorkerPool m_workerPool;
+};
+
+TEST_F(TestWorkerChannel, TransmitAndReceiveViaWorker)
+{
+    std::unique_ptr<connection_t> connection = connect();
+
+    connection->workerChannel->transmit(DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 });
+    processUntil(connection->receivedByPeer, 1);
+
+    connection->peerChannel->transmit(DotsTestStruct{ .stringField = "bar", .indKeyfField = 2 });
+    processUntil(connection->receivedByWorker, 1);
+
+    EXPECT_EQ(connection->receivedByPeer[0].instance().to<DotsTestStruct>(), (DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 }));
+    EXPECT_EQ(connection->receivedByWorker[0].instance().to<DotsTestStruct>(), (DotsTestStruct{ .stringField = "bar", .indKeyfField = 2 }));
+}
+
+TEST_F(TestWorkerChannel, FanOutTransmissionToChannelsOnDifferentWorkers)
+{
+    std::unique_ptr<connection_t> connection1 = connect();
+    std::unique_ptr<connection_t> connection2 = connect();
+
+    DotsHeader header{
+        .typeName = DotsTestStruct::_Name,
+        .attributes = DotsTestStruct::stringField_p + DotsTestStruct::indKeyfField_p
+    };
+    dots::io::Transmission transmission{ header, dots::type::AnyStruct{ DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 } } };
+
+    // note: the transmission is shared with both workers instead of being
+    // copied, so it must still be intact after being transmitted
+    connection1->workerChannel->transmit(transmission);
+    connection2->workerChannel->transmit(transmission);
+    processUntil(connection1->receivedByPeer, 1);
+    processUntil(connection2->receivedByPeer, 1);
+
+    EXPECT_EQ(connection1->receivedByPeer[0].instance().to<DotsTestStruct>(), (DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 }));
+    EXPECT_EQ(connection2->receivedByPeer[0].instance().to<DotsTestStruct>(), (DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 }));
+    EXPECT_EQ(transmission.instance().to<DotsTestStruct>(), (DotsTestStruct{ .stringField = "foo", .indKeyfField = 1 }));
+}
+#endif
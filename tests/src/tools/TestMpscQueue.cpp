@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: LGPL-3.0-only
+// Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
+#include <dots/testing/gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <dots/tools/MpscQueue.h>
+
+using dots::tools::MpscQueue;
+
+TEST(TestMpscQueue, tryPop_EmptyWhenNothingWasPushed)
+{
+    MpscQueue<int> sut;
+    EXPECT_EQ(sut.tryPop(), std::nullopt);
+}
+
+TEST(TestMpscQueue, tryPop_ReturnsElementsInOrderOfPush)
+{
+    MpscQueue<int> sut;
+    sut.push(1);
+    sut.push(2);
+    EXPECT_EQ(sut.tryPop(), 1);
+
+    sut.push(3);
+    EXPECT_EQ(sut.tryPop(), 2);
+    EXPECT_EQ(sut.tryPop(), 3);
+    EXPECT_EQ(sut.tryPop(), std::nullopt);
+}
+
+TEST(TestMpscQueue, dtor_DestroysRemainingElements)
+{
+    auto element = std::make_shared<int>(42);
+
+    {
+        MpscQueue<std::shared_ptr<int>> sut;
+        sut.push(element);
+        sut.push(element);
+        sut.push(element);
+        EXPECT_NE(sut.tryPop(), nullptr);
+        EXPECT_EQ(element.use_count(), 3);
+    }
+
+    EXPECT_EQ(element.use_count(), 1);
+}
+
+TEST(TestMpscQueue, tryPop_ReturnsElementsOfEachProducerInOrder)
+{
+    constexpr int NumProducers = 4;
+    constexpr int NumElements = 10000;
+
+    MpscQueue<std::pair<int, int>> sut;
+    std::vector<std::thread> producers;
+
+    for (int producer = 0; producer < NumProducers; ++producer)
+    {
+        producers.emplace_back([&sut, producer]
+        {
+            for (int i = 0; i < NumElements; ++i)
+            {
+                sut.push({ producer, i });
+            }
+        });
+    }
+
+    std::vector<int> expected(NumProducers, 0);
+
+    for (int popped = 0; popped < NumProducers * NumElements;)
+    {
+        if (std::optional<std::pair<int, int>> element = sut.tryPop(); element != std::nullopt)
+        {
+            auto [producer, i] = *element;
+            ASSERT_EQ(i, expected[producer]);
+            ++expected[producer];
+            ++popped;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    EXPECT_EQ(sut.tryPop(), std::nullopt);
+    EXPECT_EQ(expected, std::vector<int>(NumProducers, NumElements));
+}
@@ -2,11 +2,19 @@
 // Copyright 2015-2022 Thomas Schaetzlein <thomas@pnxs.de>, Christopher Gerlach <gerlachch@gmx.com>
 #include <dots/testing/gtest/gtest.h>
 #include <dots/type/Registry.h>
+#include <dots/type/DynamicStruct.h>
 #include <DotsHeader.dots.h>
 #include <DotsTestStruct.dots.h>
 
 struct TestRegistry : ::testing::Test
 {
+protected:
+
+    static std::shared_ptr<dots::type::Descriptor<dots::type::DynamicStruct>> MakeDynamicDescriptor(std::string name)
+    {
+        const dots::type::StructDescriptor& descriptor = DotsTestStruct::_Descriptor();
+        return dots::type::make_descriptor<dots::type::Descriptor<dots::type::DynamicStruct>>(std::move(name), descriptor.flags(), descriptor.propertyDescriptors(), descriptor.size());
+    }
 };
 
 #define EXPECT_TYPE_IN_REGISTRY(typeName_) [&] \
@@ -102,6 +110,36 @@ TEST_F(TestRegistry, deregisterType)
     EXPECT_STRUCT_TYPE_NOT_IN_REGISTRY(DotsTestStruct::_Descriptor().name());
 }
 
+TEST_F(TestRegistry, findStructTypeByTypeId)
+{
+    auto& descriptor = dots::type::Descriptor<DotsTestStruct>::Instance();
+    dots::type::Registry sut{ std::nullopt, dots::type::Registry::StaticTypePolicy::FundamentalOnly };
+
+    EXPECT_EQ(sut.findStructType(descriptor.typeId()), nullptr);
+    EXPECT_NE(descriptor.typeId(), dots::type::Descriptor<DotsTestSubStruct>::Instance().typeId());
+
+    sut.registerType(descriptor);
+    EXPECT_EQ(sut.findStructType(descriptor.typeId()), &descriptor);
+
+    sut.deregisterType(descriptor);
+    EXPECT_EQ(sut.findStructType(descriptor.typeId()), nullptr);
+}
+
+TEST_F(TestRegistry, deregistrationsAreCounted)
+{
+    auto& descriptor = dots::type::Descriptor<DotsTestStruct>::Instance();
+    dots::type::Registry sut{ std::nullopt, dots::type::Registry::StaticTypePolicy::FundamentalOnly };
+
+    sut.registerType(descriptor);
+    EXPECT_EQ(sut.deregistrations(), 0u);
+
+    EXPECT_THROW(sut.deregisterType("Foobar"), std::logic_error);
+    EXPECT_EQ(sut.deregistrations(), 0u);
+
+    sut.deregisterType(descriptor);
+    EXPECT_EQ(sut.deregistrations(), 1u);
+}
+
 
 TEST_F(TestRegistry, deregisterStaticType)
 {
@@ -117,6 +155,78 @@ TEST_F(TestRegistry, deregisterStaticType)
     EXPECT_FALSE(sut.hasType(descriptor.name()));
 }
 
+TEST_F(TestRegistry, reuseTypeIdOfDeregisteredDynamicType)
+{
+    dots::type::Registry sut{ std::nullopt, dots::type::Registry::StaticTypePolicy::FundamentalOnly };
+
+    auto descriptor1 = MakeDynamicDescriptor("DynamicTestStruct1");
+    sut.registerType(descriptor1);
+    dots::type::StructDescriptor::type_id_t typeId = descriptor1->typeId();
+    EXPECT_EQ(sut.findStructType(typeId), descriptor1.get());
+
+    sut.deregisterType(*descriptor1);
+    EXPECT_EQ(sut.findStructType(typeId), nullptr);
+
+    auto descriptor2 = MakeDynamicDescriptor("DynamicTestStruct2");
+    sut.registerType(descriptor2);
+    EXPECT_EQ(descriptor2->typeId(), typeId);
+    EXPECT_EQ(sut.findStructType(typeId), descriptor2.get());
+}
+
+TEST_F(TestRegistry, doNotAllocateTypeIdsForDuplicateRegistrations)
+{
+    dots::type::Registry sut{ std::nullopt, dots::type::Registry::StaticTypePolicy::FundamentalOnly };
+
+    auto descriptor = MakeDynamicDescriptor("DynamicTestStruct");
+    sut.registerType(descriptor);
+
+    // note: the id of the probe is released again and therefore the next id
+    // that will be allocated
+    auto probe = MakeDynamicDescriptor("DynamicTestStructProbe");
+    sut.registerType(probe);
+    dots::type::StructDescriptor::type_id_t nextTypeId = probe->typeId();
+    sut.deregisterType(*probe);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto duplicate = MakeDynamicDescriptor("DynamicTestStruct");
+        EXPECT_EQ(&sut.registerType(duplicate, false), descriptor.get());
+    }
+
+    auto other = MakeDynamicDescriptor("DynamicTestStructOther");
+    sut.registerType(other);
+    EXPECT_EQ(other->typeId(), nextTypeId);
+}
+
+TEST_F(TestRegistry, releaseTypeIdsOfDynamicTypesOnDestruction)
+{
+    dots::type::StructDescriptor::type_id_t typeId;
+
+    {
+        dots::type::Registry sut{ std::nullopt, dots::type::Registry::StaticTypePolicy::FundamentalOnly };
+        auto descriptor = MakeDynamicDescriptor("DynamicTestStruct");
+        sut.registerType(descriptor);
+        typeId = descriptor->typeId();
+    }
+
+    dots::type::Registry sut{ std::nullopt, dots::type::Registry::StaticTypePolicy::FundamentalOnly };
+    auto descriptor = MakeDynamicDescriptor("DynamicTestStruct");
+    sut.registerType(descriptor);
+    EXPECT_EQ(descriptor->typeId(), typeId);
+}
+
+TEST_F(TestRegistry, retainTypeIdOfStaticTypeAfterDeregistration)
+{
+    auto& descriptor = dots::type::Descriptor<DotsTestStruct>::Instance();
+    dots::type::StructDescriptor::type_id_t typeId = descriptor.typeId();
+
+    dots::type::Registry sut{ std::nullopt, dots::type::Registry::StaticTypePolicy::FundamentalOnly };
+    sut.registerType(descriptor);
+    sut.deregisterType(descriptor);
+
+    EXPECT_EQ(descriptor.typeId(), typeId);
+}
+
 TEST_F(TestRegistry, forEach)
 {
     using namespace dots::type;